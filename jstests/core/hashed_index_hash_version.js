@@ -0,0 +1,45 @@
+// Tests that hashed indexes can be built with the MurmurHash3 hash version, that their keys are
+// computed with the requested hash function, and that queries use matching bounds.
+// @tags: [requires_non_retryable_commands]
+(function() {
+    "use strict";
+
+    const coll = db.hashed_index_hash_version;
+    coll.drop();
+
+    for (let i = 0; i < 100; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i % 10 === 0 ? null : "value" + i}));
+    }
+    assert.writeOK(coll.insert({_id: 100}));
+
+    // Unknown hash versions are rejected.
+    assert.commandFailedWithCode(coll.createIndex({a: "hashed"}, {hashVersion: 2}),
+                                 ErrorCodes.BadValue);
+    assert.commandFailedWithCode(coll.createIndex({a: "hashed"}, {hashVersion: "1"}),
+                                 ErrorCodes.TypeMismatch);
+
+    assert.commandWorked(coll.createIndex({a: "hashed"}, {hashVersion: 1}));
+    const spec = coll.getIndexes().filter((idx) => idx.name === "a_hashed")[0];
+    assert.eq(1, spec.hashVersion, tojson(spec));
+
+    function hashOf(value, hashVersion) {
+        const res = assert.commandWorked(
+            db.runCommand({_hashBSONElement: value, seed: 0, hashVersion: hashVersion}));
+        return res.out;
+    }
+
+    // The index keys are the MurmurHash3 hashes of the values, which differ from the MD5 ones.
+    assert.neq(hashOf("value1", 0), hashOf("value1", 1));
+    const keys = coll.find({a: "value1"}).hint({a: "hashed"}).returnKey().toArray();
+    assert.eq([{a: hashOf("value1", 1)}], keys);
+
+    // Equality and $in predicates answered by the index match a collection scan.
+    for (let query of [{a: "value1"}, {a: {$in: ["value2", "value33"]}}, {a: null}]) {
+        const expected = coll.find(query).sort({_id: 1}).hint({$natural: 1}).toArray();
+        assert.eq(expected, coll.find(query).sort({_id: 1}).hint({a: "hashed"}).toArray(),
+                  tojson(query));
+    }
+
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+}());
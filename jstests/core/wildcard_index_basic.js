@@ -0,0 +1,88 @@
+// Tests that a wildcard index answers predicates over the paths it indexes with the same results as
+// a collection scan, and that it is not used for predicates it cannot answer.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const coll = db.wildcard_index_basic;
+    coll.drop();
+
+    assert.writeOK(coll.insert([
+        {_id: 0, a: 1, b: {c: "x", d: 5}},
+        {_id: 1, a: [1, 2], b: {c: "y", d: [6, 7]}},
+        {_id: 2, a: {e: 1}, b: [{c: "x"}, {c: "z", d: 8}]},
+        {_id: 3, a: null, b: {}},
+        {_id: 4, b: {c: ["x", "y"], d: {f: 9}}},
+        {_id: 5, a: 3, b: "not an object"},
+    ]));
+
+    // Invalid wildcard key patterns and options are rejected.
+    assert.commandFailedWithCode(coll.createIndex({"a": 1, "$**": 1}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({"$**": -1}), ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({"a.$**.b": 1}), ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({"$**": 1}, {unique: true}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({"$**": 1}, {sparse: true}),
+                                 ErrorCodes.CannotCreateIndex);
+
+    function assertSameResults(query, wildcardUsable) {
+        const expected = coll.find(query).sort({_id: 1}).hint({$natural: 1}).toArray();
+        assert.eq(expected, coll.find(query).sort({_id: 1}).toArray(), tojson(query));
+
+        const explain = coll.find(query).explain();
+        const ixscans = getPlanStages(explain.queryPlanner.winningPlan, "IXSCAN");
+        const usesWildcard = ixscans.some((stage) => stage.keyPattern.hasOwnProperty("$_path"));
+        assert.eq(wildcardUsable, usesWildcard, tojson(explain));
+    }
+
+    function runTests(keyPattern, indexedPaths) {
+        assert.commandWorked(coll.createIndex(keyPattern));
+
+        const queries = [
+            {a: 1},
+            {a: {$gt: 1}},
+            {"a.e": 1},
+            {"b.c": "x"},
+            {"b.c": {$in: ["y", "z"]}},
+            {"b.c": /^x/},
+            {"b.d": {$gte: 6, $lte: 8}},
+            {"b.d.f": 9},
+            {a: {$elemMatch: {$gt: 1}}},
+            {b: {$elemMatch: {c: "z"}}},
+        ];
+        for (let query of queries) {
+            const path = Object.keys(query)[0];
+            const usable = indexedPaths.some((prefix) => path === prefix ||
+                                                 path.startsWith(prefix + ".") || prefix === "");
+            assertSameResults(query, usable);
+        }
+
+        // Predicates which can match documents with no index keys for the path are answered
+        // without the index.
+        for (let query of [{a: null}, {a: {$exists: true}}, {a: {$ne: 1}}, {b: {}}, {"a.0": 1}]) {
+            assertSameResults(query, false);
+        }
+
+        const validateRes = assert.commandWorked(coll.validate({full: true}));
+        assert(validateRes.valid, tojson(validateRes));
+
+        assert.commandWorked(coll.dropIndex(keyPattern));
+    }
+
+    runTests({"$**": 1}, [""]);
+    runTests({"b.$**": 1}, ["b"]);
+
+    // Updates and removes maintain the index.
+    assert.commandWorked(coll.createIndex({"$**": 1}));
+    assert.writeOK(coll.update({_id: 0}, {$set: {"b.c": "w"}}));
+    assertSameResults({"b.c": "w"}, true);
+    assertSameResults({"b.c": "x"}, true);
+    assert.writeOK(coll.remove({_id: 2}));
+    assertSameResults({"b.c": "x"}, true);
+
+    // A hinted wildcard index must be able to answer a predicate in the query.
+    assert.eq(1, coll.find({"b.c": "w"}).hint({"$**": 1}).itcount());
+    assert.throws(() => coll.find({}).hint({"$**": 1}).itcount());
+}());
@@ -0,0 +1,123 @@
+/**
+ * Tests collections created with the 'clustered' option, which store documents under RecordIds
+ * derived from their _id instead of maintaining a separate _id index.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    // Skip this test if not running with the "wiredTiger" storage engine.
+    const storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        print('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    const rst = new ReplSetTest({nodes: 2});
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const testDB = primary.getDB("test");
+    const coll = testDB.clustered;
+
+    assert.commandFailedWithCode(testDB.createCollection("bad", {clustered: true, capped: true}),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(testDB.createCollection("bad", {clustered: 1}),
+                                 ErrorCodes.TypeMismatch);
+    assert.commandFailedWithCode(
+        testDB.createCollection("bad", {clustered: true, collation: {locale: "fr"}}),
+        ErrorCodes.InvalidOptions);
+
+    assert.commandWorked(testDB.createCollection(coll.getName(), {clustered: true}));
+    assert.eq(0, coll.getIndexes().length, tojson(coll.getIndexes()));
+    assert.eq(true, testDB.getCollectionInfos({name: coll.getName()})[0].options.clustered);
+
+    // Insert out of order; every document is found by its _id regardless.
+    const ids = [];
+    for (let i = 1; i <= 100; ++i) {
+        ids.push(i);
+    }
+    Array.shuffle(ids);
+    const bulk = coll.initializeUnorderedBulkOp();
+    ids.forEach(id => bulk.insert({_id: id, x: id % 10}));
+    assert.commandWorked(bulk.execute());
+
+    const natural = coll.find().sort({$natural: 1}).toArray().map(doc => doc._id);
+    assert.eq(100, natural.length);
+    assert.eq(ids.slice().sort((a, b) => a - b), natural.sort((a, b) => a - b));
+    ids.forEach(id => assert.eq(id % 10, coll.findOne({_id: id}).x, tojson(id)));
+
+    // _ids stay unique across numeric types.
+    assert.writeErrorWithCode(coll.insert({_id: NumberLong(7)}), ErrorCodes.DuplicateKey);
+    assert.writeErrorWithCode(coll.insert({_id: NumberDecimal("7.0")}), ErrorCodes.DuplicateKey);
+
+    // Any _id type clusters, including generated ObjectIds.
+    const otherIds = [ObjectId(), "b", "a", {k: 1}, -2.5, 0];
+    otherIds.forEach(id => assert.commandWorked(coll.insert({_id: id})));
+    assert.commandWorked(coll.insert({x: -1}));
+    assert.writeErrorWithCode(coll.insert({_id: "a"}), ErrorCodes.DuplicateKey);
+    const generated = coll.findOne({x: -1});
+    assert(generated._id instanceof ObjectId, tojson(generated));
+    assert.eq(generated, coll.findOne({_id: generated._id}));
+    otherIds.forEach(id => assert.eq(id, coll.findOne({_id: id})._id, tojson(id)));
+    assert.eq(["a", "b"],
+              coll.find({_id: {$type: "string"}}).toArray().map(doc => doc._id).sort());
+    assert.eq(2, coll.find({_id: {$gte: "a", $lt: "c"}}).itcount());
+    assert.eq(2, coll.find({_id: {$type: "objectId"}}).itcount());
+    assert.commandWorked(coll.remove({_id: {$nin: ids}}));
+    assert.eq(100, coll.find().itcount());
+
+    // Point lookups go straight to the record store.
+    let explain = coll.find({_id: NumberInt(42)}).explain("executionStats");
+    assert(isIdhack(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+    assert.eq(1, explain.executionStats.nReturned);
+    assert.eq(1, explain.executionStats.totalDocsExamined);
+    assert.eq(0, coll.find({_id: "42"}).itcount());
+    assert.eq(0, coll.find({_id: 42.5}).itcount());
+    assert.eq(42, coll.findOne({_id: 42.0})._id);
+
+    // Range scans only read the records whose _id shares a prefix with the range.
+    explain = coll.find({_id: {$gte: 10, $lt: 20}}).explain("executionStats");
+    assert(isCollscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+    assert.eq(10, explain.executionStats.nReturned);
+    assert.lt(explain.executionStats.totalDocsExamined, 100, tojson(explain));
+    assert.eq([17, 18, 19],
+              coll.find({_id: {$gt: 16.5, $lte: 19}}, {_id: 1})
+                  .sort({$natural: -1})
+                  .toArray()
+                  .map(doc => doc._id)
+                  .sort((a, b) => a - b));
+    assert.eq(0, coll.find({_id: {$gt: 100}}).itcount());
+
+    // Updates and deletes by _id, including upserts.
+    assert.commandWorked(coll.update({_id: 42}, {$set: {y: 1}}));
+    assert.eq(1, coll.findOne({_id: 42}).y);
+    // An in-place update, which modifies the stored document rather than replacing it.
+    assert.commandWorked(coll.update({_id: 42}, {$inc: {x: 1}}));
+    assert.eq(3, coll.findOne({_id: 42}).x);
+    assert.commandWorked(coll.update({_id: 1000}, {$set: {y: 2}}, {upsert: true}));
+    assert.eq(2, coll.findOne({_id: 1000}).y);
+    assert.commandWorked(coll.remove({_id: 50}));
+    assert.eq(null, coll.findOne({_id: 50}));
+    assert.commandWorked(coll.insert({_id: 50}));
+
+    // Secondary indexes work as usual.
+    assert.commandWorked(coll.createIndex({x: 1}));
+    assert.eq(10, coll.find({x: 3}).hint({x: 1}).itcount());
+
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    // Secondaries apply the same operations to their own clustered collection.
+    rst.awaitReplication();
+    const secondaryColl = rst.getSecondary().getDB("test").clustered;
+    secondaryColl.getMongo().setSlaveOk();
+    assert.eq(101, secondaryColl.find().itcount());
+    assert.eq(1, secondaryColl.findOne({_id: 42}).y);
+    assert.eq(true, secondaryColl.stats().clustered);
+
+    // Stopping the set checks that the data on both members is the same.
+    rst.stopSet();
+}());
@@ -0,0 +1,90 @@
+/**
+ * Tests that a node started with initialSyncMethod "fileCopyBased" copies the data files of its
+ * sync source before opening them, and falls back to a logical initial sync when it cannot.
+ * @tags: [requires_persistence, requires_replication, requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const rst = new ReplSetTest({nodes: 1});
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const coll = primary.getDB("test").file_copy_initial_sync;
+
+    // The copy can only read this collection with the dictionary it was compressed with.
+    assert.commandWorked(primary.getDB("test").createCollection(
+        coll.getName(),
+        {storageEngine: {wiredTiger: {configString: "block_compressor=dictionary"}}}));
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        bulk.insert({_id: i, x: "x".repeat(1000)});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({x: 1}));
+    assert.commandWorked(primary.getDB("test").runCommand(
+        {collMod: coll.getName(), trainCompressionDictionary: true}));
+
+    // Only one backup may be open at a time, and its files must be read with its backupId.
+    const begin = assert.commandWorked(primary.adminCommand({beginFileCopyBackup: 1}));
+    assert(begin.files.some((file) => file.filename === "storage.bson"), tojson(begin));
+    assert(begin.files.some((file) => file.filename === "WiredTigerDictionaries.bson"),
+           tojson(begin));
+    assert.commandFailed(primary.adminCommand({beginFileCopyBackup: 1}));
+    assert.commandFailed(primary.adminCommand(
+        {readFileCopyBackupFile: ObjectId(), filename: "storage.bson", offset: 0, length: 16}));
+    assert.commandFailed(primary.adminCommand({
+        readFileCopyBackupFile: begin.backupId,
+        filename: "../mongod.lock",
+        offset: 0,
+        length: 16
+    }));
+    assert.commandWorked(primary.adminCommand({endFileCopyBackup: begin.backupId}));
+
+    // A backup left idle is ended without waiting for another one to be begun.
+    assert.commandWorked(primary.adminCommand({setParameter: 1, fileCopyBackupIdleTimeoutSecs: 1}));
+    const idle = assert.commandWorked(primary.adminCommand({beginFileCopyBackup: 1}));
+    checkLog.contains(primary,
+                      "Ending file copy backup " + idle.backupId.str + " which has been idle");
+    assert.commandFailedWithCode(primary.adminCommand({
+        readFileCopyBackupFile: idle.backupId,
+        filename: "storage.bson",
+        offset: 0,
+        length: 16
+    }),
+                                 ErrorCodes.NoSuchKey);
+    assert.commandWorked(
+        primary.adminCommand({setParameter: 1, fileCopyBackupIdleTimeoutSecs: 10 * 60}));
+
+    function addNode(source) {
+        const node = rst.add({
+            rsConfig: {priority: 0, votes: 0},
+            setParameter: {initialSyncMethod: "fileCopyBased", fileCopyInitialSyncSource: source}
+        });
+        rst.reInitiate();
+        rst.awaitSecondaryNodes();
+        rst.awaitReplication();
+        return node;
+    }
+
+    const copied = addNode(primary.host);
+    checkLog.contains(copied, "File copy based initial sync from " + primary.host + " copied");
+    assert.eq(1000, copied.getDB("test").file_copy_initial_sync.find().itcount());
+
+    // Writes made after the backup was taken are replicated to the copy.
+    assert.writeOK(coll.insert({_id: 1000}, {writeConcern: {w: 2}}));
+    assert.eq(1, copied.getDB("test").file_copy_initial_sync.find({_id: 1000}).itcount());
+
+    // A node which cannot copy the files of its source syncs logically instead.
+    const fallback = addNode("localhost:" + allocatePort());
+    checkLog.contains(fallback, "falling back to logical initial sync");
+    const fallbackColl = fallback.getDB("test").file_copy_initial_sync;
+    assert.eq(1001, fallbackColl.find().itcount());
+    assert.eq(1001, fallbackColl.find({x: {$exists: true}}).hint({x: 1}).itcount());
+
+    rst.stopSet();
+}());
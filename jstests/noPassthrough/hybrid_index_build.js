@@ -0,0 +1,72 @@
+/**
+ * Tests that a hybrid background index build, which bulk loads the keys it finds by scanning the
+ * collection, applies the writes made to the collection while it was scanning.
+ * @tags: [requires_document_locking]
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+
+    const conn = MongoRunner.runMongod({setParameter: {enableHybridIndexBuilds: true}});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.hybrid_index_build;
+    coll.drop();
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 100; ++i) {
+        bulk.insert({_id: i, i: i, a: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    // Stop the collection scan halfway, so that the writes below land on both sides of it.
+    assert.commandWorked(testDB.adminCommand(
+        {configureFailPoint: "hangAfterIndexBuildOf", mode: "alwaysOn", data: {i: 50}}));
+
+    const awaitIndexBuild = startParallelShell(function() {
+        assert.commandWorked(
+            db.hybrid_index_build.createIndex({a: 1}, {background: true, name: "a_1"}));
+    }, conn.port);
+
+    checkLog.contains(conn, "Hanging after index build of i=50");
+
+    for (let i = 100; i < 200; ++i) {
+        assert.writeOK(coll.insert({_id: i, i: i, a: i}));
+    }
+    for (let i = 0; i < 10; ++i) {
+        assert.writeOK(coll.update({_id: i}, {$set: {a: -1 - i}}));
+    }
+    assert.writeOK(coll.remove({_id: {$gte: 60, $lt: 70}}));
+    assert.writeOK(coll.update({_id: 80}, {$set: {a: [1000, 1001]}}));
+
+    assert.commandWorked(
+        testDB.adminCommand({configureFailPoint: "hangAfterIndexBuildOf", mode: "off"}));
+    awaitIndexBuild();
+
+    assert.eq(190, coll.find().itcount());
+    assert.eq(180, coll.find({a: {$gte: 0}}).hint({a: 1}).itcount());
+    assert.eq(10, coll.find({a: {$lt: 0}}).hint({a: 1}).itcount());
+    assert.eq(0, coll.find({a: {$gte: 60, $lt: 70}}).hint({a: 1}).itcount());
+    assert.eq(0, coll.find({a: 80}).hint({a: 1}).itcount());
+    assert.eq(1, coll.find({a: 1001}).hint({a: 1}).itcount());
+
+    // The index became multikey through a write the build recorded rather than one it scanned.
+    const explain = coll.find({a: 1001}).hint({a: 1}).explain();
+    assert(explain.queryPlanner.winningPlan.inputStage.isMultiKey, tojson(explain));
+
+    let validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    // Unique indexes are built in the background without sorting, and still reject duplicates.
+    assert.commandWorked(coll.createIndex({i: 1}, {background: true, unique: true}));
+    assert.writeError(coll.insert({_id: 200, i: 0}));
+    assert.commandFailedWithCode(coll.createIndex({b: 1}, {background: true, unique: true}),
+                                 ErrorCodes.DuplicateKey);
+
+    validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    MongoRunner.stopMongod(conn);
+}());
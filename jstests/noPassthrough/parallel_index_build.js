@@ -0,0 +1,70 @@
+/**
+ * Tests that foreground index builds which generate, sort and bulk load keys on several threads
+ * produce the same indexes and errors as builds on a single thread.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({setParameter: {indexBuildThreads: 4}});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.parallel_index_build;
+    coll.drop();
+
+    // Enough documents that every worker sorts several batches.
+    const numDocs = 10000;
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; ++i) {
+        bulk.insert({
+            _id: i,
+            a: i,
+            b: i % 7,
+            c: i,
+            dup: i % 2,
+            tags: ["t" + (i % 3), "t" + (i % 5)],
+            loc: {type: "Point", coordinates: [i % 90, i % 45]}
+        });
+    }
+    assert.writeOK(bulk.execute());
+
+    assert.commandWorked(testDB.runCommand({
+        createIndexes: coll.getName(),
+        indexes: [
+            {key: {a: 1}, name: "a_1", unique: true},
+            {key: {b: 1, a: -1}, name: "b_1_a_-1"},
+            {key: {tags: 1}, name: "tags_1"},
+            {key: {loc: "2dsphere"}, name: "loc_2dsphere"},
+            {key: {c: 1}, name: "c_1", partialFilterExpression: {a: {$gte: 5000}}},
+        ]
+    }));
+
+    assert.eq(numDocs, coll.find({a: {$gte: 0}}).hint({a: 1}).itcount());
+    assert.eq(1429, coll.find({b: 3}).hint({b: 1, a: -1}).itcount());
+    assert.eq(4667, coll.find({tags: "t0"}).hint({tags: 1}).itcount());
+    assert.eq(5000, coll.find({c: {$gte: 0}, a: {$gte: 5000}}).hint({c: 1}).itcount());
+    assert.eq(112,
+              coll.find({loc: {$geoIntersects: {$geometry: {type: "Point", coordinates: [3, 3]}}}})
+                  .itcount());
+
+    // The index on 'tags' is multikey even though no single worker need have seen every array.
+    const explain = coll.find({tags: "t0"}).hint({tags: 1}).explain();
+    assert(explain.queryPlanner.winningPlan.inputStage.isMultiKey, tojson(explain));
+
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    // Duplicates found while merging the keys sorted by different workers fail the build.
+    assert.commandFailedWithCode(coll.createIndex({dup: 1}, {unique: true}),
+                                 ErrorCodes.DuplicateKey);
+
+    // Key generation errors on the workers fail the build.
+    assert.writeOK(coll.insert({_id: numDocs, x: [1, 2], y: [1, 2]}));
+    assert.commandFailedWithCode(coll.createIndex({x: 1, y: 1}),
+                                 ErrorCodes.CannotIndexParallelArrays);
+
+    assert.commandFailedWithCode(testDB.adminCommand({setParameter: 1, indexBuildThreads: 0}),
+                                 ErrorCodes.BadValue);
+
+    MongoRunner.stopMongod(conn);
+}());
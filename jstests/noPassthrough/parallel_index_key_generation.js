@@ -0,0 +1,54 @@
+/**
+ * Tests that inserts produce the same index entries and errors when the keys for an insert batch
+ * are generated on the index key generation thread pool.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({
+        setParameter: {indexKeyGenerationThreads: 4, internalInsertParallelKeyGenerationMinWork: 1}
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.parallel_index_key_generation;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: 1, a: -1}));
+    assert.commandWorked(coll.createIndex({tags: 1}));
+    assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+    assert.commandWorked(coll.createIndex({c: 1}, {partialFilterExpression: {a: {$gte: 50}}}));
+
+    const docs = [];
+    for (let i = 0; i < 100; ++i) {
+        docs.push({
+            _id: i,
+            a: i,
+            b: i % 7,
+            c: i,
+            tags: ["t" + (i % 3), "t" + (i % 5)],
+            loc: {type: "Point", coordinates: [i % 90, i % 45]}
+        });
+    }
+    assert.commandWorked(coll.insert(docs));
+
+    assert.eq(100, coll.find({a: {$gte: 0}}).hint({a: 1}).itcount());
+    assert.eq(14, coll.find({b: 3}).hint({b: 1, a: -1}).itcount());
+    assert.eq(47, coll.find({tags: "t0"}).hint({tags: 1}).itcount());
+    assert.eq(50, coll.find({c: {$gte: 0}, a: {$gte: 50}}).hint({c: 1}).itcount());
+    assert.eq(2,
+              coll.find({loc: {$geoIntersects: {$geometry: {type: "Point", coordinates: [3, 3]}}}})
+                  .itcount());
+
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    // Key generation errors are reported for the document which caused them.
+    const res = coll.insert([{_id: 100, tags: [1]}, {_id: 101, tags: [1], a: [1, 2], b: [1, 2]}],
+                            {ordered: true});
+    assert.writeErrorWithCode(res, ErrorCodes.CannotIndexParallelArrays);
+    assert.eq(101, coll.find().itcount());
+
+    MongoRunner.stopMongod(conn);
+}());
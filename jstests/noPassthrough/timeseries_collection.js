@@ -0,0 +1,123 @@
+/**
+ * Tests time-series collections, which store measurements in bucket documents grouped by meta value
+ * and time range, and expose them through a view which unpacks the buckets.
+ */
+(function() {
+    "use strict";
+
+    const rst = new ReplSetTest({nodes: 2});
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const testDB = primary.getDB("test");
+    const coll = testDB.weather;
+    const bucketsColl = testDB.getCollection("system.buckets." + coll.getName());
+
+    assert.commandFailedWithCode(testDB.createCollection("bad", {timeseries: {metaField: "m"}}),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(
+        testDB.createCollection("bad", {timeseries: {timeField: "t", metaField: "t"}}),
+        ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(
+        testDB.createCollection("bad", {timeseries: {timeField: "t"}, validator: {a: 1}}),
+        ErrorCodes.InvalidOptions);
+
+    const timeseriesOptions = {timeField: "t", metaField: "sensor", bucketMaxSpanSeconds: 60};
+    assert.commandWorked(testDB.createCollection(coll.getName(), {timeseries: timeseriesOptions}));
+
+    const names = [coll.getName(), bucketsColl.getName()];
+    const collInfos = testDB.getCollectionInfos({name: {$in: names}});
+    assert.eq(2, collInfos.length, tojson(collInfos));
+    collInfos.forEach(info => {
+        if (info.name === coll.getName()) {
+            assert.eq("view", info.type, tojson(info));
+            assert.eq(bucketsColl.getName(), info.options.viewOn, tojson(info));
+        } else {
+            assert.eq(timeseriesOptions, info.options.timeseries, tojson(info));
+        }
+    });
+
+    // 3 sensors with one measurement every 10 seconds for 5 minutes.
+    const start = ISODate("2018-06-01T00:00:00Z").getTime();
+    const measurements = [];
+    for (let i = 0; i < 30; ++i) {
+        for (let sensor = 0; sensor < 3; ++sensor) {
+            const doc = {t: new Date(start + i * 10 * 1000), sensor: {id: sensor}, temp: i};
+            if (i % 2 === 0) {
+                doc.humidity = sensor;
+            }
+            measurements.push(doc);
+        }
+    }
+    assert.commandWorked(coll.insert(measurements.slice(0, 45)));
+    assert.commandWorked(coll.insert(measurements.slice(45), {ordered: false}));
+
+    // Each sensor fills one bucket per minute.
+    assert.eq(15, bucketsColl.count());
+    bucketsColl.find().forEach(bucket => {
+        assert.eq(1, bucket.control.version, tojson(bucket));
+        assert.eq(6, bucket.control.count, tojson(bucket));
+        assert.eq(6, Object.keys(bucket.data.t).length, tojson(bucket));
+        assert.eq(3, Object.keys(bucket.data.humidity).length, tojson(bucket));
+        assert.lte(bucket.control.min.t, bucket.control.max.t, tojson(bucket));
+    });
+
+    // The view returns the measurements as they were inserted, though not necessarily with their
+    // fields in the same order.
+    const sortSpec = {t: 1, "sensor.id": 1};
+    const find = (c, filter) => c.find(filter).sort(sortSpec).toArray().map(doc => {
+        const measurement = {t: doc.t, sensor: doc.sensor, temp: doc.temp};
+        if (doc.hasOwnProperty("humidity")) {
+            measurement.humidity = doc.humidity;
+        }
+        return measurement;
+    });
+    assert.eq(measurements, find(coll, {}));
+
+    // Predicates on the time and meta fields are evaluated against the bounds of the buckets.
+    const from = new Date(start + 60 * 1000);
+    const to = new Date(start + 120 * 1000);
+    const filter = {t: {$gte: from, $lt: to}, "sensor.id": 1};
+    const expected = measurements.filter(m => m.t >= from && m.t < to && m.sensor.id === 1);
+    assert.eq(6, expected.length);
+    assert.eq(expected, find(coll, filter));
+
+    const explain = coll.explain().aggregate([{$match: filter}]);
+    const bucketQuery = tojson(explain.stages[0].$cursor.query);
+    assert(bucketQuery.includes("control.max.t"), tojson(explain));
+    assert(bucketQuery.includes("control.min.t"), tojson(explain));
+    assert(bucketQuery.includes("meta.id"), tojson(explain));
+
+    // Invalid measurements are reported with their index.
+    const badRes = coll.insert(
+        [{t: new Date(start), sensor: {id: 9}}, {sensor: {id: 9}}, {t: new Date(start), x: 1}],
+        {ordered: false});
+    assert.eq(1, badRes.getWriteErrors().length, tojson(badRes));
+    assert.eq(1, badRes.getWriteErrors()[0].index, tojson(badRes));
+    assert.eq(ErrorCodes.BadValue, badRes.getWriteErrors()[0].code, tojson(badRes));
+    assert.eq(92, coll.find().itcount());
+
+    // Measurements are rejected in transactions.
+    const session = primary.startSession();
+    session.startTransaction();
+    assert.commandFailedWithCode(
+        session.getDatabase("test").runCommand(
+            {insert: coll.getName(), documents: [{t: new Date(start)}]}),
+        ErrorCodes.OperationNotSupportedInTransaction);
+    session.abortTransaction();
+    session.endSession();
+
+    // The secondary serves the same measurements.
+    rst.awaitReplication();
+    const secondaryColl = rst.getSecondary().getDB("test").getCollection(coll.getName());
+    secondaryColl.getMongo().setSlaveOk();
+    assert.eq(92, secondaryColl.find().itcount());
+    assert.eq(expected, find(secondaryColl, filter));
+
+    // Dropping the time-series collection drops its buckets.
+    assert(coll.drop());
+    assert.eq(0, testDB.getCollectionInfos({name: {$in: names}}).length);
+
+    rst.stopSet();
+}());
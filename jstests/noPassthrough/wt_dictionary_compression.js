@@ -0,0 +1,75 @@
+/**
+ * Tests that collections created with the "dictionary" block compressor can train a compression
+ * dictionary with collMod, and that documents written before and after training remain readable
+ * across a restart.
+ */
+(function() {
+    "use strict";
+
+    // Skip this test if not running with the "wiredTiger" storage engine.
+    const storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        print('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    const dbpath = MongoRunner.dataPath + "wt_dictionary_compression";
+    resetDbpath(dbpath);
+
+    let conn = MongoRunner.runMongod({dbpath: dbpath});
+    assert.neq(null, conn, "mongod was unable to start up");
+    let testDB = conn.getDB("test");
+
+    assert.commandWorked(testDB.createCollection(
+        "events",
+        {storageEngine: {wiredTiger: {configString: "block_compressor=dictionary"}}}));
+    assert.commandWorked(testDB.createCollection("plain"));
+
+    function makeEvent(i) {
+        return {
+            _id: i,
+            eventType: i % 2 ? "click" : "view",
+            userAgent: "Mozilla/5.0 (X11; Linux x86_64)",
+            payload: {page: "/home", visible: true}
+        };
+    }
+
+    let bulk = testDB.events.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; ++i) {
+        bulk.insert(makeEvent(i));
+    }
+    assert.commandWorked(bulk.execute());
+
+    let res = assert.commandWorked(
+        testDB.runCommand({collMod: "events", trainCompressionDictionary: true}));
+    assert.eq(1, res.compressionDictionary.version, tojson(res));
+    assert.gt(res.compressionDictionary.size, 0, tojson(res));
+
+    res = assert.commandWorked(
+        testDB.runCommand({collMod: "events", trainCompressionDictionary: 500}));
+    assert.eq(2, res.compressionDictionary.version, tojson(res));
+
+    bulk = testDB.events.initializeUnorderedBulkOp();
+    for (let i = 1000; i < 2000; ++i) {
+        bulk.insert(makeEvent(i));
+    }
+    assert.commandWorked(bulk.execute());
+
+    // Collections which do not use the dictionary compressor cannot train a dictionary.
+    assert.commandFailedWithCode(
+        testDB.runCommand({collMod: "plain", trainCompressionDictionary: true}),
+        ErrorCodes.InvalidOptions);
+
+    // The dictionaries are needed to read back pages written before the restart.
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({dbpath: dbpath, noCleanData: true});
+    assert.neq(null, conn, "mongod was unable to restart");
+    testDB = conn.getDB("test");
+
+    assert.eq(2000, testDB.events.find().itcount());
+    assert.eq(1000, testDB.events.find({eventType: "click"}).itcount());
+    const validateRes = assert.commandWorked(testDB.events.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,48 @@
+/**
+ * Tests that the WiredTiger serverStatus section reports how long committed oplog writes wait to
+ * become visible, and that a tailing oplog reader sees new writes.
+ */
+(function() {
+    "use strict";
+
+    // Skip this test if not running with the "wiredTiger" storage engine.
+    const storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        print('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    const rst = new ReplSetTest({nodes: 1});
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const testDB = primary.getDB("test");
+    const oplog = primary.getDB("local").oplog.rs;
+
+    const lastTs = oplog.find().sort({$natural: -1}).limit(1).next().ts;
+    const cursor = new DBCommandCursor(testDB, assert.commandWorked(oplog.runCommand("find", {
+        filter: {ts: {$gt: lastTs}},
+        tailable: true,
+        awaitData: true,
+    })));
+
+    for (let i = 0; i < 10; i++) {
+        assert.commandWorked(testDB.coll.insert({_id: i}));
+    }
+
+    assert.soon(() => cursor.hasNext());
+    assert.eq({_id: 0}, cursor.next().o);
+
+    const stats = assert.commandWorked(primary.adminCommand({serverStatus: 1}))
+                      .wiredTiger.oplog["commit to visible latency"];
+    assert(stats, "missing commit to visible latency statistics");
+    assert.gte(stats.commits, 10, tojson(stats));
+    assert.gte(stats.commits, stats.batches, tojson(stats));
+    assert.gt(stats.histogram.length, 0, tojson(stats));
+    assert.eq(stats.batches,
+              stats.histogram.reduce((total, bucket) => total + bucket.count, 0),
+              tojson(stats));
+
+    rst.stopSet();
+}());
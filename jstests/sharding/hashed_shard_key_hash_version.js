@@ -0,0 +1,88 @@
+// Tests sharding a collection on a hashed shard key which uses the MurmurHash3 hash version.
+(function() {
+    "use strict";
+
+    const st = new ShardingTest({shards: 2});
+    const dbName = "test";
+    const ns = dbName + ".coll";
+    const mongos = st.s0;
+    const configDB = mongos.getDB("config");
+    const testDB = mongos.getDB(dbName);
+
+    assert.commandWorked(mongos.adminCommand({enableSharding: dbName}));
+    st.ensurePrimaryShard(dbName, st.shard0.shardName);
+
+    // A hash version can only be given for a hashed shard key, and must be known.
+    assert.commandFailedWithCode(
+        mongos.adminCommand({shardCollection: ns, key: {a: 1}, hashVersion: 1}),
+        ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        mongos.adminCommand({shardCollection: ns, key: {a: "hashed"}, hashVersion: 2}),
+        ErrorCodes.BadValue);
+
+    // An existing hashed index with a different hash version cannot back the shard key.
+    assert.commandWorked(testDB.coll.createIndex({a: "hashed"}));
+    assert.commandFailedWithCode(
+        mongos.adminCommand({shardCollection: ns, key: {a: "hashed"}, hashVersion: 1}),
+        ErrorCodes.InvalidOptions);
+    assert(testDB.coll.drop());
+
+    assert.commandWorked(mongos.adminCommand(
+        {shardCollection: ns, key: {a: "hashed"}, hashVersion: 1, numInitialChunks: 4}));
+
+    const collDoc = configDB.collections.findOne({_id: ns});
+    assert.eq(1, collDoc.hashVersion, tojson(collDoc));
+    assert.eq(4, configDB.chunks.count({ns: ns}));
+
+    const indexSpec = st.shard0.getCollection(ns).getIndexes().filter(
+        (idx) => idx.name === "a_hashed")[0];
+    assert.eq(1, indexSpec.hashVersion, tojson(indexSpec));
+
+    // Resharding with the same options is a no-op, but a different hash version is an error.
+    assert.commandWorked(
+        mongos.adminCommand({shardCollection: ns, key: {a: "hashed"}, hashVersion: 1}));
+    assert.commandFailedWithCode(mongos.adminCommand({shardCollection: ns, key: {a: "hashed"}}),
+                                 ErrorCodes.AlreadyInitialized);
+
+    const numDocs = 200;
+    const bulk = testDB.coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; ++i) {
+        bulk.insert({_id: i, a: i});
+    }
+    assert.writeOK(bulk.execute());
+
+    // Every document lives on the shard which owns the chunk containing the MurmurHash3 hash of
+    // its shard key, and equality queries target exactly that shard.
+    const chunks = configDB.chunks.find({ns: ns}).toArray();
+    for (let i = 0; i < numDocs; i += 17) {
+        const hash = assert
+                         .commandWorked(testDB.runCommand(
+                             {_hashBSONElement: NumberInt(i), seed: 0, hashVersion: 1}))
+                         .out;
+        const owner = chunks.filter((chunk) => bsonWoCompare({a: hash}, chunk.min) >= 0 &&
+                                        bsonWoCompare({a: hash}, chunk.max) < 0)[0];
+        const shardConn = owner.shard === st.shard0.shardName ? st.shard0 : st.shard1;
+        assert.eq(1, shardConn.getCollection(ns).find({_id: i}).itcount(), tojson(owner));
+
+        const explain = testDB.coll.find({a: i}).explain();
+        assert.eq(1, explain.queryPlanner.winningPlan.shards.length, tojson(explain));
+        assert.eq(owner.shard, explain.queryPlanner.winningPlan.shards[0].shardName);
+        assert.eq(1, testDB.coll.find({a: i}).itcount());
+    }
+    assert.eq(numDocs, testDB.coll.find().itcount());
+
+    // Migrations preserve the hash version of the shard key index on the recipient.
+    const chunkToMove = configDB.chunks.findOne({ns: ns, shard: st.shard0.shardName});
+    assert.commandWorked(mongos.adminCommand({
+        moveChunk: ns,
+        bounds: [chunkToMove.min, chunkToMove.max],
+        to: st.shard1.shardName,
+        _waitForDelete: true
+    }));
+    const recipientSpec = st.shard1.getCollection(ns).getIndexes().filter(
+        (idx) => idx.name === "a_hashed")[0];
+    assert.eq(1, recipientSpec.hashVersion, tojson(recipientSpec));
+    assert.eq(numDocs, testDB.coll.find().itcount());
+
+    st.stop();
+}());
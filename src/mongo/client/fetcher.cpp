@@ -245,6 +245,12 @@ bool Fetcher::_isActive_inlock() const {
     return State::kRunning == _state || State::kShuttingDown == _state;
 }
 
+void Fetcher::setReadAheadFn(const ReadAheadFn& readAheadFn) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(State::kPreStart == _state);
+    _readAheadFn = readAheadFn;
+}
+
 Status Fetcher::schedule() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     switch (_state) {
@@ -310,19 +316,23 @@ bool Fetcher::_isShuttingDown_inlock() const {
     return State::kShuttingDown == _state;
 }
 
-Status Fetcher::_scheduleGetMore(const BSONObj& cmdObj) {
+Status Fetcher::_scheduleGetMore(const BSONObj& cmdObj, bool readAhead) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     if (_isShuttingDown_inlock()) {
         return Status(ErrorCodes::CallbackCanceled,
                       "fetcher was shut down after previous batch was processed");
     }
+
+    // Set before scheduling because the response may arrive before this function returns.
+    _processingBatch = readAhead;
     StatusWith<executor::TaskExecutor::CallbackHandle> scheduleResult =
         _executor->scheduleRemoteCommand(
             RemoteCommandRequest(
                 _source, _dbname, cmdObj, _metadata, nullptr, _getMoreNetworkTimeout),
-            [this](const auto& x) { return this->_callback(x, kNextBatchFieldName); });
+            [this](const auto& x) { return this->_getMoreCallback(x); });
 
     if (!scheduleResult.isOK()) {
+        _processingBatch = false;
         return scheduleResult.getStatus();
     }
 
@@ -331,6 +341,34 @@ Status Fetcher::_scheduleGetMore(const BSONObj& cmdObj) {
     return Status::OK();
 }
 
+void Fetcher::_getMoreCallback(const RemoteCommandCallbackArgs& rcbd) {
+    CursorId cursorIdToKill = 0;
+    NamespaceString nssToKill;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_processingBatch) {
+            // '_work' is still processing the batch this getMore was sent ahead of.
+            invariant(!_pendingResponse);
+            _pendingResponse = rcbd;
+            return;
+        }
+        if (_discardReadAhead) {
+            _discardReadAhead = false;
+            std::swap(cursorIdToKill, _readAheadCursorId);
+            std::swap(nssToKill, _readAheadNss);
+        }
+    }
+
+    if (!cursorIdToKill) {
+        _callback(rcbd, kNextBatchFieldName);
+        return;
+    }
+
+    // '_work' stopped the fetcher while this getMore was outstanding.
+    _sendKillCursors(cursorIdToKill, nssToKill);
+    _finishCallback();
+}
+
 void Fetcher::_callback(const RemoteCommandCallbackArgs& rcbd, const char* batchFieldName) {
     QueryResponse batchData;
     auto finishCallbackGuard = MakeGuard([this, &batchData] {
@@ -380,9 +418,65 @@ void Fetcher::_callback(const RemoteCommandCallbackArgs& rcbd, const char* batch
 
     nextAction = NextAction::kGetMore;
 
+    // Send the getMore for the next batch before processing this one, if asked to. Should that
+    // fail, the getMore filled in by '_work' is sent after processing this batch instead.
+    bool readingAhead = false;
+    if (_readAheadFn) {
+        auto readAheadCmdObj = _readAheadFn(batchData);
+        readingAhead = !readAheadCmdObj.isEmpty() && _scheduleGetMore(readAheadCmdObj, true).isOK();
+    }
+
     BSONObjBuilder bob;
     _work(StatusWith<QueryResponse>(batchData), &nextAction, &bob);
 
+    if (readingAhead) {
+        const bool keepFetching = nextAction == NextAction::kGetMore && !bob.asTempObj().isEmpty();
+        boost::optional<RemoteCommandCallbackArgs> pendingResponse;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _processingBatch = false;
+            std::swap(pendingResponse, _pendingResponse);
+            if (!keepFetching && !pendingResponse) {
+                // The getMore sent ahead is still outstanding. Its callback kills the cursor and
+                // completes the fetcher.
+                _discardReadAhead = true;
+                _readAheadCursorId = batchData.cursorId;
+                _readAheadNss = batchData.nss;
+                _executor->cancel(_getMoreCallbackHandle);
+                finishCallbackGuard.Dismiss();
+                return;
+            }
+        }
+
+        if (!keepFetching) {
+            return;
+        }
+
+        // Hand the batch read ahead to '_work' on a fresh executor task rather than recursing, so
+        // that the stack does not grow with every batch that arrived while its predecessor was
+        // being processed.
+        if (pendingResponse) {
+            auto scheduleResult = _executor->scheduleWork(
+                [ this, response = std::move(*pendingResponse) ](
+                    const executor::TaskExecutor::CallbackArgs& cbData) {
+                    auto args = response;
+                    if (!cbData.status.isOK()) {
+                        args.response = RemoteCommandResponse(cbData.status);
+                    }
+                    _callback(args, kNextBatchFieldName);
+                });
+            if (!scheduleResult.isOK()) {
+                _work(StatusWith<Fetcher::QueryResponse>(scheduleResult.getStatus()),
+                      nullptr,
+                      nullptr);
+                return;
+            }
+        }
+
+        finishCallbackGuard.Dismiss();
+        return;
+    }
+
     // Callback function _work may modify nextAction to request the fetcher
     // not to schedule a getMore command.
     if (nextAction != NextAction::kGetMore) {
@@ -35,6 +35,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
@@ -88,6 +90,12 @@ public:
     typedef stdx::function<void(const StatusWith<QueryResponse>&, NextAction*, BSONObjBuilder*)>
         CallbackFn;
 
+    /**
+     * Type of a function returning the getMore command to send ahead for the batch after
+     * 'queryResponse', or an empty object to not read ahead of it.
+     */
+    using ReadAheadFn = stdx::function<BSONObj(const QueryResponse& queryResponse)>;
+
     /**
      * Creates Fetcher task but does not schedule it to be run by the executor.
      *
@@ -167,6 +175,18 @@ public:
      */
     bool isActive() const;
 
+    /**
+     * Has the fetcher send the getMore command for the next batch, as returned by 'readAheadFn',
+     * before handing the current batch to the callback function, so that the next batch is
+     * fetched while the current one is processed. The getMore command the callback function
+     * fills in is ignored for batches read ahead of, but the callback function still stops the
+     * fetcher by changing NextAction or leaving the BSONObjBuilder empty, in which case the
+     * batch read ahead is discarded. At most one batch is read ahead.
+     *
+     * Must be called before schedule().
+     */
+    void setReadAheadFn(const ReadAheadFn& readAheadFn);
+
     /**
      * Schedules 'cmdObj' to be run on the remote server.
      */
@@ -202,9 +222,15 @@ private:
     bool _isActive_inlock() const;
 
     /**
-     * Schedules getMore command to be run by the executor
+     * Schedules getMore command to be run by the executor. If 'readAhead' is true, the response
+     * is held back until the batch currently being processed has been handed to '_work'.
+     */
+    Status _scheduleGetMore(const BSONObj& cmdObj, bool readAhead = false);
+
+    /**
+     * Callback for getMore command.
      */
-    Status _scheduleGetMore(const BSONObj& cmdObj);
+    void _getMoreCallback(const executor::TaskExecutor::RemoteCommandCallbackArgs& rcbd);
 
     /**
      * Callback for remote command.
@@ -254,6 +280,20 @@ private:
     // Callback handle to the scheduled getMore command.
     executor::TaskExecutor::CallbackHandle _getMoreCallbackHandle;
 
+    // Returns the getMore command to send before a batch is processed. See setReadAheadFn().
+    ReadAheadFn _readAheadFn;
+
+    // Set while '_work' processes a batch with a getMore sent ahead of it. The response to that
+    // getMore is kept in '_pendingResponse' if it arrives in the meantime.
+    bool _processingBatch = false;
+    boost::optional<executor::TaskExecutor::RemoteCommandCallbackArgs> _pendingResponse;
+
+    // Set when '_work' stopped the fetcher while a getMore sent ahead was outstanding. The cursor
+    // is killed once that getMore completes.
+    bool _discardReadAhead = false;
+    CursorId _readAheadCursorId = 0;
+    NamespaceString _readAheadNss;
+
     // Socket timeout
     Milliseconds _findNetworkTimeout;
     Milliseconds _getMoreNetworkTimeout;
@@ -956,6 +956,108 @@ TEST_F(FetcherTest, UpdateNextActionAfterSecondBatch) {
     ASSERT_EQUALS(1, countLogLinesContaining("killCursors command failed: UnknownError"));
 }
 
+BSONObj makeReadAheadGetMoreRequest(const Fetcher::QueryResponse& queryResponse) {
+    return BSON("getMore" << queryResponse.cursorId << "collection" << queryResponse.nss.coll()
+                          << "readAhead"
+                          << true);
+}
+
+TEST_F(FetcherTest, ReadAheadSendsGetMoreForNextBatchInsteadOfTheOneFilledInByCallback) {
+    fetcher->setReadAheadFn(makeReadAheadGetMoreRequest);
+    callbackHook = appendGetMoreRequest;
+
+    ASSERT_OK(fetcher->schedule());
+
+    const BSONObj doc = BSON("_id" << 1);
+
+    processNetworkResponse(BSON("cursor" << BSON("id" << 1LL << "ns"
+                                                      << "db.coll"
+                                                      << "firstBatch"
+                                                      << BSON_ARRAY(doc))
+                                         << "ok"
+                                         << 1),
+                           ReadyQueueState::kHasReadyRequests,
+                           FetcherState::kActive);
+
+    ASSERT_OK(status);
+    ASSERT_EQUALS(1LL, cursorId);
+    ASSERT_EQUALS(1U, documents.size());
+    ASSERT_BSONOBJ_EQ(doc, documents.front());
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(Fetcher::NextAction::kGetMore == nextAction);
+
+    const BSONObj doc2 = BSON("_id" << 2);
+
+    {
+        auto net = getNet();
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        ASSERT_TRUE(net->hasReadyRequests());
+        auto noi = net->getNextReadyRequest();
+        ASSERT_BSONOBJ_EQ(BSON("getMore" << 1LL << "collection"
+                                         << "coll"
+                                         << "readAhead"
+                                         << true),
+                          noi->getRequest().cmdObj);
+        net->scheduleSuccessfulResponse(noi,
+                                        {BSON("cursor" << BSON("id" << 0LL << "ns"
+                                                                    << "db.coll"
+                                                                    << "nextBatch"
+                                                                    << BSON_ARRAY(doc2))
+                                                       << "ok"
+                                                       << 1),
+                                         {},
+                                         Milliseconds(0)});
+        finishProcessingNetworkResponse(ReadyQueueState::kEmpty, FetcherState::kInactive);
+    }
+
+    ASSERT_OK(status);
+    ASSERT_EQUALS(0, cursorId);
+    ASSERT_EQUALS(1U, documents.size());
+    ASSERT_BSONOBJ_EQ(doc2, documents.front());
+    ASSERT_FALSE(first);
+    ASSERT_TRUE(Fetcher::NextAction::kNoAction == nextAction);
+}
+
+TEST_F(FetcherTest, ReadAheadGetMoreIsCanceledAndCursorKilledWhenCallbackStopsFetcher) {
+    fetcher->setReadAheadFn(makeReadAheadGetMoreRequest);
+    callbackHook = setNextActionToNoAction;
+
+    ASSERT_OK(fetcher->schedule());
+
+    const BSONObj doc = BSON("_id" << 1);
+
+    // The getMore sent ahead of the batch is canceled, and the fetcher stays active until the
+    // executor has delivered the cancellation.
+    processNetworkResponse(BSON("cursor" << BSON("id" << 1LL << "ns"
+                                                      << "db.coll"
+                                                      << "firstBatch"
+                                                      << BSON_ARRAY(doc))
+                                         << "ok"
+                                         << 1),
+                           ReadyQueueState::kEmpty,
+                           FetcherState::kActive);
+
+    ASSERT_OK(status);
+    ASSERT_EQUALS(1LL, cursorId);
+    ASSERT_TRUE(Fetcher::NextAction::kNoAction == nextAction);
+
+    {
+        auto net = getNet();
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        net->runReadyNetworkOperations();
+        ASSERT_FALSE(fetcher->isActive());
+
+        ASSERT_TRUE(net->hasReadyRequests());
+        auto noi = net->getNextReadyRequest();
+        auto&& cmdObj = noi->getRequest().cmdObj;
+        ASSERT_EQUALS("killCursors", cmdObj.firstElement().fieldNameStringData());
+        ASSERT_EQUALS(nss.coll(), cmdObj.firstElement().String());
+        auto cursors = cmdObj["cursors"].Array();
+        ASSERT_EQUALS(1U, cursors.size());
+        ASSERT_EQUALS(cursorId, cursors.front().numberLong());
+    }
+}
+
 /**
  * This will be invoked twice before the fetcher returns control to the task executor.
  */
@@ -66,6 +66,11 @@ namespace {
 // databases if none are provided).
 MONGO_FAIL_POINT_DEFINE(hangBeforeDatabaseUpgrade);
 
+// The number of documents sampled by 'trainCompressionDictionary: true', and the most which may be
+// requested explicitly.
+const long long kDefaultCompressionDictionarySampleSize = 1000;
+const long long kMaxCompressionDictionarySampleSize = 100000;
+
 struct CollModRequest {
     const IndexDescriptor* idx = nullptr;
     BSONElement indexExpireAfterSeconds = {};
@@ -76,6 +81,7 @@ struct CollModRequest {
     std::string collValidationLevel = {};
     BSONElement usePowerOf2Sizes = {};
     BSONElement noPadding = {};
+    long long compressionDictionarySampleSize = 0;
 };
 
 StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
@@ -240,7 +246,19 @@ StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
                 cmr.usePowerOf2Sizes = e;
             else if (fieldName == "noPadding")
                 cmr.noPadding = e;
-            else
+            else if (fieldName == "trainCompressionDictionary") {
+                if (e.type() == BSONType::Bool && e.boolean()) {
+                    cmr.compressionDictionarySampleSize = kDefaultCompressionDictionarySampleSize;
+                } else if (e.isNumber() && e.safeNumberLong() > 0 &&
+                           e.safeNumberLong() <= kMaxCompressionDictionarySampleSize) {
+                    cmr.compressionDictionarySampleSize = e.safeNumberLong();
+                } else {
+                    return Status(ErrorCodes::InvalidOptions,
+                                  str::stream() << "trainCompressionDictionary must be true or the "
+                                                   "number of documents to sample, at most "
+                                                << kMaxCompressionDictionarySampleSize);
+                }
+            } else
                 return Status(ErrorCodes::InvalidOptions,
                               str::stream() << "unknown option to collMod: " << fieldName);
         }
@@ -425,6 +443,17 @@ Status _collModInternal(OperationContext* opCtx,
     if (!cmr.noPadding.eoo())
         setCollectionOptionFlag(opCtx, coll, cmr.noPadding, result);
 
+    // Compression dictionary. The dictionary is a physical detail of each node, so secondaries
+    // train their own from their copy of the data when they apply the collMod.
+    if (cmr.compressionDictionarySampleSize > 0) {
+        BSONObjBuilder dictionaryBuilder(result->subobjStart("compressionDictionary"));
+        Status status = coll->getRecordStore()->trainCompressionDictionary(
+            opCtx, cmr.compressionDictionarySampleSize, &dictionaryBuilder);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     // Upgrade unique indexes
     if (upgradeUniqueIndexes) {
         // A cmdObj with an empty collMod, i.e. nFields = 1, implies that it is a Unique Index
@@ -316,6 +316,8 @@ public:
 
         virtual bool isCapped() const = 0;
 
+        virtual bool isClustered() const = 0;
+
         virtual std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier() const = 0;
 
         virtual uint64_t numRecords(OperationContext* opCtx) const = 0;
@@ -681,6 +683,14 @@ public:
         return this->_impl().isCapped();
     }
 
+    /**
+     * Returns true if the collection was created with the 'clustered' option, meaning that its
+     * documents are stored under RecordIds derived from their _id and it has no separate _id index.
+     */
+    inline bool isClustered() const {
+        return this->_impl().isClustered();
+    }
+
     /**
      * Get a pointer to a capped insert notifier object. The caller can wait on this object
      * until it is notified of a new insert into the capped collection.
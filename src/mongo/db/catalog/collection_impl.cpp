@@ -222,6 +222,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (isClustered()) {
+        // The record store of a clustered collection is keyed by _id.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -859,8 +864,15 @@ bool CollectionImpl::isCapped() const {
     return _cappedNotifier.get();
 }
 
+bool CollectionImpl::isClustered() const {
+    return _recordStore->isClustered();
+}
+
 std::shared_ptr<CappedInsertNotifier> CollectionImpl::getCappedInsertNotifier() const {
     invariant(isCapped());
+    // Callers are about to wait for inserts, so let the storage engine know that new data should
+    // be made visible without delay.
+    _recordStore->notifyCappedWaiterArrived();
     return _cappedNotifier;
 }
 
@@ -1352,6 +1364,7 @@ void _validateCatalogEntry(OperationContext* opCtx,
                           "collation",
                           results);
     addErrorIfUnequal(options.capped, coll->isCapped(), "is capped", results);
+    addErrorIfUnequal(options.clustered, coll->isClustered(), "is clustered", results);
 
     addErrorIfUnequal(options.validator.toString(), validatorDoc.toString(), "validator", results);
     if (!options.validator.isEmpty() && !validatorDoc.isEmpty()) {
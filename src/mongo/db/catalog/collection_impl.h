@@ -324,6 +324,8 @@ public:
 
     bool isCapped() const final;
 
+    bool isClustered() const final;
+
     /**
      * Get a pointer to a capped insert notifier object. The caller can wait on this object
      * until it is notified of a new insert into the capped collection.
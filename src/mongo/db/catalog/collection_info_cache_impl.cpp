@@ -40,6 +40,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_legacy.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
@@ -90,7 +91,16 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
     while (i.more()) {
         IndexDescriptor* descriptor = i.next();
 
-        if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
+        if (descriptor->getAccessMethodName() == IndexNames::WILDCARD) {
+            // A wildcard index holds keys for every path beneath its prefix.
+            StringData prefix = WildcardKeyGenerator::extractPrefix(
+                descriptor->keyPattern().firstElementFieldName());
+            if (prefix.empty()) {
+                _indexedPaths.allPathsIndexed();
+            } else {
+                _indexedPaths.addPath(prefix);
+            }
+        } else if (descriptor->getAccessMethodName() != IndexNames::TEXT) {
             BSONObj key = descriptor->keyPattern();
             const BSONObj& infoObj = descriptor->infoObj();
             if (infoObj.hasField("expireAfterSeconds")) {
@@ -260,6 +260,10 @@ public:
         std::abort();
     }
 
+    bool isClustered() const {
+        std::abort();
+    }
+
     std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier() const {
         std::abort();
     }
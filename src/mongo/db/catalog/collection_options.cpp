@@ -40,6 +40,7 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -185,6 +186,12 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             flagsSet = true;
         } else if (fieldName == "temp") {
             temp = e.trueValue();
+        } else if (fieldName == "clustered") {
+            if (e.type() != mongo::Bool) {
+                return Status(ErrorCodes::TypeMismatch, "'clustered' has to be a boolean.");
+            }
+
+            clustered = e.boolean();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -252,6 +259,16 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             }
 
             pipeline = e.Obj().getOwned();
+        } else if (fieldName == "timeseries") {
+            if (e.type() != mongo::Object) {
+                return {ErrorCodes::TypeMismatch, "'timeseries' has to be a document."};
+            }
+
+            auto swTimeseries = TimeseriesOptions::parse(e.Obj());
+            if (!swTimeseries.isOK()) {
+                return swTimeseries.getStatus();
+            }
+            timeseries = swTimeseries.getValue().toBSON();
         } else if (fieldName == "idIndex" && kind == parseForCommand) {
             if (e.type() != mongo::Object) {
                 return Status(ErrorCodes::TypeMismatch, "'idIndex' has to be an object.");
@@ -275,6 +292,27 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (clustered) {
+        if (capped) {
+            return {ErrorCodes::InvalidOptions, "A clustered collection cannot be capped"};
+        }
+        if (!viewOn.empty()) {
+            return {ErrorCodes::InvalidOptions, "A view cannot be clustered"};
+        }
+        if (autoIndexId != DEFAULT || !idIndex.isEmpty()) {
+            return {ErrorCodes::InvalidOptions,
+                    "A clustered collection does not have an _id index, so 'autoIndexId' and "
+                    "'idIndex' are not allowed"};
+        }
+    }
+
+    if (!timeseries.isEmpty()) {
+        if (capped || clustered || !viewOn.empty()) {
+            return {ErrorCodes::InvalidOptions,
+                    "A time-series collection cannot be capped, clustered or a view"};
+        }
+    }
+
     return Status::OK();
 }
 
@@ -311,6 +349,9 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (temp)
         builder->appendBool("temp", true);
 
+    if (clustered)
+        builder->appendBool("clustered", true);
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -346,6 +387,10 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (!idIndex.isEmpty()) {
         builder->append("idIndex", idIndex);
     }
+
+    if (!timeseries.isEmpty()) {
+        builder->append("timeseries", timeseries);
+    }
 }
 
 bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
@@ -392,6 +437,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (clustered != other.clustered) {
+        return false;
+    }
+
     if (storageEngine.woCompare(other.storageEngine) != 0) {
         return false;
     }
@@ -432,6 +481,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (timeseries.woCompare(other.timeseries) != 0) {
+        return false;
+    }
+
     return true;
 }
 }
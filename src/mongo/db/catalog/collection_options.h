@@ -133,6 +133,10 @@ struct CollectionOptions {
 
     bool temp = false;
 
+    // Store documents under RecordIds derived from their _id rather than generated ones. Clustered
+    // collections have no separate _id index. See clustered_record_id.h.
+    bool clustered = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
@@ -156,5 +160,9 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+
+    // The time-series options of a collection holding time-series buckets, or empty. Validated and
+    // normalized by TimeseriesOptions::parse(). See timeseries_options.h.
+    BSONObj timeseries;
 };
 }
@@ -335,4 +335,53 @@ TEST(CollectionOptions, ParseUUID) {
     // Check that a collection options containing a UUID passes validation.
     ASSERT_OK(options.validateForStorage());
 }
+
+TEST(CollectionOptions, Clustered) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(fromjson("{clustered: true}")));
+    ASSERT_TRUE(options.clustered);
+    checkRoundTrip(options);
+    ASSERT_OK(options.validateForStorage());
+
+    ASSERT_OK(options.parse(fromjson("{clustered: false}")));
+    ASSERT_FALSE(options.clustered);
+    ASSERT_BSONOBJ_EQ(BSONObj(), options.toBSON());
+
+    ASSERT_EQ(ErrorCodes::TypeMismatch, options.parse(fromjson("{clustered: 1}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{clustered: true, capped: true, size: 1024}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{clustered: true, autoIndexId: true}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{clustered: true, idIndex: {key: {_id: 1}, name: '_id_'}}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{clustered: true, viewOn: 'c', pipeline: []}")));
+}
+
+TEST(CollectionOptions, Timeseries) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(fromjson("{timeseries: {metaField: 'm', timeField: 't'}}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{timeField: 't', metaField: 'm', bucketMaxSpanSeconds: 3600}"),
+                      options.timeseries);
+    checkRoundTrip(options);
+    ASSERT_OK(options.validateForStorage());
+
+    ASSERT_OK(options.parse(fromjson("{timeseries: {timeField: 't', bucketMaxSpanSeconds: 60}}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{timeField: 't', bucketMaxSpanSeconds: 60}"), options.timeseries);
+
+    ASSERT_EQ(ErrorCodes::TypeMismatch, options.parse(fromjson("{timeseries: 't'}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions, options.parse(fromjson("{timeseries: {}}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{timeseries: {timeField: 't', metaField: 't'}}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{timeseries: {timeField: 't', granularity: 'hours'}}")));
+    ASSERT_EQ(ErrorCodes::BadValue, options.parse(fromjson("{timeseries: {timeField: 'a.b'}}")));
+    ASSERT_EQ(ErrorCodes::BadValue, options.parse(fromjson("{timeseries: {timeField: '_id'}}")));
+    ASSERT_EQ(ErrorCodes::BadValue,
+              options.parse(fromjson("{timeseries: {timeField: 't', bucketMaxSpanSeconds: 0}}")));
+    ASSERT_EQ(ErrorCodes::BadValue,
+              options.parse(fromjson("{timeseries: {timeField: 't', bucketMaxSpanSeconds: 1.5}}")));
+    ASSERT_EQ(ErrorCodes::InvalidOptions,
+              options.parse(fromjson("{timeseries: {timeField: 't'}, capped: true, size: 1024}")));
+}
 }  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/logger/redaction.h"
 #include "mongo/util/log.h"
@@ -52,6 +53,47 @@
 namespace mongo {
 namespace {
 
+/**
+ * Creates the time-series collection 'nss', which consists of the collection
+ * 'system.buckets.<coll>' holding the bucketed measurements and the view 'nss' which unpacks them.
+ * Must be called in a WriteUnitOfWork with the database locked exclusively.
+ */
+Status createTimeseries(OperationContext* opCtx,
+                        Database* db,
+                        const NamespaceString& nss,
+                        const CollectionOptions& options) {
+    if (!options.validator.isEmpty() || !options.validationLevel.empty() ||
+        !options.validationAction.empty()) {
+        return {ErrorCodes::InvalidOptions,
+                "Document validation is not supported on time-series collections"};
+    }
+
+    const auto bucketsNs = nss.makeTimeseriesBucketsNamespace();
+    Status status = userAllowedCreateNS(bucketsNs.db(), bucketsNs.coll());
+    if (!status.isOK()) {
+        return status;
+    }
+
+    CollectionOptions bucketsOptions;
+    bucketsOptions.storageEngine = options.storageEngine;
+    bucketsOptions.indexOptionDefaults = options.indexOptionDefaults;
+    bucketsOptions.collation = options.collation;
+    bucketsOptions.timeseries = options.timeseries;
+    const bool createDefaultIndexes = true;
+    status =
+        Database::userCreateNS(opCtx, db, bucketsNs.ns(), bucketsOptions, createDefaultIndexes);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    CollectionOptions viewOptions;
+    viewOptions.viewOn = bucketsNs.coll().toString();
+    viewOptions.collation = options.collation;
+    viewOptions.pipeline = BSON_ARRAY(
+        BSON(DocumentSourceInternalUnpackBucket::kStageName << options.timeseries));
+    return Database::userCreateNS(opCtx, db, nss.ns(), viewOptions, createDefaultIndexes);
+}
+
 /**
  * Shared part of the implementation of the createCollection versions for replicated and regular
  * collection creation.
@@ -110,7 +152,11 @@ Status createCollection(OperationContext* opCtx,
                           str::stream() << "Not primary while creating collection " << nss.ns());
         }
 
-        if (collectionOptions.isView()) {
+        // A time-series collection is exposed as a view on the collection holding its buckets.
+        const bool isTimeseries =
+            !collectionOptions.timeseries.isEmpty() && !nss.isTimeseriesBucketsCollection();
+
+        if (collectionOptions.isView() || isTimeseries) {
             // If the `system.views` collection does not exist, create it in a separate
             // WriteUnitOfWork.
             WriteUnitOfWork wuow(opCtx);
@@ -120,6 +166,16 @@ Status createCollection(OperationContext* opCtx,
 
         WriteUnitOfWork wunit(opCtx);
 
+        if (isTimeseries) {
+            Status status = createTimeseries(opCtx, ctx.db(), nss, collectionOptions);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            wunit.commit();
+            return Status::OK();
+        }
+
         // Create collection.
         const bool createDefaultIndexes = true;
         Status status = Database::userCreateNS(
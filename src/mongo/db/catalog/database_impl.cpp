@@ -72,6 +72,7 @@
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/system_index.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/cannot_implicitly_create_collection_info.h"
@@ -230,6 +231,9 @@ Collection* DatabaseImpl::_getOrCreateCollectionInstance(OperationContext* opCtx
 
     // Not registering AddCollectionChange since this is for collections that already exist.
     Collection* coll = new Collection(opCtx, nss.ns(), uuid, cce.release(), rs.release(), _dbEntry);
+    if (nss.isTimeseriesBucketsCollection()) {
+        BucketCatalog::get(opCtx).registerBucketsCollection(nss);
+    }
     if (uuid) {
         // We are not in a WUOW only when we are called from Database::init(). There is no need
         // to rollback UUIDCatalog changes because we are initializing existing collections.
@@ -744,6 +748,21 @@ void DatabaseImpl::_checkCanCreateCollection(OperationContext* opCtx,
 
     uassert(17316, "cannot create a blank collection", nss.coll() > 0);
     uassert(28838, "cannot create a non-capped oplog collection", options.capped || !nss.isOplog());
+    if (options.clustered) {
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Cannot create clustered collection " << nss.ns()
+                              << " - the storage engine does not support clustered collections",
+                opCtx->getServiceContext()->getStorageEngine()->supportsClusteredCollections());
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Cannot create clustered collection " << nss.ns()
+                              << " - system collections cannot be clustered",
+                !nss.isSystem());
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Cannot create clustered collection " << nss.ns()
+                              << " - clustered collections are ordered by _id under the simple "
+                                 "collation and cannot have a default collation",
+                options.collation.isEmpty());
+    }
     uassert(ErrorCodes::DatabaseDropPending,
             str::stream() << "Cannot create collection " << nss.ns()
                           << " - database is in the process of being dropped.",
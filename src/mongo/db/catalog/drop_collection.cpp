@@ -44,6 +44,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/util/log.h"
 
@@ -110,9 +111,25 @@ Status dropCollection(OperationContext* opCtx,
             if (!status.isOK()) {
                 return status;
             }
+
+            // Dropping a time-series collection drops the collection holding its buckets along
+            // with the view through which they are read.
+            const auto bucketsNs = collectionName.makeTimeseriesBucketsNamespace();
+            if (view->viewOn() == bucketsNs && db->getCollection(opCtx, bucketsNs)) {
+                BackgroundOperation::assertNoBgOpInProgForNs(bucketsNs.ns());
+                status = db->dropCollectionEvenIfSystem(opCtx, bucketsNs, dropOpTime);
+                if (!status.isOK()) {
+                    return status;
+                }
+            }
         }
         wunit.commit();
 
+        const auto bucketsNs = collectionName.isTimeseriesBucketsCollection()
+            ? collectionName
+            : collectionName.makeTimeseriesBucketsNamespace();
+        BucketCatalog::get(opCtx).clear(bucketsNs);
+
         return Status::OK();
     });
 }
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog/index_catalog_entry.h"
 
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 
 namespace mongo {
@@ -61,6 +62,11 @@ void IndexCatalogEntry::init(std::unique_ptr<IndexAccessMethod> accessMethod) {
     return this->_impl().init(std::move(accessMethod));
 }
 
+void IndexCatalogEntry::setIndexBuildInterceptor(
+    std::unique_ptr<IndexBuildInterceptor> interceptor) {
+    return this->_impl().setIndexBuildInterceptor(std::move(interceptor));
+}
+
 // ------------------
 
 const IndexCatalogEntry* IndexCatalogEntryContainer::find(const IndexDescriptor* desc) const {
@@ -31,6 +31,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -51,6 +52,7 @@ class CollectionCatalogEntry;
 class CollectionInfoCache;
 class HeadManager;
 class IndexAccessMethod;
+class IndexBuildInterceptor;
 class IndexDescriptor;
 class MatchExpression;
 class OperationContext;
@@ -103,6 +105,11 @@ public:
         virtual boost::optional<Timestamp> getMinimumVisibleSnapshot() = 0;
 
         virtual void setMinimumVisibleSnapshot(Timestamp name) = 0;
+
+        virtual IndexBuildInterceptor* indexBuildInterceptor() = 0;
+
+        virtual void setIndexBuildInterceptor(
+            std::unique_ptr<IndexBuildInterceptor> interceptor) = 0;
     };
 
 public:
@@ -245,6 +252,20 @@ public:
         return this->_impl().setMinimumVisibleSnapshot(name);
     }
 
+    /**
+     * Returns the interceptor which records the writes to this index while a hybrid index build is
+     * bulk loading it, or nullptr if writes go straight to the index.
+     */
+    IndexBuildInterceptor* indexBuildInterceptor() {
+        return this->_impl().indexBuildInterceptor();
+    }
+
+    /**
+     * Makes this entry the owner of 'interceptor', replacing any interceptor it already has. The
+     * caller must hold the collection lock in exclusive mode.
+     */
+    void setIndexBuildInterceptor(std::unique_ptr<IndexBuildInterceptor> interceptor);
+
 private:
     // This structure exists to give us a customization point to decide how to force users of this
     // class to depend upon the corresponding `index_catalog_entry.cpp` Translation Unit (TU).  All
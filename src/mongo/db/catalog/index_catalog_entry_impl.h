@@ -31,6 +31,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -51,6 +52,7 @@ class CollectionCatalogEntry;
 class CollectionInfoCache;
 class HeadManager;
 class IndexAccessMethod;
+class IndexBuildInterceptor;
 class IndexDescriptor;
 class MatchExpression;
 class OperationContext;
@@ -169,6 +171,12 @@ public:
      */
     void setMinimumVisibleSnapshot(Timestamp newMinimumVisibleSnapshot) final;
 
+    IndexBuildInterceptor* indexBuildInterceptor() final {
+        return _indexBuildInterceptor.get();
+    }
+
+    void setIndexBuildInterceptor(std::unique_ptr<IndexBuildInterceptor> interceptor) final;
+
 private:
     class SetMultikeyChange;
     class SetHeadChange;
@@ -240,5 +248,8 @@ private:
 
     // The earliest snapshot that is allowed to read this index.
     boost::optional<Timestamp> _minVisibleSnapshot;
+
+    // Set while a hybrid index build is bulk loading this index.
+    std::unique_ptr<IndexBuildInterceptor> _indexBuildInterceptor;
 };
 }  // namespace mongo
@@ -65,9 +65,13 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/represent_as.h"
@@ -107,6 +111,60 @@ using std::vector;
 
 using IndexVersion = IndexDescriptor::IndexVersion;
 
+// Number of threads used to generate index keys for large insert batches. Zero disables parallel
+// key generation.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(indexKeyGenerationThreads, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "indexKeyGenerationThreads must be non-negative");
+        }
+        return Status::OK();
+    });
+
+// Insert batches are only handed to the key generation threads when the number of documents times
+// the number of indexes is at least this large, since smaller batches don't amortize the handoff.
+MONGO_EXPORT_SERVER_PARAMETER(internalInsertParallelKeyGenerationMinWork, int, 64);
+
+namespace {
+
+// The pool is created on first use and is never destroyed, so that the threads which use it don't
+// need to hold the mutex for longer than it takes to look it up.
+stdx::mutex indexKeyGenerationPoolMutex;
+ThreadPool* indexKeyGenerationPool = nullptr;
+bool indexKeyGenerationPoolShutDown = false;
+
+/**
+ * Returns nullptr if the pool was shut down before it was ever used.
+ */
+ThreadPool* getIndexKeyGenerationPool() {
+    stdx::lock_guard<stdx::mutex> lk(indexKeyGenerationPoolMutex);
+    if (!indexKeyGenerationPool && !indexKeyGenerationPoolShutDown) {
+        ThreadPool::Options options;
+        options.poolName = "IndexKeyGeneration";
+        options.threadNamePrefix = "IndexKeyGen-";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(indexKeyGenerationThreads);
+        indexKeyGenerationPool = new ThreadPool(options);
+        indexKeyGenerationPool->startup();
+    }
+    return indexKeyGenerationPool;
+}
+
+}  // namespace
+
+void shutdownIndexKeyGenerationPool() {
+    ThreadPool* pool;
+    {
+        stdx::lock_guard<stdx::mutex> lk(indexKeyGenerationPoolMutex);
+        indexKeyGenerationPoolShutDown = true;
+        pool = indexKeyGenerationPool;
+    }
+    if (pool) {
+        pool->shutdown();
+        pool->join();
+    }
+}
+
 static const int INDEX_CATALOG_INIT = 283711;
 static const int INDEX_CATALOG_UNINIT = 654321;
 
@@ -741,7 +799,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
         string pluginName = IndexNames::findPluginName(key);
         if ((pluginName != IndexNames::BTREE) && (pluginName != IndexNames::GEO_2DSPHERE) &&
-            (pluginName != IndexNames::HASHED)) {
+            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD)) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
                                         << "' does not support collation: "
@@ -751,6 +809,20 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
+    // Wildcard indexes only hold keys for the paths which exist in a document, so they are
+    // implicitly sparse, and a single document may generate many keys under the same path.
+    if (IndexNames::findPluginName(key) == IndexNames::WILDCARD) {
+        if (isSparse) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          "Index type 'wildcard' does not support the sparse option");
+        }
+
+        if (spec["unique"].trueValue()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          "Index type 'wildcard' does not support the unique option");
+        }
+    }
+
     // Ensure if there is a filter, its valid.
     BSONElement filterElement = spec.getField("partialFilterExpression");
     if (filterElement) {
@@ -1513,6 +1585,136 @@ Status IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
 }
 
 
+Status IndexCatalogImpl::_indexRecordsWithParallelKeyGeneration(
+    OperationContext* opCtx, const std::vector<BsonRecord>& bsonRecords, int64_t* keysInsertedOut) {
+    // The keys generated for each index. Partial indexes only get keys for the matching records.
+    struct IndexKeys {
+        IndexCatalogEntry* index;
+        InsertDeleteOptions options;
+        std::vector<BsonRecord> records;
+        // The position in 'bsonRecords' of each of 'records'.
+        std::vector<size_t> recordPositions;
+        std::vector<BSONObjSet> keys;
+        std::vector<MultikeyPaths> multikeyPaths;
+    };
+    std::vector<IndexKeys> indexKeys;
+    indexKeys.reserve(_entries.size());
+    for (auto&& entry : _entries) {
+        IndexKeys ik;
+        ik.index = entry.get();
+        prepareInsertDeleteOptions(opCtx, ik.index->descriptor(), &ik.options);
+        const MatchExpression* filter = ik.index->getFilterExpression();
+        for (size_t pos = 0; pos < bsonRecords.size(); ++pos) {
+            if (!filter || filter->matchesBSON(*bsonRecords[pos].docPtr)) {
+                ik.records.push_back(bsonRecords[pos]);
+                ik.recordPositions.push_back(pos);
+            }
+        }
+        ik.keys.resize(ik.records.size(), SimpleBSONObjComparator::kInstance.makeBSONObjSet());
+        ik.multikeyPaths.resize(ik.records.size());
+        indexKeys.push_back(std::move(ik));
+    }
+
+    // Split each index's records into one chunk per thread. Key generation only reads the
+    // document and the index descriptor, so the chunks are independent of each other.
+    const size_t numThreads = static_cast<size_t>(indexKeyGenerationThreads);
+    const size_t chunkSize = (bsonRecords.size() + numThreads - 1) / numThreads;
+
+    stdx::mutex mutex;
+    stdx::condition_variable allDone;
+    size_t numPending = 0;
+
+    // The error for the earliest record, and among those for the earliest index, so that which
+    // error is reported does not depend on how the chunks were scheduled.
+    Status firstError = Status::OK();
+    std::pair<size_t, size_t> firstErrorPosition;
+
+    auto generateKeys = [&](IndexKeys* ik, size_t begin, size_t end) {
+        Status status = Status::OK();
+        size_t i = begin;
+        try {
+            for (; i < end; ++i) {
+                auto accessMethod = ik->index->accessMethod();
+                accessMethod->getKeys(*ik->records[i].docPtr,
+                                      ik->options.getKeysMode,
+                                      IndexAccessMethod::GetKeysContext::kReadOrAddKeys,
+                                      &ik->keys[i],
+                                      &ik->multikeyPaths[i]);
+            }
+        } catch (...) {
+            // This may be running on a pool thread, where an escaping exception would terminate
+            // the process.
+            status = exceptionToStatus();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        if (!status.isOK()) {
+            const std::pair<size_t, size_t> position(ik->recordPositions[i],
+                                                     static_cast<size_t>(ik - indexKeys.data()));
+            if (firstError.isOK() || position < firstErrorPosition) {
+                firstError = status;
+                firstErrorPosition = position;
+            }
+        }
+        if (--numPending == 0) {
+            allDone.notify_one();
+        }
+    };
+
+    ThreadPool* const pool = getIndexKeyGenerationPool();
+    for (auto&& ik : indexKeys) {
+        for (size_t begin = 0; begin < ik.records.size(); begin += chunkSize) {
+            const size_t end = std::min(begin + chunkSize, ik.records.size());
+            {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                ++numPending;
+            }
+            IndexKeys* ikPtr = &ik;
+            if (!pool ||
+                !pool->schedule([&generateKeys, ikPtr, begin, end] {
+                         generateKeys(ikPtr, begin, end);
+                     }).isOK()) {
+                // The pool is shut down, so generate the keys on this thread instead.
+                generateKeys(ikPtr, begin, end);
+            }
+        }
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        allDone.wait(lk, [&] { return numPending == 0; });
+    }
+
+    // Errors from key generation are surfaced exactly as getKeys() would have thrown them.
+    uassertStatusOK(firstError);
+
+    // Apply the keys in the same index-major, record order as the serial path.
+    for (auto&& ik : indexKeys) {
+        for (size_t i = 0; i < ik.records.size(); ++i) {
+            const BsonRecord& bsonRecord = ik.records[i];
+            invariant(bsonRecord.id != RecordId());
+
+            if (!bsonRecord.ts.isNull()) {
+                Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecord.ts);
+                if (!status.isOK())
+                    return status;
+            }
+
+            int64_t inserted;
+            Status status = ik.index->accessMethod()->insertKeys(
+                opCtx, ik.keys[i], ik.multikeyPaths[i], bsonRecord.id, ik.options, &inserted);
+            if (!status.isOK())
+                return status;
+
+            if (keysInsertedOut) {
+                *keysInsertedOut += inserted;
+            }
+        }
+    }
+
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
                                       const std::vector<BsonRecord>& bsonRecords,
                                       int64_t* keysInsertedOut) {
@@ -1520,6 +1722,12 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    if (indexKeyGenerationThreads > 0 && bsonRecords.size() > 1 &&
+        bsonRecords.size() * _entries.size() >=
+            static_cast<size_t>(internalInsertParallelKeyGenerationMinWork.load())) {
+        return _indexRecordsWithParallelKeyGeneration(opCtx, bsonRecords, keysInsertedOut);
+    }
+
     for (IndexCatalogEntryContainer::const_iterator i = _entries.begin(); i != _entries.end();
          ++i) {
         Status s = _indexRecords(opCtx, i->get(), bsonRecords, keysInsertedOut);
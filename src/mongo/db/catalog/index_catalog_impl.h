@@ -399,6 +399,14 @@ private:
                          const std::vector<BsonRecord>& bsonRecords,
                          int64_t* keysInsertedOut);
 
+    /**
+     * Same as calling _indexRecords() for every index, except that the keys for all of the
+     * indexes and records are generated up front on the index key generation thread pool.
+     */
+    Status _indexRecordsWithParallelKeyGeneration(OperationContext* opCtx,
+                                                  const std::vector<BsonRecord>& bsonRecords,
+                                                  int64_t* keysInsertedOut);
+
     Status _unindexRecord(OperationContext* opCtx,
                           IndexCatalogEntry* index,
                           const BSONObj& obj,
@@ -487,4 +495,10 @@ private:
         return this_->_dropIndex(opCtx, desc);
     }
 };
+
+/**
+ * Stops the thread pool used to generate index keys for large insert batches and waits for its
+ * threads to exit. Keys for later batches are generated by the inserting thread.
+ */
+void shutdownIndexKeyGenerationPool();
 }  // namespace mongo
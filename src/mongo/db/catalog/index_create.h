@@ -84,6 +84,8 @@ public:
 
         virtual Status doneInserting(std::set<RecordId>* dupsOut = NULL) = 0;
 
+        virtual Status drainBackgroundWrites() = 0;
+
         virtual void commit(stdx::function<void(const BSONObj& spec)> onCreateFn) = 0;
 
         virtual void abortWithoutCleanup() = 0;
@@ -230,6 +232,19 @@ public:
         return this->_impl().doneInserting(dupsOut);
     }
 
+    /**
+     * Call this after insertAllDocumentsInCollection() returns success and before commit(). When
+     * the indexes were built by a hybrid background build, applies the writes which were made to
+     * the collection while the indexes were being loaded. Does nothing for other builds.
+     *
+     * Should not be called inside of a WriteUnitOfWork.
+     *
+     * Requires holding an exclusive collection lock.
+     */
+    inline Status drainBackgroundWrites() {
+        return this->_impl().drainBackgroundWrites();
+    }
+
     /**
      * Marks the index ready for use. Should only be called as the last method after
      * doneInserting() or insertAllDocumentsInCollection() return success.
@@ -34,6 +34,9 @@
 
 #include "mongo/db/catalog/index_create_impl.h"
 
+#include <algorithm>
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/init.h"
 #include "mongo/client/dbclientinterface.h"
@@ -45,6 +48,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
@@ -52,15 +56,21 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -77,6 +87,42 @@ MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildOf);
 
 AtomicInt32 maxIndexBuildMemoryUsageMegabytes(500);
 
+// Number of threads used to generate and sort keys and to bulk load indexes during foreground
+// index builds. A value of one builds the indexes on the thread running the build.
+MONGO_EXPORT_SERVER_PARAMETER(indexBuildThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue, "indexBuildThreads must be at least 1");
+        }
+        return Status::OK();
+    });
+
+// Background builds of indexes without uniqueness constraints sort and bulk load the keys of the
+// documents they scan, recording concurrent writes to the collection in temporary tables which are
+// applied to the indexes once they are loaded.
+MONGO_EXPORT_SERVER_PARAMETER(enableHybridIndexBuilds, bool, false);
+
+// The drain of recorded writes which a hybrid build makes under intent locks, while writes to the
+// collection continue, stops after applying this many writes to each index. Whatever is left is
+// drained under the exclusive lock taken to commit the build.
+MONGO_EXPORT_SERVER_PARAMETER(maxIndexBuildDrainWritesUnderIntentLocks, long long, 100 * 1000)
+    ->withValidator([](const long long& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "maxIndexBuildDrainWritesUnderIntentLocks must be at least 1");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+// Parallel foreground builds hand scanned documents to the workers in batches of at most this many
+// documents or bytes.
+const size_t kMaxParallelBuildBatchDocuments = 1000;
+const size_t kMaxParallelBuildBatchBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
 MONGO_REGISTER_SHIM(MultiIndexBlock::makeImpl)
 (OperationContext* const opCtx, Collection* const collection, PrivateTo<MultiIndexBlock>)
     ->std::unique_ptr<MultiIndexBlock::Impl> {
@@ -158,6 +204,10 @@ MultiIndexBlockImpl::~MultiIndexBlockImpl() {
     // Make lock acquisition uninterruptible because onOpMessage() can take locks.
     UninterruptibleLockGuard noInterrupt(_opCtx->lockState());
 
+    // The side writes tables of a hybrid build are not in the catalog, so dropping them can't be
+    // part of the unit of work which removes the indexes.
+    _removeIndexBuildInterceptors();
+
     while (true) {
         try {
             WriteUnitOfWork wunit(_opCtx);
@@ -247,11 +297,18 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
             _buildInBackground = (_buildInBackground && info["background"].trueValue());
         }
 
+        // The writes recorded during a hybrid build may repeat keys which the collection scan
+        // found, so indexes which must reject duplicate keys are built without sorting.
+        _hybrid = _buildInBackground && enableHybridIndexBuilds.load() &&
+            std::none_of(indexSpecs.begin(), indexSpecs.end(), [](const BSONObj& spec) {
+                return spec["unique"].trueValue();
+            });
+
         std::vector<BSONObj> indexInfoObjs;
         indexInfoObjs.reserve(indexSpecs.size());
-        std::size_t eachIndexBuildMaxMemoryUsageBytes = 0;
+        _eachIndexBuildMaxMemoryUsageBytes = 0;
         if (!indexSpecs.empty()) {
-            eachIndexBuildMaxMemoryUsageBytes =
+            _eachIndexBuildMaxMemoryUsageBytes =
                 static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
                 indexSpecs.size();
         }
@@ -277,10 +334,25 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
             if (!status.isOK())
                 return status;
 
-            if (!_buildInBackground) {
+            if (_hybrid) {
+                auto sideWritesTable =
+                    _opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(
+                        _opCtx);
+                if (sideWritesTable) {
+                    index.block->getEntry()->setIndexBuildInterceptor(
+                        stdx::make_unique<IndexBuildInterceptor>(std::move(sideWritesTable)));
+                } else {
+                    // The storage engine has no temporary tables, which it decides for all of the
+                    // indexes when asked for the first.
+                    invariant(i == 0);
+                    _hybrid = false;
+                }
+            }
+
+            if (!_buildInBackground || _hybrid) {
                 // Bulk build process requires foreground building as it assumes nothing is changing
-                // under it.
-                index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+                // under it, unless a hybrid build records the changes for later.
+                index.bulk = index.real->initiateBulk(_eachIndexBuildMaxMemoryUsageBytes);
             }
 
             const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
@@ -294,7 +366,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
             log() << "build index on: " << ns << " properties: " << descriptor->toString();
             if (index.bulk)
                 log() << "\t building index using bulk method; build may temporarily use up to "
-                      << eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024 << " megabytes of RAM";
+                      << _eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024 << " megabytes of RAM";
 
             index.filterExpression = index.block->getEntry()->getFilterExpression();
 
@@ -369,6 +441,11 @@ void failPointHangDuringBuild(FailPoint* fp, StringData where, const BSONObj& do
 Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* dupsOut) {
     invariant(!_opCtx->lockState()->inAWriteUnitOfWork());
 
+    const int numThreads = indexBuildThreads.load();
+    if (!_buildInBackground && numThreads > 1 && !_indexes.empty()) {
+        return _insertAllDocumentsInCollectionParallel(static_cast<size_t>(numThreads), dupsOut);
+    }
+
     // Refrain from persisting any multikey updates as a result from building the index. Instead,
     // accumulate them in the `MultikeyPathTracker` and do the write as part of the update that
     // commits the index.
@@ -379,7 +456,9 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* d
     }
     MultikeyPathTracker::get(_opCtx).startTrackingMultikeyPathInfo();
 
-    const char* curopMessage = _buildInBackground ? "Index Build (background)" : "Index Build";
+    const char* curopMessage = _hybrid
+        ? "Index Build (hybrid)"
+        : _buildInBackground ? "Index Build (background)" : "Index Build";
     const auto numRecords = _collection->numRecords(_opCtx);
     stdx::unique_lock<Client> lk(*_opCtx->getClient());
     ProgressMeterHolder progress(
@@ -507,11 +586,359 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* d
     if (!ret.isOK())
         return ret;
 
+    if (_hybrid) {
+        // Catch up with the writes made while the collection was scanned without blocking new
+        // ones, leaving drainBackgroundWrites() with only those made since. New writes may keep
+        // coming faster than they are drained, so this drain is bounded.
+        ret = _drainSideWrites("Index Build (hybrid): draining writes received during build",
+                               maxIndexBuildDrainWritesUnderIntentLocks.load());
+        if (!ret.isOK())
+            return ret;
+    }
+
     log() << "build index done.  scanned " << n << " total records. " << t.seconds() << " secs";
 
     return Status::OK();
 }
 
+Status MultiIndexBlockImpl::_insertAllDocumentsInCollectionParallel(size_t numThreads,
+                                                                    std::set<RecordId>* dupsOut) {
+    invariant(!_buildInBackground);
+
+    // Every worker sorts the keys of the documents it is handed into its own bulk builder for each
+    // index, so each index's memory budget is split between the workers. Nothing has been inserted
+    // into the builders created by init() yet, so they can be replaced.
+    const size_t maxMemoryUsageBytesPerWorker = _eachIndexBuildMaxMemoryUsageBytes / numThreads;
+    for (auto&& index : _indexes) {
+        invariant(index.bulk);
+        index.bulk = index.real->initiateBulk(maxMemoryUsageBytesPerWorker);
+        index.bulkPartitions.clear();
+        for (size_t i = 1; i < numThreads; ++i) {
+            index.bulkPartitions.push_back(index.real->initiateBulk(maxMemoryUsageBytesPerWorker));
+        }
+    }
+
+    using Batch = std::vector<std::pair<BSONObj, RecordId>>;
+
+    stdx::mutex mutex;
+    stdx::condition_variable queueChanged;
+    std::deque<Batch> batches;
+    size_t numActiveWorkers = 0;
+    bool scanDone = false;
+    bool abandoned = false;
+    Status firstError = Status::OK();
+
+    ThreadPool::Options options;
+    options.poolName = "IndexBuild";
+    options.threadNamePrefix = "IndexBuild-";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    ThreadPool pool(options);
+    pool.startup();
+    ON_BLOCK_EXIT([&] {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            abandoned = true;
+        }
+        queueChanged.notify_all();
+        pool.shutdown();
+        pool.join();
+    });
+
+    auto sortKeys = [&](size_t worker) {
+        Status status = Status::OK();
+        try {
+            while (true) {
+                Batch batch;
+                {
+                    stdx::unique_lock<stdx::mutex> lk(mutex);
+                    queueChanged.wait(lk, [&] {
+                        return !batches.empty() || scanDone || abandoned || !firstError.isOK();
+                    });
+                    if (batches.empty() || abandoned || !firstError.isOK()) {
+                        break;
+                    }
+                    batch = std::move(batches.front());
+                    batches.pop_front();
+                }
+                queueChanged.notify_all();
+
+                for (auto&& doc : batch) {
+                    for (auto&& index : _indexes) {
+                        if (index.filterExpression &&
+                            !index.filterExpression->matchesBSON(doc.first)) {
+                            continue;
+                        }
+
+                        // Key generation and sorting don't use the OperationContext, which belongs
+                        // to the thread running the build.
+                        auto bulk = worker == 0 ? index.bulk.get()
+                                                : index.bulkPartitions[worker - 1].get();
+                        int64_t unused;
+                        uassertStatusOK(
+                            bulk->insert(nullptr, doc.first, doc.second, index.options, &unused));
+                    }
+                }
+            }
+        } catch (...) {
+            status = exceptionToStatus();
+        }
+
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (!status.isOK() && firstError.isOK()) {
+                firstError = status;
+            }
+            --numActiveWorkers;
+        }
+        queueChanged.notify_all();
+    };
+
+    for (size_t worker = 0; worker < numThreads; ++worker) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            ++numActiveWorkers;
+        }
+        Status scheduled = pool.schedule([&sortKeys, worker] { sortKeys(worker); });
+        if (!scheduled.isOK()) {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --numActiveWorkers;
+            return scheduled;
+        }
+    }
+
+    // Hands a batch to the workers, waiting while they are already holding enough unsorted
+    // documents to keep all of them busy.
+    auto enqueueBatch = [&](Batch batch) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(mutex);
+            queueChanged.wait(
+                lk, [&] { return batches.size() < numThreads || !firstError.isOK(); });
+            if (!firstError.isOK()) {
+                return firstError;
+            }
+            batches.push_back(std::move(batch));
+        }
+        queueChanged.notify_all();
+        return Status::OK();
+    };
+
+    const auto numRecords = _collection->numRecords(_opCtx);
+    stdx::unique_lock<Client> clientLk(*_opCtx->getClient());
+    ProgressMeterHolder progress(CurOp::get(_opCtx)->setMessage_inlock(
+        "Index Build: (1/2) scanning collection and sorting keys",
+        "Index Build: (1/2) Scan And Sort Progress",
+        numRecords));
+    clientLk.unlock();
+
+    Timer t;
+
+    unsigned long long n = 0;
+
+    // The collection is scanned on this thread because the storage engine's cursor is tied to its
+    // OperationContext. Matching partial filters, generating keys and sorting them, which is where
+    // a foreground build spends its time, is done by the workers.
+    auto exec = InternalPlanner::collectionScan(
+        _opCtx, _collection->ns().ns(), _collection, PlanExecutor::WRITE_CONFLICT_RETRY_ONLY);
+
+    BSONObj objToIndex;
+    RecordId loc;
+    PlanExecutor::ExecState state;
+    Batch batch;
+    size_t batchBytes = 0;
+    while (PlanExecutor::ADVANCED == (state = exec->getNext(&objToIndex, &loc))) {
+        if (_allowInterruption) {
+            Status interruptStatus = _opCtx->checkForInterruptNoAssert();
+            if (!interruptStatus.isOK()) {
+                return interruptStatus;
+            }
+        }
+
+        batch.emplace_back(objToIndex.getOwned(), loc);
+        batchBytes += objToIndex.objsize();
+        if (batch.size() >= kMaxParallelBuildBatchDocuments ||
+            batchBytes >= kMaxParallelBuildBatchBytes) {
+            Status status = enqueueBatch(std::move(batch));
+            if (!status.isOK()) {
+                return status;
+            }
+            batch.clear();
+            batchBytes = 0;
+        }
+
+        progress->setTotalWhileRunning(_collection->numRecords(_opCtx));
+        progress->hit();
+        n++;
+    }
+
+    if (state != PlanExecutor::IS_EOF) {
+        return WorkingSetCommon::getMemberObjectStatus(objToIndex);
+    }
+
+    if (!batch.empty()) {
+        Status status = enqueueBatch(std::move(batch));
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        scanDone = true;
+        queueChanged.notify_all();
+        queueChanged.wait(lk, [&] { return numActiveWorkers == 0; });
+        if (!firstError.isOK()) {
+            return firstError;
+        }
+    }
+
+    progress->finished();
+
+    const int scanAndSortSecs = t.seconds();
+    log() << "index build: scanned " << n << " total records and sorted their keys using "
+          << numThreads << " threads in " << scanAndSortSecs << " secs";
+
+    Timer loadTimer;
+    const std::string loadMessage = str::stream()
+        << "Index Build: (2/2) bulk loading " << _indexes.size() << " indexes; scan and sort took "
+        << scanAndSortSecs << " secs";
+    Status ret = _doneInsertingParallel(&pool, loadMessage, dupsOut);
+    if (!ret.isOK())
+        return ret;
+
+    log() << "build index done.  scanned " << n << " total records. " << t.seconds()
+          << " secs (scan and sort: " << scanAndSortSecs << " secs, bulk load: "
+          << loadTimer.seconds() << " secs)";
+
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::_doneInsertingParallel(ThreadPool* pool,
+                                                   const std::string& curopMessage,
+                                                   std::set<RecordId>* dupsOut) {
+    invariant(!_opCtx->lockState()->inAWriteUnitOfWork());
+
+    // Each index is loaded by its own OperationContext, which holds no locks of its own and relies
+    // on the collection lock held by this thread. Only storage engines with document-level
+    // concurrency support writes from several sessions at once.
+    auto serviceContext = _opCtx->getServiceContext();
+    if (_indexes.size() < 2 || !serviceContext->getStorageEngine()->supportsDocLocking()) {
+        return doneInserting(dupsOut);
+    }
+
+    // Secondaries build indexes inside a TimestampBlock, whose timestamp the loaders' writes must
+    // carry as well.
+    const Timestamp commitTimestamp = _opCtx->recoveryUnit()->getCommitTimestamp();
+
+    stdx::mutex mutex;
+    stdx::condition_variable indexLoaded;
+    size_t numPending = 0;
+    size_t numLoaded = 0;
+    Status firstError = Status::OK();
+    std::vector<OperationContext*> loaderOpCtxs;
+    std::vector<std::set<RecordId>> dups(_indexes.size());
+
+    auto loadIndex = [&](size_t i) {
+        Status status = Status::OK();
+        try {
+            auto opCtx = cc().makeOperationContext();
+            {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                loaderOpCtxs.push_back(opCtx.get());
+            }
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                loaderOpCtxs.erase(
+                    std::find(loaderOpCtxs.begin(), loaderOpCtxs.end(), opCtx.get()));
+            });
+
+            if (!commitTimestamp.isNull()) {
+                opCtx->recoveryUnit()->setCommitTimestamp(commitTimestamp);
+            }
+            status = _commitBulk(
+                opCtx.get(), &_indexes[i], _allowInterruption, dupsOut ? &dups[i] : nullptr);
+            if (!commitTimestamp.isNull()) {
+                opCtx->recoveryUnit()->clearCommitTimestamp();
+            }
+        } catch (...) {
+            status = exceptionToStatus();
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        if (!status.isOK() && firstError.isOK()) {
+            firstError = status;
+        }
+        ++numLoaded;
+        --numPending;
+        indexLoaded.notify_one();
+    };
+
+    stdx::unique_lock<Client> clientLk(*_opCtx->getClient());
+    ProgressMeterHolder progress(
+        CurOp::get(_opCtx)->setMessage_inlock(curopMessage.c_str(),
+                                              "Index Build: (2/2) Bulk Load Progress",
+                                              _indexes.size(),
+                                              10));
+    clientLk.unlock();
+
+    size_t numScheduled = 0;
+    for (size_t i = 0; i < _indexes.size(); ++i) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            ++numPending;
+        }
+        Status scheduled = pool->schedule([&loadIndex, i] { loadIndex(i); });
+        if (!scheduled.isOK()) {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --numPending;
+            if (firstError.isOK()) {
+                firstError = scheduled;
+            }
+            break;
+        }
+        ++numScheduled;
+    }
+
+    // Wait for the loaders while watching for this operation being interrupted, and stop the
+    // remaining loaders as soon as one of them fails.
+    size_t numReported = 0;
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        while (numPending > 0) {
+            if (firstError.isOK() && _allowInterruption) {
+                firstError = _opCtx->checkForInterruptNoAssert();
+            }
+            if (!firstError.isOK()) {
+                for (auto&& loaderOpCtx : loaderOpCtxs) {
+                    stdx::lock_guard<Client> loaderClientLk(*loaderOpCtx->getClient());
+                    serviceContext->killOperation(loaderOpCtx, ErrorCodes::Interrupted);
+                }
+            }
+
+            if (numLoaded > numReported) {
+                progress->hit(static_cast<int>(numLoaded - numReported));
+                numReported = numLoaded;
+            }
+
+            indexLoaded.wait_for(lk, Milliseconds(100).toSystemDuration());
+        }
+    }
+
+    if (!firstError.isOK()) {
+        return firstError;
+    }
+    invariant(numScheduled == _indexes.size());
+    progress->finished();
+
+    if (dupsOut) {
+        for (auto&& indexDups : dups) {
+            dupsOut->insert(indexDups.begin(), indexDups.end());
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlockImpl::insert(const BSONObj& doc, const RecordId& loc) {
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
@@ -544,27 +971,100 @@ Status MultiIndexBlockImpl::doneInserting(std::set<RecordId>* dupsOut) {
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].bulk == NULL)
             continue;
-        LOG(1) << "\t bulk commit starting for index: "
-               << _indexes[i].block->getEntry()->descriptor()->indexName();
-        // SERVER-41918 This call to commitBulk() results in file I/O that may result in an
-        // exception.
-        try {
-            Status status = _indexes[i].real->commitBulk(_opCtx,
-                                                         _indexes[i].bulk.get(),
-                                                         _allowInterruption,
-                                                         _indexes[i].options.dupsAllowed,
-                                                         dupsOut);
-            if (!status.isOK()) {
-                return status;
-            }
-        } catch (...) {
-            return exceptionToStatus();
+        Status status = _commitBulk(_opCtx, &_indexes[i], _allowInterruption, dupsOut);
+        if (!status.isOK()) {
+            return status;
         }
     }
 
     return Status::OK();
 }
 
+Status MultiIndexBlockImpl::_commitBulk(OperationContext* opCtx,
+                                        IndexToBuild* index,
+                                        bool mayInterrupt,
+                                        std::set<RecordId>* dupsOut) {
+    LOG(1) << "\t bulk commit starting for index: "
+           << index->block->getEntry()->descriptor()->indexName();
+
+    std::vector<IndexAccessMethod::BulkBuilder*> bulks{index->bulk.get()};
+    for (auto&& partition : index->bulkPartitions) {
+        bulks.push_back(partition.get());
+    }
+
+    // SERVER-41918 This call to commitBulk() results in file I/O that may result in an exception.
+    try {
+        Status status = index->real->commitBulk(
+            opCtx, bulks, mayInterrupt, index->options.dupsAllowed, dupsOut);
+        if (!status.isOK()) {
+            return status;
+        }
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    // commit() only consults 'bulk' for the multikey state of the index.
+    for (auto&& partition : index->bulkPartitions) {
+        index->bulk->mergeMultikeyInfo(*partition);
+    }
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::drainBackgroundWrites() {
+    invariant(!_opCtx->lockState()->inAWriteUnitOfWork());
+    if (!_hybrid) {
+        return Status::OK();
+    }
+    invariant(_opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_X));
+
+    Status status =
+        _drainSideWrites("Index Build (hybrid): draining writes received during build under lock");
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // Nothing can be written to the collection until the indexes are committed, so the writes
+    // which follow go straight to the indexes.
+    _removeIndexBuildInterceptors();
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::_drainSideWrites(const char* curopMessage,
+                                             boost::optional<long long> maxWritesPerIndex) {
+    {
+        stdx::lock_guard<Client> lk(*_opCtx->getClient());
+        CurOp::get(_opCtx)->setMessage_inlock(curopMessage);
+    }
+
+    Timer t;
+    for (auto&& index : _indexes) {
+        auto interceptor = index.block->getEntry()->indexBuildInterceptor();
+        if (!interceptor) {
+            continue;
+        }
+
+        Status status = interceptor->drainWritesIntoIndex(
+            _opCtx, index.real, index.options, maxWritesPerIndex);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    LOG(1) << "index build: drained side writes for " << _indexes.size() << " indexes in "
+           << t.millis() << " ms";
+    return Status::OK();
+}
+
+void MultiIndexBlockImpl::_removeIndexBuildInterceptors() {
+    for (auto&& index : _indexes) {
+        auto entry = index.block->getEntry();
+        if (auto interceptor = entry->indexBuildInterceptor()) {
+            interceptor->deleteTemporaryTable(_opCtx);
+            entry->setIndexBuildInterceptor(nullptr);
+        }
+    }
+}
+
 void MultiIndexBlockImpl::abortWithoutCleanup() {
     _indexes.clear();
     _needToCleanup = false;
@@ -584,6 +1084,9 @@ void MultiIndexBlockImpl::commit(stdx::function<void(const BSONObj& spec)> onCre
             onCreateFn(_indexes[i].block->getSpec());
         }
 
+        // A hybrid build must have applied the writes it recorded.
+        invariant(!_indexes[i].block->getEntry()->indexBuildInterceptor());
+
         _indexes[i].block->success();
 
         // The bulk builder will track multikey information itself. Non-bulk builders re-use the
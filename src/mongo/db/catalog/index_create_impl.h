@@ -32,6 +32,7 @@
 
 #include "mongo/db/catalog/index_create.h"
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <set>
 #include <string>
@@ -50,6 +51,7 @@ class BackgroundOperation;
 class BSONObj;
 class Collection;
 class OperationContext;
+class ThreadPool;
 
 /**
  * Builds one or more indexes.
@@ -159,6 +161,17 @@ public:
      */
     Status doneInserting(std::set<RecordId>* dupsOut = nullptr) override;
 
+    /**
+     * Call this after insertAllDocumentsInCollection() returns success and before commit(). When
+     * the indexes were built by a hybrid background build, applies the writes which were made to
+     * the collection while the indexes were being loaded. Does nothing for other builds.
+     *
+     * Must not be called inside of a WriteUnitOfWork.
+     *
+     * Requires holding an exclusive collection lock.
+     */
+    Status drainBackgroundWrites() override;
+
     /**
      * Marks the index ready for use. Should only be called as the last method after
      * doneInserting() or insertAllDocumentsInCollection() return success.
@@ -201,9 +214,55 @@ private:
         const MatchExpression* filterExpression;  // might be NULL, owned elsewhere
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
+        // Additional builders used by parallel foreground builds, one per worker thread other than
+        // the first (which uses 'bulk'). Each sorts the keys of the documents handed to its
+        // worker, and all of them are merged into a single bulk load on commit.
+        std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>> bulkPartitions;
+
         InsertDeleteOptions options;
     };
 
+    /**
+     * Implements insertAllDocumentsInCollection() for foreground builds using 'numThreads' worker
+     * threads. This thread scans the collection and hands batches of documents to the workers,
+     * which generate and sort the keys for every index. The indexes are then bulk loaded
+     * concurrently when the storage engine allows it.
+     */
+    Status _insertAllDocumentsInCollectionParallel(size_t numThreads,
+                                                   std::set<RecordId>* dupsOut);
+
+    /**
+     * Like doneInserting(), but bulk loads each index on its own thread from 'pool', reporting
+     * progress in currentOp under 'curopMessage'. Falls back to doneInserting() when the storage
+     * engine cannot write to different indexes concurrently.
+     */
+    Status _doneInsertingParallel(ThreadPool* pool,
+                                  const std::string& curopMessage,
+                                  std::set<RecordId>* dupsOut);
+
+    /**
+     * Merges the sorted keys of all the bulk builders for 'index' and loads them into the index
+     * using 'opCtx'.
+     */
+    Status _commitBulk(OperationContext* opCtx,
+                       IndexToBuild* index,
+                       bool mayInterrupt,
+                       std::set<RecordId>* dupsOut);
+
+    /**
+     * Applies the writes recorded by the IndexBuildInterceptor of each index of a hybrid build,
+     * reporting progress in currentOp under 'curopMessage'. If 'maxWritesPerIndex' is set, writes
+     * beyond that many per index may be left for a later drain.
+     */
+    Status _drainSideWrites(const char* curopMessage,
+                            boost::optional<long long> maxWritesPerIndex = boost::none);
+
+    /**
+     * Drops the side writes table of each index of a hybrid build and lets writes go straight to
+     * the indexes again.
+     */
+    void _removeIndexBuildInterceptors();
+
     std::vector<IndexToBuild> _indexes;
 
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
@@ -216,7 +275,16 @@ private:
     bool _allowInterruption;
     bool _ignoreUnique;
 
+    // Set by init() when this is a background build which sorts and bulk loads the keys of the
+    // documents it scans, while IndexBuildInterceptors record the writes made to the collection
+    // during the scan.
+    bool _hybrid = false;
+
     bool _needToCleanup;
+
+    // Memory budget of the external sorter for each index, shared by all of that index's bulk
+    // builders.
+    std::size_t _eachIndexBuildMaxMemoryUsageBytes = 0;
 };
 
 }  // namespace mongo
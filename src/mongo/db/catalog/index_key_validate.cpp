@@ -40,6 +40,7 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
@@ -80,6 +81,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
     IndexDescriptor::kGeoHaystackBucketSize,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
     IndexDescriptor::kKeyPatternFieldName,
@@ -120,6 +122,22 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                 code, mongoutils::str::stream() << "Unknown index plugin '" << pluginName << '\'');
     }
 
+    const bool isWildcard = (pluginName == IndexNames::WILDCARD);
+    if (isWildcard) {
+        if (indexVersion < IndexVersion::kV2) {
+            return {code, "Wildcard indexes require index version v:2 or later."};
+        }
+
+        if (key.nFields() != 1) {
+            return {code, "Wildcard indexes cannot be compound."};
+        }
+
+        const BSONElement wildcardElt = key.firstElement();
+        if (!wildcardElt.isNumber() || wildcardElt.number() <= 0) {
+            return {code, "Wildcard indexes must be ascending."};
+        }
+    }
+
     BSONObjIterator it(key);
     while (it.more()) {
         BSONElement keyElement = it.next();
@@ -196,6 +214,10 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             if (part[0] != '$')
                 continue;
 
+            // The trailing "$**" of a wildcard index key indexes every path under the prefix.
+            if (isWildcard && i == numParts - 1)
+                continue;
+
             // Check if the '$'-prefixed field is part of a DBRef: since we don't have the
             // necessary context to validate whether this is a proper DBRef, we allow index
             // creation on '$'-prefixed names that match those used in a DBRef.
@@ -339,6 +361,20 @@ StatusWith<BSONObj> validateIndexSpec(
             }
 
             hasCollationField = true;
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+
+            auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || !BSONElementHasher::isValidHashVersion(*hashVersion)) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Invalid hash version: "
+                                      << indexSpecElem.toString(false, false)};
+            }
         } else if (IndexDescriptor::kPartialFilterExprFieldName == indexSpecElemFieldName) {
             if (indexSpecElem.type() != BSONType::Object) {
                 return {ErrorCodes::TypeMismatch,
@@ -237,6 +237,32 @@ TEST(IndexKeyValidateTest, KeyElementNameTextSucceedsOnTextIndex) {
     }
 }
 
+TEST(IndexKeyValidateTest, WildcardKeySucceedsForV2Indexes) {
+    ASSERT_OK(validateKeyPattern(BSON("$**" << 1), IndexVersion::kV2));
+    ASSERT_OK(validateKeyPattern(BSON("a.b.$**" << 1), IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, WildcardKeyFailsForV0AndV1Indexes) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("$**" << 1), IndexVersion::kV0));
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("$**" << 1), IndexVersion::kV1));
+}
+
+TEST(IndexKeyValidateTest, WildcardKeyFailsWhenCompoundOrDescending) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a" << 1 << "$**" << 1), IndexVersion::kV2));
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("$**" << -1), IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, WildcardKeyFailsWhenNotTrailingComponent) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a.$**.b" << 1), IndexVersion::kV2));
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("$a.$**" << 1), IndexVersion::kV2));
+}
+
 }  // namespace
 
 }  // namespace mongo
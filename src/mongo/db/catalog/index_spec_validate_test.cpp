@@ -806,5 +806,48 @@ TEST(IndexSpecPartialFilterTest, AcceptsValidPartialFilterExpression) {
     ASSERT_OK(result.getStatus());
 }
 
+TEST(IndexSpecHashVersionTest, FailsIfHashVersionIsNotANumber) {
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("field"
+                                                       << "hashed")
+                                               << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << "1"),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus(), ErrorCodes::TypeMismatch);
+}
+
+TEST(IndexSpecHashVersionTest, FailsIfHashVersionIsUnknown) {
+    for (auto hashVersion : {-1.0, 1.5, 2.0}) {
+        auto result = validateIndexSpec(kDefaultOpCtx,
+                                        BSON("key" << BSON("field"
+                                                           << "hashed")
+                                                   << "name"
+                                                   << "indexName"
+                                                   << "hashVersion"
+                                                   << hashVersion),
+                                        kTestNamespace,
+                                        serverGlobalParams.featureCompatibility);
+        ASSERT_EQ(result.getStatus(), ErrorCodes::BadValue);
+    }
+}
+
+TEST(IndexSpecHashVersionTest, AcceptsKnownHashVersions) {
+    for (auto hashVersion : {0, 1}) {
+        auto result = validateIndexSpec(kDefaultOpCtx,
+                                        BSON("key" << BSON("field"
+                                                           << "hashed")
+                                                   << "name"
+                                                   << "indexName"
+                                                   << "hashVersion"
+                                                   << hashVersion),
+                                        kTestNamespace,
+                                        serverGlobalParams.featureCompatibility);
+        ASSERT_OK(result.getStatus());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include <map>
 #include <string>
 
+#include "mongo/base/data_view.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
@@ -259,7 +260,7 @@ private:
                                               PlanExecutor::NO_YIELD,
                                               InternalPlanner::FORWARD,
                                               InternalPlanner::IXSCAN_FETCH);
-        } else if (collection->isCapped()) {
+        } else if (collection->isCapped() || collection->isClustered()) {
             exec = InternalPlanner::collectionScan(
                 opCtx, fullCollectionName, collection, PlanExecutor::NO_YIELD);
         } else {
@@ -270,14 +271,34 @@ private:
         md5_state_t st;
         md5_init(&st);
 
+        // Documents of a clustered collection whose _ids collide may be stored in a different order
+        // on each member, since it depends on the order in which they were inserted. Those
+        // documents are hashed regardless of order, by summing the hash of each one.
+        const bool unordered = !desc && collection->isClustered();
+        uint64_t digestSums[2] = {0, 0};
+
         long long n = 0;
         PlanExecutor::ExecState state;
         BSONObj c;
         verify(NULL != exec.get());
         while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
-            md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+            if (unordered) {
+                md5digest d;
+                md5(c.objdata(), c.objsize(), d);
+                ConstDataView view(reinterpret_cast<const char*>(d));
+                digestSums[0] += view.read<LittleEndian<uint64_t>>();
+                digestSums[1] += view.read<LittleEndian<uint64_t>>(sizeof(uint64_t));
+            } else {
+                md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+            }
             n++;
         }
+        if (unordered) {
+            char sums[sizeof(digestSums)];
+            DataView(sums).write<LittleEndian<uint64_t>>(digestSums[0]);
+            DataView(sums).write<LittleEndian<uint64_t>>(digestSums[1], sizeof(uint64_t));
+            md5_append(&st, (const md5_byte_t*)sums, sizeof(sums));
+        }
         if (PlanExecutor::IS_EOF != state) {
             warning() << "error while hashing, db dropped? ns=" << fullCollectionName;
             uasserted(34371,
@@ -59,6 +59,7 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/health_log.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/uuid_catalog.h"
 #include "mongo/db/client.h"
@@ -99,6 +100,8 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repair_database_and_check_version.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/file_copy_backup_commands.h"
+#include "mongo/db/repl/file_copy_initial_syncer.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
@@ -174,6 +177,7 @@
 #include "mongo/util/startup_test.h"
 #include "mongo/util/text.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/version.h"
 
 #ifdef MONGO_CONFIG_SSL
@@ -338,6 +342,12 @@ ExitCode _initAndListen(int listenPort) {
         serviceContext->setTransportLayer(std::move(tl));
     }
 
+    // A node asked to initial sync by copying data files does so before the storage engine opens
+    // the dbpath.
+    if (replSettings.usingReplSets() && !storageGlobalParams.repair) {
+        repl::runFileCopyInitialSyncIfRequested();
+    }
+
     // Set up the periodic runner for background job execution. This is required to be running
     // before the storage engine is initialized.
     auto runner = makePeriodicRunner(serviceContext);
@@ -441,7 +451,10 @@ ExitCode _initAndListen(int listenPort) {
                                                        repl::StorageInterface::get(serviceContext));
     }
 
+    Timer repairDatabasesTimer;
     auto swNonLocalDatabases = repairDatabasesAndCheckVersion(startupOpCtx.get());
+    log() << "Checked the databases for repair and version compatibility in "
+          << repairDatabasesTimer.millis() << "ms";
     if (!swNonLocalDatabases.isOK()) {
         // SERVER-31611 introduced a return value to `repairDatabasesAndCheckVersion`. Previously,
         // a failing condition would fassert. SERVER-31611 covers a case where the binary (3.6) is
@@ -962,6 +975,9 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
             PeriodicThreadToAbortExpiredTransactions::get(serviceContext)->stop();
         }
 
+        log() << "Shutting down the FileCopyBackupReaper";
+        repl::shutdownFileCopyBackupReaper(serviceContext);
+
         ServiceContext::UniqueOperationContext uniqueOpCtx;
         OperationContext* opCtx = client->getOperationContext();
         if (!opCtx) {
@@ -1037,6 +1053,9 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     log() << "Shutting down the HealthLog";
     HealthLog::get(serviceContext).shutdown();
 
+    log() << "Shutting down the index key generation pool";
+    shutdownIndexKeyGenerationPool();
+
     // We should always be able to acquire the global lock at shutdown.
     //
     // TODO: This call chain uses the locker directly, because we do not want to start an
@@ -75,6 +75,20 @@ using std::string;
 using std::stringstream;
 using std::unique_ptr;
 
+namespace {
+
+/**
+ * Clustered collections have no _id index; their record store is keyed by _id instead. Returns a
+ * null RecordId if there is no document with the given _id.
+ */
+RecordId findByIdInClusteredCollection(OperationContext* opCtx,
+                                       Collection* collection,
+                                       const BSONElement& id) {
+    return collection->getRecordStore()->findClusteredId(opCtx, id);
+}
+
+}  // namespace
+
 /* fetch a single object from collection ns that matches query
    set your db SavedContext first
 */
@@ -161,13 +175,14 @@ bool Helpers::findById(OperationContext* opCtx,
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
 
-    if (!desc)
+    if (!desc && !collection->isClustered())
         return false;
 
     if (indexFound)
         *indexFound = 1;
 
-    RecordId loc = catalog->getIndex(desc)->findSingle(opCtx, query["_id"].wrap());
+    RecordId loc = desc ? catalog->getIndex(desc)->findSingle(opCtx, query["_id"].wrap())
+                        : findByIdInClusteredCollection(opCtx, collection, query["_id"]);
     if (loc.isNull())
         return false;
     result = collection->docFor(opCtx, loc).value();
@@ -180,6 +195,9 @@ RecordId Helpers::findById(OperationContext* opCtx,
     verify(collection);
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
+    if (!desc && collection->isClustered()) {
+        return findByIdInClusteredCollection(opCtx, collection, idquery["_id"]);
+    }
     uassert(13430, "no _id index", desc);
     return catalog->getIndex(desc)->findSingle(opCtx, idquery["_id"].wrap());
 }
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
@@ -84,6 +85,16 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
         _endCondition = stdx::make_unique<GTEMatchExpression>(repl::OpTime::kTimestampFieldName,
                                                               _endConditionBSON.firstElement());
     }
+
+    const BSONObj& endId =
+        params.direction == CollectionScanParams::FORWARD ? params.maxId : params.minId;
+    if (!endId.isEmpty()) {
+        invariant(params.collection->isClustered());
+        const std::string endKey = clustered_record_id::keyForId(endId.firstElement());
+        _endRecordId = params.direction == CollectionScanParams::FORWARD
+            ? clustered_record_id::maxRecordIdInGroup(endKey)
+            : clustered_record_id::minRecordIdInGroup(endKey);
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -155,8 +166,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
 
+        const bool forward = _params.direction == CollectionScanParams::FORWARD;
         if (_lastSeenId.isNull() && !_params.start.isNull()) {
             record = _cursor->seekExact(_params.start);
+        } else if (_lastSeenId.isNull() && !(forward ? _params.minId : _params.maxId).isEmpty()) {
+            record = seekToStartRecord();
         } else {
             // See if the record we're about to access is in memory. If not, pass a fetch
             // request up.
@@ -189,6 +203,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (isPastEndRecord(*record)) {
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
     _lastSeenId = record->id;
     if (_params.assertMinTsHasNotFallenOffOplog) {
         assertMinTsHasNotFallenOffOplog(*record);
@@ -242,6 +261,33 @@ void CollectionScan::assertMinTsHasNotFallenOffOplog(const Record& record) {
     _params.assertMinTsHasNotFallenOffOplog = false;
 }
 
+boost::optional<Record> CollectionScan::seekToStartRecord() {
+    const bool forward = _params.direction == CollectionScanParams::FORWARD;
+    const BSONObj& startId = forward ? _params.minId : _params.maxId;
+
+    // Find the first record which may be in range. This happens in the same snapshot as the seek
+    // below, so the record cannot disappear in between.
+    const RecordId start = _params.collection->getRecordStore()->seekClusteredId(
+        getOpCtx(), startId.firstElement(), forward);
+    if (start.isNull()) {
+        // There are no records in range.
+        return boost::none;
+    }
+
+    return _cursor->seekExact(start);
+}
+
+bool CollectionScan::isPastEndRecord(const Record& record) const {
+    if (_endRecordId.isNull()) {
+        return false;
+    }
+
+    if (_params.direction == CollectionScanParams::FORWARD) {
+        return record.id > _endRecordId;
+    }
+    return record.id < _endRecordId;
+}
+
 PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
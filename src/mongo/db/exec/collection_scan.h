@@ -99,6 +99,18 @@ private:
      */
     void assertMinTsHasNotFallenOffOplog(const Record& record);
 
+    /**
+     * Positions '_cursor' for a scan starting at '_params.minId' (or '_params.maxId' when scanning
+     * backwards), and returns the first record to examine.
+     */
+    boost::optional<Record> seekToStartRecord();
+
+    /**
+     * Returns true if 'record' is past every record which may have an _id within the end bound of
+     * the scan. Records before that point may still be out of bounds, and are left to the filter.
+     */
+    bool isPastEndRecord(const Record& record) const;
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -110,6 +122,10 @@ private:
     BSONObj _endConditionBSON;
     std::unique_ptr<GTEMatchExpression> _endCondition;
 
+    // The last RecordId which may hold an _id within the end bound of the scan, or null if the scan
+    // has no end bound.
+    RecordId _endRecordId;
+
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
     CollectionScanParams _params;
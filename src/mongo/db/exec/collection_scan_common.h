@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "mongo/bson/bsonobj.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/record_id.h"
 
@@ -59,6 +60,14 @@ struct CollectionScanParams {
     // that does not pass the filter and has 'ts' greater than 'maxTs'.
     boost::optional<Timestamp> maxTs;
 
+    // Inclusive bounds on the _id of the records to scan, each held as the only element of an
+    // object, or empty if unbounded. Only set on scans of collections clustered by _id, where they
+    // are derived from the query's predicates on _id. The scan seeks to the group of the start
+    // bound and stops after the group of the end bound, see clustered_record_id.h. It relies on
+    // the filter for the records of those groups which are out of bounds.
+    BSONObj minId;
+    BSONObj maxId;
+
     Direction direction = FORWARD;
 
     // Do we want the scan to be 'tailable'?  Only meaningful if the collection is capped.
@@ -42,6 +42,8 @@
 #include "mongo/db/exec/write_stage_common.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
@@ -83,7 +85,10 @@ DeleteStage::DeleteStage(OperationContext* opCtx,
       _ws(ws),
       _collection(collection),
       _idRetrying(WorkingSet::INVALID_ID),
-      _idReturning(WorkingSet::INVALID_ID) {
+      _idReturning(WorkingSet::INVALID_ID),
+      _batchMaxDocs(params.isMulti && !params.isExplain && !params.returnDeleted
+                        ? write_stage_common::getWriteBatchMaxDocs(opCtx)
+                        : 1) {
     _children.emplace_back(child);
 }
 
@@ -95,7 +100,7 @@ bool DeleteStage::isEOF() {
         return true;
     }
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
-        child()->isEOF();
+        _batchedIds.empty() && child()->isEOF();
 }
 
 PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
@@ -118,6 +123,10 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         return PlanStage::ADVANCED;
     }
 
+    if (_batchMaxDocs > 1) {
+        return doBatchedWork(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     if (_idRetrying != WorkingSet::INVALID_ID) {
@@ -198,9 +207,6 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         member->obj.setValue(deletedDoc.getOwned());
     }
 
-    // TODO: Do we want to buffer docs and delete them in a group rather than saving/restoring state
-    // repeatedly?
-
     WorkingSetCommon::prepareForSnapshotChange(_ws);
     try {
         child()->saveState();
@@ -267,6 +273,119 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState DeleteStage::doBatchedWork(WorkingSetID* out) {
+    // A batch which is full, or which was staged before the child hit EOF, is deleted before
+    // asking the child for more. This is also how a batch which hit a write conflict is retried.
+    if (!_batchedIds.empty() &&
+        (child()->isEOF() || _batchedIds.size() >= _batchMaxDocs ||
+         _batchedBytes >= static_cast<size_t>(internalQueryExecWriteBatchMaxBytes.load()))) {
+        return commitBatch(out);
+    }
+
+    WorkingSetID id;
+    auto status = child()->work(&id);
+    switch (status) {
+        case PlanStage::ADVANCED:
+            break;
+
+        case PlanStage::FAILURE:
+        case PlanStage::DEAD:
+            // The stage which produces a failure is responsible for allocating a working set
+            // member with error details.
+            invariant(WorkingSet::INVALID_ID != id);
+            *out = id;
+            return status;
+
+        case PlanStage::NEED_TIME:
+            return status;
+
+        case PlanStage::NEED_YIELD:
+            *out = id;
+            return status;
+
+        case PlanStage::IS_EOF:
+            return _batchedIds.empty() ? status : commitBatch(out);
+
+        default:
+            MONGO_UNREACHABLE;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    if (!member->hasRecordId()) {
+        // We expect to be here because of an invalidation causing a force-fetch.
+        ++_specificStats.nInvalidateSkips;
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    }
+    invariant(member->hasObj());
+
+    // The child is free to reuse the memory backing an unowned document once it is asked for the
+    // next one, so staged documents must be owned.
+    member->makeObjOwnedIfNeeded();
+    _batchedIds.push_back(id);
+    _batchedBytes += member->obj.value().objsize();
+    return PlanStage::NEED_TIME;
+}
+
+PlanStage::StageState DeleteStage::commitBatch(WorkingSetID* out) {
+    invariant(!_batchedIds.empty());
+
+    WorkingSetCommon::prepareForSnapshotChange(_ws);
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    size_t docsDeleted = 0;
+    try {
+        WriteUnitOfWork wunit(getOpCtx());
+        // Each document is written at the timestamp of its own oplog entry.
+        repl::OplogBatch oplogBatch(getOpCtx(), _collection->ns(), _batchedIds.size());
+        for (auto id : _batchedIds) {
+            // Members staged before a yield are re-fetched and matched against the predicate.
+            if (!write_stage_common::ensureStillMatches(
+                    _collection, getOpCtx(), _ws, id, _params.canonicalQuery)) {
+                continue;
+            }
+            oplogBatch.prepareForNextWrite();
+            _collection->deleteDocument(getOpCtx(),
+                                        _params.stmtId,
+                                        _ws->get(id)->recordId,
+                                        _params.opDebug,
+                                        _params.fromMigrate,
+                                        false,
+                                        Collection::StoreDeletedDoc::Off);
+            ++docsDeleted;
+        }
+        oplogBatch.flush();
+        wunit.commit();
+    } catch (const WriteConflictException&) {
+        // Nothing in the batch was deleted. Keep the staged members so the whole batch is retried.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    _specificStats.docsDeleted += docsDeleted;
+
+    for (auto id : _batchedIds) {
+        _ws->free(id);
+    }
+    _batchedIds.clear();
+    _batchedBytes = 0;
+
+    // As restoreState may restore (recreate) cursors, make sure to restore the state outside of
+    // the WriteUnitOfWork.
+    try {
+        child()->restoreState();
+    } catch (const WriteConflictException&) {
+        // The batch was already committed, so there is nothing to retry.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
 void DeleteStage::doRestoreState() {
     invariant(_collection);
     const NamespaceString& ns(_collection->ns());
@@ -124,6 +124,20 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Used instead of the single-document path when '_batchMaxDocs' is greater than one. Stages
+     * documents produced by the child in '_batchedIds' until the batch is full or the child is
+     * EOF, and then deletes the whole batch via commitBatch().
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Deletes every document staged in '_batchedIds' which still matches the predicate within a
+     * single WriteUnitOfWork. If a WriteConflictException is thrown, the entire batch is kept and
+     * retried during the next call to work(), and NEED_YIELD is returned.
+     */
+    StageState commitBatch(WorkingSetID* out);
+
     DeleteStageParams _params;
 
     // Not owned by us.
@@ -140,6 +154,14 @@ private:
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
+    // The maximum number of documents to delete within a single WriteUnitOfWork. Batching is only
+    // used for multi-deletes which do not return the deleted documents.
+    size_t _batchMaxDocs;
+
+    // Members staged for deletion by the next call to commitBatch(), and their total size.
+    std::vector<WorkingSetID> _batchedIds;
+    size_t _batchedBytes = 0;
+
     // Stats
     DeleteStats _specificStats;
 };
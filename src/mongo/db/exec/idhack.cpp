@@ -63,9 +63,12 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
       _key(query->getQueryObj()["_id"].wrap()),
       _done(false),
       _idBeingPagedIn(WorkingSet::INVALID_ID) {
-    const IndexCatalog* catalog = _collection->getIndexCatalog();
-    _specificStats.indexName = descriptor->indexName();
-    _accessMethod = catalog->getIndex(descriptor);
+    if (descriptor) {
+        _specificStats.indexName = descriptor->indexName();
+        _accessMethod = _collection->getIndexCatalog()->getIndex(descriptor);
+    } else {
+        invariant(_collection->isClustered());
+    }
 
     if (NULL != query->getProj()) {
         _addKeyMetadata = query->getProj()->wantIndexKey();
@@ -86,9 +89,12 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
       _done(false),
       _addKeyMetadata(false),
       _idBeingPagedIn(WorkingSet::INVALID_ID) {
-    const IndexCatalog* catalog = _collection->getIndexCatalog();
-    _specificStats.indexName = descriptor->indexName();
-    _accessMethod = catalog->getIndex(descriptor);
+    if (descriptor) {
+        _specificStats.indexName = descriptor->indexName();
+        _accessMethod = _collection->getIndexCatalog()->getIndex(descriptor);
+    } else {
+        invariant(_collection->isClustered());
+    }
 }
 
 IDHackStage::~IDHackStage() {}
@@ -121,8 +127,15 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
 
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
-        // Look up the key by going directly to the index.
-        RecordId recordId = _accessMethod->findSingle(getOpCtx(), _key);
+        RecordId recordId;
+        if (_accessMethod) {
+            // Look up the key by going directly to the index.
+            recordId = _accessMethod->findSingle(getOpCtx(), _key);
+        } else {
+            // Look up the key directly in the record store, which is keyed by _id.
+            recordId = _collection->getRecordStore()->findClusteredId(getOpCtx(),
+                                                                      _key.firstElement());
+        }
 
         // Key not found.
         if (recordId.isNull()) {
@@ -130,7 +143,9 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
             return PlanStage::IS_EOF;
         }
 
-        ++_specificStats.keysExamined;
+        if (_accessMethod) {
+            ++_specificStats.keysExamined;
+        }
         ++_specificStats.docsExamined;
 
         // Create a new WSM for the result document.
@@ -46,6 +46,9 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * Clustered collections have no _id index. For them 'descriptor' is null and the stage looks the
+ * _id up directly in the record store, which is keyed by _id.
  */
 class IDHackStage final : public PlanStage {
 public:
@@ -104,8 +107,8 @@ private:
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
-    // Not owned here.
-    const IndexAccessMethod* _accessMethod;
+    // Not owned here. Null when looking up documents in a clustered collection.
+    const IndexAccessMethod* _accessMethod = nullptr;
 
     // The value to match against the _id field.
     BSONObj _key;
@@ -68,7 +68,8 @@ IndexScan::IndexScan(OperationContext* opCtx,
     : PlanStage(kStageType, opCtx),
       _workingSet(workingSet),
       _iam(params.descriptor->getIndexCatalog()->getIndex(params.descriptor)),
-      _keyPattern(params.descriptor->keyPattern().getOwned()),
+      _keyPattern(params.keyPattern.isEmpty() ? params.descriptor->keyPattern().getOwned()
+                                              : params.keyPattern.getOwned()),
       _scanState(INITIALIZING),
       _filter(filter),
       _shouldDedup(true),
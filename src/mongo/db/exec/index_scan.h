@@ -53,6 +53,11 @@ struct IndexScanParams {
 
     const IndexDescriptor* descriptor;
 
+    // The key pattern that 'bounds' are expressed against. If empty, the key pattern of
+    // 'descriptor' is used. Wildcard index scans set this, since the keys of a wildcard index have
+    // more fields than its key pattern.
+    BSONObj keyPattern;
+
     IndexBounds bounds;
 
     int direction;
@@ -45,6 +45,8 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/ops/update_lifecycle.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -173,6 +175,10 @@ UpdateStage::UpdateStage(OperationContext* opCtx,
       _idRetrying(WorkingSet::INVALID_ID),
       _idReturning(WorkingSet::INVALID_ID),
       _updatedRecordIds(params.request->isMulti() ? new RecordIdSet() : NULL),
+      _batchMaxDocs(params.request->isMulti() && !params.request->isExplain() &&
+                            !params.request->shouldReturnAnyDocs()
+                        ? write_stage_common::getWriteBatchMaxDocs(opCtx)
+                        : 1),
       _doc(params.driver->getDocument()) {
     _children.emplace_back(child);
 
@@ -349,9 +355,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. When
+        // batching, the enclosing batch may still roll back, so defer until it commits.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            if (_batchMaxDocs > 1) {
+                _batchUpdatedRecordIds.push_back(newRecordId);
+            } else {
+                _updatedRecordIds->insert(newRecordId);
+            }
         }
     }
 
@@ -484,6 +495,7 @@ bool UpdateStage::doneUpdating() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _batchedIds.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -553,6 +565,10 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         return PlanStage::ADVANCED;
     }
 
+    if (_batchMaxDocs > 1) {
+        return doBatchedWork(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -709,6 +725,128 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState UpdateStage::doBatchedWork(WorkingSetID* out) {
+    // A batch which is full, or which was staged before the child hit EOF, is updated before
+    // asking the child for more. This is also how a batch which hit a write conflict is retried.
+    if (!_batchedIds.empty() &&
+        (child()->isEOF() || _batchedIds.size() >= _batchMaxDocs ||
+         _batchedBytes >= static_cast<size_t>(internalQueryExecWriteBatchMaxBytes.load()))) {
+        return commitBatch(out);
+    }
+
+    WorkingSetID id;
+    StageState status = child()->work(&id);
+    if (PlanStage::IS_EOF == status) {
+        // The child is out of results, but we might not be done yet because we still might
+        // have to update the last batch or do an insert.
+        return _batchedIds.empty() ? PlanStage::NEED_TIME : commitBatch(out);
+    } else if (PlanStage::FAILURE == status) {
+        *out = id;
+        // If a stage fails, it may create a status WSM to indicate why it failed, in which case
+        // 'id' is valid.  If ID is invalid, we create our own error message.
+        if (WorkingSet::INVALID_ID == id) {
+            const std::string errmsg = "update stage failed to read in results from child";
+            *out = WorkingSetCommon::allocateStatusMember(
+                _ws, Status(ErrorCodes::InternalError, errmsg));
+            return PlanStage::FAILURE;
+        }
+        return status;
+    } else if (PlanStage::ADVANCED != status) {
+        if (PlanStage::NEED_YIELD == status) {
+            *out = id;
+        }
+        return status;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    if (!member->hasRecordId()) {
+        // We expect to be here because of an invalidation causing a force-fetch.
+        ++_specificStats.nInvalidateSkips;
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    // Updates can't have projections. This means that covering analysis will always add
+    // a fetch. We should always get fetched data, and never just key data.
+    invariant(member->hasObj());
+
+    if (_updatedRecordIds->count(member->recordId) > 0) {
+        // Found a RecordId that refers to a document updated by an earlier batch.
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    // The child is free to reuse the memory backing an unowned document once it is asked for the
+    // next one, so staged documents must be owned.
+    member->makeObjOwnedIfNeeded();
+    _batchedIds.push_back(id);
+    _batchedBytes += member->obj.value().objsize();
+    return PlanStage::NEED_TIME;
+}
+
+PlanStage::StageState UpdateStage::commitBatch(WorkingSetID* out) {
+    invariant(!_batchedIds.empty());
+
+    WorkingSetCommon::prepareForSnapshotChange(_ws);
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    // If the batch rolls back for any reason, none of its documents were updated.
+    const UpdateStats statsBeforeBatch = _specificStats;
+    ScopeGuard statsRestorer = MakeGuard([&] {
+        _specificStats = statsBeforeBatch;
+        _batchUpdatedRecordIds.clear();
+    });
+
+    try {
+        WriteUnitOfWork wunit(getOpCtx());
+        // Each document is written at the timestamp of its own oplog entry.
+        repl::OplogBatch oplogBatch(getOpCtx(), _collection->ns(), _batchedIds.size());
+        for (auto id : _batchedIds) {
+            // Members staged before a yield are re-fetched and matched against the predicate.
+            if (!write_stage_common::ensureStillMatches(
+                    _collection, getOpCtx(), _ws, id, _params.canonicalQuery)) {
+                continue;
+            }
+            oplogBatch.prepareForNextWrite();
+            WorkingSetMember* member = _ws->get(id);
+            RecordId recordId = member->recordId;
+            transformAndUpdate(member->obj, recordId);
+            ++_specificStats.nMatched;
+        }
+        oplogBatch.flush();
+        wunit.commit();
+    } catch (const WriteConflictException&) {
+        // Keep the staged members so the whole batch is retried.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    statsRestorer.Dismiss();
+
+    _updatedRecordIds->insert(_batchUpdatedRecordIds.begin(), _batchUpdatedRecordIds.end());
+    _batchUpdatedRecordIds.clear();
+    for (auto id : _batchedIds) {
+        _ws->free(id);
+    }
+    _batchedIds.clear();
+    _batchedBytes = 0;
+
+    // As restoreState may restore (recreate) cursors, make sure to restore the state outside of
+    // the WriteUnitOfWork.
+    try {
+        child()->restoreState();
+    } catch (const WriteConflictException&) {
+        // The batch was already committed, so there is nothing to retry.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
 void UpdateStage::doRestoreState() {
     const UpdateRequest& request = *_params.request;
     const NamespaceString& nsString(request.getNamespaceString());
@@ -178,6 +178,20 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Used instead of the single-document path when '_batchMaxDocs' is greater than one. Stages
+     * documents produced by the child in '_batchedIds' until the batch is full or the child is
+     * EOF, and then updates the whole batch via commitBatch().
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Updates every document staged in '_batchedIds' which still matches the predicate within a
+     * single WriteUnitOfWork. If a WriteConflictException is thrown, the entire batch is kept and
+     * retried during the next call to work(), and NEED_YIELD is returned.
+     */
+    StageState commitBatch(WorkingSetID* out);
+
     UpdateStageParams _params;
 
     // Not owned by us.
@@ -213,6 +227,18 @@ private:
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> RecordIdSet;
     const std::unique_ptr<RecordIdSet> _updatedRecordIds;
 
+    // The maximum number of documents to update within a single WriteUnitOfWork. Batching is only
+    // used for multi-updates which do not return the updated documents.
+    size_t _batchMaxDocs;
+
+    // Members staged for update by the next call to commitBatch(), and their total size.
+    std::vector<WorkingSetID> _batchedIds;
+    size_t _batchedBytes = 0;
+
+    // RecordIds written by the batch in progress. They are only added to '_updatedRecordIds' once
+    // the batch commits, since a rolled back batch is retried from scratch.
+    std::vector<RecordId> _batchUpdatedRecordIds;
+
     // These get reused for each update.
     mutablebson::Document& _doc;
     mutablebson::DamageVector _damages;
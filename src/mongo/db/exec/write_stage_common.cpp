@@ -36,6 +36,8 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
 
 namespace mongo {
 namespace write_stage_common {
@@ -69,5 +71,12 @@ bool ensureStillMatches(const Collection* collection,
     return true;
 }
 
+size_t getWriteBatchMaxDocs(OperationContext* opCtx) {
+    if (!supportsDocLocking() || opCtx->lockState()->inAWriteUnitOfWork()) {
+        return 1;
+    }
+    return std::max(internalQueryExecWriteBatchMaxDocs.load(), 1);
+}
+
 }  // namespace write_stage_common
 }  // namespace mongo
@@ -55,5 +55,14 @@ bool ensureStillMatches(const Collection* collection,
                         WorkingSet* ws,
                         WorkingSetID id,
                         const CanonicalQuery* cq);
+
+/**
+ * Returns the maximum number of documents which a multi-update or multi-delete may write within a
+ * single WriteUnitOfWork. Returns 1 if each document must be written in its own WriteUnitOfWork,
+ * which is the case when batching is disabled, when the caller is already inside a
+ * WriteUnitOfWork, or when the storage engine relies on invalidations rather than document-level
+ * locking.
+ */
+size_t getWriteBatchMaxDocs(OperationContext* opCtx);
 }
 }
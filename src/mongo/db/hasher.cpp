@@ -36,7 +36,11 @@
 #include "mongo/db/hasher.h"
 
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/startup_test.h"
 
@@ -48,18 +52,18 @@ namespace {
 
 typedef unsigned char HashDigest[16];
 
-class Hasher {
-    MONGO_DISALLOW_COPYING(Hasher);
+class MD5Hasher {
+    MONGO_DISALLOW_COPYING(MD5Hasher);
 
 public:
-    explicit Hasher(HashSeed seed);
-    ~Hasher(){};
+    explicit MD5Hasher(HashSeed seed);
+    ~MD5Hasher(){};
 
     // pointer to next part of input key, length in bytes to read
     void addData(const void* keyData, size_t numBytes);
 
     // finish computing the hash, put the result in the digest
-    // only call this once per Hasher
+    // only call this once per MD5Hasher
     void finish(HashDigest out);
 
 private:
@@ -67,19 +71,46 @@ private:
     HashSeed _seed;
 };
 
-Hasher::Hasher(HashSeed seed) : _seed(seed) {
+MD5Hasher::MD5Hasher(HashSeed seed) : _seed(seed) {
     md5_init(&_md5State);
     md5_append(&_md5State, reinterpret_cast<const md5_byte_t*>(&_seed), sizeof(_seed));
 }
 
-void Hasher::addData(const void* keyData, size_t numBytes) {
+void MD5Hasher::addData(const void* keyData, size_t numBytes) {
     md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
 }
 
-void Hasher::finish(HashDigest out) {
+void MD5Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
+/**
+ * MurmurHash3 has no incremental interface, so the input is gathered into a buffer which is
+ * hashed in one pass by finish(). Hashed values are typically small scalars, which fit in the
+ * builder's inline storage.
+ */
+class Murmur3Hasher {
+    MONGO_DISALLOW_COPYING(Murmur3Hasher);
+
+public:
+    explicit Murmur3Hasher(HashSeed seed) : _seed(seed) {}
+
+    void addData(const void* keyData, size_t numBytes) {
+        _buf.appendBuf(keyData, numBytes);
+    }
+
+    // finish computing the hash, put the result in the digest
+    // only call this once per Murmur3Hasher
+    void finish(HashDigest out) {
+        MurmurHash3_x64_128(_buf.buf(), _buf.len(), static_cast<uint32_t>(_seed), out);
+    }
+
+private:
+    StackBufBuilder _buf;
+    HashSeed _seed;
+};
+
+template <typename Hasher>
 void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
@@ -118,24 +149,47 @@ void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
     }
 }
 
+template <typename Hasher>
+long long int computeHash(const BSONElement& e, HashSeed seed) {
+    Hasher h(seed);
+    recursiveHash(&h, e, false);
+    HashDigest d;
+    h.finish(d);
+    // HashDigest is actually 16 bytes, but we just read 8 bytes
+    ConstDataView digestView(reinterpret_cast<const char*>(d));
+    return digestView.read<LittleEndian<long long int>>();
+}
+
 struct HasherUnitTest : public StartupTest {
     void run() {
         // Hard-coded check to ensure the hash function is consistent across platforms
         BSONObj o = BSON("check" << 42);
         verify(BSONElementHasher::hash64(o.firstElement(), 0) == -944302157085130861LL);
+        verify(BSONElementHasher::hash64(o.firstElement(),
+                                         0,
+                                         BSONElementHasher::MURMUR3_HASH_VERSION) ==
+               8715208212397937794LL);
     }
 } hasherUnitTest;
 
 }  // namespace
 
+bool BSONElementHasher::isValidHashVersion(int hashVersion) {
+    return hashVersion == MD5_HASH_VERSION || hashVersion == MURMUR3_HASH_VERSION;
+}
+
 long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
-    Hasher h(seed);
-    recursiveHash(&h, e, false);
-    HashDigest d;
-    h.finish(d);
-    // HashDigest is actually 16 bytes, but we just read 8 bytes
-    ConstDataView digestView(reinterpret_cast<const char*>(d));
-    return digestView.read<LittleEndian<long long int>>();
+    return computeHash<MD5Hasher>(e, seed);
+}
+
+long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed, int hashVersion) {
+    switch (hashVersion) {
+        case MD5_HASH_VERSION:
+            return computeHash<MD5Hasher>(e, seed);
+        case MURMUR3_HASH_VERSION:
+            return computeHash<Murmur3Hasher>(e, seed);
+    }
+    MONGO_UNREACHABLE;
 }
 
 }  // namespace mongo
@@ -55,6 +55,23 @@ public:
      */
     static const int DEFAULT_HASH_SEED = 0;
 
+    /* The hash function itself is identified by a hash version, which is persisted in the
+     * spec of hashed indexes and in the sharding metadata of collections with a hashed shard
+     * key. Version 0 hashes with MD5 and is what every index and shard key created before
+     * versioning existed uses. Version 1 hashes with the 64-bit variant of MurmurHash3, which
+     * is several times cheaper to compute.
+     *
+     * WARNING: do not change the default hash version. Indexes and shard keys which do not
+     * record a version expect it to be zero.
+     */
+    static const int MD5_HASH_VERSION = 0;
+    static const int MURMUR3_HASH_VERSION = 1;
+    static const int DEFAULT_HASH_VERSION = MD5_HASH_VERSION;
+
+    /* Returns true if "hashVersion" names a hash function which this binary implements.
+     */
+    static bool isValidHashVersion(int hashVersion);
+
     /* This computes a 64-bit hash of the value part of BSONElement "e",
      * preceded by the seed "seed".  Squashes element (and any sub-elements)
      * of the same canonical type, so hash({a:{b:4}}) will be the same
@@ -69,6 +86,11 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* Same as above, but computes the hash with the function identified by "hashVersion",
+     * which must be a valid hash version.
+     */
+    static long long int hash64(const BSONElement& e, HashSeed seed, int hashVersion);
+
 private:
     BSONElementHasher();
 };
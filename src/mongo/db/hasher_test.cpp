@@ -361,5 +361,56 @@ TEST(BSONElementHasher, HashCodeWScope) {
     ASSERT_EQUALS(hashIt(o), 501342939894575968LL);
 }
 
+TEST(BSONElementHasher, HashVersionZeroIsMD5) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(BSONElementHasher::hash64(
+                      o.firstElement(), 0, BSONElementHasher::DEFAULT_HASH_VERSION),
+                  hashIt(o));
+    ASSERT_EQUALS(
+        BSONElementHasher::hash64(o.firstElement(), 0, BSONElementHasher::MD5_HASH_VERSION),
+        -944302157085130861LL);
+}
+
+TEST(BSONElementHasher, HashVersionOneIsMurmur3) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+
+    BSONObj o = BSON("check" << 42);
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0, v), 8715208212397937794LL);
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 1, v), -9087602108468514688LL);
+
+    o = BSON("check"
+             << "hello");
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0, v), 681951484752308530LL);
+
+    o = BSON("check" << BSONNULL);
+    ASSERT_EQUALS(BSONElementHasher::hash64(o.firstElement(), 0, v), 6655367218388208063LL);
+}
+
+TEST(BSONElementHasher, Murmur3SquashesNumericTypes) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+    long long int intHash = BSONElementHasher::hash64(BSON("a" << 3).firstElement(), 0, v);
+    long long int longHash = BSONElementHasher::hash64(BSON("a" << 3LL).firstElement(), 0, v);
+    long long int doubleHash = BSONElementHasher::hash64(BSON("a" << 3.1).firstElement(), 0, v);
+    ASSERT_EQUALS(intHash, longHash);
+    ASSERT_EQUALS(intHash, doubleHash);
+}
+
+TEST(BSONElementHasher, Murmur3HashesNestedObjects) {
+    const int v = BSONElementHasher::MURMUR3_HASH_VERSION;
+    BSONObj o1 = BSON("a" << BSON("b" << 1 << "c" << "x"));
+    BSONObj o2 = BSON("a" << BSON("b" << 1 << "d" << "x"));
+    ASSERT_EQUALS(BSONElementHasher::hash64(o1.firstElement(), 0, v),
+                  BSONElementHasher::hash64(o1.copy().firstElement(), 0, v));
+    ASSERT_NOT_EQUALS(BSONElementHasher::hash64(o1.firstElement(), 0, v),
+                      BSONElementHasher::hash64(o2.firstElement(), 0, v));
+}
+
+TEST(BSONElementHasher, ValidHashVersions) {
+    ASSERT_TRUE(BSONElementHasher::isValidHashVersion(BSONElementHasher::MD5_HASH_VERSION));
+    ASSERT_TRUE(BSONElementHasher::isValidHashVersion(BSONElementHasher::MURMUR3_HASH_VERSION));
+    ASSERT_FALSE(BSONElementHasher::isValidHashVersion(-1));
+    ASSERT_FALSE(BSONElementHasher::isValidHashVersion(2));
+}
+
 }  // namespace
 }  // namespace mongo
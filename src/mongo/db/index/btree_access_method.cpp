@@ -44,7 +44,7 @@ using std::vector;
 
 // Standard Btree implementation below.
 BtreeAccessMethod::BtreeAccessMethod(IndexCatalogEntry* btreeState, SortedDataInterface* btree)
-    : IndexAccessMethod(btreeState, btree) {
+    : IndexAccessMethod(btreeState, btree), _ordering(Ordering::make(_descriptor->keyPattern())) {
     // The key generation wants these values.
     vector<const char*> fieldNames;
     vector<BSONElement> fixed;
@@ -71,4 +71,10 @@ void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
     _keyGenerator->getKeys(obj, keys, multikeyPaths);
 }
 
+bool BtreeAccessMethod::doGetKeyStringWithoutArrays(const BSONObj& obj,
+                                                    KeyString* keyString,
+                                                    int* keySize) const {
+    return _keyGenerator->getKeyStringWithoutArrays(obj, _ordering, keyString, keySize);
+}
+
 }  // namespace mongo
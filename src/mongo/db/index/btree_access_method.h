@@ -55,8 +55,14 @@ private:
                    BSONObjSet* keys,
                    MultikeyPaths* multikeyPaths) const final;
 
+    bool doGetKeyStringWithoutArrays(const BSONObj& obj,
+                                     KeyString* keyString,
+                                     int* keySize) const final;
+
     // Our keys differ for V0 and V1.
     std::unique_ptr<BtreeKeyGenerator> _keyGenerator;
+
+    const Ordering _ordering;
 };
 
 }  // namespace mongo
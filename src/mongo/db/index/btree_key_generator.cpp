@@ -37,6 +37,7 @@
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -89,6 +90,9 @@ void BtreeKeyGenerator::getKeys(const BSONObj& obj,
                                 MultikeyPaths* multikeyPaths) const {
     // '_fieldNames' and '_fixed' are passed by value so that they can be mutated as part of the
     // getKeys call.  :|
+    if (getKeysWithoutArrays(obj, keys, multikeyPaths)) {
+        return;
+    }
     getKeysImpl(_fieldNames, _fixed, obj, keys, multikeyPaths);
     if (keys->empty() && !_isSparse) {
         keys->insert(_nullKey);
@@ -247,7 +251,127 @@ BtreeKeyGeneratorV1::BtreeKeyGeneratorV1(std::vector<const char*> fieldNames,
         size_t pathLength = FieldRef{fieldName}.numParts();
         invariant(pathLength > 0);
         _pathLengths.push_back(pathLength);
+
+        // Split the path into StringData components which point into 'fieldName', which is owned
+        // by the index key pattern and outlives this key generator.
+        std::vector<StringData> components;
+        StringData remaining(fieldName);
+        for (size_t dot = remaining.find('.'); dot != std::string::npos;
+             dot = remaining.find('.')) {
+            components.push_back(remaining.substr(0, dot));
+            remaining = remaining.substr(dot + 1);
+        }
+        components.push_back(remaining);
+        invariant(components.size() == pathLength);
+        _pathComponents.push_back(std::move(components));
+    }
+}
+
+namespace {
+
+/**
+ * Walks each path in 'pathComponents' through the embedded objects of 'obj' and passes the element
+ * found, or null if the path is missing, to 'appendElement' in key pattern order. Returns false as
+ * soon as an array is found along any of the paths; elements already passed to 'appendElement'
+ * must then be discarded. Otherwise sets '*numNotFound' to the number of missing paths.
+ *
+ * This is a template so that each kind of key output gets its own instantiation of the walk.
+ */
+template <typename AppendElementFn>
+bool forEachElementWithoutArrays(const BSONObj& obj,
+                                 const std::vector<std::vector<StringData>>& pathComponents,
+                                 size_t* numNotFound,
+                                 AppendElementFn&& appendElement) {
+    *numNotFound = 0;
+    for (const auto& components : pathComponents) {
+        BSONElement elt = obj.getField(components[0]);
+        for (size_t i = 1; i < components.size(); ++i) {
+            if (elt.type() == Array) {
+                return false;
+            }
+            if (elt.type() != Object) {
+                // The path ends at a scalar (or is missing) before its last component.
+                elt = BSONElement();
+                break;
+            }
+            elt = elt.embeddedObject().getField(components[i]);
+        }
+
+        if (elt.type() == Array) {
+            return false;
+        }
+        if (elt.eoo()) {
+            elt = nullElt;
+            ++*numNotFound;
+        }
+        appendElement(elt);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool BtreeKeyGeneratorV1::getKeysWithoutArrays(const BSONObj& obj,
+                                               BSONObjSet* keys,
+                                               MultikeyPaths* multikeyPaths) const {
+    if (_isIdIndex) {
+        // The _id index has its own special case in getKeysImpl().
+        return false;
+    }
+
+    BSONObjBuilder b(_sizeTracker);
+    size_t numNotFound;
+    if (!forEachElementWithoutArrays(obj, _pathComponents, &numNotFound, [&](BSONElement elt) {
+            CollationIndexKey::collationAwareIndexKeyAppend(elt, _collator, &b);
+        })) {
+        return false;
+    }
+
+    if (multikeyPaths) {
+        invariant(multikeyPaths->empty());
+        multikeyPaths->resize(_pathComponents.size());
+    }
+    if (_isSparse && numNotFound == _pathComponents.size()) {
+        return true;
+    }
+    keys->insert(b.obj());
+    return true;
+}
+
+bool BtreeKeyGeneratorV1::getKeyStringWithoutArrays(const BSONObj& obj,
+                                                    Ordering ord,
+                                                    KeyString* keyString,
+                                                    int* keySize) const {
+    if (_isIdIndex || _collator) {
+        // Collation-aware keys are produced by rewriting string elements into a BSON key.
+        return false;
+    }
+
+    invariant(keyString->isEmpty());
+
+    // The size of the BSON key with the same elements, which starts with the object length and
+    // ends with the EOO byte. Each element has an empty field name.
+    int bsonKeySize = 4 + 1;
+    const bool allAscending = ord.descending(~0U) == 0;
+    size_t elemIdx = 0;
+    size_t numNotFound;
+    if (!forEachElementWithoutArrays(obj, _pathComponents, &numNotFound, [&](BSONElement elt) {
+            const bool invert = !allAscending && ord.get(elemIdx) == -1;
+            keyString->appendBSONElement(elt, invert);
+            bsonKeySize += 1 /* type */ + 1 /* empty field name */ + elt.valuesize();
+            ++elemIdx;
+        })) {
+        keyString->resetToEmpty();
+        return false;
+    }
+
+    if (_isSparse && numNotFound == _pathComponents.size()) {
+        keyString->resetToEmpty();
+        return true;
     }
+    keyString->appendDiscriminator(KeyString::kInclusive);
+    *keySize = bsonKeySize;
+    return true;
 }
 
 BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
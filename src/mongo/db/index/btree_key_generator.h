@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
@@ -42,6 +43,7 @@
 namespace mongo {
 
 class CollatorInterface;
+class KeyString;
 
 /**
  * Internal class used by BtreeAccessMethod to generate keys for indexed documents.
@@ -63,6 +65,23 @@ public:
 
     void getKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Encodes the key for 'obj' directly into the empty 'keyString' using the ordering 'ord', for
+     * the common case where none of the indexed paths in 'obj' traverse an array and the document
+     * therefore has a single key which does not make the index multikey. The KeyString is
+     * terminated but has no RecordId. Sets '*keySize' to the size the key would have as a BSONObj,
+     * which is what index key length limits are expressed in.
+     *
+     * Leaves 'keyString' empty if the index is sparse and 'obj' has none of the indexed fields.
+     * Returns false, leaving 'keyString' empty, if the keys must be generated by getKeys() instead.
+     */
+    virtual bool getKeyStringWithoutArrays(const BSONObj& obj,
+                                           Ordering ord,
+                                           KeyString* keyString,
+                                           int* keySize) const {
+        return false;
+    }
+
 protected:
     // These are used by the getKeysImpl(s) below.
     std::vector<const char*> _fieldNames;
@@ -72,6 +91,18 @@ protected:
     BSONSizeTracker _sizeTracker;
 
 private:
+    /**
+     * Generates the keys for 'obj' without going through getKeysImpl() when none of the indexed
+     * paths in 'obj' traverse an array, in which case the document produces at most one key.
+     * Returns false, leaving 'keys' and 'multikeyPaths' untouched, if the general key generation
+     * path must be used instead.
+     */
+    virtual bool getKeysWithoutArrays(const BSONObj& obj,
+                                      BSONObjSet* keys,
+                                      MultikeyPaths* multikeyPaths) const {
+        return false;
+    }
+
     virtual void getKeysImpl(std::vector<const char*> fieldNames,
                              std::vector<BSONElement> fixed,
                              const BSONObj& obj,
@@ -113,6 +144,11 @@ public:
 
     virtual ~BtreeKeyGeneratorV1() {}
 
+    bool getKeyStringWithoutArrays(const BSONObj& obj,
+                                   Ordering ord,
+                                   KeyString* keyString,
+                                   int* keySize) const final;
+
 private:
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
@@ -167,6 +203,16 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * Walks each indexed path through the embedded objects of 'obj' and appends the resulting
+     * element to the key as it goes, so that a document without arrays along its indexed paths
+     * is handled in a single pass and without copying the field name and fixed element vectors.
+     * Gives up as soon as an array is found on any indexed path.
+     */
+    bool getKeysWithoutArrays(const BSONObj& obj,
+                              BSONObjSet* keys,
+                              MultikeyPaths* multikeyPaths) const final;
+
     /**
      * Generates the index keys for the document 'obj' and stores them in the set 'keys'.
      *
@@ -257,6 +303,11 @@ private:
     // the vector is the number of path components in the indexed field.
     std::vector<size_t> _pathLengths;
 
+    // The components of each indexed field, split up front so that getKeysWithoutArrays() and
+    // getKeyStringWithoutArrays() do not have to reparse the dotted field names for every
+    // document.
+    std::vector<std::vector<StringData>> _pathComponents;
+
     // Null if this key generator orders strings according to the simple binary compare. If
     // non-null, represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
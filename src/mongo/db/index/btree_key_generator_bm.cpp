@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/btree_key_generator.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<BtreeKeyGenerator> makeKeyGenerator(const BSONObj& keyPattern,
+                                                    const CollatorInterface* collator) {
+    std::vector<const char*> fieldNames;
+    std::vector<BSONElement> fixed;
+    for (auto&& elt : keyPattern) {
+        fieldNames.push_back(elt.fieldName());
+        fixed.push_back(BSONElement());
+    }
+    return BtreeKeyGenerator::make(
+        IndexDescriptor::IndexVersion::kV2, fieldNames, fixed, false, collator);
+}
+
+void runGetKeys(benchmark::State& state,
+                const BSONObj& keyPattern,
+                const BSONObj& doc,
+                const CollatorInterface* collator = nullptr) {
+    auto keyGen = makeKeyGenerator(keyPattern, collator);
+    for (auto keepRunning : state) {
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        MultikeyPaths multikeyPaths;
+        keyGen->getKeys(doc, &keys, &multikeyPaths);
+        benchmark::DoNotOptimize(keys);
+    }
+}
+
+void BM_GetKeysSingleField(benchmark::State& state) {
+    runGetKeys(state,
+               fromjson("{a: 1}"),
+               fromjson("{_id: 1, a: 42, b: 'some string value', c: {d: 1, e: 2}}"));
+}
+
+void BM_GetKeysCompoundDotted(benchmark::State& state) {
+    runGetKeys(state,
+               fromjson("{'a.b': 1, c: 1, 'd.e.f': -1}"),
+               fromjson("{_id: 1, a: {b: 'x', z: 1}, c: 3.5, d: {e: {f: true, g: 1}}, h: 'y'}"));
+}
+
+void BM_GetKeysCompoundMissingFields(benchmark::State& state) {
+    runGetKeys(state, fromjson("{'a.b': 1, c: 1, d: 1}"), fromjson("{_id: 1, a: 5, e: 1}"));
+}
+
+void BM_GetKeysCompoundDottedWithCollation(benchmark::State& state) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    runGetKeys(state,
+               fromjson("{'a.b': 1, c: 1}"),
+               fromjson("{_id: 1, a: {b: 'some string'}, c: 'another string'}"),
+               &collator);
+}
+
+// Documents with arrays along an indexed path use the general key generation path. These serve as
+// a baseline for the array-free cases above.
+void BM_GetKeysArrayOfOne(benchmark::State& state) {
+    runGetKeys(state,
+               fromjson("{a: 1}"),
+               fromjson("{_id: 1, a: [42], b: 'some string value', c: {d: 1, e: 2}}"));
+}
+
+void BM_GetKeysCompoundDottedThroughArray(benchmark::State& state) {
+    runGetKeys(state,
+               fromjson("{'a.b': 1, c: 1, 'd.e.f': -1}"),
+               fromjson("{_id: 1, a: [{b: 'x', z: 1}], c: 3.5, d: {e: {f: true, g: 1}}, h: 'y'}"));
+}
+
+// Compares encoding the index key of a document into a KeyString through a BSON key, as inserts
+// into storage engines which only accept BSON keys do, against encoding it directly.
+const BSONObj kWideKeyPattern = fromjson("{a: 1, 'b.c': 1, d: -1, 'e.f.g': 1, h: 1, i: 1}");
+const BSONObj kWideDoc = fromjson(
+    "{_id: 1, a: 1, b: {c: 'some string'}, d: 2.5, e: {f: {g: true}}, h: 'x', i: null, j: 5}");
+
+void BM_GetKeysThenKeyString(benchmark::State& state) {
+    auto keyGen = makeKeyGenerator(kWideKeyPattern, nullptr);
+    const Ordering ord = Ordering::make(kWideKeyPattern);
+    for (auto keepRunning : state) {
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        MultikeyPaths multikeyPaths;
+        keyGen->getKeys(kWideDoc, &keys, &multikeyPaths);
+        for (auto&& key : keys) {
+            KeyString keyString(KeyString::Version::V1, key, ord, RecordId(1));
+            benchmark::DoNotOptimize(keyString.getBuffer());
+        }
+    }
+}
+
+void BM_GetKeyStringDirectly(benchmark::State& state) {
+    auto keyGen = makeKeyGenerator(kWideKeyPattern, nullptr);
+    const Ordering ord = Ordering::make(kWideKeyPattern);
+    for (auto keepRunning : state) {
+        KeyString keyString(KeyString::Version::V1);
+        int keySize;
+        invariant(keyGen->getKeyStringWithoutArrays(kWideDoc, ord, &keyString, &keySize));
+        keyString.appendRecordId(RecordId(1));
+        benchmark::DoNotOptimize(keyString.getBuffer());
+    }
+}
+
+BENCHMARK(BM_GetKeysSingleField);
+BENCHMARK(BM_GetKeysCompoundDotted);
+BENCHMARK(BM_GetKeysCompoundMissingFields);
+BENCHMARK(BM_GetKeysCompoundDottedWithCollation);
+BENCHMARK(BM_GetKeysArrayOfOne);
+BENCHMARK(BM_GetKeysCompoundDottedThroughArray);
+BENCHMARK(BM_GetKeysThenKeyString);
+BENCHMARK(BM_GetKeyStringDirectly);
+
+}  // namespace
+}  // namespace mongo
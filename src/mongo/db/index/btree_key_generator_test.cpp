@@ -40,6 +40,8 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 
@@ -1162,4 +1164,152 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysFromCompoundNestedObjectWithoutArrays) {
+    BSONObj keyPattern = fromjson("{'a.b.c': 1, d: -1, 'a.e': 1}");
+    BSONObj genKeysFrom = fromjson("{a: {b: {c: 1}, e: {f: 2}}, d: 'foo'}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 1, '': 'foo', '': {f: 2}}"));
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeysWhenPathEndsAtScalarBeforeLastComponent) {
+    BSONObj keyPattern = fromjson("{'a.b.c': 1, d: 1}");
+    BSONObj genKeysFrom = fromjson("{a: {b: 5}, d: 1}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': null, '': 1}"));
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeysWhenArrayOnLaterFieldOfCompoundKey) {
+    // The first indexed field is array-free, so key generation has to fall back to the general
+    // path only after it has started building a key.
+    BSONObj keyPattern = fromjson("{a: 1, 'b.c': 1}");
+    BSONObj genKeysFrom = fromjson("{a: 1, b: [{c: 2}, {c: 3}]}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 1, '': 2}"));
+    expectedKeys.insert(fromjson("{'': 1, '': 3}"));
+    MultikeyPaths expectedMultikeyPaths{std::set<size_t>{}, {0U}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeysFromSparseCompoundIndexWithoutArrays) {
+    BSONObj keyPattern = fromjson("{'a.b': 1, c: 1}");
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    ASSERT(testKeygen(
+        keyPattern, fromjson("{a: {d: 1}, d: 1}"), expectedKeys, expectedMultikeyPaths, true));
+
+    expectedKeys.insert(fromjson("{'': null, '': 2}"));
+    ASSERT(testKeygen(
+        keyPattern, fromjson("{a: {d: 1}, c: 2}"), expectedKeys, expectedMultikeyPaths, true));
+}
+
+TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromCompoundNestedObjectWithoutArrays) {
+    BSONObj keyPattern = fromjson("{'a.b': 1, c: 1}");
+    BSONObj genKeysFrom = fromjson("{a: {b: 'foo'}, c: 5}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 'oof', '': 5}"));
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    MultikeyPaths expectedMultikeyPaths(keyPattern.nFields());
+    ASSERT(
+        testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
+}
+
+//
+// KeyString generation
+//
+
+std::unique_ptr<BtreeKeyGenerator> makeKeyGenerator(const BSONObj& keyPattern,
+                                                    bool sparse = false,
+                                                    const CollatorInterface* collator = nullptr) {
+    vector<const char*> fieldNames;
+    vector<BSONElement> fixed;
+    for (auto&& elt : keyPattern) {
+        fieldNames.push_back(elt.fieldName());
+        fixed.push_back(BSONElement());
+    }
+    return stdx::make_unique<BtreeKeyGeneratorV1>(fieldNames, fixed, sparse, collator);
+}
+
+/**
+ * Checks that the KeyString generated for 'obj' is the encoding of the single BSON key which
+ * getKeys() generates for it.
+ */
+void assertKeyStringMatchesBSONKey(const BSONObj& keyPattern, const BSONObj& obj) {
+    auto keyGen = makeKeyGenerator(keyPattern);
+    const Ordering ord = Ordering::make(keyPattern);
+
+    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    keyGen->getKeys(obj, &keys, nullptr);
+    ASSERT_EQ(1U, keys.size());
+
+    for (auto version : {KeyString::Version::V0, KeyString::Version::V1}) {
+        KeyString keyString(version);
+        int keySize = 0;
+        ASSERT(keyGen->getKeyStringWithoutArrays(obj, ord, &keyString, &keySize));
+
+        const KeyString expected(version, *keys.begin(), ord);
+        ASSERT_EQ(expected, keyString);
+        ASSERT_EQ(keys.begin()->objsize(), keySize);
+        ASSERT_BSONOBJ_EQ(*keys.begin(),
+                          KeyString::toBson(keyString.getBuffer(),
+                                            keyString.getSize(),
+                                            ord,
+                                            keyString.getTypeBits()));
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeyStringFromObjectWithoutArrays) {
+    assertKeyStringMatchesBSONKey(fromjson("{a: 1}"), fromjson("{b: 4, a: 5}"));
+    assertKeyStringMatchesBSONKey(fromjson("{a: 1}"), fromjson("{b: 4}"));
+    assertKeyStringMatchesBSONKey(fromjson("{'a.b': 1, c: -1, 'a.d': 1}"),
+                                  fromjson("{a: {b: 'x', d: {e: 1.5}}, c: 7}"));
+    assertKeyStringMatchesBSONKey(fromjson("{'a.b.c': -1, d: -1}"), fromjson("{a: {b: 5}, d: 1}"));
+    assertKeyStringMatchesBSONKey(fromjson("{a: 1, b: 1}"), fromjson("{a: {c: [1, 2]}, b: 1}"));
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeyStringFailsForArraysAlongIndexedPaths) {
+    auto keyGen = makeKeyGenerator(fromjson("{a: 1, 'b.c': 1}"));
+    const Ordering ord = Ordering::make(fromjson("{a: 1, 'b.c': 1}"));
+    int keySize;
+
+    for (auto&& doc :
+         {fromjson("{a: [1]}"), fromjson("{a: 1, b: [{c: 1}]}"), fromjson("{b: {c: []}}")}) {
+        KeyString keyString(KeyString::Version::V1);
+        ASSERT_FALSE(keyGen->getKeyStringWithoutArrays(doc, ord, &keyString, &keySize));
+        ASSERT(keyString.isEmpty());
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeyStringFromSparseIndexLeavesKeyStringEmptyIfNoFields) {
+    const BSONObj keyPattern = fromjson("{'a.b': 1, c: 1}");
+    auto keyGen = makeKeyGenerator(keyPattern, true);
+    int keySize;
+
+    KeyString keyString(KeyString::Version::V1);
+    ASSERT(keyGen->getKeyStringWithoutArrays(
+        fromjson("{a: {d: 1}}"), Ordering::make(keyPattern), &keyString, &keySize));
+    ASSERT(keyString.isEmpty());
+
+    ASSERT(keyGen->getKeyStringWithoutArrays(
+        fromjson("{c: 1}"), Ordering::make(keyPattern), &keyString, &keySize));
+    ASSERT_FALSE(keyString.isEmpty());
+}
+
+TEST(BtreeKeyGeneratorTest, GetKeyStringNotSupportedForIdIndexOrCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    int keySize;
+    KeyString keyString(KeyString::Version::V1);
+
+    ASSERT_FALSE(makeKeyGenerator(fromjson("{_id: 1}"))
+                     ->getKeyStringWithoutArrays(
+                         fromjson("{_id: 1}"), Ordering::make(BSONObj()), &keyString, &keySize));
+    ASSERT_FALSE(makeKeyGenerator(fromjson("{a: 1}"), false, &collator)
+                     ->getKeyStringWithoutArrays(
+                         fromjson("{a: 'foo'}"), Ordering::make(BSONObj()), &keyString, &keySize));
+}
+
 }  // namespace
@@ -86,10 +86,9 @@ void ExpressionParams::parseHashParams(const BSONObj& infoObj,
         *seedOut = infoObj["seed"].numberInt();
     }
 
-    // In case we have hashed indexes based on other hash functions in the future, we store
-    // a hashVersion number. If hashVersion changes, "makeSingleHashKey" will need to change
-    // accordingly.  Defaults to 0 if "hashVersion" is not included in the index spec or if
-    // the value of "hashversion" is not a number
+    // The hashVersion number selects the hash function, see BSONElementHasher. Defaults to 0
+    // (MD5) if "hashVersion" is not included in the index spec or if the value of "hashVersion"
+    // is not a number
     *versionOut = infoObj["hashVersion"].numberInt();
 
     // Get the hashfield name
@@ -126,6 +126,37 @@ TEST(HashKeyGeneratorTest, CollatorAppliedBeforeHashingNestedObject) {
     ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
 }
 
+TEST(HashKeyGeneratorTest, Murmur3HashVersion) {
+    const int murmur3 = BSONElementHasher::MURMUR3_HASH_VERSION;
+    BSONObj obj = fromjson("{a: 'string'}");
+    BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    ExpressionKeysPrivate::getHashKeys(
+        obj, "a", kHashSeed, murmur3, false, nullptr, &actualKeys, false);
+
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(BSON("" << BSONElementHasher::hash64(obj["a"], kHashSeed, murmur3)));
+    ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
+
+    // Missing fields are indexed as the hash of null under the index's hash version.
+    actualKeys.clear();
+    ExpressionKeysPrivate::getHashKeys(
+        fromjson("{b: 1}"), "a", kHashSeed, murmur3, false, nullptr, &actualKeys, false);
+
+    expectedKeys.clear();
+    expectedKeys.insert(BSON("" << BSONElementHasher::hash64(
+                                 BSON("" << BSONNULL).firstElement(), kHashSeed, murmur3)));
+    ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
+}
+
+TEST(HashKeyGeneratorTest, UnknownHashVersionThrows) {
+    BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    ASSERT_THROWS_CODE(
+        ExpressionKeysPrivate::getHashKeys(
+            fromjson("{a: 1}"), "a", kHashSeed, 2, false, nullptr, &actualKeys, false),
+        AssertionException,
+        16767);
+}
+
 TEST(HashKeyGeneratorTest, NoCollation) {
     BSONObj obj = fromjson("{a: 'string'}");
     BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
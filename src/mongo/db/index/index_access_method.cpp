@@ -45,6 +45,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
@@ -82,6 +83,27 @@ bool isMultikeyFromPaths(const MultikeyPaths& multikeyPaths) {
 }  // namespace
 MONGO_EXPORT_SERVER_PARAMETER(failIndexKeyTooLong, bool, true);
 
+// Threads used by the external sorter of each index being built to sort the keys it holds in
+// memory before spilling them.
+MONGO_EXPORT_SERVER_PARAMETER(indexBuildSortThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue, "indexBuildSortThreads must be at least 1");
+        }
+        return Status::OK();
+    });
+
+// How the keys index builds spill to disk are compressed: 0 uses snappy, 1 through 9 use zlib at
+// that level and -1 leaves them uncompressed.
+MONGO_EXPORT_SERVER_PARAMETER(indexBuildSpillCompressionLevel, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < SortOptions::kNoSpillCompression || newVal > 9) {
+            return Status(ErrorCodes::BadValue,
+                          "indexBuildSpillCompressionLevel must be between -1 and 9");
+        }
+        return Status::OK();
+    });
+
 //
 // Comparison for external sorter interface
 //
@@ -133,13 +155,48 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
                                  const RecordId& loc,
                                  const InsertDeleteOptions& options,
                                  int64_t* numInserted) {
-    invariant(numInserted);
-    *numInserted = 0;
+    // When the storage engine stores keys as KeyStrings, a document with a single key for this
+    // index has that key encoded straight from the document instead of through a BSON key. Keys
+    // recorded by an IndexBuildInterceptor are always BSON keys.
+    auto keyStringVersion = _btreeState->indexBuildInterceptor()
+        ? boost::none
+        : _newInterface->getKeyStringInsertVersion(opCtx);
+    if (keyStringVersion) {
+        KeyString keyString(*keyStringVersion);
+        int keySize;
+        if (doGetKeyStringWithoutArrays(obj, &keyString, &keySize)) {
+            return insertKeyString(opCtx, keyString, keySize, loc, options, numInserted);
+        }
+    }
+
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
     // Delegate to the subclass.
     getKeys(obj, options.getKeysMode, GetKeysContext::kReadOrAddKeys, &keys, &multikeyPaths);
 
+    return insertKeys(opCtx, keys, multikeyPaths, loc, options, numInserted);
+}
+
+Status IndexAccessMethod::insertKeys(OperationContext* opCtx,
+                                     const BSONObjSet& keys,
+                                     const MultikeyPaths& multikeyPaths,
+                                     const RecordId& loc,
+                                     const InsertDeleteOptions& options,
+                                     int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+
+    if (auto interceptor = _btreeState->indexBuildInterceptor()) {
+        if (keys.size() > 1 || isMultikeyFromPaths(multikeyPaths)) {
+            _btreeState->setMultikey(opCtx, multikeyPaths);
+        }
+        return interceptor->sideWrite(opCtx,
+                                      std::vector<BSONObj>(keys.begin(), keys.end()),
+                                      loc,
+                                      IndexBuildInterceptor::Op::kInsert,
+                                      numInserted);
+    }
+
     Status ret = Status::OK();
     for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
         Status status = _newInterface->insert(opCtx, *i, loc, options.dupsAllowed);
@@ -183,6 +240,31 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
     return ret;
 }
 
+Status IndexAccessMethod::insertKeyString(OperationContext* opCtx,
+                                          const KeyString& keyString,
+                                          int keySize,
+                                          const RecordId& loc,
+                                          const InsertDeleteOptions& options,
+                                          int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+
+    if (keyString.isEmpty()) {
+        return Status::OK();
+    }
+
+    Status status =
+        _newInterface->insertKeyString(opCtx, keyString, keySize, loc, options.dupsAllowed);
+    if (status.isOK()) {
+        *numInserted = 1;
+        return status;
+    }
+    if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+        return Status::OK();
+    }
+    return status;
+}
+
 void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                      const BSONObj& key,
                                      const RecordId& loc,
@@ -231,6 +313,14 @@ Status IndexAccessMethod::remove(OperationContext* opCtx,
             &keys,
             multikeyPaths);
 
+    if (auto interceptor = _btreeState->indexBuildInterceptor()) {
+        return interceptor->sideWrite(opCtx,
+                                      std::vector<BSONObj>(keys.begin(), keys.end()),
+                                      loc,
+                                      IndexBuildInterceptor::Op::kDelete,
+                                      numDeleted);
+    }
+
     for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
         removeOneKey(opCtx, *i, loc, options.dupsAllowed);
         ++*numDeleted;
@@ -410,6 +500,16 @@ Status IndexAccessMethod::update(OperationContext* opCtx,
         _btreeState->setMultikey(opCtx, ticket.newMultikeyPaths);
     }
 
+    if (auto interceptor = _btreeState->indexBuildInterceptor()) {
+        Status status = interceptor->sideWrite(
+            opCtx, ticket.removed, ticket.loc, IndexBuildInterceptor::Op::kDelete, numDeleted);
+        if (!status.isOK()) {
+            return status;
+        }
+        return interceptor->sideWrite(
+            opCtx, ticket.added, ticket.loc, IndexBuildInterceptor::Op::kInsert, numInserted);
+    }
+
     for (size_t i = 0; i < ticket.removed.size(); ++i) {
         _newInterface->unindex(opCtx, ticket.removed[i], ticket.loc, ticket.dupsAllowed);
         IndexKeyEntry indexEntry = IndexKeyEntry(ticket.removed[i], ticket.loc);
@@ -437,6 +537,24 @@ Status IndexAccessMethod::update(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexAccessMethod::insertKeyForIndexBuild(OperationContext* opCtx,
+                                                 const BSONObj& key,
+                                                 const RecordId& loc,
+                                                 const InsertDeleteOptions& options) {
+    Status status = _newInterface->insert(opCtx, key, loc, options.dupsAllowed);
+    if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+        return Status::OK();
+    }
+    return status;
+}
+
+void IndexAccessMethod::removeKeyForIndexBuild(OperationContext* opCtx,
+                                               const BSONObj& key,
+                                               const RecordId& loc,
+                                               const InsertDeleteOptions& options) {
+    removeOneKey(opCtx, key, loc, options.dupsAllowed);
+}
+
 Status IndexAccessMethod::compact(OperationContext* opCtx) {
     return this->_newInterface->compact(opCtx);
 }
@@ -453,7 +571,9 @@ IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .NumSortThreads(indexBuildSortThreads.load())
+              .SpillCompressionLevel(indexBuildSpillCompressionLevel.load()),
           BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
       _real(index) {}
 
@@ -468,17 +588,7 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
     _real->getKeys(obj, options.getKeysMode, GetKeysContext::kReadOrAddKeys, &keys, &multikeyPaths);
 
     _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || (keys.size() > 1);
-
-    if (!multikeyPaths.empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
-            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
-                _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
-            }
-        }
-    }
+    _addMultikeyPaths(multikeyPaths);
 
     for (BSONObjSet::iterator it = keys.begin(); it != keys.end(); ++it) {
         _sorter->add(*it, loc);
@@ -493,20 +603,70 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
 }
 
 
+void IndexAccessMethod::BulkBuilder::_addMultikeyPaths(const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (_indexMultikeyPaths.empty()) {
+        _indexMultikeyPaths = multikeyPaths;
+    } else {
+        invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+        for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+            _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
+        }
+    }
+}
+
+void IndexAccessMethod::BulkBuilder::mergeMultikeyInfo(const BulkBuilder& other) {
+    invariant(_real == other._real);
+    _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || other._everGeneratedMultipleKeys;
+    _addMultikeyPaths(other._indexMultikeyPaths);
+}
+
 Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
                                      BulkBuilder* bulk,
                                      bool mayInterrupt,
                                      bool dupsAllowed,
                                      set<RecordId>* dupsToDrop) {
-    Timer timer;
+    return commitBulk(
+        opCtx, std::vector<BulkBuilder*>{bulk}, mayInterrupt, dupsAllowed, dupsToDrop);
+}
 
-    std::unique_ptr<BulkBuilder::Sorter::Iterator> it(bulk->_sorter->done());
+Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
+                                     const std::vector<BulkBuilder*>& bulks,
+                                     bool mayInterrupt,
+                                     bool dupsAllowed,
+                                     set<RecordId>* dupsToDrop) {
+    Timer timer;
+    invariant(!bulks.empty());
+
+    // Each BulkBuilder's sorted output is merged into a single stream of keys. The merge iterator
+    // does not own any file of its own; each Sorter keeps cleaning up its own spill file.
+    std::unique_ptr<BulkBuilder::Sorter::Iterator> it;
+    int64_t keysInserted = 0;
+    if (bulks.size() == 1) {
+        it.reset(bulks.front()->_sorter->done());
+        keysInserted = bulks.front()->_keysInserted;
+    } else {
+        std::vector<std::shared_ptr<BulkBuilder::Sorter::Iterator>> iters;
+        for (auto&& bulk : bulks) {
+            invariant(bulk->_real == this);
+            iters.emplace_back(bulk->_sorter->done());
+            keysInserted += bulk->_keysInserted;
+        }
+        it.reset(BulkBuilder::Sorter::Iterator::merge(
+            iters,
+            "",
+            SortOptions(),
+            BtreeExternalSortComparison(_descriptor->keyPattern(), _descriptor->version())));
+    }
 
     stdx::unique_lock<Client> lk(*opCtx->getClient());
     ProgressMeterHolder pm(
         CurOp::get(opCtx)->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
                                              "Index: (2/3) BTree Bottom Up Progress",
-                                             bulk->_keysInserted,
+                                             keysInserted,
                                              10));
     lk.unlock();
 
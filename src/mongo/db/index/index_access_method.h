@@ -86,6 +86,18 @@ public:
                   const InsertDeleteOptions& options,
                   int64_t* numInserted);
 
+    /**
+     * Inserts the keys previously generated for the document at 'loc' by getKeys(). This is the
+     * second half of insert(), for callers which generate the keys themselves. 'multikeyPaths'
+     * must be the paths produced alongside 'keys'.
+     */
+    Status insertKeys(OperationContext* opCtx,
+                      const BSONObjSet& keys,
+                      const MultikeyPaths& multikeyPaths,
+                      const RecordId& loc,
+                      const InsertDeleteOptions& options,
+                      int64_t* numInserted);
+
     /**
      * Analogous to above, but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
@@ -130,6 +142,20 @@ public:
                   int64_t* numInserted,
                   int64_t* numDeleted);
 
+    /**
+     * While the index is being built by a hybrid index build, insert(), remove() and update()
+     * record the keys they would write with the IndexBuildInterceptor of the index instead. These
+     * write a recorded key straight into the index when the build applies those writes.
+     */
+    Status insertKeyForIndexBuild(OperationContext* opCtx,
+                                  const BSONObj& key,
+                                  const RecordId& loc,
+                                  const InsertDeleteOptions& options);
+    void removeKeyForIndexBuild(OperationContext* opCtx,
+                                const BSONObj& key,
+                                const RecordId& loc,
+                                const InsertDeleteOptions& options);
+
     /**
      * Returns an unpositioned cursor over 'this' index.
      */
@@ -218,9 +244,18 @@ public:
 
         bool isMultikey() const;
 
+        /**
+         * Folds the multikey state of 'other', which must have been initiated on the same index,
+         * into this BulkBuilder. Used when several BulkBuilders sort disjoint subsets of the
+         * collection for a single index.
+         */
+        void mergeMultikeyInfo(const BulkBuilder& other);
+
     private:
         friend class IndexAccessMethod;
 
+        void _addMultikeyPaths(const MultikeyPaths& multikeyPaths);
+
         using Sorter = mongo::Sorter<BSONObj, RecordId>;
 
         BulkBuilder(const IndexAccessMethod* index,
@@ -267,6 +302,16 @@ public:
                       bool dupsAllowed,
                       std::set<RecordId>* dups);
 
+    /**
+     * Like commitBulk() above, but merges the sorted output of several BulkBuilders, each of which
+     * holds the keys for a disjoint subset of the collection, into a single bulk load.
+     */
+    Status commitBulk(OperationContext* opCtx,
+                      const std::vector<BulkBuilder*>& bulks,
+                      bool mayInterrupt,
+                      bool dupsAllowed,
+                      std::set<RecordId>* dups);
+
     /**
      * Specifies whether getKeys should relax the index constraints or not, in order of most
      * permissive to least permissive.
@@ -330,6 +375,20 @@ protected:
                            BSONObjSet* keys,
                            MultikeyPaths* multikeyPaths) const = 0;
 
+    /**
+     * Encodes the key for 'obj' directly into the empty 'keyString', using the Ordering of this
+     * index, if 'obj' has a single key which does not make the index multikey. Sets '*keySize' to
+     * the size of that key as a BSONObj. Leaves 'keyString' empty if 'obj' has no keys.
+     *
+     * Returns false if the keys for 'obj' must be generated by doGetKeys() instead, which is
+     * always the case for index types that do not override this.
+     */
+    virtual bool doGetKeyStringWithoutArrays(const BSONObj& obj,
+                                             KeyString* keyString,
+                                             int* keySize) const {
+        return false;
+    }
+
     /**
      * Determines whether it's OK to ignore ErrorCodes::KeyTooLong for this OperationContext
      */
@@ -339,6 +398,17 @@ protected:
     const IndexDescriptor* _descriptor;
 
 private:
+    /**
+     * Inserts the single key of a document which doGetKeyStringWithoutArrays() encoded as
+     * 'keyString', or nothing if 'keyString' is empty. Such a key never makes the index multikey.
+     */
+    Status insertKeyString(OperationContext* opCtx,
+                           const KeyString& keyString,
+                           int keySize,
+                           const RecordId& loc,
+                           const InsertDeleteOptions& options,
+                           int64_t* numInserted);
+
     void removeOneKey(OperationContext* opCtx,
                       const BSONObj& key,
                       const RecordId& loc,
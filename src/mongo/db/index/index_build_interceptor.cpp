@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kIndex
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_build_interceptor.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+namespace {
+
+// The number of recorded writes applied to the index in each WriteUnitOfWork while draining.
+const size_t kDrainBatchSize = 1000;
+
+const auto kOpFieldName = "op"_sd;
+const auto kKeyFieldName = "key"_sd;
+const auto kRecordIdFieldName = "recordId"_sd;
+
+const auto kInsertOp = "i"_sd;
+const auto kDeleteOp = "d"_sd;
+
+}  // namespace
+
+IndexBuildInterceptor::IndexBuildInterceptor(std::unique_ptr<TemporaryRecordStore> sideWritesTable)
+    : _sideWritesTable(std::move(sideWritesTable)) {
+    invariant(_sideWritesTable);
+}
+
+Status IndexBuildInterceptor::sideWrite(OperationContext* opCtx,
+                                        const std::vector<BSONObj>& keys,
+                                        const RecordId& loc,
+                                        Op op,
+                                        int64_t* numKeysOut) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(numKeysOut);
+    *numKeysOut = 0;
+
+    for (auto&& key : keys) {
+        BSONObjBuilder builder;
+        builder.append(kOpFieldName, op == Op::kInsert ? kInsertOp : kDeleteOp);
+        builder.append(kKeyFieldName, key);
+        builder.append(kRecordIdFieldName, loc.repr());
+        BSONObj operation = builder.done();
+
+        auto status = _sideWritesTable->rs()->insertRecord(
+            opCtx, operation.objdata(), operation.objsize(), Timestamp(), false);
+        if (!status.isOK()) {
+            return status.getStatus();
+        }
+        ++*numKeysOut;
+    }
+    return Status::OK();
+}
+
+Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
+                                                   IndexAccessMethod* indexAccessMethod,
+                                                   const InsertDeleteOptions& options,
+                                                   boost::optional<long long> maxWrites) {
+    invariant(!opCtx->lockState()->inAWriteUnitOfWork());
+
+    RecordStore* sideWrites = _sideWritesTable->rs();
+    long long numApplied = 0;
+
+    // Writes are recorded in the order their operations apply them, but a write may become visible
+    // after writes which were recorded later. Each pass therefore starts from the beginning of the
+    // table on a new snapshot, until one finds nothing left to apply. Writes to the same document
+    // are never reordered, since the second one can't be made until the first has committed.
+    while (true) {
+        Status interruptStatus = opCtx->checkForInterruptNoAssert();
+        if (!interruptStatus.isOK()) {
+            return interruptStatus;
+        }
+
+        std::vector<std::pair<RecordId, BSONObj>> batch;
+        {
+            auto cursor = sideWrites->getCursor(opCtx);
+            while (batch.size() < kDrainBatchSize) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                batch.emplace_back(record->id, record->data.toBson().getOwned());
+            }
+        }
+
+        if (batch.empty()) {
+            break;
+        }
+
+        Status status = writeConflictRetry(opCtx, "index build drain", sideWrites->ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            for (auto&& operation : batch) {
+                Status applyStatus =
+                    _applyWrite(opCtx, indexAccessMethod, operation.second, options);
+                if (!applyStatus.isOK()) {
+                    return applyStatus;
+                }
+                sideWrites->deleteRecord(opCtx, operation.first);
+            }
+            wuow.commit();
+            return Status::OK();
+        });
+        if (!status.isOK()) {
+            return status;
+        }
+
+        numApplied += batch.size();
+        opCtx->recoveryUnit()->abandonSnapshot();
+
+        if (maxWrites && numApplied >= *maxWrites) {
+            LOG(1) << "index build: stopped draining side writes after " << numApplied
+                   << " writes, leaving any others for a later drain";
+            break;
+        }
+    }
+
+    LOG(1) << "index build: drained " << numApplied << " side writes into the index";
+    return Status::OK();
+}
+
+void IndexBuildInterceptor::deleteTemporaryTable(OperationContext* opCtx) {
+    _sideWritesTable->deleteTemporaryTable(opCtx);
+}
+
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          IndexAccessMethod* indexAccessMethod,
+                                          const BSONObj& operation,
+                                          const InsertDeleteOptions& options) {
+    const BSONObj key = operation[kKeyFieldName].Obj();
+    const RecordId loc(operation[kRecordIdFieldName].Long());
+    const StringData op = operation[kOpFieldName].valueStringData();
+
+    if (op == kInsertOp) {
+        return indexAccessMethod->insertKeyForIndexBuild(opCtx, key, loc, options);
+    }
+    invariant(op == kDeleteOp);
+    indexAccessMethod->removeKeyForIndexBuild(opCtx, key, loc, options);
+    return Status::OK();
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/temporary_record_store.h"
+
+namespace mongo {
+
+class IndexAccessMethod;
+class OperationContext;
+struct InsertDeleteOptions;
+
+/**
+ * Captures the index writes made by concurrent operations while a hybrid index build scans the
+ * collection, so that the build can sort and bulk load the keys of the documents it scans without
+ * racing with those writes. The captured writes are kept in a temporary table and applied to the
+ * index by drainWritesIntoIndex() once the bulk load is done.
+ *
+ * Only non-unique indexes may be built this way: a captured insert may duplicate a key which the
+ * collection scan already found, and a captured delete may name a key which was never loaded.
+ */
+class IndexBuildInterceptor {
+    MONGO_DISALLOW_COPYING(IndexBuildInterceptor);
+
+public:
+    enum class Op { kInsert, kDelete };
+
+    explicit IndexBuildInterceptor(std::unique_ptr<TemporaryRecordStore> sideWritesTable);
+
+    /**
+     * Records that 'op' should be applied to each of 'keys' for the document at 'loc'. Must be
+     * called inside the WriteUnitOfWork of the write being intercepted. Sets '*numKeysOut' to the
+     * number of keys recorded.
+     */
+    Status sideWrite(OperationContext* opCtx,
+                     const std::vector<BSONObj>& keys,
+                     const RecordId& loc,
+                     Op op,
+                     int64_t* numKeysOut);
+
+    /**
+     * Applies the recorded writes to the index through 'indexAccessMethod' and removes them from
+     * the side writes table, in the order they were recorded. Writes which are recorded while this
+     * runs are applied as well; the caller must block writes to the collection to be certain that
+     * none remain when this returns.
+     *
+     * If 'maxWrites' is set, returns once at least that many writes have been applied, even if more
+     * remain, so that a drain which races with a steady stream of writes still ends. The remaining
+     * writes are left for a later drain.
+     */
+    Status drainWritesIntoIndex(OperationContext* opCtx,
+                                IndexAccessMethod* indexAccessMethod,
+                                const InsertDeleteOptions& options,
+                                boost::optional<long long> maxWrites = boost::none);
+
+    /**
+     * Drops the side writes table. Must be called before the interceptor is destroyed.
+     */
+    void deleteTemporaryTable(OperationContext* opCtx);
+
+private:
+    Status _applyWrite(OperationContext* opCtx,
+                       IndexAccessMethod* indexAccessMethod,
+                       const BSONObj& operation,
+                       const InsertDeleteOptions& options);
+
+    std::unique_ptr<TemporaryRecordStore> _sideWritesTable;
+};
+
+}  // namespace mongo
@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/wildcard_key_generator.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "wildcard" indices, which index every path/value pair beneath a
+ * given prefix of the document in a single physical index. See WildcardKeyGenerator for the
+ * format of the keys.
+ */
+class WildcardAccessMethod : public IndexAccessMethod {
+public:
+    WildcardAccessMethod(IndexCatalogEntry* wildcardState, SortedDataInterface* btree);
+
+private:
+    /**
+     * Fills 'keys' with the keys that should be generated for 'obj' on this index.
+     *
+     * This function ignores the 'multikeyPaths' pointer because wildcard indexes don't support
+     * tracking path-level multikey information. Any document which generates more than one key
+     * therefore marks the whole index as multikey.
+     */
+    void doGetKeys(const BSONObj& obj,
+                   GetKeysContext context,
+                   BSONObjSet* keys,
+                   MultikeyPaths* multikeyPaths) const final;
+
+    WildcardKeyGenerator _keyGen;
+};
+
+}  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/wildcard_key_generator.h"
+
+#include "mongo/db/field_ref.h"
+#include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+WildcardKeyGenerator::WildcardKeyGenerator(const BSONObj& keyPattern,
+                                           const CollatorInterface* collator)
+    : _prefix(extractPrefix(keyPattern.firstElementFieldName()).toString()),
+      _collator(collator) {
+    if (!_prefix.empty()) {
+        FieldRef prefixRef(_prefix);
+        for (size_t i = 0; i < prefixRef.numParts(); ++i) {
+            _prefixParts.push_back(prefixRef.getPart(i).toString());
+        }
+    }
+}
+
+StringData WildcardKeyGenerator::extractPrefix(StringData wildcardFieldName) {
+    invariant(wildcardFieldName.endsWith("$**"));
+    const size_t prefixLength = wildcardFieldName.size() - 3;
+    // Strip the '.' separating the prefix from "$**", if there is a prefix.
+    return wildcardFieldName.substr(0, prefixLength == 0 ? 0 : prefixLength - 1);
+}
+
+void WildcardKeyGenerator::getKeys(const BSONObj& obj, BSONObjSet* keys) const {
+    if (_prefixParts.empty()) {
+        for (auto&& elem : obj) {
+            if (elem.fieldNameStringData() == "_id") {
+                continue;
+            }
+            _traverseElement(elem, elem.fieldName(), keys);
+        }
+        return;
+    }
+
+    _traversePrefix(obj, 0, keys);
+}
+
+void WildcardKeyGenerator::_traversePrefix(const BSONObj& obj,
+                                           size_t partIndex,
+                                           BSONObjSet* keys) const {
+    BSONElement elem = obj[_prefixParts[partIndex]];
+    if (elem.eoo()) {
+        return;
+    }
+
+    if (partIndex == _prefixParts.size() - 1) {
+        _traverseElement(elem, _prefix, keys);
+        return;
+    }
+
+    if (elem.type() == BSONType::Object) {
+        _traversePrefix(elem.Obj(), partIndex + 1, keys);
+    } else if (elem.type() == BSONType::Array) {
+        // Objects inside an array along the prefix are traversed as if the array were not there.
+        for (auto&& arrayElem : elem.Obj()) {
+            if (arrayElem.type() == BSONType::Object) {
+                _traversePrefix(arrayElem.Obj(), partIndex + 1, keys);
+            }
+        }
+    }
+}
+
+void WildcardKeyGenerator::_traverseElement(BSONElement elem,
+                                            const std::string& path,
+                                            BSONObjSet* keys) const {
+    switch (elem.type()) {
+        case BSONType::Object: {
+            BSONObj subObj = elem.Obj();
+            if (subObj.isEmpty()) {
+                _addKey(path, elem, keys);
+                return;
+            }
+            for (auto&& child : subObj) {
+                _traverseElement(child, path + '.' + child.fieldName(), keys);
+            }
+            return;
+        }
+        case BSONType::Array: {
+            BSONObj arr = elem.Obj();
+            if (arr.isEmpty()) {
+                _addKey(path, elem, keys);
+                return;
+            }
+            for (auto&& arrayElem : arr) {
+                // Nested arrays are indexed as values, in the same way as by a btree index.
+                if (arrayElem.type() == BSONType::Array) {
+                    _addKey(path, arrayElem, keys);
+                } else {
+                    _traverseElement(arrayElem, path, keys);
+                }
+            }
+            return;
+        }
+        default:
+            _addKey(path, elem, keys);
+    }
+}
+
+void WildcardKeyGenerator::_addKey(const std::string& path,
+                                   BSONElement value,
+                                   BSONObjSet* keys) const {
+    BSONObjBuilder bob;
+    bob.append("", path);
+    CollationIndexKey::collationAwareIndexKeyAppend(value, _collator, &bob);
+    keys->insert(bob.obj());
+}
+
+}  // namespace mongo
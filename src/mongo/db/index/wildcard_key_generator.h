@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+class CollatorInterface;
+
+/**
+ * Internal class used by WildcardAccessMethod to generate keys for indexed documents.
+ *
+ * A wildcard index over the key pattern {"<prefix>.$**": 1} (or {"$**": 1}) holds one key of the
+ * form {"": <path>, "": <value>} for every leaf value found beneath the prefix, where <path> is
+ * the full dotted path to the value. Array positions never appear in an indexed path: the
+ * elements of an array are indexed under the path of the array itself, and objects inside arrays
+ * are traversed as if the array were not there. Nested arrays and empty objects or arrays are
+ * indexed as values. The top-level _id field is not indexed by {"$**": 1}.
+ */
+class WildcardKeyGenerator {
+public:
+    WildcardKeyGenerator(const BSONObj& keyPattern, const CollatorInterface* collator);
+
+    /**
+     * Returns the path prefix indexed by the wildcard key pattern field 'wildcardFieldName', e.g.
+     * "a.b" for "a.b.$**" and the empty string for "$**".
+     */
+    static StringData extractPrefix(StringData wildcardFieldName);
+
+    void getKeys(const BSONObj& obj, BSONObjSet* keys) const;
+
+private:
+    void _traversePrefix(const BSONObj& obj, size_t partIndex, BSONObjSet* keys) const;
+
+    void _traverseElement(BSONElement elem, const std::string& path, BSONObjSet* keys) const;
+
+    void _addKey(const std::string& path, BSONElement value, BSONObjSet* keys) const;
+
+    std::string _prefix;
+    std::vector<std::string> _prefixParts;
+
+    // Null if this index orders strings according to the simple binary compare. If non-null,
+    // represents the collator used to generate index keys for indexed strings.
+    const CollatorInterface* _collator;
+};
+
+}  // namespace mongo
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kIndex
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/wildcard_key_generator.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+std::string dumpKeyset(const BSONObjSet& objs) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (auto&& obj : objs) {
+        ss << obj.toString() << " ";
+    }
+    ss << "]";
+
+    return ss.str();
+}
+
+bool assertKeysetsEqual(const BSONObjSet& expectedKeys, const BSONObjSet& actualKeys) {
+    if (expectedKeys.size() != actualKeys.size() ||
+        !std::equal(expectedKeys.begin(),
+                    expectedKeys.end(),
+                    actualKeys.begin(),
+                    SimpleBSONObjComparator::kInstance.makeEqualTo())) {
+        log() << "Expected: " << dumpKeyset(expectedKeys) << ", "
+              << "Actual: " << dumpKeyset(actualKeys);
+        return false;
+    }
+
+    return true;
+}
+
+BSONObjSet makeKeySet(std::initializer_list<BSONObj> keys) {
+    BSONObjSet keySet = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    keySet.insert(keys.begin(), keys.end());
+    return keySet;
+}
+
+BSONObjSet getKeys(const BSONObj& keyPattern,
+                   const BSONObj& obj,
+                   const CollatorInterface* collator = nullptr) {
+    WildcardKeyGenerator keyGen(keyPattern, collator);
+    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    keyGen.getKeys(obj, &keys);
+    return keys;
+}
+
+TEST(WildcardKeyGeneratorTest, ExtractPrefix) {
+    ASSERT_EQ(WildcardKeyGenerator::extractPrefix("$**"), "");
+    ASSERT_EQ(WildcardKeyGenerator::extractPrefix("a.$**"), "a");
+    ASSERT_EQ(WildcardKeyGenerator::extractPrefix("a.b.$**"), "a.b");
+}
+
+TEST(WildcardKeyGeneratorTest, IndexesEveryLeafExceptId) {
+    auto keys = getKeys(fromjson("{'$**': 1}"), fromjson("{_id: 1, a: 1, b: {c: 'x', d: true}}"));
+    auto expected = makeKeySet({fromjson("{'': 'a', '': 1}"),
+                                fromjson("{'': 'b.c', '': 'x'}"),
+                                fromjson("{'': 'b.d', '': true}")});
+    ASSERT(assertKeysetsEqual(expected, keys));
+}
+
+TEST(WildcardKeyGeneratorTest, ArrayElementsAreIndexedUnderTheArrayPath) {
+    auto keys = getKeys(fromjson("{'$**': 1}"), fromjson("{a: [1, {b: 2}, [3]], c: []}"));
+    auto expected = makeKeySet({fromjson("{'': 'a', '': 1}"),
+                                fromjson("{'': 'a.b', '': 2}"),
+                                fromjson("{'': 'a', '': [3]}"),
+                                fromjson("{'': 'c', '': []}")});
+    ASSERT(assertKeysetsEqual(expected, keys));
+}
+
+TEST(WildcardKeyGeneratorTest, EmptyObjectIsIndexedAsValue) {
+    auto keys = getKeys(fromjson("{'$**': 1}"), fromjson("{a: {}}"));
+    ASSERT(assertKeysetsEqual(makeKeySet({fromjson("{'': 'a', '': {}}")}), keys));
+}
+
+TEST(WildcardKeyGeneratorTest, OnlyPathsUnderPrefixAreIndexed) {
+    auto keys = getKeys(fromjson("{'a.b.$**': 1}"),
+                        fromjson("{a: {b: {c: 1, d: [2]}, e: 3}, f: 4, _id: 5}"));
+    auto expected =
+        makeKeySet({fromjson("{'': 'a.b.c', '': 1}"), fromjson("{'': 'a.b.d', '': 2}")});
+    ASSERT(assertKeysetsEqual(expected, keys));
+}
+
+TEST(WildcardKeyGeneratorTest, ArraysAlongPrefixAreTraversed) {
+    auto keys = getKeys(fromjson("{'a.b.$**': 1}"), fromjson("{a: [{b: 1}, {b: {c: 2}}, 3]}"));
+    auto expected =
+        makeKeySet({fromjson("{'': 'a.b', '': 1}"), fromjson("{'': 'a.b.c', '': 2}")});
+    ASSERT(assertKeysetsEqual(expected, keys));
+}
+
+TEST(WildcardKeyGeneratorTest, IdIsIndexedWhenUnderPrefix) {
+    auto keys = getKeys(fromjson("{'_id.$**': 1}"), fromjson("{_id: {a: 1}}"));
+    ASSERT(assertKeysetsEqual(makeKeySet({fromjson("{'': '_id.a', '': 1}")}), keys));
+}
+
+TEST(WildcardKeyGeneratorTest, MissingPrefixGeneratesNoKeys) {
+    auto keys = getKeys(fromjson("{'a.$**': 1}"), fromjson("{b: 1}"));
+    ASSERT(keys.empty());
+}
+
+TEST(WildcardKeyGeneratorTest, CollatorAppliesToValuesButNotPaths) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    auto keys = getKeys(fromjson("{'$**': 1}"), fromjson("{ab: 'string'}"), &collator);
+    ASSERT(assertKeysetsEqual(makeKeySet({fromjson("{'': 'ab', '': 'gnirts'}")}), keys));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -261,6 +261,14 @@ Status IndexBuilder::_build(OperationContext* opCtx,
     if (allowBackgroundBuilding) {
         dbLock->relockWithMode(MODE_X);
     }
+    status = indexer.drainBackgroundWrites();
+    if (!status.isOK()) {
+        if (allowBackgroundBuilding && status != ErrorCodes::InterruptedAtShutdown) {
+            opCtx->checkForInterrupt();
+        }
+        return _failIndexBuild(indexer, status, allowBackgroundBuilding);
+    }
+
     writeConflictRetry(opCtx, "Commit index build", ns.ns(), [opCtx, coll, &indexer, &ns] {
         WriteUnitOfWork wunit(opCtx);
         indexer.commit([opCtx, coll, &ns](const BSONObj& indexSpec) {
@@ -41,6 +41,7 @@ const string IndexNames::GEO_HAYSTACK = "geoHaystack";
 const string IndexNames::GEO_2DSPHERE = "2dsphere";
 const string IndexNames::TEXT = "text";
 const string IndexNames::HASHED = "hashed";
+const string IndexNames::WILDCARD = "wildcard";
 const string IndexNames::BTREE = "";
 
 // static
@@ -49,10 +50,14 @@ string IndexNames::findPluginName(const BSONObj& keyPattern) {
 
     while (i.more()) {
         BSONElement e = i.next();
-        if (String != e.type()) {
-            continue;
+        if (String == e.type()) {
+            return e.String();
+        }
+
+        StringData fieldName = e.fieldNameStringData();
+        if (fieldName == "$**" || fieldName.endsWith(".$**")) {
+            return IndexNames::WILDCARD;
         }
-        return e.String();
     }
 
     return IndexNames::BTREE;
@@ -68,7 +73,7 @@ bool IndexNames::existedBefore24(const string& name) {
 bool IndexNames::isKnownName(const string& name) {
     return name == IndexNames::GEO_2D || name == IndexNames::GEO_2DSPHERE ||
         name == IndexNames::GEO_HAYSTACK || name == IndexNames::TEXT ||
-        name == IndexNames::HASHED || name == IndexNames::BTREE;
+        name == IndexNames::HASHED || name == IndexNames::WILDCARD || name == IndexNames::BTREE;
 }
 
 // static
@@ -83,6 +88,8 @@ IndexType IndexNames::nameToType(const string& accessMethod) {
         return INDEX_TEXT;
     } else if (IndexNames::HASHED == accessMethod) {
         return INDEX_HASHED;
+    } else if (IndexNames::WILDCARD == accessMethod) {
+        return INDEX_WILDCARD;
     } else {
         return INDEX_BTREE;
     }
@@ -54,6 +54,7 @@ enum IndexType {
     INDEX_2DSPHERE,
     INDEX_TEXT,
     INDEX_HASHED,
+    INDEX_WILDCARD,
 };
 
 /**
@@ -67,6 +68,7 @@ public:
     static const std::string GEO_2DSPHERE;
     static const std::string TEXT;
     static const std::string HASHED;
+    static const std::string WILDCARD;
     static const std::string BTREE;
 
     /**
@@ -78,7 +80,8 @@ public:
 
     /**
      * Return the first std::string value in the provided object.  For an index key pattern,
-     * a field with a non-string value indicates a "special" (not straight Btree) index.
+     * a field with a non-string value indicates a "special" (not straight Btree) index. A
+     * numeric field named "$**" or ending in ".$**" indicates a wildcard index.
      */
     static std::string findPluginName(const BSONObj& keyPattern);
 
@@ -51,6 +51,7 @@ constexpr StringData NamespaceString::kAdminDb;
 constexpr StringData NamespaceString::kLocalDb;
 constexpr StringData NamespaceString::kConfigDb;
 constexpr StringData NamespaceString::kSystemDotViewsCollectionName;
+constexpr StringData NamespaceString::kTimeseriesBucketsCollectionPrefix;
 constexpr StringData NamespaceString::kOrphanCollectionPrefix;
 constexpr StringData NamespaceString::kOrphanCollectionDb;
 
@@ -111,6 +112,8 @@ bool NamespaceString::isLegalClientSystemNS() const {
 
     if (coll() == kSystemDotViewsCollectionName)
         return true;
+    if (isTimeseriesBucketsCollection())
+        return true;
 
     return false;
 }
@@ -169,6 +172,20 @@ NamespaceString NamespaceString::makeDropPendingNamespace(const repl::OpTime& op
     return NamespaceString(ss.stringData().substr(0, MaxNsCollectionLen));
 }
 
+bool NamespaceString::isTimeseriesBucketsCollection() const {
+    return coll().startsWith(kTimeseriesBucketsCollectionPrefix) &&
+        coll().size() > kTimeseriesBucketsCollectionPrefix.size();
+}
+
+NamespaceString NamespaceString::makeTimeseriesBucketsNamespace() const {
+    return {db(), kTimeseriesBucketsCollectionPrefix.toString() + coll()};
+}
+
+NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
+    invariant(isTimeseriesBucketsCollection());
+    return {db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size())};
+}
+
 StatusWith<repl::OpTime> NamespaceString::getDropPendingNamespaceOpTime() const {
     if (!isDropPendingNamespace()) {
         return Status(ErrorCodes::BadValue,
@@ -62,6 +62,9 @@ public:
     // Name for the system views collection
     static constexpr StringData kSystemDotViewsCollectionName = "system.views"_sd;
 
+    // Prefix for the collections holding the buckets of time-series collections
+    static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
+
     // Prefix for orphan collections
     static constexpr StringData kOrphanCollectionPrefix = "orphan."_sd;
     static constexpr StringData kOrphanCollectionDb = "local"_sd;
@@ -334,6 +337,26 @@ public:
      */
     StatusWith<repl::OpTime> getDropPendingNamespaceOpTime() const;
 
+    /**
+     * Returns true if this namespace holds the bucket documents of a time-series collection.
+     */
+    bool isTimeseriesBucketsCollection() const;
+
+    /**
+     * Returns the namespace of the collection holding the buckets of the time-series collection
+     * exposed under this namespace.
+     *
+     * Example:
+     *     test.weather -> test.system.buckets.weather
+     */
+    NamespaceString makeTimeseriesBucketsNamespace() const;
+
+    /**
+     * Returns the namespace of the view through which the measurements stored in this buckets
+     * collection are read. Must only be called when isTimeseriesBucketsCollection() is true.
+     */
+    NamespaceString getTimeseriesViewNamespace() const;
+
     /**
      * Checks if this namespace is valid as a target namespace for a rename operation, given
      * the length of the longest index name in the source collection.
@@ -364,6 +364,19 @@ TEST(NamespaceStringTest, makeListIndexesNSIsCorrect) {
     ASSERT_EQUALS(NamespaceString("DB.COLL"), ns.getTargetNSForListIndexes());
 }
 
+TEST(NamespaceStringTest, TimeseriesBucketsNamespace) {
+    NamespaceString view("test.weather");
+    ASSERT_FALSE(view.isTimeseriesBucketsCollection());
+
+    NamespaceString buckets = view.makeTimeseriesBucketsNamespace();
+    ASSERT_EQUALS("test.system.buckets.weather", buckets.ns());
+    ASSERT_TRUE(buckets.isTimeseriesBucketsCollection());
+    ASSERT_TRUE(buckets.isLegalClientSystemNS());
+    ASSERT_EQUALS(view, buckets.getTimeseriesViewNamespace());
+
+    ASSERT_FALSE(NamespaceString("test.system.buckets.").isTimeseriesBucketsCollection());
+}
+
 TEST(NamespaceStringTest, EmptyNSStringReturnsEmptyColl) {
     NamespaceString nss{};
     ASSERT_TRUE(nss.isEmpty());
@@ -38,6 +38,7 @@
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog_entry.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -71,6 +72,9 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/server_write_concern_metrics.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+#include "mongo/db/views/view.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/cannot_implicitly_create_collection_info.h"
@@ -477,6 +481,161 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
     return true;
 }
 
+/**
+ * Returns the options of the time-series collection whose measurements are read through the view
+ * 'ns', or boost::none if 'ns' is not such a view. Inserts into the view are written to the buckets
+ * of the time-series collection instead.
+ */
+boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
+                                                         const NamespaceString& ns) {
+    AutoGetCollection autoColl(opCtx, ns, MODE_IS, AutoGetCollection::kViewsPermitted);
+    auto view = autoColl.getView();
+    if (!view || view->viewOn() != ns.makeTimeseriesBucketsNamespace()) {
+        return boost::none;
+    }
+
+    Lock::CollectionLock bucketsLock(opCtx->lockState(), view->viewOn().ns(), MODE_IS);
+    auto bucketsColl = autoColl.getDb()->getCollection(opCtx, view->viewOn());
+    if (!bucketsColl) {
+        return boost::none;
+    }
+
+    auto options = bucketsColl->getCatalogEntry()->getCollectionOptions(opCtx);
+    if (options.timeseries.isEmpty()) {
+        return boost::none;
+    }
+    return uassertStatusOK(TimeseriesOptions::parse(options.timeseries));
+}
+
+/**
+ * Writes 'update' to the bucket 'bucketId' of the time-series collection whose buckets are held in
+ * 'bucketsNs', creating the bucket if it does not exist yet.
+ */
+void upsertBucket(OperationContext* opCtx,
+                  const NamespaceString& bucketsNs,
+                  const OID& bucketId,
+                  const BSONObj& update) {
+    UpdateLifecycleImpl updateLifecycle(bucketsNs);
+    UpdateRequest request(bucketsNs);
+    request.setLifecycle(&updateLifecycle);
+    request.setQuery(BSON("_id" << bucketId));
+    request.setUpdates(update);
+    request.setUpsert(true);
+    request.setYieldPolicy(PlanExecutor::YIELD_AUTO);
+
+    ParsedUpdate parsedUpdate(opCtx, &request);
+    uassertStatusOK(parsedUpdate.parseRequest());
+
+    AutoGetCollection collection(opCtx, bucketsNs, MODE_IX);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Time-series buckets collection " << bucketsNs.ns()
+                          << " does not exist",
+            collection.getCollection());
+    assertCanWrite_inlock(opCtx, bucketsNs);
+
+    auto exec = uassertStatusOK(getExecutorUpdate(
+        opCtx, &CurOp::get(opCtx)->debug(), collection.getCollection(), &parsedUpdate));
+    uassertStatusOK(exec->executePlan());
+}
+
+/**
+ * Inserts the measurements of 'wholeOp' into the time-series collection described by 'options'.
+ * Each measurement is assigned a slot in an open bucket, after which each bucket receiving
+ * measurements is written with a single upsert. Since the buckets are written independently, an
+ * ordered insert which fails part way may have written measurements following the failed one.
+ */
+WriteResult performTimeseriesInserts(OperationContext* opCtx,
+                                     const write_ops::Insert& wholeOp,
+                                     const TimeseriesOptions& options) {
+    uassert(ErrorCodes::OperationNotSupportedInTransaction,
+            str::stream() << "Cannot insert into time-series collection "
+                          << wholeOp.getNamespace().ns()
+                          << " in a multi-document transaction or as a retryable write",
+            !opCtx->getTxnNumber());
+
+    auto& curOp = *CurOp::get(opCtx);
+    const auto bucketsNs = wholeOp.getNamespace().makeTimeseriesBucketsNamespace();
+    const auto& docs = wholeOp.getDocuments();
+    const bool ordered = wholeOp.getWriteCommandBase().getOrdered();
+
+    // Assign each measurement a slot, grouping the measurements by bucket in the order in which the
+    // buckets are first seen.
+    auto& bucketCatalog = BucketCatalog::get(opCtx);
+    std::vector<StatusWith<BucketCatalog::Placement>> placements;
+    placements.reserve(docs.size());
+    std::vector<OID> bucketIds;
+    std::map<OID, std::vector<std::pair<BSONObj, BucketCatalog::Placement>>> bucketMeasurements;
+    for (auto&& doc : docs) {
+        placements.push_back(bucketCatalog.insert(bucketsNs, options, doc));
+        if (!placements.back().isOK()) {
+            if (ordered) {
+                break;
+            }
+            continue;
+        }
+
+        const auto& placement = placements.back().getValue();
+        auto& measurements = bucketMeasurements[placement.bucketId];
+        if (measurements.empty()) {
+            bucketIds.push_back(placement.bucketId);
+        }
+        measurements.emplace_back(doc, placement);
+    }
+
+    LastOpFixer lastOpFixer(opCtx, bucketsNs);
+    std::map<OID, Status> bucketErrors;
+    for (auto&& bucketId : bucketIds) {
+        const auto& measurements = bucketMeasurements[bucketId];
+        const auto update = BucketCatalog::makeBucketUpdate(options, measurements);
+        try {
+            if (MONGO_FAIL_POINT(failAllInserts)) {
+                uasserted(ErrorCodes::InternalError, "failAllInserts failpoint active!");
+            }
+
+            lastOpFixer.startingOp();
+            try {
+                upsertBucket(opCtx, bucketsNs, bucketId, update);
+            } catch (const ExceptionFor<ErrorCodes::DuplicateKey>&) {
+                // A concurrent insert created the bucket first, so this time the upsert updates it.
+                upsertBucket(opCtx, bucketsNs, bucketId, update);
+            }
+            lastOpFixer.finishedOpSuccessfully();
+        } catch (const DBException& ex) {
+            if (ErrorCodes::isInterruption(ex.code())) {
+                throw;
+            }
+            bucketErrors.emplace(bucketId, ex.toStatus());
+        }
+    }
+
+    WriteResult out;
+    out.results.reserve(placements.size());
+    for (auto&& placement : placements) {
+        globalOpCounters.gotInsert();
+        ServerWriteConcernMetrics::get(opCtx)->recordWriteConcernForInsert(
+            opCtx->getWriteConcern());
+        try {
+            uassertStatusOK(placement.getStatus());
+            auto bucketError = bucketErrors.find(placement.getValue().bucketId);
+            if (bucketError != bucketErrors.end()) {
+                uassertStatusOK(bucketError->second);
+            }
+
+            SingleWriteResult result;
+            result.setN(1);
+            out.results.emplace_back(std::move(result));
+            curOp.debug().additiveMetrics.incrementNinserted(1);
+        } catch (const DBException& ex) {
+            const bool canContinue =
+                handleError(opCtx, ex, wholeOp.getNamespace(), wholeOp.getWriteCommandBase(), &out);
+            if (!canContinue)
+                break;
+        }
+    }
+
+    return out;
+}
+
 template <typename T>
 StmtId getStmtIdForWriteOp(OperationContext* opCtx, const T& wholeOp, size_t opIndex) {
     return opCtx->getTxnNumber() ? write_ops::getStmtIdForWriteAt(wholeOp, opIndex)
@@ -529,6 +688,12 @@ WriteResult performInserts(OperationContext* opCtx,
         return performCreateIndexes(opCtx, wholeOp);
     }
 
+    if (BucketCatalog::get(opCtx).mayBeTimeseriesCollection(wholeOp.getNamespace())) {
+        if (auto timeseriesOptions = getTimeseriesOptions(opCtx, wholeOp.getNamespace())) {
+            return performTimeseriesInserts(opCtx, wholeOp, *timeseriesOptions);
+        }
+    }
+
     DisableDocumentValidationIfTrue docValidationDisabler(
         opCtx, wholeOp.getWriteCommandBase().getBypassDocumentValidation());
     LastOpFixer lastOpFixer(opCtx, wholeOp.getNamespace());
@@ -0,0 +1,270 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/timeseries/bucket_format.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+
+namespace {
+
+/**
+ * Returns the index of a measurement in a bucket column from the name of its field.
+ */
+int parseMeasurementIndex(StringData fieldName) {
+    int index;
+    uassert(56857,
+            str::stream() << "Invalid measurement index in time-series bucket: '" << fieldName
+                          << "'",
+            parseNumberFromStringWithBase(fieldName, 10, &index).isOK() && index >= 0);
+    return index;
+}
+
+template <typename T>
+void sortByIndex(std::vector<std::pair<int, T>>* values) {
+    std::sort(values->begin(), values->end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+}
+
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << kStageName << " must take a nested object but found: " << elem,
+            elem.type() == BSONType::Object);
+
+    auto options = uassertStatusOKWithContext(TimeseriesOptions::parse(elem.embeddedObject()),
+                                              str::stream() << "Invalid " << kStageName);
+    return new DocumentSourceInternalUnpackBucket(expCtx, std::move(options));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, TimeseriesOptions options)
+    : DocumentSource(expCtx), _options(std::move(options)) {}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    while (_timesPos == _times.size()) {
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        loadBucket(nextResult.releaseDocument());
+    }
+
+    return unpackNextMeasurement();
+}
+
+void DocumentSourceInternalUnpackBucket::loadBucket(const Document& bucket) {
+    _times.clear();
+    _timesPos = 0;
+    _columns.clear();
+
+    auto id = bucket[timeseries::kBucketIdFieldName];
+    uassert(56858,
+            str::stream() << "Time-series bucket _id must be an ObjectId, found: " << id.toString(),
+            id.getType() == BSONType::jstOID);
+    const auto bucketStart = Date_t::fromMillisSinceEpoch(
+        static_cast<long long>(static_cast<uint32_t>(id.getOid().getTimestamp())) * 1000);
+
+    _meta = bucket[timeseries::kBucketMetaFieldName];
+
+    auto data = bucket[timeseries::kBucketDataFieldName];
+    uassert(56859,
+            str::stream() << "Time-series bucket " << id.toString()
+                          << " has no data document, found: "
+                          << data.toString(),
+            data.getType() == BSONType::Object);
+
+    FieldIterator columns(data.getDocument());
+    while (columns.more()) {
+        auto column = columns.next();
+        uassert(56860,
+                str::stream() << "Time-series bucket column '" << column.first
+                              << "' must be a document, found: "
+                              << column.second.toString(),
+                column.second.getType() == BSONType::Object);
+
+        FieldIterator values(column.second.getDocument());
+        if (column.first == _options.timeField) {
+            while (values.more()) {
+                auto value = values.next();
+                uassert(56861,
+                        str::stream() << "Time-series bucket time offsets must be integers, found: "
+                                      << value.second.toString(),
+                        value.second.integral64Bit());
+                _times.emplace_back(parseMeasurementIndex(value.first),
+                                    bucketStart + Milliseconds(value.second.coerceToLong()));
+            }
+            sortByIndex(&_times);
+        } else {
+            Column unpacked;
+            unpacked.fieldName = column.first.toString();
+            while (values.more()) {
+                auto value = values.next();
+                unpacked.values.emplace_back(parseMeasurementIndex(value.first), value.second);
+            }
+            sortByIndex(&unpacked.values);
+            _columns.push_back(std::move(unpacked));
+        }
+    }
+}
+
+Document DocumentSourceInternalUnpackBucket::unpackNextMeasurement() {
+    const auto& time = _times[_timesPos++];
+
+    MutableDocument measurement(_columns.size() + 2);
+    measurement.addField(_options.timeField, Value(time.second));
+    if (_options.metaField && !_meta.missing()) {
+        measurement.addField(*_options.metaField, _meta);
+    }
+
+    // Measurements are visited in index order, so each column only ever advances past the values
+    // of the measurements before this one.
+    for (auto&& column : _columns) {
+        while (column.pos < column.values.size() && column.values[column.pos].first < time.first) {
+            ++column.pos;
+        }
+        if (column.pos < column.values.size() && column.values[column.pos].first == time.first) {
+            measurement.addField(column.fieldName, column.values[column.pos].second);
+        }
+    }
+
+    return measurement.freeze();
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
+    const BSONObj& predicate) const {
+    const std::string controlPrefix = timeseries::kBucketControlFieldName + ".";
+    const std::string minTimeField =
+        controlPrefix + timeseries::kControlMinFieldName + "." + _options.timeField;
+    const std::string maxTimeField =
+        controlPrefix + timeseries::kControlMaxFieldName + "." + _options.timeField;
+
+    BSONArrayBuilder conjuncts;
+
+    // A bucket can only hold a measurement whose time is 't' if its range overlaps 't'.
+    auto addTimePredicate = [&](StringData op, const BSONElement& operand) {
+        if (operand.type() != BSONType::Date) {
+            return;
+        }
+        if (op == "$eq") {
+            conjuncts.append(BSON(minTimeField << BSON("$lte" << operand.date())));
+            conjuncts.append(BSON(maxTimeField << BSON("$gte" << operand.date())));
+        } else if (op == "$gt" || op == "$gte") {
+            conjuncts.append(BSON(maxTimeField << BSON(op << operand.date())));
+        } else if (op == "$lt" || op == "$lte") {
+            conjuncts.append(BSON(minTimeField << BSON(op << operand.date())));
+        }
+    };
+
+    std::function<void(const BSONObj&)> addPredicates = [&](const BSONObj& obj) {
+        for (auto&& elem : obj) {
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName == "$and" && elem.type() == BSONType::Array) {
+                for (auto&& child : elem.Obj()) {
+                    if (child.type() == BSONType::Object) {
+                        addPredicates(child.Obj());
+                    }
+                }
+            } else if (fieldName == _options.timeField) {
+                if (elem.type() == BSONType::Object &&
+                    StringData(elem.Obj().firstElementFieldName()).startsWith("$")) {
+                    for (auto&& op : elem.Obj()) {
+                        addTimePredicate(op.fieldNameStringData(), op);
+                    }
+                } else {
+                    addTimePredicate("$eq", elem);
+                }
+            } else if (_options.metaField &&
+                       (fieldName == *_options.metaField ||
+                        fieldName.startsWith(*_options.metaField + "."))) {
+                // The meta value of a measurement is the meta value of its bucket, so predicates on
+                // it apply unchanged to the bucket.
+                BSONObjBuilder metaPredicate(conjuncts.subobjStart());
+                metaPredicate.appendAs(elem,
+                                       timeseries::kBucketMetaFieldName.toString() +
+                                           fieldName.substr(_options.metaField->size()));
+            }
+        }
+    };
+    addPredicates(predicate);
+
+    auto conjunctsArray = conjuncts.arr();
+    if (conjunctsArray.isEmpty()) {
+        return BSONObj();
+    }
+    return BSON("$and" << conjunctsArray);
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch || nextMatch->isTextQuery() || _triedBucketLevelPushdown) {
+        return std::next(itr);
+    }
+    _triedBucketLevelPushdown = true;
+
+    auto bucketPredicate = createPredicatesOnBucketLevelField(nextMatch->getQuery());
+    if (bucketPredicate.isEmpty()) {
+        return std::next(itr);
+    }
+
+    // The original $match stays after this stage to filter the unpacked measurements. Return the
+    // new $match so that it can be optimized with the stages in front of it.
+    return container->insert(itr, DocumentSourceMatch::create(bucketPredicate, pExpCtx));
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(Document{{getSourceName(), Value(_options.toBSON())}});
+}
+
+}  // namespace mongo
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+
+namespace mongo {
+
+/**
+ * Unpacks the bucket documents of a time-series collection into the measurements they hold. The
+ * view through which a time-series collection is read consists of this stage, whose spec is the
+ * 'timeseries' options of the collection. See bucket_format.h for the layout of a bucket.
+ *
+ * A $match on the time or meta field which directly follows this stage is translated into a $match
+ * on the bounds of the buckets, which is placed in front of this stage so that it can make use of
+ * indexes and skip the buckets which cannot hold a matching measurement.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       TimeseriesOptions options);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed};
+    }
+
+    GetNextResult getNext() final;
+
+    /**
+     * Returns a predicate on the buckets which is satisfied by every bucket holding a measurement
+     * that matches 'predicate', or an empty object if no such predicate can be derived. Only the
+     * conjuncts of 'predicate' which compare the time field to a date, or test the meta field, are
+     * translated; the rest are left to be applied to the unpacked measurements.
+     */
+    BSONObj createPredicatesOnBucketLevelField(const BSONObj& predicate) const;
+
+private:
+    /**
+     * The values of one field of the measurements in a bucket, ordered by measurement index.
+     */
+    struct Column {
+        std::string fieldName;
+        std::vector<std::pair<int, Value>> values;
+        size_t pos = 0;
+    };
+
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    /**
+     * Resets the unpacking state to iterate over the measurements in 'bucket'.
+     */
+    void loadBucket(const Document& bucket);
+
+    /**
+     * Assembles the next measurement of the current bucket.
+     */
+    Document unpackNextMeasurement();
+
+    const TimeseriesOptions _options;
+
+    // Set once a $match following this stage has been translated, so that the translation is not
+    // repeated each time the pipeline optimizer revisits this stage.
+    bool _triedBucketLevelPushdown = false;
+
+    // The measurements of the current bucket: the time of each measurement ordered by index, and
+    // the other fields column by column.
+    std::vector<std::pair<int, Date_t>> _times;
+    size_t _timesPos = 0;
+    std::vector<Column> _columns;
+    Value _meta;
+};
+
+}  // namespace mongo
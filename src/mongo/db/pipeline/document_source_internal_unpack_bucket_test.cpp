@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class DocumentSourceInternalUnpackBucketTest : public AggregationContextFixture {
+protected:
+    boost::intrusive_ptr<DocumentSourceInternalUnpackBucket> createUnpack() {
+        auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageName << _options);
+        return static_cast<DocumentSourceInternalUnpackBucket*>(
+            DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(), getExpCtx())
+                .get());
+    }
+
+    static Date_t date(long long millis) {
+        return Date_t::fromMillisSinceEpoch(millis);
+    }
+
+    static OID bucketId(int startSeconds) {
+        OID id = OID::gen();
+        id.setTimestamp(startSeconds);
+        return id;
+    }
+
+    const BSONObj _options = BSON("timeField"
+                                  << "t"
+                                  << "metaField"
+                                  << "m"
+                                  << "bucketMaxSpanSeconds"
+                                  << 60);
+};
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, UnpacksMeasurementsInIndexOrder) {
+    auto unpack = createUnpack();
+    auto mock = DocumentSourceMock::create(
+        {Document(BSON("_id" << bucketId(1000) << "meta"
+                             << "a"
+                             << "data"
+                             << BSON("t" << BSON("1" << 250 << "0" << 500) << "v"
+                                         << BSON("0" << 10)
+                                         << "w"
+                                         << BSON("1"
+                                                 << "x")))),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document(BSON("_id" << bucketId(2000) << "data"
+                             << BSON("t" << BSON("0" << 0) << "v" << BSON("0" << 1))))});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(BSON("t" << date(1000500) << "m"
+                                         << "a"
+                                         << "v"
+                                         << 10)),
+                       next.releaseDocument());
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(BSON("t" << date(1000250) << "m"
+                                         << "a"
+                                         << "w"
+                                         << "x")),
+                       next.releaseDocument());
+
+    ASSERT_TRUE(unpack->getNext().isPaused());
+
+    // A bucket without a meta value unpacks into measurements without the meta field.
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(BSON("t" << date(2000000) << "v" << 1)), next.releaseDocument());
+
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, RejectsMalformedBuckets) {
+    auto unpack = createUnpack();
+    auto mock = DocumentSourceMock::create(
+        {Document(BSON("_id" << bucketId(1000) << "data" << BSON("t" << BSON("x" << 1))))});
+    unpack->setSource(mock.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 56857);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, RejectsInvalidSpecs) {
+    ASSERT_THROWS_CODE(DocumentSourceInternalUnpackBucket::createFromBson(
+                           BSON(DocumentSourceInternalUnpackBucket::kStageName << 1).firstElement(),
+                           getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::TypeMismatch);
+    ASSERT_THROWS_CODE(
+        DocumentSourceInternalUnpackBucket::createFromBson(
+            BSON(DocumentSourceInternalUnpackBucket::kStageName << BSONObj()).firstElement(),
+            getExpCtx()),
+        AssertionException,
+        ErrorCodes::InvalidOptions);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, SerializesToItsOptions) {
+    std::vector<Value> serialized;
+    createUnpack()->serializeToArray(serialized);
+    ASSERT_EQ(1U, serialized.size());
+    ASSERT_VALUE_EQ(Value(Document(BSON(DocumentSourceInternalUnpackBucket::kStageName
+                                        << _options))),
+                    serialized[0]);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, TranslatesTimeAndMetaPredicates) {
+    auto unpack = createUnpack();
+
+    ASSERT_BSONOBJ_EQ(
+        BSON("$and" << BSON_ARRAY(BSON("control.max.t" << BSON("$gte" << date(1000)))
+                                  << BSON("control.min.t" << BSON("$lt" << date(2000)))
+                                  << BSON("meta"
+                                          << "a")
+                                  << BSON("meta.x" << BSON("$gt" << 1)))),
+        unpack->createPredicatesOnBucketLevelField(BSON(
+            "t" << BSON("$gte" << date(1000) << "$lt" << date(2000)) << "m"
+                << "a"
+                << "m.x"
+                << BSON("$gt" << 1)
+                << "v"
+                << 5)));
+
+    ASSERT_BSONOBJ_EQ(
+        BSON("$and" << BSON_ARRAY(BSON("control.min.t" << BSON("$lte" << date(1000)))
+                                  << BSON("control.max.t" << BSON("$gte" << date(1000))))),
+        unpack->createPredicatesOnBucketLevelField(
+            BSON("$and" << BSON_ARRAY(BSON("t" << date(1000)) << BSON("v" << 1)))));
+
+    // Only comparisons of the time field to dates are translated.
+    ASSERT_BSONOBJ_EQ(BSONObj(),
+                      unpack->createPredicatesOnBucketLevelField(
+                          BSON("t" << BSON("$gt" << 5) << "v" << 1 << "mm" << 1)));
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, OptimizationPlacesBucketPredicateInFront) {
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {BSON(DocumentSourceInternalUnpackBucket::kStageName << _options),
+         BSON("$match" << BSON("m"
+                               << "a"))},
+        getExpCtx()));
+    pipeline->optimizePipeline();
+
+    auto& sources = pipeline->getSources();
+    ASSERT_EQ(3U, sources.size());
+    auto bucketMatch = dynamic_cast<DocumentSourceMatch*>(sources.front().get());
+    ASSERT(bucketMatch);
+    ASSERT_BSONOBJ_EQ(BSON("$and" << BSON_ARRAY(BSON("meta"
+                                                      << "a"))),
+                      bucketMatch->getQuery());
+    ASSERT(dynamic_cast<DocumentSourceInternalUnpackBucket*>(std::next(sources.begin())->get()));
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(sources.back().get()));
+
+    // Optimizing again does not translate the predicate a second time.
+    pipeline->optimizePipeline();
+    ASSERT_EQ(3U, pipeline->getSources().size());
+}
+
+}  // namespace
+}  // namespace mongo
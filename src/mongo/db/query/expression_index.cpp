@@ -53,6 +53,18 @@ BSONObj ExpressionMapping::hash(const BSONElement& value) {
     return bob.obj();
 }
 
+BSONObj ExpressionMapping::hash(const BSONElement& value, const BSONObj& indexInfoObj) {
+    // Planner tests may describe a hashed index without a full spec, so the seed and hash
+    // version are read directly rather than through ExpressionParams::parseHashParams().
+    BSONElement seedElt = indexInfoObj["seed"];
+    HashSeed seed = seedElt.eoo() ? BSONElementHasher::DEFAULT_HASH_SEED : seedElt.numberInt();
+    int hashVersion = indexInfoObj["hashVersion"].numberInt();
+
+    BSONObjBuilder bob;
+    bob.append("", BSONElementHasher::hash64(value, seed, hashVersion));
+    return bob.obj();
+}
+
 // For debugging only
 static std::string toCoveringString(const GeoHashConverter& hashConverter,
                                     const set<GeoHash>& covering) {
@@ -52,6 +52,12 @@ class ExpressionMapping {
 public:
     static BSONObj hash(const BSONElement& value);
 
+    /**
+     * Hashes 'value' with the seed and hash version recorded in the spec of the hashed index
+     * described by 'indexInfoObj'.
+     */
+    static BSONObj hash(const BSONElement& value, const BSONObj& indexInfoObj);
+
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
                                               int maxCoveringCells);
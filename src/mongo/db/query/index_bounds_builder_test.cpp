@@ -35,6 +35,7 @@
 #include <limits>
 #include <memory>
 
+#include "mongo/db/hasher.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
@@ -899,6 +900,31 @@ TEST(IndexBoundsBuilderTest, TranslateExprEqualHashedIndex) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
 }
 
+TEST(IndexBoundsBuilderTest, TranslateEqualHashedIndexUsesIndexSeedAndHashVersion) {
+    BSONObj keyPattern = fromjson("{a: 'hashed'}");
+    BSONObj infoObj = BSON("key" << keyPattern << "seed" << 5 << "hashVersion" << 1);
+    BSONElement elt = keyPattern.firstElement();
+    IndexEntry testIndex{keyPattern, false, false, false, "a_hashed", nullptr, infoObj};
+    BSONObj obj = BSON("a" << 4);
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+
+    long long expectedHash = BSONElementHasher::hash64(
+        BSON("" << 4).firstElement(), 5, BSONElementHasher::MURMUR3_HASH_VERSION);
+    ASSERT_NOT_EQUALS(expectedHash,
+                      ExpressionMapping::hash(BSON("" << 4).firstElement())
+                          .firstElement()
+                          .numberLong());
+
+    ASSERT_EQUALS(oil.intervals.size(), 1U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(
+                      Interval(BSON("" << expectedHash << "" << expectedHash), true, true)));
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
+}
+
 TEST(IndexBoundsBuilderTest, TranslateExprEqualToNullIsInexactFetch) {
     BSONObj keyPattern = BSON("a" << 1);
     BSONElement elt = keyPattern.firstElement();
@@ -43,10 +43,12 @@
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_text.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
@@ -144,6 +146,76 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+/**
+ * Returns true if a comparison of _id against 'elem' can bound a scan of a collection clustered by
+ * _id. Every _id which satisfies such a comparison sorts on the same side of 'elem' in the
+ * collection. This holds for comparisons with the simple collation, other than those against
+ * values which compare specially in queries.
+ */
+bool isClusteredIdBound(const BSONElement& elem) {
+    switch (elem.type()) {
+        case Array:
+        case Undefined:
+        case jstNULL:
+        case RegEx:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Extracts inclusive lower and upper bounds on the _id of a clustered collection from 'me'. This
+ * only examines comparisons of _id at the top level or inside a top-level $and. The bounds need
+ * not be tight, since the collection scan still applies the query's filter.
+ */
+std::pair<BSONElement, BSONElement> extractClusteredIdRange(const MatchExpression* me,
+                                                            bool topLevel = true) {
+    BSONElement min;
+    BSONElement max;
+
+    if (me->matchType() == MatchExpression::AND && topLevel) {
+        for (size_t i = 0; i < me->numChildren(); ++i) {
+            BSONElement childMin;
+            BSONElement childMax;
+            std::tie(childMin, childMax) = extractClusteredIdRange(me->getChild(i), false);
+            if (!childMin.eoo() && (min.eoo() || childMin.woCompare(min, false) > 0)) {
+                min = childMin;
+            }
+            if (!childMax.eoo() && (max.eoo() || childMax.woCompare(max, false) < 0)) {
+                max = childMax;
+            }
+        }
+        return {min, max};
+    }
+
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(me) || me->path() != "_id") {
+        return {min, max};
+    }
+
+    const BSONElement rawElem = static_cast<const ComparisonMatchExpression*>(me)->getData();
+    if (!isClusteredIdBound(rawElem)) {
+        return {min, max};
+    }
+
+    switch (me->matchType()) {
+        case MatchExpression::EQ:
+            return {rawElem, rawElem};
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return {rawElem, max};
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+            return {min, rawElem};
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+}  // namespace
+
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
     const CanonicalQuery& query, bool tailable, const QueryPlannerParams& params) {
     // Make the (only) node, a collection scan.
@@ -159,6 +231,21 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
     csn->shouldWaitForOplogVisibility =
         params.options & QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
 
+    // A clustered collection is stored in order of a prefix of each _id, so that predicates on _id
+    // can bound the scan. Its keys compare with the simple collation, so queries with a collation
+    // are not bounded.
+    if ((params.options & QueryPlannerParams::CLUSTERED_COLLECTION) && !query.getCollator()) {
+        BSONElement minId;
+        BSONElement maxId;
+        std::tie(minId, maxId) = extractClusteredIdRange(query.root());
+        if (!minId.eoo()) {
+            csn->minId = minId.wrap("");
+        }
+        if (!maxId.eoo()) {
+            csn->maxId = maxId.wrap("");
+        }
+    }
+
     // If the hint is {$natural: +-1} this changes the direction of the collection scan.
     if (!query.getQueryRequest().getHint().isEmpty()) {
         BSONElement natural =
@@ -611,40 +698,44 @@ void QueryPlannerAccess::finishLeafNode(QuerySolutionNode* node, const IndexEntr
         }
     }
 
-    // All fields are filled out with bounds, nothing to do.
-    if (firstEmptyField == bounds->fields.size()) {
-        IndexBoundsBuilder::alignBounds(bounds, index.keyPattern);
-        return;
-    }
-
-    // Skip ahead to the firstEmptyField-th element, where we begin filling in bounds.
-    BSONObjIterator it(index.keyPattern);
-    for (size_t i = 0; i < firstEmptyField; ++i) {
-        verify(it.more());
-        it.next();
-    }
+    // If all fields are filled out with bounds, there is nothing to fill in.
+    if (firstEmptyField < bounds->fields.size()) {
+        // Skip ahead to the firstEmptyField-th element, where we begin filling in bounds.
+        BSONObjIterator it(index.keyPattern);
+        for (size_t i = 0; i < firstEmptyField; ++i) {
+            verify(it.more());
+            it.next();
+        }
 
-    // For each field in the key...
-    while (it.more()) {
-        BSONElement kpElt = it.next();
-        // There may be filled-in fields to the right of the firstEmptyField.
-        // Example:
-        // The index {loc:"2dsphere", x:1}
-        // With a predicate over x and a near search over loc.
-        if ("" == bounds->fields[firstEmptyField].name) {
-            verify(bounds->fields[firstEmptyField].intervals.empty());
-            // ...build the "all values" interval.
-            IndexBoundsBuilder::allValuesForField(kpElt, &bounds->fields[firstEmptyField]);
+        // For each field in the key...
+        while (it.more()) {
+            BSONElement kpElt = it.next();
+            // There may be filled-in fields to the right of the firstEmptyField.
+            // Example:
+            // The index {loc:"2dsphere", x:1}
+            // With a predicate over x and a near search over loc.
+            if ("" == bounds->fields[firstEmptyField].name) {
+                verify(bounds->fields[firstEmptyField].intervals.empty());
+                // ...build the "all values" interval.
+                IndexBoundsBuilder::allValuesForField(kpElt, &bounds->fields[firstEmptyField]);
+            }
+            ++firstEmptyField;
         }
-        ++firstEmptyField;
-    }
 
-    // Make sure that the length of the key is the length of the bounds we started.
-    verify(firstEmptyField == bounds->fields.size());
+        // Make sure that the length of the key is the length of the bounds we started.
+        verify(firstEmptyField == bounds->fields.size());
+    }
 
     // We create bounds assuming a forward direction but can easily reverse bounds to align
     // according to our desired direction.
     IndexBoundsBuilder::alignBounds(bounds, index.keyPattern);
+
+    // Scans over a wildcard index were planned against a single path; restate them in terms of
+    // the {$_path, value} keys the index holds.
+    if (STAGE_IXSCAN == type && INDEX_WILDCARD == index.type) {
+        wildcard_planning::finalizeWildcardIndexScanConfiguration(
+            static_cast<IndexScanNode*>(node));
+    }
 }
 
 void QueryPlannerAccess::findElemMatchChildren(const MatchExpression* node,
@@ -46,6 +46,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/util/log.h"
 
@@ -195,6 +196,13 @@ void QueryPlannerIXSelect::findRelevantIndices(const stdx::unordered_set<string>
                                                const vector<IndexEntry>& allIndices,
                                                vector<IndexEntry>* out) {
     for (size_t i = 0; i < allIndices.size(); ++i) {
+        // A wildcard index is relevant to every queried path beneath its prefix. It is expanded
+        // into one entry per such path.
+        if (INDEX_WILDCARD == allIndices[i].type) {
+            wildcard_planning::expandWildcardIndexEntry(allIndices[i], fields, out);
+            continue;
+        }
+
         BSONObjIterator it(allIndices[i].keyPattern);
         verify(it.more());
         BSONElement elt = it.next();
@@ -242,6 +250,10 @@ bool QueryPlannerIXSelect::compatible(const BSONElement& elt,
     }
 
     if (indexedFieldType.empty()) {
+        if (INDEX_WILDCARD == index.type && !wildcard_planning::canAnswerPredicate(node)) {
+            return false;
+        }
+
         // Can't use a sparse index for $eq with a null element, unless the equality is within a
         // $elemMatch expression since the latter implies a match on the literal element 'null'.
         //
@@ -57,7 +57,8 @@ public:
 
     /**
      * Find all indices prefixed by fields we have predicates over.  Only these indices are
-     * useful in answering the query.
+     * useful in answering the query. Wildcard indices are expanded into one entry for each
+     * such field which they index.
      */
     static void findRelevantIndices(const stdx::unordered_set<std::string>& fields,
                                     const std::vector<IndexEntry>& indices,
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/planner_wildcard_helpers.h"
+
+#include <algorithm>
+
+#include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace wildcard_planning {
+
+namespace {
+
+/**
+ * Returns the path prefix indexed by the wildcard key pattern 'keyPattern', e.g. "a.b" for
+ * {"a.b.$**": 1} and the empty string for {"$**": 1}.
+ */
+StringData getWildcardPrefix(const BSONObj& keyPattern) {
+    StringData fieldName = keyPattern.firstElementFieldName();
+    invariant(fieldName.endsWith("$**"));
+    const size_t prefixLength = fieldName.size() - 3;
+    return fieldName.substr(0, prefixLength == 0 ? 0 : prefixLength - 1);
+}
+
+bool isIndexedPath(StringData prefix, StringData path) {
+    if (prefix.empty()) {
+        // The _id field is not indexed by {"$**": 1}.
+        return path != "_id" && !path.startsWith("_id.");
+    }
+    return path == prefix || (path.startsWith(prefix) && path[prefix.size()] == '.');
+}
+
+bool hasNumericComponent(StringData path) {
+    FieldRef pathRef(path);
+    for (size_t i = 0; i < pathRef.numParts(); ++i) {
+        const StringData part = pathRef.getPart(i);
+        if (!part.empty() &&
+            std::all_of(part.begin(), part.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Null and undefined values are only matched by documents which may be missing the path, and
+ * objects and arrays are not stored as values in a wildcard index, so comparisons against them
+ * cannot be answered from one. MinKey and MaxKey produce bounds which would span such values.
+ */
+bool isIndexableValue(const BSONElement& elt) {
+    switch (elt.type()) {
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::Object:
+        case BSONType::Array:
+        case BSONType::MinKey:
+        case BSONType::MaxKey:
+            return false;
+        default:
+            return true;
+    }
+}
+
+}  // namespace
+
+void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
+                              const stdx::unordered_set<std::string>& fields,
+                              std::vector<IndexEntry>* out) {
+    invariant(wildcardIndex.type == INDEX_WILDCARD);
+    const StringData prefix = getWildcardPrefix(wildcardIndex.keyPattern);
+
+    // Sort the expanded entries so that the relevant index list is deterministic.
+    std::vector<std::string> paths;
+    for (auto&& field : fields) {
+        if (isIndexedPath(prefix, field) && !hasNumericComponent(field)) {
+            paths.push_back(field);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    for (auto&& path : paths) {
+        IndexEntry entry(wildcardIndex);
+        entry.keyPattern = BSON(path << 1);
+        entry.multikey = true;
+        entry.multikeyPaths.clear();
+        out->push_back(std::move(entry));
+    }
+}
+
+bool canAnswerPredicate(const MatchExpression* node) {
+    switch (node->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return isIndexableValue(
+                static_cast<const ComparisonMatchExpressionBase*>(node)->getData());
+        case MatchExpression::MATCH_IN: {
+            const auto& equalities = static_cast<const InMatchExpression*>(node)->getEqualities();
+            return std::all_of(equalities.begin(), equalities.end(), isIndexableValue);
+        }
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::ELEM_MATCH_VALUE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void finalizeWildcardIndexScanConfiguration(IndexScanNode* scan) {
+    IndexEntry* index = &scan->index;
+    IndexBounds* bounds = &scan->bounds;
+    invariant(index->type == INDEX_WILDCARD);
+    invariant(index->keyPattern.nFields() == 1);
+    invariant(bounds->fields.size() == 1);
+
+    const std::string path = index->keyPattern.firstElementFieldName();
+    index->keyPattern = BSON(kPathFieldName << 1 << path << 1);
+
+    OrderedIntervalList pathBounds(kPathFieldName.toString());
+    pathBounds.intervals.push_back(IndexBoundsBuilder::makePointInterval(path));
+    bounds->fields.insert(bounds->fields.begin(), std::move(pathBounds));
+}
+
+}  // namespace wildcard_planning
+}  // namespace mongo
@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/stdx/unordered_set.h"
+
+namespace mongo {
+
+class MatchExpression;
+class IndexScanNode;
+
+namespace wildcard_planning {
+
+/**
+ * The name given to the first field of a wildcard index scan's key pattern, which holds the path
+ * of each indexed value.
+ */
+constexpr StringData kPathFieldName = "$_path"_sd;
+
+/**
+ * Appends to 'out' one IndexEntry for each path in 'fields' which the wildcard index
+ * 'wildcardIndex' holds keys for. Each expanded entry has the key pattern {<path>: 1} and is
+ * always multikey, so that the rest of the planner can treat it as a regular single-field index
+ * over that path. Paths with numeric components are never expanded, since the index does not
+ * record array positions.
+ */
+void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
+                              const stdx::unordered_set<std::string>& fields,
+                              std::vector<IndexEntry>* out);
+
+/**
+ * Returns true if the predicate 'node', over a path indexed by a wildcard index, can be answered
+ * using that index. Wildcard indexes only hold keys for the values found in documents, so
+ * predicates which can match null, missing values or whole objects and arrays cannot use them.
+ */
+bool canAnswerPredicate(const MatchExpression* node);
+
+/**
+ * Rewrites the key pattern and bounds of 'scan', which were planned against an expanded wildcard
+ * index entry, to describe the {$_path: 1, <path>: 1} keys actually stored in the index.
+ */
+void finalizeWildcardIndexScanConfiguration(IndexScanNode* scan);
+
+}  // namespace wildcard_planning
+}  // namespace mongo
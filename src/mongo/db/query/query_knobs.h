@@ -137,6 +137,13 @@ extern AtomicInt32 internalQueryExecYieldPeriodMS;
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
+// Multi-updates and multi-deletes write up to this many documents within a single
+// WriteUnitOfWork. A value of 1 writes each document in its own WriteUnitOfWork.
+extern AtomicInt32 internalQueryExecWriteBatchMaxDocs;
+
+// Stop adding documents to a multi-update or multi-delete batch once it holds this many bytes.
+extern AtomicInt32 internalQueryExecWriteBatchMaxBytes;
+
 // The number of bytes to buffer at once during a $facet stage.
 extern AtomicInt32 internalQueryFacetBufferSizeBytes;
 
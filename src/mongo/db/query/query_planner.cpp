@@ -52,6 +52,7 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/util/log.h"
@@ -329,6 +330,12 @@ StatusWith<std::unique_ptr<PlanCacheIndexTree>> QueryPlanner::cacheDataFromTagge
             return Status(ErrorCodes::BadValue, "can't cache '2d' index");
         }
 
+        // Wildcard index entries are expanded per query, so they cannot be matched back up with
+        // the catalog's index entries when a cached plan is replanned.
+        if (INDEX_WILDCARD == relevantIndices[itag->index].type) {
+            return Status(ErrorCodes::BadValue, "can't cache 'wildcard' index");
+        }
+
         IndexEntry* ientry = new IndexEntry(relevantIndices[itag->index]);
         indexTree->entry.reset(ientry);
         indexTree->index_pos = itag->pos;
@@ -344,6 +351,10 @@ StatusWith<std::unique_ptr<PlanCacheIndexTree>> QueryPlanner::cacheDataFromTagge
                 return Status(ErrorCodes::BadValue, "can't cache '2d' index");
             }
 
+            if (INDEX_WILDCARD == relevantIndices[itag->index].type) {
+                return Status(ErrorCodes::BadValue, "can't cache 'wildcard' index");
+            }
+
             std::unique_ptr<IndexEntry> indexEntry =
                 stdx::make_unique<IndexEntry>(relevantIndices[itag->index]);
             indexTree->entry.reset(indexEntry.release());
@@ -648,6 +659,13 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         if (!hintIndexNumber) {
             return Status(ErrorCodes::BadValue, "bad hint");
         }
+
+        // A hinted wildcard index can only be used through the paths it indexes.
+        if (INDEX_WILDCARD == params.indices[*hintIndexNumber].type) {
+            relevantIndices.clear();
+            wildcard_planning::expandWildcardIndexEntry(
+                params.indices[*hintIndexNumber], fields, &relevantIndices);
+        }
     }
 
     // Deal with the .min() and .max() query options.  If either exist we can only use an index
@@ -672,6 +690,11 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
             invariant(hintIndexNumber);
             const auto& hintedIndexEntry = params.indices[*hintIndexNumber];
 
+            if (INDEX_WILDCARD == hintedIndexEntry.type) {
+                return Status(ErrorCodes::BadValue,
+                              "min/max queries cannot use a hinted wildcard index");
+            }
+
             if (!minObj.isEmpty() &&
                 !indexCompatibleMaxMin(minObj, query.getCollator(), hintedIndexEntry)) {
                 LOG(5) << "Minobj doesn't work with hint";
@@ -700,6 +723,9 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
             // ordering thereof).
             for (size_t i = 0; i < params.indices.size(); ++i) {
                 const auto& indexEntry = params.indices[i];
+                if (INDEX_WILDCARD == indexEntry.type) {
+                    continue;
+                }
 
                 BSONObj toUse = minObj.isEmpty() ? maxObj : minObj;
                 if (indexCompatibleMaxMin(toUse, query.getCollator(), indexEntry)) {
@@ -901,6 +927,13 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     // desired behavior when an index is hinted that is not relevant to the query.
     if (!hintIndex.isEmpty()) {
         if (0 == out.size()) {
+            // The keys of a wildcard index are only meaningful alongside a predicate over one of
+            // the paths it indexes, so it cannot be scanned in its entirety.
+            if (INDEX_WILDCARD == params.indices[*hintIndexNumber].type) {
+                return Status(ErrorCodes::BadValue,
+                              "hinted wildcard index cannot answer any predicate in the query");
+            }
+
             // Push hinted index solution to output list if found. It is possible to end up without
             // a solution in the case where a filtering QueryPlannerParams argument, such as
             // NO_BLOCKING_SORT, leads to its exclusion.
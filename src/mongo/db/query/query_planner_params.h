@@ -123,6 +123,10 @@ struct QueryPlannerParams {
         // is thought to be helpful in general, but particularly in cases where all children of the
         // $or use the same fields and have the same indexes available, as in this example.
         ENUMERATE_OR_CHILDREN_LOCKSTEP = 1 << 15,
+
+        // Set this if the collection is clustered by _id, so that collection scans can be bounded
+        // by the query's predicates on _id.
+        CLUSTERED_COLLECTION = 1 << 16,
     };
 
     // See Options enum above.
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+TEST_F(QueryPlannerTest, WildcardIndexAnswersEqualityOnAnyPath) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{'a.b': 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {'$_path': 1, 'a.b': 1}, "
+        "bounds: {'$_path': [['a.b', 'a.b', true, true]], 'a.b': [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexAnswersRangeWithResidualFilter) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'a.$**': 1}"));
+
+    runQuery(fromjson("{'a.b': {$gt: 3}, c: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {c: 1}, node: {ixscan: {pattern: {'$_path': 1, 'a.b': 1}, "
+        "bounds: {'$_path': [['a.b', 'a.b', true, true]], "
+        "'a.b': [[3, Infinity, false, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexIsExpandedForEachQueriedPath) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{a: 1, b: 2}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 2}, node: {ixscan: {pattern: {'$_path': 1, a: 1}, "
+        "bounds: {'$_path': [['a', 'a', true, true]], a: [[1, 1, true, true]]}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: 1}, node: {ixscan: {pattern: {'$_path': 1, b: 1}, "
+        "bounds: {'$_path': [['b', 'b', true, true]], b: [[2, 2, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexUsedForElemMatchObjectPath) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{a: {$elemMatch: {b: 1}}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {'$_path': 1, 'a.b': 1}, "
+        "bounds: {'$_path': [['a.b', 'a.b', true, true]], 'a.b': [[1, 1, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexNotUsedForPathsOutsidePrefix) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'a.$**': 1}"));
+
+    runQuery(fromjson("{ab: 1}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{b: 1}"));
+    assertNumSolutions(0U);
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexOverAllPathsDoesNotIndexId) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{_id: 1}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{'_id.a': 1}"));
+    assertNumSolutions(0U);
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexNotUsedForPositionalPaths) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{'a.0': 1}"));
+    assertNumSolutions(0U);
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexNotUsedForPredicatesMatchingMissingOrObjects) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuery(fromjson("{a: null}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{a: {$in: [1, null]}}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{a: {$exists: true}}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{a: {$ne: 1}}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{a: {b: 1}}"));
+    assertNumSolutions(0U);
+
+    runQuery(fromjson("{a: [1, 2]}"));
+    assertNumSolutions(0U);
+}
+
+TEST_F(QueryPlannerTest, WildcardIndexCannotProvideSortOrCoverProjection) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQuerySortProj(fromjson("{a: {$gt: 1}}"), fromjson("{a: 1}"), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sort: {pattern: {a: 1}, limit: 0, node: "
+        "{sortKeyGen: {node: {fetch: {filter: null, node: {ixscan: "
+        "{pattern: {'$_path': 1, a: 1}}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, HintedWildcardIndexIsExpanded) {
+    addIndex(fromjson("{'$**': 1}"));
+
+    runQueryHint(fromjson("{a: 1}"), fromjson("{'$**': 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {'$_path': 1, a: 1}, "
+        "bounds: {'$_path': [['a', 'a', true, true]], a: [[1, 1, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, HintedWildcardIndexWithoutIndexedPredicateFails) {
+    addIndex(fromjson("{'$**': 1}"));
+
+    runInvalidQueryHint(fromjson("{}"), fromjson("{'$**': 1}"));
+    runInvalidQueryHint(fromjson("{a: {$exists: false}}"), fromjson("{'$**': 1}"));
+}
+
+}  // namespace
+}  // namespace mongo
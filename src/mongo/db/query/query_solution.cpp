@@ -233,6 +233,14 @@ void CollectionScanNode::appendToString(mongoutils::str::stream* ss, int indent)
     *ss << "COLLSCAN\n";
     addIndent(ss, indent + 1);
     *ss << "ns = " << name << '\n';
+    if (!minId.isEmpty()) {
+        addIndent(ss, indent + 1);
+        *ss << "minId = " << minId.firstElement().toString(false) << '\n';
+    }
+    if (!maxId.isEmpty()) {
+        addIndent(ss, indent + 1);
+        *ss << "maxId = " << maxId.firstElement().toString(false) << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->toString();
@@ -252,6 +260,8 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->assertMinTsHasNotFallenOffOplog = this->assertMinTsHasNotFallenOffOplog;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->minId = this->minId;
+    copy->maxId = this->maxId;
 
     return copy;
 }
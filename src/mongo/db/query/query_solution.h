@@ -329,6 +329,11 @@ struct CollectionScanNode : public QuerySolutionNode {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // Inclusive bounds on the _id of the records to scan in a collection clustered by _id, each
+    // held as the only element of an object. Empty if unbounded.
+    BSONObj minId;
+    BSONObj maxId;
 };
 
 struct AndHashNode : public QuerySolutionNode {
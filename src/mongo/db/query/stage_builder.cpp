@@ -86,6 +86,8 @@ PlanStage* buildStages(OperationContext* opCtx,
                                                      : CollectionScanParams::BACKWARD;
             params.maxScan = csn->maxScan;
             params.shouldWaitForOplogVisibility = csn->shouldWaitForOplogVisibility;
+            params.minId = csn->minId;
+            params.maxId = csn->maxId;
             return new CollectionScan(opCtx, params, ws, csn->filter.get());
         }
         case STAGE_IXSCAN: {
@@ -107,6 +109,9 @@ PlanStage* buildStages(OperationContext* opCtx,
                                     << ", IndexEntry: "
                                     << ixn->index.toString());
 
+            if (ixn->index.type == INDEX_WILDCARD) {
+                params.keyPattern = ixn->index.keyPattern;
+            }
             params.bounds = ixn->bounds;
             params.direction = ixn->direction;
             params.maxScan = ixn->maxScan;
@@ -644,7 +644,7 @@ void checkForIdIndexesAndDropPendingCollections(OperationContext* opCtx, Databas
         if (!coll)
             continue;
 
-        if (coll->getIndexCatalog()->findIdIndex(opCtx))
+        if (coll->getIndexCatalog()->findIdIndex(opCtx) || coll->isClustered())
             continue;
 
         log() << "WARNING: the collection '" << collectionName << "' lacks a unique index on _id."
@@ -335,10 +335,15 @@ void AbstractOplogFetcher::_finishCallback(Status status) {
     std::swap(_onShutdownCallbackFn, onShutdownCallbackFn);
 }
 
+BSONObj AbstractOplogFetcher::_makeReadAheadGetMoreCommandObject(
+    const Fetcher::QueryResponse& queryResponse) const {
+    return BSONObj();
+}
+
 std::unique_ptr<Fetcher> AbstractOplogFetcher::_makeFetcher(const BSONObj& findCommandObj,
                                                             const BSONObj& metadataObj,
                                                             Milliseconds findMaxTime) {
-    return stdx::make_unique<Fetcher>(
+    auto fetcher = stdx::make_unique<Fetcher>(
         _getExecutor(),
         _source,
         _nss.db().toString(),
@@ -349,6 +354,10 @@ std::unique_ptr<Fetcher> AbstractOplogFetcher::_makeFetcher(const BSONObj& findC
         metadataObj,
         findMaxTime + kNetworkTimeoutBufferMS,
         _getGetMoreMaxTime() + kNetworkTimeoutBufferMS);
+    fetcher->setReadAheadFn([this](const Fetcher::QueryResponse& queryResponse) {
+        return _makeReadAheadGetMoreCommandObject(queryResponse);
+    });
+    return fetcher;
 }
 
 }  // namespace repl
@@ -184,6 +184,17 @@ private:
      */
     virtual StatusWith<BSONObj> _onSuccessfulBatch(const Fetcher::QueryResponse& queryResponse) = 0;
 
+    /**
+     * Function called by the abstract oplog fetcher when it gets a successful batch from the sync
+     * source, before the batch is passed to _onSuccessfulBatch().
+     *
+     * Returns the `getMore` command to send to the sync source while the batch is processed, or
+     * an empty object to only send the `getMore` returned by _onSuccessfulBatch(). The default
+     * implementation does not read ahead.
+     */
+    virtual BSONObj _makeReadAheadGetMoreCommandObject(
+        const Fetcher::QueryResponse& queryResponse) const;
+
     /**
      * This function creates a Fetcher with the given `find` command and metadata.
      */
@@ -55,6 +55,38 @@ const auto kInsertGroupMaxBatchSize = insertVectorMaxBytes;
 // Limit number of ops in a single group.
 constexpr auto kInsertGroupMaxBatchCount = 64;
 
+// Grouped updates and deletes are bounded like grouped inserts.
+const auto kUpdateDeleteGroupMaxBatchSize = insertVectorMaxBytes;
+constexpr auto kUpdateDeleteGroupMaxBatchCount = 64;
+
+/**
+ * Populates the "ts" and "t" fields of a grouped operation with arrays of the timestamps and terms
+ * of the operations in [begin, end).
+ */
+void appendGroupedOpTimes(BSONObjBuilder* groupedOpBuilder,
+                          ApplierHelpers::OperationPtrs::const_iterator begin,
+                          ApplierHelpers::OperationPtrs::const_iterator end) {
+    {
+        BSONArrayBuilder tsArrayBuilder(groupedOpBuilder->subarrayStart("ts"));
+        for (auto groupingIt = begin; groupingIt != end; ++groupingIt) {
+            tsArrayBuilder.append((*groupingIt)->getTimestamp());
+        }
+    }
+
+    {
+        BSONArrayBuilder tArrayBuilder(groupedOpBuilder->subarrayStart("t"));
+        for (auto groupingIt = begin; groupingIt != end; ++groupingIt) {
+            auto parsedTerm = (*groupingIt)->getTerm();
+            long long term = OpTime::kUninitializedTerm;
+            // Term may not be present (pv0)
+            if (parsedTerm) {
+                term = parsedTerm.get();
+            }
+            tArrayBuilder.append(term);
+        }
+    }
+}
+
 }  // namespace
 
 // static
@@ -152,27 +184,9 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
     //   op: "i" }
     BSONObjBuilder groupedInsertBuilder;
 
-    // Populate the "ts" field with an array of all the grouped inserts' timestamps.
-    {
-        BSONArrayBuilder tsArrayBuilder(groupedInsertBuilder.subarrayStart("ts"));
-        for (auto groupingIt = it; groupingIt != endOfGroupableOpsIterator; ++groupingIt) {
-            tsArrayBuilder.append((*groupingIt)->getTimestamp());
-        }
-    }
-
-    // Populate the "t" (term) field with an array of all the grouped inserts' terms.
-    {
-        BSONArrayBuilder tArrayBuilder(groupedInsertBuilder.subarrayStart("t"));
-        for (auto groupingIt = it; groupingIt != endOfGroupableOpsIterator; ++groupingIt) {
-            auto parsedTerm = (*groupingIt)->getTerm();
-            long long term = OpTime::kUninitializedTerm;
-            // Term may not be present (pv0)
-            if (parsedTerm) {
-                term = parsedTerm.get();
-            }
-            tArrayBuilder.append(term);
-        }
-    }
+    // Populate the "ts" and "t" (term) fields with arrays of all the grouped inserts' timestamps
+    // and terms.
+    appendGroupedOpTimes(&groupedInsertBuilder, it, endOfGroupableOpsIterator);
 
     // Populate the "o" field with an array of all the grouped inserts.
     {
@@ -214,5 +228,120 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
     MONGO_UNREACHABLE;
 }
 
+using UpdateDeleteGroup = ApplierHelpers::UpdateDeleteGroup;
+
+UpdateDeleteGroup::UpdateDeleteGroup(ApplierHelpers::OperationPtrs* ops,
+                                     OperationContext* opCtx,
+                                     UpdateDeleteGroup::Mode mode)
+    : _doNotGroupBeforePoint(ops->cbegin()), _end(ops->cend()), _opCtx(opCtx), _mode(mode) {}
+
+StatusWith<UpdateDeleteGroup::ConstIterator> UpdateDeleteGroup::groupAndApplyUpdatesAndDeletes(
+    ConstIterator it, const bool isDataConsistent) {
+    const auto& entry = **it;
+    const auto opType = entry.getOpType();
+
+    // The following conditions must be met before attempting to group the oplog entries starting
+    // at 'oplogEntriesIterator':
+    // 1) The CRUD operation must be an update or a delete;
+    // 2) The operation must not save a pre- or post-image, which is written separately;
+    // 3) We have not attempted to group this operation during a previous call to this function.
+    if (opType != OpTypeEnum::kUpdate && opType != OpTypeEnum::kDelete) {
+        return Status(ErrorCodes::TypeMismatch, "Can only group update and delete operations.");
+    }
+    if (entry.getNeedsRetryImage()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "Cannot group operations which save a pre- or post-image.");
+    }
+    if (it <= _doNotGroupBeforePoint) {
+        return Status(ErrorCodes::InvalidPath,
+                      "Cannot group an operation that we previously attempted to group.");
+    }
+
+    auto opSize = [](const OplogEntry& op) {
+        return op.getObject().objsize() + (op.getObject2() ? op.getObject2()->objsize() : 0);
+    };
+
+    // Make sure to include the first op in the batch size.
+    auto batchSize = opSize(entry);
+    auto batchCount = OperationPtrs::size_type(1);
+    auto batchNamespace = entry.getNamespace();
+    auto batchUpsert = entry.getUpsert().value_or(false);
+
+    // Find the first op which can't be added to the group, as for grouped inserts. Updates must
+    // also agree on whether they are upserts, since the grouped operation has a single "b" field.
+    auto endOfGroupableOpsIterator =
+        std::find_if(it + 1, _end, [&](const OplogEntry* nextEntry) -> bool {
+            batchSize += opSize(*nextEntry);
+            batchCount += 1;
+
+            return nextEntry->getOpType() != opType                       // Must be the same type.
+                || nextEntry->getNamespace() != batchNamespace            // Must be in the same ns.
+                || nextEntry->getNeedsRetryImage()                        // Must not save an image.
+                || nextEntry->getUpsert().value_or(false) != batchUpsert  // Must agree on upsert.
+                || batchSize > kUpdateDeleteGroupMaxBatchSize     // Must not be too large.
+                || batchCount > kUpdateDeleteGroupMaxBatchCount;  // Limit number of ops.
+        });
+
+    // See if we were able to create a group that contains more than a single op.
+    if (std::distance(it, endOfGroupableOpsIterator) == 1) {
+        return Status(ErrorCodes::NoSuchKey,
+                      "Not able to create a group with more than a single operation");
+    }
+
+    // Group the ops into a single op with array fields for 'ts', 't', 'o' and, for updates, 'o2'.
+    // For example:
+    // { ts: Timestamp(1,1), t:1, ns: "test.foo", op:"u", o2: {_id:1}, o: {$set: {a: 1}} }
+    // { ts: Timestamp(1,2), t:1, ns: "test.foo", op:"u", o2: {_id:2}, o: {$set: {a: 2}} }
+    // become:
+    // { ts: [Timestamp(1, 1), Timestamp(1, 2)],
+    //    t: [1, 1],
+    //   o2: [{_id: 1}, {_id: 2}],
+    //    o: [{$set: {a: 1}}, {$set: {a: 2}}],
+    //   ns: "test.foo",
+    //   op: "u" }
+    BSONObjBuilder groupedOpBuilder;
+    appendGroupedOpTimes(&groupedOpBuilder, it, endOfGroupableOpsIterator);
+
+    {
+        BSONArrayBuilder oArrayBuilder(groupedOpBuilder.subarrayStart("o"));
+        for (auto groupingIt = it; groupingIt != endOfGroupableOpsIterator; ++groupingIt) {
+            oArrayBuilder.append((*groupingIt)->getObject());
+        }
+    }
+
+    if (opType == OpTypeEnum::kUpdate) {
+        BSONArrayBuilder o2ArrayBuilder(groupedOpBuilder.subarrayStart("o2"));
+        for (auto groupingIt = it; groupingIt != endOfGroupableOpsIterator; ++groupingIt) {
+            o2ArrayBuilder.append(*(*groupingIt)->getObject2());
+        }
+    }
+
+    // Take the remaining fields, such as "ns", "ui", "op" and "b", from the first op.
+    groupedOpBuilder.appendElementsUnique(entry.raw);
+
+    auto groupedOpObj = groupedOpBuilder.done();
+    try {
+        uassertStatusOK(SyncTail::syncApply(_opCtx, groupedOpObj, _mode, isDataConsistent));
+        return endOfGroupableOpsIterator - 1;
+    } catch (...) {
+        // The grouped operation failed and none of its writes were made. Log an error and fall
+        // through to the application of the individual ops.
+        auto status = mongo::exceptionToStatus();
+        error() << "Error applying " << OpType_serializer(opType) << " operations in bulk "
+                << causedBy(redact(status)) << ": " << redact(groupedOpObj)
+                << ". Trying first operation on its own: " << redact(entry.raw);
+
+        // Avoid quadratic run time by not retrying until we are beyond this group of ops.
+        _doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+
+        return status.withContext(str::stream() << "Error applying operations in bulk: "
+                                                << redact(groupedOpObj)
+                                                << ". Trying first operation on its own: "
+                                                << redact(entry.raw));
+    }
+
+    MONGO_UNREACHABLE;
+}
+
 }  // namespace repl
 }  // namespace mongo
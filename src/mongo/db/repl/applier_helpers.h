@@ -53,6 +53,7 @@ public:
     static void stableSortByNamespace(OperationPtrs* oplogEntryPointers);
 
     class InsertGroup;
+    class UpdateDeleteGroup;
 };
 
 /**
@@ -91,5 +92,42 @@ private:
     Mode _mode;
 };
 
+/**
+ * Groups consecutive update operations, or consecutive delete operations, on the same namespace
+ * and applies the combined operation as a single oplog entry, in a single storage transaction.
+ * Each write is still timestamped with the optime of the operation it came from.
+ * Advances the MultiApplier::OperationPtrs iterator if the grouped operation is applied
+ * successfully.
+ */
+class ApplierHelpers::UpdateDeleteGroup {
+    MONGO_DISALLOW_COPYING(UpdateDeleteGroup);
+
+public:
+    using ConstIterator = OperationPtrs::const_iterator;
+    using Mode = OplogApplication::Mode;
+
+    UpdateDeleteGroup(OperationPtrs* ops, OperationContext* opCtx, Mode mode);
+
+    /**
+     * Attempts to group update or delete operations starting at 'iter'.
+     * If the grouped operation is applied successfully, returns the iterator to the last
+     * standalone operation included in it.
+     */
+    StatusWith<ConstIterator> groupAndApplyUpdatesAndDeletes(ConstIterator oplogEntriesIterator,
+                                                             const bool isDataConsistent);
+
+private:
+    // Marks the final op of a failed group, so that ops are not grouped again until that op has
+    // been applied on its own.
+    ConstIterator _doNotGroupBeforePoint;
+
+    // Used for constructing search bounds when grouping operations.
+    ConstIterator _end;
+
+    // Passed to _syncApply when applying grouped operations.
+    OperationContext* _opCtx;
+    Mode _mode;
+};
+
 }  // namespace repl
 }  // namespace mongo
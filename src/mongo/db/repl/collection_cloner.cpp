@@ -34,6 +34,7 @@
 
 #include "mongo/db/repl/collection_cloner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/base/string_data.h"
@@ -70,6 +71,27 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionCountAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 // The number of attempts for the find command, which gets the data.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
+
+// The maximum number of _id ranges a collection is split into, each of which is cloned through its
+// own cursor. A value of one clones every collection through a single cursor.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncCollectionClonerRanges, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncCollectionClonerRanges must be at least 1");
+        }
+        return Status::OK();
+    });
+
+// The minimum number of documents in each _id range a collection is split into.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncCollectionClonerMinDocumentsPerRange, int, 10000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "initialSyncCollectionClonerMinDocumentsPerRange must be at least 1");
+        }
+        return Status::OK();
+    });
 }  // namespace
 
 // Failpoint which causes initial sync to hang before establishing its cursor to clone the
@@ -265,6 +287,12 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
     if (_establishCollectionCursorsScheduler) {
         _establishCollectionCursorsScheduler->shutdown();
     }
+    for (auto&& scheduler : _splitKeySchedulers) {
+        scheduler->shutdown();
+    }
+    for (auto&& scheduler : _rangeCursorSchedulers) {
+        scheduler->shutdown();
+    }
     if (_verifyCollectionDroppedScheduler) {
         _verifyCollectionDroppedScheduler->shutdown();
     }
@@ -477,6 +505,47 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
 
     _collLoader = std::move(collectionBulkLoader.getValue());
 
+    Client::initThreadIfNotAlready();
+    auto opCtx = cc().getOperationContext();
+
+    MONGO_FAIL_POINT_BLOCK(initialSyncHangBeforeCollectionClone, options) {
+        const BSONObj& data = options.getData();
+        if (data["namespace"].String() == _destNss.ns()) {
+            log() << "initial sync - initialSyncHangBeforeCollectionClone fail point "
+                     "enabled. Blocking until fail point is disabled.";
+            while (MONGO_FAIL_POINT(initialSyncHangBeforeCollectionClone) && !_isShuttingDown()) {
+                mongo::sleepsecs(1);
+            }
+        }
+    }
+
+    const auto numRanges = _getNumRangesToClone();
+    if (numRanges == 1) {
+        _establishCollectionCursors(opCtx);
+        return;
+    }
+
+    // This completion guard invokes _finishCallback on destruction.
+    auto cancelRemainingWorkInLock = [this]() { _cancelRemainingWork_inlock(); };
+    auto finishCallbackFn = [this](const Status& status) { _finishCallback(status); };
+    auto onCompletionGuard =
+        std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
+
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    if (_state == State::kShuttingDown) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lock, Status(ErrorCodes::CallbackCanceled, "Cloner shutting down."));
+        return;
+    }
+    LOG(1) << "Cloning collection " << _sourceNss.ns() << " in " << numRanges << " _id ranges";
+    auto scheduleStatus = _scheduleSplitKeyQueries(lock, numRanges, opCtx, onCompletionGuard);
+    if (!scheduleStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+        return;
+    }
+}
+
+void CollectionCloner::_establishCollectionCursors(OperationContext* opCtx) {
     BSONObjBuilder cmdObj;
     EstablishCursorsCommand cursorCommand;
     // The 'find' command is used when the number of cloning cursors is 1 to ensure
@@ -497,20 +566,6 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
         cursorCommand = ParallelCollScan;
     }
 
-    Client::initThreadIfNotAlready();
-    auto opCtx = cc().getOperationContext();
-
-    MONGO_FAIL_POINT_BLOCK(initialSyncHangBeforeCollectionClone, options) {
-        const BSONObj& data = options.getData();
-        if (data["namespace"].String() == _destNss.ns()) {
-            log() << "initial sync - initialSyncHangBeforeCollectionClone fail point "
-                     "enabled. Blocking until fail point is disabled.";
-            while (MONGO_FAIL_POINT(initialSyncHangBeforeCollectionClone) && !_isShuttingDown()) {
-                mongo::sleepsecs(1);
-            }
-        }
-    }
-
     _establishCollectionCursorsScheduler = stdx::make_unique<RemoteCommandRetryScheduler>(
         _executor,
         RemoteCommandRequest(_source,
@@ -534,6 +589,314 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
     }
 }
 
+size_t CollectionCloner::_getNumRangesToClone() const {
+    // Ranges are read in _id order, whereas capped collections must be cloned in their natural
+    // order. Range boundaries are compared without a collation, so _id indexes with a collation
+    // cannot be split either.
+    if (_maxNumClonerCursors != 1 || _options.capped || _idIndexSpec.isEmpty() ||
+        _idIndexSpec.hasField("collation")) {
+        return 1;
+    }
+
+    const size_t maxRanges = initialSyncCollectionClonerRanges.load();
+    const size_t minDocumentsPerRange = initialSyncCollectionClonerMinDocumentsPerRange.load();
+    LockGuard lk(_mutex);
+    return std::max<size_t>(1, std::min(maxRanges, _stats.documentToCopy / minDocumentsPerRange));
+}
+
+Status CollectionCloner::_scheduleSplitKeyQueries(
+    WithLock lock,
+    size_t numRanges,
+    OperationContext* opCtx,
+    std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    invariant(numRanges > 1);
+    const long long documentsPerRange = _stats.documentToCopy / numRanges;
+
+    // Each boundary is found by skipping through the _id index, which the projection keeps the
+    // sync source from fetching any documents for.
+    _rangeSplitKeys.clear();
+    _numRangeCommandsPending = numRanges - 1;
+    _rangeCommandsStatus = Status::OK();
+    for (size_t i = 1; i < numRanges; ++i) {
+        BSONObjBuilder cmdObj;
+        cmdObj.appendElements(
+            makeCommandWithUUIDorCollectionName("find", _options.uuid, _sourceNss));
+        cmdObj.append("sort", BSON("_id" << 1));
+        cmdObj.append("hint", BSON("_id" << 1));
+        cmdObj.append("projection", BSON("_id" << 1));
+        cmdObj.append("skip", documentsPerRange * static_cast<long long>(i));
+        cmdObj.append("limit", 1);
+        cmdObj.append("singleBatch", true);
+
+        _splitKeySchedulers.push_back(stdx::make_unique<RemoteCommandRetryScheduler>(
+            _executor,
+            RemoteCommandRequest(_source,
+                                 _sourceNss.db().toString(),
+                                 cmdObj.obj(),
+                                 ReadPreferenceSetting::secondaryPreferredMetadata(),
+                                 opCtx,
+                                 RemoteCommandRequest::kNoTimeout),
+            [=](const RemoteCommandCallbackArgs& rcbd) {
+                _splitKeyCallback(rcbd, onCompletionGuard);
+            },
+            RemoteCommandRetryScheduler::makeRetryPolicy<ErrorCategory::RetriableError>(
+                numInitialSyncCollectionFindAttempts.load(),
+                executor::RemoteCommandRequest::kNoTimeout)));
+        auto scheduleStatus = _splitKeySchedulers.back()->startup();
+        if (!scheduleStatus.isOK()) {
+            _numRangeCommandsPending -= numRanges - i;
+            return scheduleStatus;
+        }
+    }
+    return Status::OK();
+}
+
+void CollectionCloner::_splitKeyCallback(const RemoteCommandCallbackArgs& rcbd,
+                                         std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    Status status = rcbd.response.status;
+    if (status.isOK()) {
+        status = getStatusFromCommandResult(rcbd.response.data);
+    }
+    std::vector<CursorResponse> cursorResponses;
+    if (status.isOK()) {
+        status = _parseCursorResponse(rcbd.response.data, &cursorResponses, Find);
+    }
+
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    if (!status.isOK()) {
+        if (_rangeCommandsStatus.isOK()) {
+            _rangeCommandsStatus = status;
+        }
+    } else if (!cursorResponses.front().getBatch().empty()) {
+        // Documents removed since the count may leave the skip past the end of the collection.
+        BSONObjBuilder splitKey;
+        splitKey.appendAs(cursorResponses.front().getBatch().front()["_id"], "_id");
+        _rangeSplitKeys.push_back(splitKey.obj());
+    }
+    if (--_numRangeCommandsPending > 0) {
+        return;
+    }
+
+    if (_state == State::kShuttingDown) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lock, Status(ErrorCodes::CallbackCanceled, "Cloner shutting down."));
+        return;
+    }
+    if (_rangeCommandsStatus == ErrorCodes::NamespaceNotFound) {
+        // The collection was dropped, which oplog application will replay.
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+        return;
+    }
+    if (!_rangeCommandsStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lock,
+            _rangeCommandsStatus.withContext(str::stream() << "Error splitting collection '"
+                                                           << _sourceNss.ns()
+                                                           << "' into _id ranges"));
+        return;
+    }
+
+    // Writes on the sync source may have shifted the boundaries found by different queries past
+    // each other.
+    auto lessThan = [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.firstElement().woCompare(rhs.firstElement(), false) < 0;
+    };
+    auto equal = [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.firstElement().woCompare(rhs.firstElement(), false) == 0;
+    };
+    std::sort(_rangeSplitKeys.begin(), _rangeSplitKeys.end(), lessThan);
+    _rangeSplitKeys.erase(std::unique(_rangeSplitKeys.begin(), _rangeSplitKeys.end(), equal),
+                          _rangeSplitKeys.end());
+    _rangeLastIds.assign(_rangeSplitKeys.size() + 1, BSONObj());
+    _stats.ranges = _rangeLastIds.size();
+
+    auto scheduleStatus = _establishRangeCursors(lock, onCompletionGuard);
+    if (!scheduleStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+        return;
+    }
+}
+
+Status CollectionCloner::_establishRangeCursors(
+    WithLock lock, std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    // The schedulers left over from establishing the previous set of cursors have all completed.
+    _rangeCursorSchedulers.clear();
+    _rangeCursorResponses.clear();
+    _numRangeCommandsPending = _rangeLastIds.size();
+    _rangeCommandsStatus = Status::OK();
+    for (size_t i = 0; i < _rangeLastIds.size(); ++i) {
+        _rangeCursorSchedulers.push_back(stdx::make_unique<RemoteCommandRetryScheduler>(
+            _executor,
+            RemoteCommandRequest(_source,
+                                 _sourceNss.db().toString(),
+                                 _makeRangeFindCommand(lock, i),
+                                 ReadPreferenceSetting::secondaryPreferredMetadata(),
+                                 nullptr,
+                                 RemoteCommandRequest::kNoTimeout),
+            [=](const RemoteCommandCallbackArgs& rcbd) {
+                _establishRangeCursorCallback(rcbd, onCompletionGuard);
+            },
+            RemoteCommandRetryScheduler::makeRetryPolicy<ErrorCategory::RetriableError>(
+                numInitialSyncCollectionFindAttempts.load(),
+                executor::RemoteCommandRequest::kNoTimeout)));
+        auto scheduleStatus = _rangeCursorSchedulers.back()->startup();
+        if (!scheduleStatus.isOK()) {
+            _numRangeCommandsPending -= _rangeLastIds.size() - i;
+            return scheduleStatus;
+        }
+    }
+    LOG(1) << "Attempting to establish cursors for " << _rangeLastIds.size()
+           << " _id ranges of collection " << _sourceNss.ns();
+    return Status::OK();
+}
+
+BSONObj CollectionCloner::_makeRangeFindCommand(WithLock lock, size_t rangeIndex) const {
+    BSONObjBuilder cmdObj;
+    cmdObj.appendElements(makeCommandWithUUIDorCollectionName("find", _options.uuid, _sourceNss));
+    cmdObj.append("hint", BSON("_id" << 1));
+
+    // 'min' and 'max' bound the scan of the _id index regardless of the types of the _id values,
+    // which query predicates would not. A resumed range starts again at the last document cloned
+    // from it, which is then skipped.
+    const auto& lastId = _rangeLastIds[rangeIndex];
+    if (!lastId.isEmpty()) {
+        cmdObj.append("min", lastId);
+    } else if (rangeIndex > 0) {
+        cmdObj.append("min", _rangeSplitKeys[rangeIndex - 1]);
+    }
+    if (rangeIndex < _rangeSplitKeys.size()) {
+        cmdObj.append("max", _rangeSplitKeys[rangeIndex]);
+    }
+    cmdObj.append("noCursorTimeout", true);
+    cmdObj.append("batchSize", 0);
+    return cmdObj.obj();
+}
+
+void CollectionCloner::_establishRangeCursorCallback(
+    const RemoteCommandCallbackArgs& rcbd, std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    Status status = rcbd.response.status;
+    if (status.isOK()) {
+        status = getStatusFromCommandResult(rcbd.response.data);
+    }
+
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    if (status.isOK()) {
+        status = _parseCursorResponse(rcbd.response.data, &_rangeCursorResponses, Find);
+    }
+    if (!status.isOK() && _rangeCommandsStatus.isOK()) {
+        _rangeCommandsStatus = status;
+    }
+    if (--_numRangeCommandsPending > 0) {
+        return;
+    }
+
+    // Cursors already established for some of the ranges are killed along with the
+    // 'AsyncResultsMerger' when cloning stops.
+    if (!_rangeCursorResponses.empty()) {
+        _makeARM(std::move(_rangeCursorResponses));
+        _rangeCursorResponses.clear();
+    }
+
+    if (_state == State::kShuttingDown) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lock, Status(ErrorCodes::CallbackCanceled, "Cloner shutting down."));
+        return;
+    }
+    if (_rangeCommandsStatus == ErrorCodes::NamespaceNotFound) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+        return;
+    }
+    if (!_rangeCommandsStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lock,
+            _rangeCommandsStatus.withContext(str::stream() << "Error querying collection '"
+                                                           << _sourceNss.ns()
+                                                           << "'"));
+        return;
+    }
+    LOG(1) << "Collection cloner running with " << _rangeLastIds.size()
+           << " _id range cursors established.";
+
+    Status scheduleStatus = _scheduleNextARMResultsCallback(onCompletionGuard);
+    if (!scheduleStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+        return;
+    }
+}
+
+bool CollectionCloner::_trackRangeDocument(WithLock lock, const BSONObj& doc) {
+    const auto id = doc["_id"];
+    auto splitKey = std::upper_bound(
+        _rangeSplitKeys.begin(),
+        _rangeSplitKeys.end(),
+        id,
+        [](const BSONElement& id, const BSONObj& key) {
+            return id.woCompare(key.firstElement(), false) < 0;
+        });
+    auto& lastId = _rangeLastIds[splitKey - _rangeSplitKeys.begin()];
+
+    // Each range returns its documents in _id order.
+    if (!lastId.isEmpty() && id.woCompare(lastId.firstElement(), false) <= 0) {
+        return false;
+    }
+    BSONObjBuilder bob;
+    bob.appendAs(id, "_id");
+    lastId = bob.obj();
+    return true;
+}
+
+bool CollectionCloner::_canResumeRanges(WithLock lock, const Status& status) const {
+    const auto maxAttempts = numInitialSyncCollectionFindAttempts.load();
+    if (_rangeLastIds.empty() || _state == State::kShuttingDown ||
+        _stats.rangeResumes + 1 >= static_cast<size_t>(maxAttempts)) {
+        return false;
+    }
+    // A cursor lost because the collection was dropped is resumed as well, after which the range
+    // queries find the collection gone.
+    return ErrorCodes::isRetriableError(status.code()) ||
+        status == ErrorCodes::CursorNotFound || status == ErrorCodes::QueryPlanKilled;
+}
+
+void CollectionCloner::_resumeRanges(const stdx::unique_lock<stdx::mutex>& lk,
+                                     std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    ++_stats.rangeResumes;
+
+    auto opCtx = cc().makeOperationContext();
+    _killArmHandle = _arm->kill(opCtx.get());
+    opCtx.reset();
+    if (!_killArmHandle.isValid()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+            lk,
+            Status(ErrorCodes::CallbackCanceled,
+                   "Task executor shut down while resuming collection cloning."));
+        return;
+    }
+
+    auto scheduleResult = _executor->onEvent(
+        _killArmHandle, [=](const executor::TaskExecutor::CallbackArgs& cbd) {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            if (!cbd.status.isOK()) {
+                onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, cbd.status);
+                return;
+            }
+            if (_state == State::kShuttingDown) {
+                onCompletionGuard->setResultAndCancelRemainingWork_inlock(
+                    lock, Status(ErrorCodes::CallbackCanceled, "Cloner shutting down."));
+                return;
+            }
+            _arm.reset();
+            auto scheduleStatus = _establishRangeCursors(lock, onCompletionGuard);
+            if (!scheduleStatus.isOK()) {
+                onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+                return;
+            }
+        });
+    if (!scheduleResult.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lk, scheduleResult.getStatus());
+        return;
+    }
+}
+
 Status CollectionCloner::_parseCursorResponse(BSONObj response,
                                               std::vector<CursorResponse>* cursors,
                                               EstablishCursorsCommand cursorCommand) {
@@ -618,6 +981,26 @@ void CollectionCloner::_establishCollectionCursorsCallback(const RemoteCommandCa
     LOG(1) << "Collection cloner running with " << cursorResponses.size()
            << " cursors established.";
 
+    _makeARM(std::move(cursorResponses));
+
+    // This completion guard invokes _finishCallback on destruction.
+    auto cancelRemainingWorkInLock = [this]() { _cancelRemainingWork_inlock(); };
+    auto finishCallbackFn = [this](const Status& status) { _finishCallback(status); };
+    auto onCompletionGuard =
+        std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
+
+    // Lock guard must be declared after completion guard. If there is an error in this function
+    // that will cause the destructor of the completion guard to run, the destructor must be run
+    // outside the mutex. This is a necessary condition to invoke _finishCallback.
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    Status scheduleStatus = _scheduleNextARMResultsCallback(onCompletionGuard);
+    if (!scheduleStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+        return;
+    }
+}
+
+void CollectionCloner::_makeARM(std::vector<CursorResponse> cursorResponses) {
     // Initialize the 'AsyncResultsMerger'(ARM).
     std::vector<RemoteCursor> remoteCursors;
     for (auto&& cursorResponse : cursorResponses) {
@@ -638,23 +1021,6 @@ void CollectionCloner::_establishCollectionCursorsCallback(const RemoteCommandCa
     auto opCtx = cc().makeOperationContext();
     _arm = stdx::make_unique<AsyncResultsMerger>(opCtx.get(), _executor, std::move(armParams));
     _arm->detachFromOperationContext();
-    opCtx.reset();
-
-    // This completion guard invokes _finishCallback on destruction.
-    auto cancelRemainingWorkInLock = [this]() { _cancelRemainingWork_inlock(); };
-    auto finishCallbackFn = [this](const Status& status) { _finishCallback(status); };
-    auto onCompletionGuard =
-        std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
-
-    // Lock guard must be declared after completion guard. If there is an error in this function
-    // that will cause the destructor of the completion guard to run, the destructor must be run
-    // outside the mutex. This is a necessary condition to invoke _finishCallback.
-    stdx::lock_guard<stdx::mutex> lock(_mutex);
-    Status scheduleStatus = _scheduleNextARMResultsCallback(onCompletionGuard);
-    if (!scheduleStatus.isOK()) {
-        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
-        return;
-    }
 }
 
 StatusWith<std::vector<BSONElement>> CollectionCloner::_parseParallelCollectionScanResponse(
@@ -688,6 +1054,9 @@ Status CollectionCloner::_bufferNextBatchFromArm(WithLock lock) {
             break;
         } else {
             auto queryResult = armResultStatus.getValue().getResult();
+            if (!_rangeLastIds.empty() && !_trackRangeDocument(lock, *queryResult)) {
+                continue;
+            }
             _documentsToInsert.push_back(std::move(*queryResult));
         }
     }
@@ -740,7 +1109,14 @@ void CollectionCloner::_handleARMResultsCallback(
         UniqueLock lk(_mutex);
         auto nextBatchStatus = _bufferNextBatchFromArm(lk);
         if (!nextBatchStatus.isOK()) {
-            if (_options.uuid && (nextBatchStatus.code() == ErrorCodes::OperationFailed ||
+            if (_canResumeRanges(lk, nextBatchStatus)) {
+                // The documents buffered so far are inserted with the first batch read from the
+                // new cursors.
+                log() << "Resuming the cloning of " << _rangeLastIds.size()
+                      << " _id ranges of collection " << _sourceNss.ns()
+                      << " after error: " << redact(nextBatchStatus);
+                _resumeRanges(lk, onCompletionGuard);
+            } else if (_options.uuid && (nextBatchStatus.code() == ErrorCodes::OperationFailed ||
                                   nextBatchStatus.code() == ErrorCodes::CursorNotFound ||
                                   nextBatchStatus.code() == ErrorCodes::QueryPlanKilled)) {
                 // With these errors, it's possible the collection was dropped while we were
@@ -972,6 +1348,10 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber(kDocumentsCopiedFieldName, documentsCopied);
     builder->appendNumber("indexes", indexes);
     builder->appendNumber("fetchedBatches", fetchBatches);
+    if (ranges > 0) {
+        builder->appendNumber("ranges", ranges);
+        builder->appendNumber("rangeResumes", rangeResumes);
+    }
     if (start != Date_t()) {
         builder->appendDate("start", start);
         if (end != Date_t()) {
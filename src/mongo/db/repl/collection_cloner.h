@@ -82,6 +82,8 @@ public:
         size_t documentsCopied{0};
         size_t indexes{0};
         size_t fetchBatches{0};
+        size_t ranges{0};
+        size_t rangeResumes{0};
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -192,6 +194,77 @@ private:
      */
     void _beginCollectionCallback(const executor::TaskExecutor::CallbackArgs& callbackData);
 
+    /**
+     * Schedules the 'find' or 'parallelCollectionScan' command which establishes the cursors
+     * cloning the whole collection.
+     */
+    void _establishCollectionCursors(OperationContext* opCtx);
+
+    /**
+     * Returns the number of _id ranges the collection should be cloned in, or 1 if it should not
+     * be split by _id.
+     */
+    size_t _getNumRangesToClone() const;
+
+    /**
+     * Sends a 'find' command for each _id value splitting the collection into 'numRanges' ranges
+     * holding roughly the same number of documents.
+     */
+    Status _scheduleSplitKeyQueries(WithLock lock,
+                                    size_t numRanges,
+                                    OperationContext* opCtx,
+                                    std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Collects a range boundary. Once all of them have been found, establishes a cursor for each
+     * range.
+     */
+    void _splitKeyCallback(const RemoteCommandCallbackArgs& rcbd,
+                           std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Passes the cursors established for the collection into the 'AsyncResultsMerger'.
+     */
+    void _makeARM(std::vector<CursorResponse> cursorResponses);
+
+    /**
+     * Sends a 'find' command for every _id range, starting each range after the last document
+     * already cloned from it.
+     */
+    Status _establishRangeCursors(WithLock lock,
+                                  std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Collects the cursor established for a range. Once all of them have been established, passes
+     * them into the 'AsyncResultsMerger'.
+     */
+    void _establishRangeCursorCallback(const RemoteCommandCallbackArgs& rcbd,
+                                       std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Returns the 'find' command reading the given range from the sync source.
+     */
+    BSONObj _makeRangeFindCommand(WithLock lock, size_t rangeIndex) const;
+
+    /**
+     * Records 'doc' as the last document cloned from its range. Returns false if the document was
+     * already cloned before the range was resumed, in which case it must not be inserted again.
+     */
+    bool _trackRangeDocument(WithLock lock, const BSONObj& doc);
+
+    /**
+     * Returns whether the cursors failing with 'status' can be re-established from the last
+     * document cloned from each range.
+     */
+    bool _canResumeRanges(WithLock lock, const Status& status) const;
+
+    /**
+     * Kills the 'AsyncResultsMerger' and, once its cursors are gone, re-establishes the cursors
+     * for every range from where it left off.
+     */
+    void _resumeRanges(const stdx::unique_lock<stdx::mutex>& lk,
+                       std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
     /**
      * The possible command types that can be used to establish the initial cursors on the
      * remote collection.
@@ -310,6 +383,28 @@ private:
     // (M) Scheduler used to establish the initial cursor or set of cursors.
     std::unique_ptr<RemoteCommandRetryScheduler> _establishCollectionCursorsScheduler;
 
+    // (M) Schedulers used to split the collection into _id ranges and to establish a cursor for
+    // each of the ranges.
+    std::vector<std::unique_ptr<RemoteCommandRetryScheduler>> _splitKeySchedulers;
+    std::vector<std::unique_ptr<RemoteCommandRetryScheduler>> _rangeCursorSchedulers;
+
+    // (M) The _id values splitting the collection into ranges, in ascending order. Range 'i' holds
+    // the documents from '_rangeSplitKeys[i - 1]' up to, but not including, '_rangeSplitKeys[i]'.
+    // Empty unless the collection is cloned in ranges.
+    std::vector<BSONObj> _rangeSplitKeys;
+
+    // (M) The _id of the last document cloned from each range, or an empty object if none was.
+    // Empty unless the collection is cloned in ranges.
+    std::vector<BSONObj> _rangeLastIds;
+
+    // (M) The range cursors established so far.
+    std::vector<CursorResponse> _rangeCursorResponses;
+
+    // (M) The number of split key queries or range cursors still outstanding, and the first error
+    // returned by one of them.
+    size_t _numRangeCommandsPending = 0;
+    Status _rangeCommandsStatus = Status::OK();
+
     // (M) Scheduler used to determine if a cursor was closed because the collection was dropped.
     std::unique_ptr<RemoteCommandRetryScheduler> _verifyCollectionDroppedScheduler;
 
@@ -39,6 +39,7 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
@@ -2157,4 +2158,234 @@ TEST_F(ParallelCollectionClonerTest,
     ASSERT_EQUALS(ErrorCodes::OperationFailed, getStatus());
 }
 
+class RangedCollectionClonerTest : public CollectionClonerTest {
+protected:
+    using RespondFn = stdx::function<BSONObj(const BSONObj& cmdObj)>;
+
+    void setUp() override;
+    void tearDown() override;
+
+    void setServerParameter(const std::string& name, const std::string& value);
+
+    /**
+     * Responds to the requests sent by the cloner with 'respond' until cloning completes.
+     */
+    void runCloner(const RespondFn& respond);
+
+    /**
+     * Returns the response to the cloner's count, listIndexes, split key queries and
+     * killCursors for a collection holding the documents with _id 0 through 5.
+     */
+    BSONObj respondToSetupCommand(const BSONObj& cmdObj);
+
+    /**
+     * Returns the index of the range the 'find' command reads, where range 'i' holds the
+     * documents with _id '2 * i' and '2 * i + 1'.
+     */
+    static int getRangeIndex(const BSONObj& findCmd);
+
+    std::vector<BSONObj> rangeFindCmds;
+};
+
+void RangedCollectionClonerTest::setUp() {
+    CollectionClonerTest::setUp();
+    setServerParameter("initialSyncCollectionClonerRanges", "3");
+    setServerParameter("initialSyncCollectionClonerMinDocumentsPerRange", "1");
+}
+
+void RangedCollectionClonerTest::tearDown() {
+    setServerParameter("initialSyncCollectionClonerRanges", "1");
+    setServerParameter("initialSyncCollectionClonerMinDocumentsPerRange", "10000");
+    CollectionClonerTest::tearDown();
+}
+
+void RangedCollectionClonerTest::setServerParameter(const std::string& name,
+                                                    const std::string& value) {
+    ASSERT_OK(ServerParameterSet::getGlobal()->getMap().find(name)->second->setFromString(value));
+}
+
+void RangedCollectionClonerTest::runCloner(const RespondFn& respond) {
+    auto net = getNet();
+    while (collectionCloner->isActive()) {
+        {
+            executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+            while (net->hasReadyRequests()) {
+                auto noi = net->getNextReadyRequest();
+                scheduleNetworkResponse(noi, respond(noi->getRequest().cmdObj));
+            }
+            net->runReadyNetworkOperations();
+        }
+        collectionCloner->waitForDbWorker();
+    }
+}
+
+BSONObj RangedCollectionClonerTest::respondToSetupCommand(const BSONObj& cmdObj) {
+    const auto cmdName = cmdObj.firstElementFieldName();
+    if (cmdName == "count"_sd) {
+        return createCountResponse(6);
+    }
+    if (cmdName == "listIndexes"_sd) {
+        return createListIndexesResponse(0, BSON_ARRAY(idIndexSpec));
+    }
+    if (cmdName == "find"_sd && cmdObj.hasField("skip")) {
+        // The document found by skipping 'n' documents in _id order has _id 'n'.
+        return createCursorResponse(0, BSON_ARRAY(BSON("_id" << cmdObj["skip"].numberInt())));
+    }
+    if (cmdName == "killCursors"_sd) {
+        return BSON("ok" << 1);
+    }
+    FAIL(str::stream() << "Unexpected command " << cmdObj);
+    MONGO_UNREACHABLE;
+}
+
+int RangedCollectionClonerTest::getRangeIndex(const BSONObj& findCmd) {
+    return findCmd.hasField("min") ? findCmd["min"].Obj()["_id"].numberInt() / 2 : 0;
+}
+
+TEST_F(RangedCollectionClonerTest, CollectionIsClonedThroughACursorForEachIdRange) {
+    ASSERT_OK(collectionCloner->startup());
+
+    runCloner([this](const BSONObj& cmdObj) {
+        const auto cmdName = cmdObj.firstElementFieldName();
+        if (cmdName == "find"_sd && !cmdObj.hasField("skip")) {
+            rangeFindCmds.push_back(cmdObj);
+            return createCursorResponse(1 + getRangeIndex(cmdObj), BSONArray());
+        }
+        if (cmdName == "getMore"_sd) {
+            const int range = cmdObj["getMore"].numberLong() - 1;
+            return createFinalCursorResponse(
+                BSON_ARRAY(BSON("_id" << 2 * range) << BSON("_id" << 2 * range + 1)));
+        }
+        return respondToSetupCommand(cmdObj);
+    });
+
+    ASSERT_OK(getStatus());
+    ASSERT_EQUALS(6, collectionStats.insertCount);
+    ASSERT_TRUE(collectionStats.commitCalled);
+    ASSERT_EQUALS(3U, collectionCloner->getStats().ranges);
+    ASSERT_EQUALS(0U, collectionCloner->getStats().rangeResumes);
+
+    ASSERT_EQUALS(3U, rangeFindCmds.size());
+    std::sort(rangeFindCmds.begin(),
+              rangeFindCmds.end(),
+              [](const BSONObj& lhs, const BSONObj& rhs) {
+                  return getRangeIndex(lhs) < getRangeIndex(rhs);
+              });
+    for (auto&& findCmd : rangeFindCmds) {
+        ASSERT_BSONOBJ_EQ(BSON("_id" << 1), findCmd["hint"].Obj());
+        ASSERT_TRUE(findCmd["noCursorTimeout"].trueValue());
+    }
+    ASSERT_FALSE(rangeFindCmds[0].hasField("min"));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), rangeFindCmds[0]["max"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), rangeFindCmds[1]["min"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 4), rangeFindCmds[1]["max"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 4), rangeFindCmds[2]["min"].Obj());
+    ASSERT_FALSE(rangeFindCmds[2].hasField("max"));
+}
+
+TEST_F(RangedCollectionClonerTest, RangesAreResumedFromTheirLastDocumentAfterLosingACursor) {
+    ASSERT_OK(collectionCloner->startup());
+
+    // The cursors established after resuming have ids 11 through 13.
+    int cursorIdBase = 1;
+    bool cursorLost = false;
+    runCloner([&](const BSONObj& cmdObj) {
+        const auto cmdName = cmdObj.firstElementFieldName();
+        if (cmdName == "find"_sd && !cmdObj.hasField("skip")) {
+            rangeFindCmds.push_back(cmdObj);
+            return createCursorResponse(cursorIdBase + getRangeIndex(cmdObj), BSONArray());
+        }
+        if (cmdName == "getMore"_sd) {
+            const long long cursorId = cmdObj["getMore"].numberLong();
+            const int range = cursorId % 10 - 1;
+            if (cursorId == 2) {
+                // The first cursor on the middle range returns a document and is then lost.
+                if (cursorLost) {
+                    cursorIdBase = 11;
+                    return BSON("ok" << 0 << "errmsg"
+                                     << "cursor not found"
+                                     << "code"
+                                     << ErrorCodes::CursorNotFound);
+                }
+                cursorLost = true;
+                return createCursorResponse(2, BSON_ARRAY(BSON("_id" << 2)), "nextBatch");
+            }
+            return createFinalCursorResponse(
+                BSON_ARRAY(BSON("_id" << 2 * range) << BSON("_id" << 2 * range + 1)));
+        }
+        return respondToSetupCommand(cmdObj);
+    });
+
+    ASSERT_OK(getStatus());
+    ASSERT_TRUE(collectionStats.commitCalled);
+    ASSERT_EQUALS(1U, collectionCloner->getStats().rangeResumes);
+
+    // The documents cloned before the cursor was lost are returned again but not inserted twice.
+    ASSERT_EQUALS(6, collectionStats.insertCount);
+
+    ASSERT_EQUALS(6U, rangeFindCmds.size());
+    bool middleRangeResumed = false;
+    for (size_t i = 3; i < rangeFindCmds.size(); ++i) {
+        if (getRangeIndex(rangeFindCmds[i]) == 1) {
+            ASSERT_BSONOBJ_EQ(BSON("_id" << 2), rangeFindCmds[i]["min"].Obj());
+            ASSERT_BSONOBJ_EQ(BSON("_id" << 4), rangeFindCmds[i]["max"].Obj());
+            middleRangeResumed = true;
+        }
+    }
+    ASSERT_TRUE(middleRangeResumed);
+}
+
+TEST_F(RangedCollectionClonerTest, CollectionTooSmallToSplitIsClonedThroughASingleCursor) {
+    setServerParameter("initialSyncCollectionClonerMinDocumentsPerRange", "6");
+    ASSERT_OK(collectionCloner->startup());
+
+    runCloner([this](const BSONObj& cmdObj) {
+        const auto cmdName = cmdObj.firstElementFieldName();
+        if (cmdName == "find"_sd) {
+            ASSERT_FALSE(cmdObj.hasField("skip"));
+            ASSERT_FALSE(cmdObj.hasField("hint"));
+            return createCursorResponse(1, BSONArray());
+        }
+        if (cmdName == "getMore"_sd) {
+            return createFinalCursorResponse(BSON_ARRAY(BSON("_id" << 0) << BSON("_id" << 1)));
+        }
+        return respondToSetupCommand(cmdObj);
+    });
+
+    ASSERT_OK(getStatus());
+    ASSERT_EQUALS(2, collectionStats.insertCount);
+    ASSERT_EQUALS(0U, collectionCloner->getStats().ranges);
+}
+
+TEST_F(RangedCollectionClonerTest, CappedCollectionIsClonedThroughASingleCursor) {
+    options.capped = true;
+    options.cappedSize = 4096;
+    collectionCloner = stdx::make_unique<CollectionCloner>(&getExecutor(),
+                                                           dbWorkThreadPool.get(),
+                                                           target,
+                                                           nss,
+                                                           options,
+                                                           setStatusCallback(),
+                                                           storageInterface.get(),
+                                                           defaultBatchSize,
+                                                           defaultNumCloningCursors);
+    ASSERT_OK(collectionCloner->startup());
+
+    runCloner([this](const BSONObj& cmdObj) {
+        const auto cmdName = cmdObj.firstElementFieldName();
+        if (cmdName == "find"_sd) {
+            ASSERT_FALSE(cmdObj.hasField("skip"));
+            ASSERT_FALSE(cmdObj.hasField("hint"));
+            return createCursorResponse(1, BSONArray());
+        }
+        if (cmdName == "getMore"_sd) {
+            return createFinalCursorResponse(BSON_ARRAY(BSON("_id" << 0)));
+        }
+        return respondToSetupCommand(cmdObj);
+    });
+
+    ASSERT_OK(getStatus());
+    ASSERT_EQUALS(0U, collectionCloner->getStats().ranges);
+}
+
 }  // namespace
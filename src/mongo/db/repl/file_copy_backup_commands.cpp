@@ -0,0 +1,425 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/file_copy_backup_commands.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#include "mongo/base/init.h"
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/repl/repl_set_command.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/periodic_runner.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// A backup left open for longer than this without being read from is ended, as the node which
+// opened it has most likely gone away.
+MONGO_EXPORT_SERVER_PARAMETER(fileCopyBackupIdleTimeoutSecs, int, 10 * 60);
+
+// How often the reaper checks whether the open backup has been idle for too long.
+const Milliseconds kReaperPeriod = Seconds(1);
+
+// The most bytes of a file returned by a single readFileCopyBackupFile command.
+const long long kMaxReadBytes = 12 * 1024 * 1024;
+
+// The file recording the storage engine and its options, which the storage engine does not list
+// as part of its backups.
+const char kStorageMetadataFileName[] = "storage.bson";
+
+/**
+ * Returns whether 'filename' is one of the small metadata files mongod keeps next to the data
+ * files. These are replaced whole rather than written in place, so they are read when the backup
+ * begins instead of piecemeal while it goes on, which could mix two versions of the file.
+ */
+bool isMetadataFile(StringData filename) {
+    return filename.endsWith(".bson");
+}
+
+/**
+ * The backup of this node's data files which a node doing a file copy based initial sync is
+ * copying. Only one backup is open at a time.
+ */
+class FileCopyBackup {
+public:
+    /**
+     * Begins a backup and returns its id, recording the files in it and their sizes into 'result'.
+     */
+    OID begin(OperationContext* opCtx, BSONObjBuilder* result);
+
+    /**
+     * Reads up to 'length' bytes from 'offset' into 'filename', which must be part of the backup,
+     * and appends them to 'result'.
+     */
+    void read(const OID& backupId,
+              const std::string& filename,
+              long long offset,
+              long long length,
+              BSONObjBuilder* result);
+
+    void end(OperationContext* opCtx, const OID& backupId);
+
+    /**
+     * Ends the open backup if it has been idle for longer than fileCopyBackupIdleTimeoutSecs.
+     */
+    void endIfIdle(OperationContext* opCtx);
+
+private:
+    bool _isIdle_inlock() const;
+
+    void _end_inlock(OperationContext* opCtx);
+
+    stdx::mutex _mutex;
+    boost::optional<OID> _backupId;
+    std::map<std::string, long long> _fileSizes;
+
+    // The contents of the metadata files in the backup, keyed by filename.
+    std::map<std::string, std::string> _metadataFiles;
+    Date_t _lastUsed;
+};
+
+FileCopyBackup fileCopyBackup;
+
+/**
+ * The periodic job which ends idle backups, so that their files are released even if no other node
+ * comes along to begin a backup.
+ */
+struct FileCopyBackupReaper {
+    stdx::mutex mutex;
+    PeriodicJobAnchor anchor;
+    bool inShutdown = false;
+};
+
+const auto getFileCopyBackupReaper = ServiceContext::declareDecoration<FileCopyBackupReaper>();
+
+void startFileCopyBackupReaper(ServiceContext* serviceContext) {
+    auto& reaper = getFileCopyBackupReaper(serviceContext);
+    stdx::lock_guard<stdx::mutex> lk(reaper.mutex);
+    uassert(ErrorCodes::ShutdownInProgress,
+            "Cannot begin a file copy backup during shutdown",
+            !reaper.inShutdown);
+    if (reaper.anchor) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+    PeriodicRunner::PeriodicJob job("FileCopyBackupReaper",
+                                    [](Client* client) {
+                                        auto opCtx = client->makeOperationContext();
+                                        fileCopyBackup.endIfIdle(opCtx.get());
+                                    },
+                                    kReaperPeriod);
+    reaper.anchor = periodicRunner->makeJob(std::move(job));
+    reaper.anchor.start();
+}
+
+OID FileCopyBackup::begin(OperationContext* opCtx, BSONObjBuilder* result) {
+    auto replCoord = ReplicationCoordinator::get(opCtx);
+    const auto memberState = replCoord->getMemberState();
+    uassert(ErrorCodes::NotMasterOrSecondary,
+            str::stream() << "Cannot back up the data files of a node in state "
+                          << memberState.toString(),
+            memberState.primary() || memberState.secondary());
+
+    startFileCopyBackupReaper(opCtx->getServiceContext());
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_backupId) {
+        // The reaper may not have got to an idle backup yet.
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                "A file copy backup is already in progress",
+                _isIdle_inlock());
+        log() << "Ending file copy backup " << *_backupId << " which has been idle since "
+              << _lastUsed;
+        _end_inlock(opCtx);
+    }
+
+    // Keeps fsyncLock from entering or leaving backup mode concurrently.
+    Lock::GlobalLock globalLock(opCtx, MODE_IX);
+    auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    auto filenames = uassertStatusOK(storageEngine->beginNonBlockingBackup(opCtx));
+
+    const boost::filesystem::path dbpath(storageGlobalParams.dbpath);
+    if (boost::filesystem::exists(dbpath / kStorageMetadataFileName)) {
+        filenames.push_back(kStorageMetadataFileName);
+    }
+
+    std::map<std::string, long long> fileSizes;
+    std::map<std::string, std::string> metadataFiles;
+    for (auto&& filename : filenames) {
+        if (isMetadataFile(filename)) {
+            const auto path = dbpath / filename;
+            std::ifstream file(path.string(), std::ios::binary);
+            std::string contents{std::istreambuf_iterator<char>(file),
+                                 std::istreambuf_iterator<char>()};
+            if (!file.is_open() || file.bad()) {
+                storageEngine->endNonBlockingBackup(opCtx);
+                uasserted(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Failed to read " << path.string());
+            }
+            fileSizes.emplace(filename, contents.size());
+            metadataFiles.emplace(filename, std::move(contents));
+            continue;
+        }
+
+        boost::system::error_code ec;
+        const long long fileSize = boost::filesystem::file_size(dbpath / filename, ec);
+        if (ec) {
+            storageEngine->endNonBlockingBackup(opCtx);
+            uasserted(ErrorCodes::FileNotOpen,
+                      str::stream() << "Failed to get the size of " << filename << ": "
+                                    << ec.message());
+        }
+        fileSizes.emplace(filename, fileSize);
+    }
+
+    BSONArrayBuilder filesBuilder(result->subarrayStart("files"));
+    for (auto&& file : fileSizes) {
+        filesBuilder.append(BSON("filename" << file.first << "fileSize" << file.second));
+    }
+    filesBuilder.doneFast();
+
+    if (auto checkpointTimestamp = storageEngine->getLastStableCheckpointTimestamp()) {
+        result->append("checkpointTimestamp", *checkpointTimestamp);
+    }
+
+    _backupId = OID::gen();
+    _fileSizes = std::move(fileSizes);
+    _metadataFiles = std::move(metadataFiles);
+    _lastUsed = Date_t::now();
+    log() << "Began file copy backup " << *_backupId << " of " << _fileSizes.size() << " files";
+    return *_backupId;
+}
+
+void FileCopyBackup::read(const OID& backupId,
+                          const std::string& filename,
+                          long long offset,
+                          long long length,
+                          BSONObjBuilder* result) {
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Invalid offset " << offset << " and length " << length,
+            offset >= 0 && length > 0);
+
+    long long fileSize;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        uassert(ErrorCodes::NoSuchKey,
+                str::stream() << "No file copy backup with id " << backupId,
+                _backupId && *_backupId == backupId);
+        auto it = _fileSizes.find(filename);
+        uassert(ErrorCodes::NoSuchKey,
+                str::stream() << filename << " is not part of file copy backup " << backupId,
+                it != _fileSizes.end());
+        fileSize = it->second;
+        _lastUsed = Date_t::now();
+
+        auto metadataFile = _metadataFiles.find(filename);
+        if (metadataFile != _metadataFiles.end()) {
+            const auto& contents = metadataFile->second;
+            const auto start = std::min<std::size_t>(offset, contents.size());
+            const auto data = contents.substr(start, std::min(length, kMaxReadBytes));
+            result->appendBinData("data", data.size(), BinDataGeneral, data.data());
+            result->append("eof", start + data.size() >= contents.size());
+            return;
+        }
+    }
+
+    // Files which keep growing during the backup, such as the journal, are only copied up to the
+    // size they had when it began.
+    const long long bytesToRead = std::min({length, kMaxReadBytes, fileSize - offset});
+    std::string data(std::max(bytesToRead, 0LL), '\0');
+    if (bytesToRead > 0) {
+        const auto path = boost::filesystem::path(storageGlobalParams.dbpath) / filename;
+        std::ifstream file(path.string(), std::ios::binary);
+        uassert(ErrorCodes::FileNotOpen,
+                str::stream() << "Failed to open " << path.string(),
+                file.is_open());
+        file.seekg(offset);
+        file.read(&data[0], bytesToRead);
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to read " << bytesToRead << " bytes at offset " << offset
+                              << " of "
+                              << path.string(),
+                file.gcount() == bytesToRead);
+    }
+
+    result->appendBinData("data", data.size(), BinDataGeneral, data.data());
+    result->append("eof", offset + static_cast<long long>(data.size()) >= fileSize);
+}
+
+void FileCopyBackup::end(OperationContext* opCtx, const OID& backupId) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    uassert(ErrorCodes::NoSuchKey,
+            str::stream() << "No file copy backup with id " << backupId,
+            _backupId && *_backupId == backupId);
+    _end_inlock(opCtx);
+    log() << "Ended file copy backup " << backupId;
+}
+
+void FileCopyBackup::endIfIdle(OperationContext* opCtx) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_backupId || !_isIdle_inlock()) {
+        return;
+    }
+    log() << "Ending file copy backup " << *_backupId << " which has been idle since "
+          << _lastUsed;
+    _end_inlock(opCtx);
+}
+
+bool FileCopyBackup::_isIdle_inlock() const {
+    return Date_t::now() - _lastUsed >= Seconds(fileCopyBackupIdleTimeoutSecs.load());
+}
+
+void FileCopyBackup::_end_inlock(OperationContext* opCtx) {
+    Lock::GlobalLock globalLock(opCtx, MODE_IX);
+    opCtx->getServiceContext()->getStorageEngine()->endNonBlockingBackup(opCtx);
+    _backupId = boost::none;
+    _fileSizes.clear();
+    _metadataFiles.clear();
+}
+
+OID parseBackupId(const BSONObj& cmdObj, StringData fieldName) {
+    auto elem = cmdObj[fieldName];
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "'" << fieldName << "' must be an ObjectId",
+            elem.type() == jstOID);
+    return elem.OID();
+}
+
+/**
+ * Begins a backup of this node's data files, returning its id and the files to copy:
+ *
+ * { beginFileCopyBackup: 1 }
+ */
+class CmdBeginFileCopyBackup : public ReplSetCommand {
+public:
+    CmdBeginFileCopyBackup() : ReplSetCommand("beginFileCopyBackup") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync.\n"
+               "{ beginFileCopyBackup: 1 }";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        auto backupId = fileCopyBackup.begin(opCtx, &result);
+        result.append("backupId", backupId);
+        return true;
+    }
+} cmdBeginFileCopyBackup;
+
+/**
+ * Reads part of a file in a backup:
+ *
+ * { readFileCopyBackupFile: <backupId>, filename: <string>, offset: <long>, length: <long> }
+ */
+class CmdReadFileCopyBackupFile : public ReplSetCommand {
+public:
+    CmdReadFileCopyBackupFile() : ReplSetCommand("readFileCopyBackupFile") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync.\n"
+               "{ readFileCopyBackupFile: <backupId>, filename: <string>, offset: <long>, "
+               "length: <long> }";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto backupId = parseBackupId(cmdObj, getName());
+        std::string filename;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "filename", &filename));
+        long long offset;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "offset", &offset));
+        long long length;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "length", &length));
+        fileCopyBackup.read(backupId, filename, offset, length, &result);
+        return true;
+    }
+} cmdReadFileCopyBackupFile;
+
+/**
+ * Ends a backup, allowing the storage engine to release the files in it:
+ *
+ * { endFileCopyBackup: <backupId> }
+ */
+class CmdEndFileCopyBackup : public ReplSetCommand {
+public:
+    CmdEndFileCopyBackup() : ReplSetCommand("endFileCopyBackup") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync.\n"
+               "{ endFileCopyBackup: <backupId> }";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        fileCopyBackup.end(opCtx, parseBackupId(cmdObj, getName()));
+        return true;
+    }
+} cmdEndFileCopyBackup;
+
+}  // namespace
+
+void shutdownFileCopyBackupReaper(ServiceContext* serviceContext) {
+    auto& reaper = getFileCopyBackupReaper(serviceContext);
+    stdx::lock_guard<stdx::mutex> lk(reaper.mutex);
+    reaper.inShutdown = true;
+    if (reaper.anchor) {
+        reaper.anchor.stop();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,344 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/file_copy_initial_syncer.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <set>
+
+#include "mongo/base/init.h"
+#include "mongo/db/repl/oplogreader.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/storage_file_util.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const char kLogicalInitialSyncMethodName[] = "logical";
+const char kFileCopyBasedInitialSyncMethodName[] = "fileCopyBased";
+
+// How a node with no data initially syncs. A file copy based initial sync copies the data files of
+// 'fileCopyInitialSyncSource' when the node starts, instead of cloning its data logically.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(initialSyncMethod,
+                                      std::string,
+                                      kLogicalInitialSyncMethodName);
+
+// The host and port of the node whose data files a file copy based initial sync copies. The
+// replica set config, which sync sources are normally chosen from, is stored in the data files.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(fileCopyInitialSyncSource, std::string, "");
+
+MONGO_INITIALIZER(initialSyncMethod)(InitializerContext*) {
+    if (initialSyncMethod != kLogicalInitialSyncMethodName &&
+        initialSyncMethod != kFileCopyBasedInitialSyncMethodName) {
+        return Status(ErrorCodes::BadValue,
+                      "unsupported initial sync method: " + initialSyncMethod);
+    }
+    if (initialSyncMethod == kFileCopyBasedInitialSyncMethodName) {
+        auto source = HostAndPort::parse(fileCopyInitialSyncSource);
+        if (!source.isOK()) {
+            return source.getStatus().withContext(
+                "fileCopyInitialSyncSource must name the node to copy data files from");
+        }
+    }
+    return Status::OK();
+}
+
+// The most bytes of a file requested by a single readFileCopyBackupFile command.
+const long long kReadChunkBytes = 8 * 1024 * 1024;
+
+// Marks a dbpath holding the partial result of a file copy based initial sync, which is removed
+// before copying the files again.
+const char kFileCopyIncompleteFileName[] = "_file_copy_initial_sync_incomplete";
+
+// The file recording the storage engine and its options. It is copied last, as a dbpath without it
+// holds no data.
+const char kStorageMetadataFileName[] = "storage.bson";
+
+const char kLockFileName[] = "mongod.lock";
+
+/**
+ * Removes everything in the dbpath but its lock file.
+ */
+Status removeCopiedFiles(const boost::filesystem::path& dbpath) {
+    try {
+        for (boost::filesystem::directory_iterator it(dbpath), end; it != end; ++it) {
+            if (it->path().filename() != kLockFileName) {
+                boost::filesystem::remove_all(it->path());
+            }
+        }
+    } catch (const boost::filesystem::filesystem_error& e) {
+        return Status(ErrorCodes::FileRenameFailed,
+                      str::stream() << "Failed to remove the files copied into " << dbpath.string()
+                                    << ": "
+                                    << e.what());
+    }
+    return Status::OK();
+}
+
+class FileCopier {
+public:
+    FileCopier(const HostAndPort& source, const boost::filesystem::path& dbpath)
+        : _source(source), _dbpath(dbpath) {}
+
+    /**
+     * Copies the files of a backup of the source into the dbpath.
+     */
+    Status run();
+
+private:
+    Status _copyFile(const OID& backupId, const std::string& filename, long long fileSize);
+
+    const HostAndPort _source;
+    const boost::filesystem::path _dbpath;
+    OplogReader _reader;
+    long long _bytesCopied = 0;
+};
+
+Status FileCopier::run() {
+    if (!_reader.connect(_source)) {
+        return Status(ErrorCodes::HostUnreachable,
+                      str::stream() << "Failed to connect to " << _source.toString());
+    }
+    auto conn = _reader.conn();
+
+    BSONObj beginResponse;
+    conn->runCommand("admin", BSON("beginFileCopyBackup" << 1), beginResponse);
+    auto status = getStatusFromCommandResult(beginResponse);
+    if (!status.isOK()) {
+        return status.withContext(str::stream() << "Failed to begin a backup of "
+                                                << _source.toString());
+    }
+    const auto backupId = beginResponse["backupId"].OID();
+    ON_BLOCK_EXIT([&] {
+        BSONObj endResponse;
+        conn->runCommand("admin", BSON("endFileCopyBackup" << backupId), endResponse);
+        auto endStatus = getStatusFromCommandResult(endResponse);
+        if (!endStatus.isOK()) {
+            warning() << "Failed to end file copy backup " << backupId << " on " << _source
+                      << ": " << redact(endStatus);
+        }
+    });
+
+    log() << "Copying the data files of " << _source << " from backup " << backupId
+          << " of the checkpoint at " << beginResponse["checkpointTimestamp"];
+
+    // The storage metadata file is copied last, once the dbpath holds all of the data.
+    std::vector<BSONObj> files;
+    BSONObj storageMetadataFile;
+    for (auto&& fileElem : beginResponse["files"].Obj()) {
+        auto file = fileElem.Obj();
+        if (file["filename"].str() == kStorageMetadataFileName) {
+            storageMetadataFile = file;
+        } else {
+            files.push_back(file);
+        }
+    }
+    if (!storageMetadataFile.isEmpty()) {
+        files.push_back(storageMetadataFile);
+    }
+
+    std::set<boost::filesystem::path> directories;
+    for (auto&& file : files) {
+        const auto filename = file["filename"].str();
+        auto status = _copyFile(backupId, filename, file["fileSize"].numberLong());
+        if (!status.isOK()) {
+            return status.withContext(str::stream() << "Failed to copy " << filename << " from "
+                                                    << _source.toString());
+        }
+        directories.insert(_dbpath / filename);
+    }
+
+    // Makes the new directory entries durable along with the files.
+    for (auto&& path : directories) {
+        auto status = fsyncParentDirectory(path);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    log() << "Copied " << files.size() << " data files (" << _bytesCopied << " bytes) from "
+          << _source;
+    return Status::OK();
+}
+
+Status FileCopier::_copyFile(const OID& backupId,
+                             const std::string& filename,
+                             long long fileSize) {
+    const auto path = _dbpath / filename;
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path.parent_path(), ec);
+    if (ec) {
+        return Status(ErrorCodes::FileOpenFailed,
+                      str::stream() << "Failed to create the directory for " << path.string()
+                                    << ": "
+                                    << ec.message());
+    }
+
+    boost::filesystem::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return Status(ErrorCodes::FileOpenFailed,
+                      str::stream() << "Failed to open " << path.string() << ": "
+                                    << errnoWithDescription());
+    }
+
+    long long offset = 0;
+    bool eof = fileSize == 0;
+    while (!eof) {
+        BSONObj response;
+        _reader.conn()->runCommand("admin",
+                                   BSON("readFileCopyBackupFile" << backupId << "filename"
+                                                                 << filename
+                                                                 << "offset"
+                                                                 << offset
+                                                                 << "length"
+                                                                 << kReadChunkBytes),
+                                   response);
+        auto status = getStatusFromCommandResult(response);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        int length = 0;
+        const char* data = response["data"].binData(length);
+        if (length == 0 && !response["eof"].trueValue()) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Read no data at offset " << offset);
+        }
+        out.write(data, length);
+        if (out.fail()) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Failed to write to " << path.string() << ": "
+                                        << errnoWithDescription());
+        }
+        offset += length;
+        _bytesCopied += length;
+        eof = response["eof"].trueValue();
+    }
+    out.close();
+    if (out.fail()) {
+        return Status(ErrorCodes::FileStreamFailed,
+                      str::stream() << "Failed to close " << path.string());
+    }
+    if (offset != fileSize) {
+        return Status(ErrorCodes::FileStreamFailed,
+                      str::stream() << "Copied " << offset << " bytes of " << filename
+                                    << ", expected "
+                                    << fileSize);
+    }
+    return fsyncFile(path);
+}
+
+Status touchFileCopyIncompleteFile(const boost::filesystem::path& path) {
+    boost::filesystem::ofstream fileStream(path);
+    fileStream << "This file indicates that a file copy based initial sync is in progress or "
+                  "incomplete.";
+    fileStream.close();
+    if (fileStream.fail()) {
+        return Status(ErrorCodes::FileStreamFailed,
+                      str::stream() << "Failed to write to file " << path.string() << ": "
+                                    << errnoWithDescription());
+    }
+    auto status = fsyncFile(path);
+    if (!status.isOK()) {
+        return status;
+    }
+    return fsyncParentDirectory(path);
+}
+
+}  // namespace
+
+void runFileCopyInitialSyncIfRequested() {
+    if (initialSyncMethod != kFileCopyBasedInitialSyncMethodName) {
+        return;
+    }
+    if (storageGlobalParams.engine != "wiredTiger") {
+        warning() << "File copy based initial sync requires the wiredTiger storage engine, "
+                     "falling back to logical initial sync";
+        return;
+    }
+
+    const boost::filesystem::path dbpath(storageGlobalParams.dbpath);
+    if (!boost::filesystem::exists(dbpath)) {
+        // Storage engine startup reports the missing dbpath.
+        return;
+    }
+
+    const auto incompleteFilePath = dbpath / kFileCopyIncompleteFileName;
+    if (boost::filesystem::exists(incompleteFilePath)) {
+        log() << "Removing the files of an incomplete file copy based initial sync from "
+              << dbpath.string();
+        fassertNoTrace(56870, removeCopiedFiles(dbpath));
+    } else if (boost::filesystem::exists(dbpath / kStorageMetadataFileName)) {
+        // The node already has data, whether it was copied or not.
+        return;
+    }
+
+    const auto source = uassertStatusOK(HostAndPort::parse(fileCopyInitialSyncSource));
+    log() << "Starting file copy based initial sync from " << source;
+    Timer timer;
+
+    fassertNoTrace(56871, touchFileCopyIncompleteFile(incompleteFilePath));
+    auto status = FileCopier(source, dbpath).run();
+    if (!status.isOK()) {
+        warning() << "File copy based initial sync from " << source
+                  << " failed, falling back to logical initial sync: " << redact(status);
+        fassertNoTrace(56872, removeCopiedFiles(dbpath));
+        return;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(incompleteFilePath, ec);
+    if (ec) {
+        severe() << "Failed to remove file " << incompleteFilePath.string() << ": "
+                 << ec.message();
+        fassertFailedNoTrace(56873);
+    }
+    fassertNoTrace(56874, fsyncParentDirectory(incompleteFilePath));
+
+    log() << "File copy based initial sync from " << source << " copied the data files in "
+          << timer.seconds() << " seconds. Startup recovery will replay the oplog from the "
+                                "checkpoint they hold.";
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,51 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Runs a file copy based initial sync if this node was started with the 'initialSyncMethod'
+ * server parameter set to "fileCopyBased" and its dbpath holds no data yet.
+ *
+ * Must be called before the storage engine is started. The data files of the node named by the
+ * 'fileCopyInitialSyncSource' server parameter are copied into the dbpath from a backup of its
+ * last checkpoint, along with its journal. Starting the storage engine on them then recovers that
+ * checkpoint, and startup recovery replays the copied oplog from the checkpoint timestamp on.
+ *
+ * If the copy fails, the files copied so far are removed and the node falls back to the logical
+ * initial sync it would do on an empty dbpath.
+ */
+void runFileCopyInitialSyncIfRequested();
+
+}  // namespace repl
+}  // namespace mongo
@@ -125,6 +125,9 @@ MONGO_FAIL_POINT_DEFINE(sleepBetweenInsertOpTimeGenerationAndLogOp);
  */
 Collection* _localOplogCollection = nullptr;
 
+// The OplogBatch, if any, which logOp() buffers the entries of its writes in.
+const auto getOplogBatch = OperationContext::declareDecoration<OplogBatch*>();
+
 PseudoRandom hashGenerator(std::unique_ptr<SecureRandom>(SecureRandom::create())->nextInt64());
 
 // Synchronizes the section where a new Timestamp is generated and when it is registered in the
@@ -177,6 +180,8 @@ void _getNextOpTimes(OperationContext* opCtx,
     }
 }
 
+}  // namespace
+
 /**
  * This allows us to stream the oplog entry directly into data region
  * main goal is to avoid copying the o portion
@@ -188,6 +193,10 @@ public:
     OplogDocWriter(BSONObj frame, BSONObj oField)
         : _frame(std::move(frame)), _oField(std::move(oField)) {}
 
+    OplogDocWriter getOwned() const {
+        return OplogDocWriter(_frame.getOwned(), _oField.getOwned());
+    }
+
     void writeDocument(char* start) const {
         char* buf = start;
 
@@ -215,6 +224,8 @@ private:
     BSONObj _oField;
 };
 
+namespace {
+
 bool shouldBuildInForeground(OperationContext* opCtx,
                              const BSONObj& index,
                              const NamespaceString& indexNss,
@@ -534,12 +545,16 @@ OpTime logOp(OperationContext* opCtx,
     }
 
     auto const oplog = _localOplogCollection;
+    auto const batch = OplogBatch::get(opCtx);
     OplogSlot slot;
+    bool batched = false;
     WriteUnitOfWork wuow(opCtx);
-    if (oplogSlot.opTime.isNull()) {
-        _getNextOpTimes(opCtx, oplog, 1, &slot);
-    } else {
+    if (!oplogSlot.opTime.isNull()) {
         slot = oplogSlot;
+    } else if (batch && batch->takeSlot(nss, &slot)) {
+        batched = true;
+    } else {
+        _getNextOpTimes(opCtx, oplog, 1, &slot);
     }
 
     auto writer = _logOpWriter(opCtx,
@@ -556,9 +571,14 @@ OpTime logOp(OperationContext* opCtx,
                                statementId,
                                oplogLink,
                                needsRetryImage);
-    const DocWriter* basePtr = &writer;
-    auto timestamp = slot.opTime.getTimestamp();
-    _logOpsInner(opCtx, nss, &basePtr, &timestamp, 1, oplog, slot.opTime);
+    if (batched) {
+        // 'obj' is only valid for the duration of this call.
+        batch->append(stdx::make_unique<OplogDocWriter>(writer.getOwned()), slot.opTime);
+    } else {
+        const DocWriter* basePtr = &writer;
+        auto timestamp = slot.opTime.getTimestamp();
+        _logOpsInner(opCtx, nss, &basePtr, &timestamp, 1, oplog, slot.opTime);
+    }
     wuow.commit();
     return slot.opTime;
 }
@@ -793,6 +813,83 @@ std::vector<OplogSlot> getNextOpTimes(OperationContext* opCtx, std::size_t count
     return oplogSlots;
 }
 
+OplogBatch::OplogBatch(OperationContext* opCtx, const NamespaceString& nss, std::size_t maxWrites)
+    : _opCtx(opCtx), _nss(nss) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(!getOplogBatch(opCtx));
+    if (!ReplicationCoordinator::get(opCtx)->isOplogDisabledFor(opCtx, nss) && maxWrites > 0) {
+        _slots = getNextOpTimes(opCtx, maxWrites);
+    }
+    getOplogBatch(opCtx) = this;
+}
+
+OplogBatch::~OplogBatch() {
+    getOplogBatch(_opCtx) = nullptr;
+}
+
+OplogBatch* OplogBatch::get(OperationContext* opCtx) {
+    return getOplogBatch(opCtx);
+}
+
+void OplogBatch::prepareForNextWrite() {
+    if (_slots.empty()) {
+        return;
+    }
+    // The previous write logged nothing, so its slot is skipped rather than shared.
+    if (_hasCurrentSlot) {
+        ++_nextSlot;
+    }
+    invariant(_nextSlot < _slots.size());
+    uassertStatusOK(
+        _opCtx->recoveryUnit()->setTimestamp(_slots[_nextSlot].opTime.getTimestamp()));
+    _hasCurrentSlot = true;
+}
+
+bool OplogBatch::takeSlot(const NamespaceString& nss, OplogSlot* slotOut) {
+    if (!_hasCurrentSlot || nss != _nss) {
+        return false;
+    }
+    *slotOut = _slots[_nextSlot++];
+    _hasCurrentSlot = false;
+    return true;
+}
+
+void OplogBatch::append(std::unique_ptr<OplogDocWriter> writer, const OpTime& opTime) {
+    _writers.push_back(std::move(writer));
+    _timestamps.push_back(opTime.getTimestamp());
+    _lastOpTime = opTime;
+}
+
+void OplogBatch::flush() {
+    _hasCurrentSlot = false;
+    if (_writers.empty()) {
+        return;
+    }
+
+    // Obtain Collection exclusive intent write lock for non-document-locking storage engines.
+    boost::optional<Lock::DBLock> dbWriteLock;
+    boost::optional<Lock::CollectionLock> collWriteLock;
+    if (!_opCtx->getServiceContext()->getStorageEngine()->supportsDocLocking()) {
+        dbWriteLock.emplace(_opCtx, NamespaceString::kLocalDb, MODE_IX);
+        collWriteLock.emplace(_opCtx->lockState(), _oplogCollectionName, MODE_IX);
+    }
+
+    std::vector<const DocWriter*> basePtrs;
+    basePtrs.reserve(_writers.size());
+    for (const auto& writer : _writers) {
+        basePtrs.push_back(writer.get());
+    }
+    _logOpsInner(_opCtx,
+                 _nss,
+                 basePtrs.data(),
+                 _timestamps.data(),
+                 _writers.size(),
+                 _localOplogCollection,
+                 _lastOpTime);
+    _writers.clear();
+    _timestamps.clear();
+}
+
 
 // -------------------------------------
 
@@ -1470,6 +1567,82 @@ Status applyOperation_inlock(OperationContext* opCtx,
                 });
             }
 
+            if (incrementOpsAppliedStats) {
+                incrementOpsAppliedStats();
+            }
+        }
+    } else if (*opType == 'u' && fieldO.type() == Array) {
+        // Batched updates, applied in order in a single storage transaction. Each write is
+        // timestamped with the timestamp of the update it came from.
+
+        // Cannot apply an array update with applyOps command, as with array inserts.
+        uassert(ErrorCodes::OperationFailed,
+                "Cannot apply an array update with applyOps",
+                !opCtx->writesAreReplicated());
+        uassert(ErrorCodes::BadValue,
+                "Expected array for field 'ts'",
+                fieldTs.ok() && fieldTs.type() == Array);
+        uassert(ErrorCodes::BadValue,
+                "Expected array for field 'o2'",
+                fieldO2.ok() && fieldO2.type() == Array);
+
+        const auto updates = fieldO.Array();
+        const auto timestamps = fieldTs.Array();
+        const auto criteria = fieldO2.Array();
+        uassert(ErrorCodes::OperationFailed,
+                str::stream() << "Failed to apply update due to invalid array elements: "
+                              << op.toString(),
+                !updates.empty() && updates.size() == timestamps.size() &&
+                    updates.size() == criteria.size());
+
+        const bool upsert = valueB || alwaysUpsert;
+        const StringData ns = fieldNs.valuestrsafe();
+        auto status = writeConflictRetry(opCtx, "applyOps_batchedUpdates", ns, [&] {
+            WriteUnitOfWork wuow(opCtx);
+            for (size_t i = 0; i < updates.size(); ++i) {
+                if (assignOperationTimestamp) {
+                    uassertStatusOK(
+                        opCtx->recoveryUnit()->setTimestamp(timestamps[i].timestamp()));
+                }
+
+                auto idField = criteria[i].Obj()["_id"];
+                uassert(ErrorCodes::NoSuchKey,
+                        str::stream() << "Failed to apply update due to missing _id: "
+                                      << op.toString(),
+                        !idField.eoo());
+
+                UpdateRequest request(requestNss);
+                request.setQuery(idField.wrap());
+                request.setUpdates(updates[i].Obj());
+                request.setUpsert(upsert);
+                request.setFromOplogApplication(true);
+
+                UpdateLifecycleImpl updateLifecycle(requestNss);
+                request.setLifecycle(&updateLifecycle);
+
+                // An update which would fail on its own fails the whole batch, whose updates are
+                // then applied one at a time.
+                UpdateResult ur = update(opCtx, db, request);
+                if (ur.numMatched == 0 && ur.upserted.isEmpty() && (ur.modifiers || !upsert)) {
+                    return Status(ErrorCodes::UpdateOperationFailed,
+                                  str::stream() << "failed to apply batched update of "
+                                                << redact(idField.wrap()));
+                }
+            }
+            wuow.commit();
+            return Status::OK();
+        });
+
+        if (!status.isOK()) {
+            return status;
+        }
+
+        for (size_t i = 0; i < updates.size(); ++i) {
+            opCounters->gotUpdate();
+            if (shouldUseGlobalOpCounters) {
+                ServerWriteConcernMetrics::get(opCtx)->recordWriteConcernForUpdate(
+                    opCtx->getWriteConcern());
+            }
             if (incrementOpsAppliedStats) {
                 incrementOpsAppliedStats();
             }
@@ -1585,6 +1758,57 @@ Status applyOperation_inlock(OperationContext* opCtx,
         if (incrementOpsAppliedStats) {
             incrementOpsAppliedStats();
         }
+    } else if (*opType == 'd' && opType[1] == 0 && fieldO.type() == Array) {
+        // Batched deletes, applied in order in a single storage transaction. Each write is
+        // timestamped with the timestamp of the delete it came from.
+
+        // Cannot apply an array delete with applyOps command, as with array inserts.
+        uassert(ErrorCodes::OperationFailed,
+                "Cannot apply an array delete with applyOps",
+                !opCtx->writesAreReplicated());
+        uassert(ErrorCodes::BadValue,
+                "Expected array for field 'ts'",
+                fieldTs.ok() && fieldTs.type() == Array);
+
+        const auto deletes = fieldO.Array();
+        const auto timestamps = fieldTs.Array();
+        uassert(ErrorCodes::OperationFailed,
+                str::stream() << "Failed to apply delete due to invalid array elements: "
+                              << op.toString(),
+                !deletes.empty() && deletes.size() == timestamps.size());
+
+        const StringData ns = fieldNs.valuestrsafe();
+        writeConflictRetry(opCtx, "applyOps_batchedDeletes", ns, [&] {
+            WriteUnitOfWork wuow(opCtx);
+            for (size_t i = 0; i < deletes.size(); ++i) {
+                if (assignOperationTimestamp) {
+                    uassertStatusOK(
+                        opCtx->recoveryUnit()->setTimestamp(timestamps[i].timestamp()));
+                }
+
+                auto idField = deletes[i].Obj()["_id"];
+                uassert(ErrorCodes::NoSuchKey,
+                        str::stream() << "Failed to apply delete due to missing _id: "
+                                      << op.toString(),
+                        !idField.eoo());
+
+                DeleteRequest request(requestNss);
+                request.setQuery(idField.wrap());
+                deleteObject(opCtx, collection, request);
+            }
+            wuow.commit();
+        });
+
+        for (size_t i = 0; i < deletes.size(); ++i) {
+            opCounters->gotDelete();
+            if (shouldUseGlobalOpCounters) {
+                ServerWriteConcernMetrics::get(opCtx)->recordWriteConcernForDelete(
+                    opCtx->getWriteConcern());
+            }
+            if (incrementOpsAppliedStats) {
+                incrementOpsAppliedStats();
+            }
+        }
     } else if (*opType == 'd') {
         opCounters->gotDelete();
         if (shouldUseGlobalOpCounters) {
@@ -30,14 +30,17 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/logical_session_id.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -46,7 +49,6 @@
 namespace mongo {
 class Collection;
 class Database;
-class NamespaceString;
 class OperationContext;
 class OperationSessionInfo;
 class Session;
@@ -75,6 +77,7 @@ public:
 };
 
 namespace repl {
+class OplogDocWriter;
 class ReplSettings;
 
 struct OplogLink {
@@ -288,5 +291,58 @@ OplogSlot getNextOpTime(OperationContext* opCtx);
 OplogSlot getNextOpTimeNoPersistForTesting(OperationContext* opCtx);
 std::vector<OplogSlot> getNextOpTimes(OperationContext* opCtx, std::size_t count);
 
+/**
+ * Gives each of many document writes to one collection in a single WriteUnitOfWork its own oplog
+ * slot, and inserts their oplog entries into the oplog together.
+ *
+ * Must be constructed inside the WriteUnitOfWork, which reserves 'maxWrites' slots. Call
+ * prepareForNextWrite() right before each document write so that the write is timestamped with
+ * the next slot; the logOp() for that write then uses the slot and buffers its entry. Call flush()
+ * before committing the WriteUnitOfWork. Slots left unused are never written, which is harmless.
+ */
+class OplogBatch {
+    MONGO_DISALLOW_COPYING(OplogBatch);
+
+public:
+    OplogBatch(OperationContext* opCtx, const NamespaceString& nss, std::size_t maxWrites);
+    ~OplogBatch();
+
+    static OplogBatch* get(OperationContext* opCtx);
+
+    /**
+     * Timestamps the next document write with the next reserved slot. Does nothing if writes to
+     * the collection are not replicated.
+     */
+    void prepareForNextWrite();
+
+    /**
+     * Used by logOp(). Returns false unless an entry for 'nss' may use the slot handed out by the
+     * last prepareForNextWrite(), in which case the slot is returned in 'slotOut' and consumed.
+     */
+    bool takeSlot(const NamespaceString& nss, OplogSlot* slotOut);
+
+    /**
+     * Used by logOp(). Buffers the entry written for a slot returned by takeSlot().
+     */
+    void append(std::unique_ptr<OplogDocWriter> writer, const OpTime& opTime);
+
+    /**
+     * Inserts the buffered entries into the oplog.
+     */
+    void flush();
+
+private:
+    OperationContext* const _opCtx;
+    const NamespaceString _nss;
+
+    std::vector<OplogSlot> _slots;
+    std::size_t _nextSlot = 0;
+    bool _hasCurrentSlot = false;
+
+    std::vector<std::unique_ptr<OplogDocWriter>> _writers;
+    std::vector<Timestamp> _timestamps;
+    OpTime _lastOpTime;
+};
+
 }  // namespace repl
 }  // namespace mongo
@@ -149,5 +149,9 @@ StatusWith<OpTime> OplogApplier::multiApply(OperationContext* opCtx, Operations
     return lastApplied;
 }
 
+OplogApplier::BatchPhaseTimes OplogApplier::getLastBatchPhaseTimes() const {
+    return _syncTail->getLastBatchPhaseTimes();
+}
+
 }  // namespace repl
 }  // namespace mongo
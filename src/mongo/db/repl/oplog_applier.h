@@ -45,6 +45,7 @@
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/future.h"
 
 namespace mongo {
@@ -83,6 +84,23 @@ public:
         boost::optional<Date_t> slaveDelayLatestTimestamp = {};
     };
 
+    /**
+     * How long each phase of applying a batch of operations with multiApply() took.
+     */
+    class BatchPhaseTimes {
+    public:
+        // Acquiring the parallel batch writer lock.
+        Microseconds lock{0};
+        // Assigning the operations to writer partitions, while the oplog is written concurrently.
+        Microseconds partition{0};
+        // Waiting for the oplog writes still outstanding after partitioning.
+        Microseconds waitForOplogWrites{0};
+        // Applying the partitions on the writer threads.
+        Microseconds apply{0};
+        // Everything else, such as updating multikey paths and notifying the storage engine.
+        Microseconds finish{0};
+    };
+
     // Used to report oplog application progress.
     class Observer;
 
@@ -148,6 +166,11 @@ public:
      */
     StatusWith<OpTime> multiApply(OperationContext* opCtx, Operations ops);
 
+    /**
+     * Returns how long the phases of the last batch applied by multiApply() took.
+     */
+    BatchPhaseTimes getLastBatchPhaseTimes() const;
+
 private:
     // Used to schedule task for oplog application loop.
     // Not owned by us.
@@ -0,0 +1,130 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// The fetcher pushes the entries of a batch together, and the applier's batcher peeks at and then
+// pops entries one at a time.
+const std::size_t kFetchedBatchSize = 100;
+
+OplogBuffer::Batch makeFetchedBatch() {
+    OplogBuffer::Batch batch;
+    for (std::size_t i = 0; i < kFetchedBatchSize; ++i) {
+        batch.push_back(BSON("ts" << Timestamp(1, i) << "t" << 1LL << "h" << 0LL << "v" << 2
+                                  << "op"
+                                  << "i"
+                                  << "ns"
+                                  << "test.coll"
+                                  << "o"
+                                  << BSON("_id" << static_cast<int>(i) << "x" << 1)));
+    }
+    return batch;
+}
+
+bool popOne(OplogBuffer* buffer) {
+    BSONObj value;
+    if (!buffer->peek(nullptr, &value)) {
+        return false;
+    }
+    benchmark::DoNotOptimize(value);
+    return buffer->tryPop(nullptr, &value);
+}
+
+template <typename Buffer>
+void BM_PushThenPopOnOneThread(benchmark::State& state) {
+    Buffer buffer;
+    const auto batch = makeFetchedBatch();
+    for (auto keepRunning : state) {
+        buffer.pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+        while (popOne(&buffer)) {
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+
+template <typename Buffer>
+void BM_ProducerAndConsumerThreads(benchmark::State& state) {
+    const auto batch = makeFetchedBatch();
+    const std::size_t numBatches = state.range(0);
+    std::size_t batchBytes = 0;
+    for (auto&& entry : batch) {
+        batchBytes += entry.objsize();
+    }
+
+    for (auto keepRunning : state) {
+        // The ring buffer allocates all of its slots up front.
+        state.PauseTiming();
+        auto buffer = stdx::make_unique<Buffer>();
+        state.ResumeTiming();
+
+        stdx::thread producer([&] {
+            for (std::size_t i = 0; i < numBatches; ++i) {
+                buffer->waitForSpace(nullptr, batchBytes);
+                buffer->pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+            }
+        });
+
+        for (std::size_t popped = 0; popped < numBatches * batch.size();) {
+            if (popOne(buffer.get())) {
+                ++popped;
+            } else {
+                buffer->waitForData(Seconds(1));
+            }
+        }
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * numBatches * batch.size());
+}
+
+BENCHMARK_TEMPLATE(BM_PushThenPopOnOneThread, OplogBufferBlockingQueue);
+BENCHMARK_TEMPLATE(BM_PushThenPopOnOneThread, OplogBufferRingBuffer);
+
+BENCHMARK_TEMPLATE(BM_ProducerAndConsumerThreads, OplogBufferBlockingQueue)
+    ->Arg(1000)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProducerAndConsumerThreads, OplogBufferRingBuffer)
+    ->Arg(1000)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,312 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
+
+#include <iterator>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+size_t getDocumentSize(const BSONObj& o) {
+    // SERVER-9808 Avoid Fortify complaint about implicit signed->unsigned conversion
+    return static_cast<size_t>(o.objsize());
+}
+
+}  // namespace
+
+class OplogBufferRingBuffer::ConsumerGuard {
+public:
+    explicit ConsumerGuard(OplogBufferRingBuffer* buffer) : _buffer(buffer) {
+        _buffer->_consumerActive.store(true);
+        while (_buffer->_consumerExcluded.load()) {
+            _buffer->_consumerActive.store(false);
+            {
+                stdx::unique_lock<stdx::mutex> lk(_buffer->_mutex);
+                _buffer->_consumerAdmittedCv.wait(
+                    lk, [this] { return !_buffer->_consumerExcluded.load(); });
+            }
+            _buffer->_consumerActive.store(true);
+        }
+    }
+
+    ~ConsumerGuard() {
+        _buffer->_consumerActive.store(false);
+    }
+
+private:
+    OplogBufferRingBuffer* const _buffer;
+};
+
+OplogBufferRingBuffer::OplogBufferRingBuffer()
+    : OplogBufferRingBuffer(kDefaultMaxSize, kDefaultInitialCount) {}
+
+OplogBufferRingBuffer::OplogBufferRingBuffer(std::size_t maxSize, std::size_t initialCount)
+    : _maxSize(maxSize), _mask(initialCount - 1), _slots(initialCount) {
+    invariant(initialCount > 0 && (initialCount & _mask) == 0);
+}
+
+void OplogBufferRingBuffer::startup(OperationContext*) {}
+
+void OplogBufferRingBuffer::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferRingBuffer::pushEvenIfFull(OperationContext*, const Value& value) {
+    invariant(!_drainMode.load());
+    _reserveSlots(1);
+    const auto writeIndex = _writeIndex.load();
+    _pushUnpublished(value, writeIndex);
+    _lastPushed = value;
+    _publish(writeIndex + 1, getDocumentSize(value));
+}
+
+void OplogBufferRingBuffer::push(OperationContext*, const Value& value) {
+    invariant(!_drainMode.load());
+    const auto size = getDocumentSize(value);
+    _waitForSpace(size);
+    _reserveSlots(1);
+    const auto writeIndex = _writeIndex.load();
+    _pushUnpublished(value, writeIndex);
+    _lastPushed = value;
+    _publish(writeIndex + 1, size);
+}
+
+void OplogBufferRingBuffer::pushAllNonBlocking(OperationContext*,
+                                               Batch::const_iterator begin,
+                                               Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+    invariant(!_drainMode.load());
+
+    _reserveSlots(std::distance(begin, end));
+    auto writeIndex = _writeIndex.load();
+    std::size_t bytes = 0;
+    for (auto it = begin; it != end; ++it) {
+        _pushUnpublished(*it, writeIndex++);
+        bytes += getDocumentSize(*it);
+    }
+    _lastPushed = *(end - 1);
+    _publish(writeIndex, bytes);
+}
+
+void OplogBufferRingBuffer::waitForSpace(OperationContext*, std::size_t size) {
+    _waitForSpace(size);
+}
+
+bool OplogBufferRingBuffer::isEmpty() const {
+    return _readIndex.load() == _writeIndex.load();
+}
+
+std::size_t OplogBufferRingBuffer::getMaxSize() const {
+    return _maxSize;
+}
+
+std::size_t OplogBufferRingBuffer::getSize() const {
+    return _size.load();
+}
+
+std::size_t OplogBufferRingBuffer::getCount() const {
+    // Load the consumer's index first, as it never passes the producer's.
+    const auto readIndex = _readIndex.load();
+    return _writeIndex.load() - readIndex;
+}
+
+std::size_t OplogBufferRingBuffer::getCapacity() const {
+    return _slots.size();
+}
+
+void OplogBufferRingBuffer::clear(OperationContext*) {
+    stdx::lock_guard<stdx::mutex> exclusionLk(_exclusionMutex);
+    _excludeConsumer();
+
+    // Entries the producer pushes from now on are kept.
+    auto readIndex = _readIndex.load();
+    const auto writeIndex = _writeIndex.load();
+    std::size_t bytes = 0;
+    for (; readIndex != writeIndex; ++readIndex) {
+        auto& slot = _slots[readIndex & _mask];
+        bytes += getDocumentSize(slot);
+        slot = Value();
+    }
+    _releaseFront(readIndex, bytes);
+    _admitConsumer();
+}
+
+bool OplogBufferRingBuffer::tryPop(OperationContext*, Value* value) {
+    ConsumerGuard guard(this);
+    const auto readIndex = _readIndex.load();
+    if (readIndex == _writeIndex.load()) {
+        return false;
+    }
+
+    auto& slot = _slots[readIndex & _mask];
+    *value = std::move(slot);
+    slot = Value();
+    _releaseFront(readIndex + 1, getDocumentSize(*value));
+    return true;
+}
+
+bool OplogBufferRingBuffer::waitForData(Seconds waitDuration) {
+    if (!isEmpty()) {
+        return true;
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _consumerWaiting.store(true);
+    _notEmptyCv.wait_for(lk, waitDuration.toSystemDuration(), [this] {
+        return _drainMode.load() || !isEmpty();
+    });
+    _consumerWaiting.store(false);
+    return !isEmpty();
+}
+
+bool OplogBufferRingBuffer::peek(OperationContext*, Value* value) {
+    ConsumerGuard guard(this);
+    const auto readIndex = _readIndex.load();
+    if (readIndex == _writeIndex.load()) {
+        return false;
+    }
+
+    *value = _slots[readIndex & _mask];
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferRingBuffer::lastObjectPushed(
+    OperationContext*) const {
+    if (isEmpty()) {
+        return {};
+    }
+    return _lastPushed;
+}
+
+void OplogBufferRingBuffer::enterDrainMode() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _drainMode.store(true);
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferRingBuffer::exitDrainMode() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _drainMode.store(false);
+}
+
+void OplogBufferRingBuffer::_pushUnpublished(const Value& value, unsigned long long writeIndex) {
+    _slots[writeIndex & _mask] = value;
+}
+
+void OplogBufferRingBuffer::_publish(unsigned long long writeIndex, std::size_t bytes) {
+    // Account for the entries before the consumer can see them, so that it never releases more
+    // bytes than have been added.
+    _size.fetchAndAdd(bytes);
+    _writeIndex.store(writeIndex);
+
+    // Pairs with the consumer setting '_consumerWaiting' before checking for data. All the loads
+    // and stores involved are sequentially consistent, so either the consumer sees the new entries
+    // or this sees that the consumer is about to sleep.
+    if (_consumerWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _notEmptyCv.notify_one();
+    }
+}
+
+void OplogBufferRingBuffer::_waitForSpace(std::size_t size) {
+    auto hasSpace = [&] { return _size.load() + size <= _maxSize; };
+    if (hasSpace()) {
+        return;
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _producerWaiting.store(true);
+    _notFullCv.wait(lk, hasSpace);
+    _producerWaiting.store(false);
+}
+
+void OplogBufferRingBuffer::_reserveSlots(std::size_t count) {
+    if (_writeIndex.load() - _readIndex.load() + count <= _slots.size()) {
+        return;
+    }
+
+    stdx::lock_guard<stdx::mutex> exclusionLk(_exclusionMutex);
+    _excludeConsumer();
+
+    // Neither index moves while the consumer is excluded and clear() is held off.
+    const auto readIndex = _readIndex.load();
+    const auto writeIndex = _writeIndex.load();
+    auto capacity = _slots.size();
+    while (writeIndex - readIndex + count > capacity) {
+        capacity *= 2;
+    }
+
+    std::vector<Value> slots(capacity);
+    const auto mask = capacity - 1;
+    for (auto index = readIndex; index != writeIndex; ++index) {
+        slots[index & mask] = std::move(_slots[index & _mask]);
+    }
+    _slots.swap(slots);
+    _mask = mask;
+
+    _admitConsumer();
+}
+
+void OplogBufferRingBuffer::_excludeConsumer() {
+    _consumerExcluded.store(true);
+    while (_consumerActive.load()) {
+        stdx::this_thread::yield();
+    }
+}
+
+void OplogBufferRingBuffer::_admitConsumer() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _consumerExcluded.store(false);
+    _consumerAdmittedCv.notify_all();
+}
+
+void OplogBufferRingBuffer::_releaseFront(unsigned long long readIndex, std::size_t bytes) {
+    _readIndex.store(readIndex);
+    _size.subtractAndFetch(bytes);
+
+    // Pairs with the producer setting '_producerWaiting' in _waitForSpace().
+    if (_producerWaiting.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _notFullCv.notify_one();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,185 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer backed by a ring of BSONObj slots allocated up front.
+ *
+ * The single producer and single consumer allowed by the OplogBuffer interface each advance their
+ * own index into the ring and only synchronize through atomics, so pushing and popping an entry
+ * neither takes a lock nor allocates. A mutex is only taken to sleep when the buffer is full or
+ * empty, and to wake the other side up when it is sleeping.
+ *
+ * The buffer is bounded by the total size of the entries it holds, like OplogBufferBlockingQueue.
+ * When the ring runs out of slots before that, the producer doubles it rather than wait, so that
+ * pushAllNonBlocking() and pushEvenIfFull() never block. The consumer is excluded while the
+ * entries are moved to the new ring.
+ *
+ * clear() and shutdown() may be called from any thread. They exclude the consumer while they
+ * discard the buffered entries.
+ */
+class OplogBufferRingBuffer final : public OplogBuffer {
+public:
+    // Limit buffer to 256MB, like OplogBufferBlockingQueue.
+    static const std::size_t kDefaultMaxSize = 256 * 1024 * 1024;
+
+    // Must be a power of two.
+    static const std::size_t kDefaultInitialCount = 512 * 1024;
+
+    OplogBufferRingBuffer();
+    OplogBufferRingBuffer(std::size_t maxSize, std::size_t initialCount);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void pushEvenIfFull(OperationContext* opCtx, const Value& value) override;
+    void push(OperationContext* opCtx, const Value& value) override;
+    void pushAllNonBlocking(OperationContext* opCtx,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+
+    /**
+     * May only be called by the producer.
+     */
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    /**
+     * Returns the number of slots in the ring. May only be called by the producer.
+     */
+    std::size_t getCapacity() const;
+
+    // In drain mode, waitForData() does not block. It is the responsibility of the caller to ensure
+    // that no items are added to the queue while in drain mode; this is enforced by invariant().
+    void enterDrainMode() final;
+    void exitDrainMode() final;
+
+private:
+    /**
+     * Pushes 'value' into the slot at the producer's index. Does not publish it to the consumer.
+     */
+    void _pushUnpublished(const Value& value, unsigned long long writeIndex);
+
+    /**
+     * Makes the entries pushed up to 'writeIndex' visible to the consumer and wakes it up if it is
+     * waiting for data.
+     */
+    void _publish(unsigned long long writeIndex, std::size_t bytes);
+
+    /**
+     * Waits until the buffered entries leave room for 'size' more bytes.
+     */
+    void _waitForSpace(std::size_t size);
+
+    /**
+     * Grows the ring, if need be, so that it has at least 'count' free slots. May only be called
+     * by the producer.
+     */
+    void _reserveSlots(std::size_t count);
+
+    /**
+     * Advances the consumer's index to 'readIndex', releasing entries totalling 'bytes', and wakes
+     * up the producer if it is waiting for space. The slots must already have been emptied.
+     */
+    void _releaseFront(unsigned long long readIndex, std::size_t bytes);
+
+    /**
+     * Waits for the consumer to finish any peek or pop in progress and keeps it from starting
+     * another until _admitConsumer() is called. The caller must hold '_exclusionMutex'.
+     */
+    void _excludeConsumer();
+    void _admitConsumer();
+
+    /**
+     * Marks the consumer as active for the lifetime of the object, waiting while it is excluded.
+     */
+    class ConsumerGuard;
+
+    const std::size_t _maxSize;
+
+    // Only replaced by the producer while the consumer is excluded.
+    std::size_t _mask;
+    std::vector<Value> _slots;
+
+    // Index of the next slot the producer will fill. Only written by the producer.
+    CacheAligned<AtomicUInt64> _writeIndex;
+
+    // Index of the next slot the consumer will pop. Only written by the consumer, or by clear()
+    // while the consumer is excluded.
+    CacheAligned<AtomicUInt64> _readIndex;
+
+    // Total size of the entries between '_readIndex' and '_writeIndex'.
+    CacheAligned<AtomicUInt64> _size;
+
+    // The last entry pushed. Only accessed by the producer.
+    Value _lastPushed;
+
+    // Set while the consumer is peeking or popping, and while it is excluded by clear() or by the
+    // producer growing the ring. Together they keep the consumer from touching the ring at the
+    // same time as either of those.
+    AtomicWord<bool> _consumerActive{false};
+    AtomicWord<bool> _consumerExcluded{false};
+
+    // Set while either side sleeps, so that the other side only takes '_mutex' to wake it up.
+    AtomicWord<bool> _producerWaiting{false};
+    AtomicWord<bool> _consumerWaiting{false};
+
+    AtomicWord<bool> _drainMode{false};
+
+    // Serializes calls to clear() with each other and with growing the ring.
+    stdx::mutex _exclusionMutex;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _notFullCv;
+    stdx::condition_variable _notEmptyCv;
+    stdx::condition_variable _consumerAdmittedCv;
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,215 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeEntry(int i) {
+    return BSON("_id" << i);
+}
+
+const std::size_t kEntrySize = makeEntry(0).objsize();
+
+TEST(OplogBufferRingBufferTest, PushAndPopEntriesInOrderWithSizeAndCount) {
+    OplogBufferRingBuffer buffer(1024, 8);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(1024U, buffer.getMaxSize());
+    ASSERT_EQUALS(8U, buffer.getCapacity());
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+
+    buffer.push(nullptr, makeEntry(0));
+    buffer.pushEvenIfFull(nullptr, makeEntry(1));
+    OplogBuffer::Batch batch = {makeEntry(2), makeEntry(3)};
+    buffer.pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+
+    ASSERT_FALSE(buffer.isEmpty());
+    ASSERT_EQUALS(4U, buffer.getCount());
+    ASSERT_EQUALS(4 * kEntrySize, buffer.getSize());
+    ASSERT_BSONOBJ_EQ(makeEntry(3), *buffer.lastObjectPushed(nullptr));
+
+    BSONObj value;
+    ASSERT_TRUE(buffer.peek(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(makeEntry(0), value);
+    ASSERT_EQUALS(4U, buffer.getCount());
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(makeEntry(i), value);
+        ASSERT_EQUALS(std::size_t(3 - i), buffer.getCount());
+        ASSERT_EQUALS((3 - i) * kEntrySize, buffer.getSize());
+    }
+
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_FALSE(buffer.peek(nullptr, &value));
+    ASSERT_FALSE(buffer.tryPop(nullptr, &value));
+    ASSERT_BSONOBJ_EQ(makeEntry(3), value);
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+}
+
+TEST(OplogBufferRingBufferTest, EntriesWrapAroundTheRing) {
+    OplogBufferRingBuffer buffer(1024, 4);
+    BSONObj value;
+    for (int i = 0; i < 20; i += 2) {
+        buffer.push(nullptr, makeEntry(i));
+        buffer.push(nullptr, makeEntry(i + 1));
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(makeEntry(i), value);
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(makeEntry(i + 1), value);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+}
+
+TEST(OplogBufferRingBufferTest, PushWaitsForConsumerToMakeRoom) {
+    // Room for two entries by size.
+    OplogBufferRingBuffer buffer(2 * kEntrySize, 8);
+    buffer.push(nullptr, makeEntry(0));
+    buffer.push(nullptr, makeEntry(1));
+
+    stdx::thread producer([&] { buffer.push(nullptr, makeEntry(2)); });
+
+    BSONObj value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    producer.join();
+    ASSERT_EQUALS(2U, buffer.getCount());
+}
+
+TEST(OplogBufferRingBufferTest, PushesGrowTheRingInsteadOfWaitingForFreeSlots) {
+    // The size limit is ignored by pushAllNonBlocking() and pushEvenIfFull(), and neither waits
+    // for the consumer when the two slots of the ring are used up.
+    OplogBufferRingBuffer buffer(kEntrySize, 2);
+    buffer.pushEvenIfFull(nullptr, makeEntry(0));
+    BSONObj value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+
+    // Leave the entries wrapped around the end of the ring before it grows.
+    OplogBuffer::Batch pushed;
+    for (int i = 1; i < 6; ++i) {
+        pushed.push_back(makeEntry(i));
+    }
+    buffer.pushEvenIfFull(nullptr, pushed[0]);
+    buffer.pushEvenIfFull(nullptr, pushed[1]);
+    buffer.pushAllNonBlocking(nullptr, pushed.cbegin() + 2, pushed.cend());
+    ASSERT_EQUALS(8U, buffer.getCapacity());
+    ASSERT_EQUALS(5U, buffer.getCount());
+    ASSERT_EQUALS(5 * kEntrySize, buffer.getSize());
+
+    for (auto&& entry : pushed) {
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(entry, value);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+}
+
+TEST(OplogBufferRingBufferTest, WaitForDataReturnsWhenEntryIsPushedOrInDrainMode) {
+    OplogBufferRingBuffer buffer(1024, 8);
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+
+    stdx::thread producer([&] { buffer.push(nullptr, makeEntry(0)); });
+    ASSERT_TRUE(buffer.waitForData(Seconds(10)));
+    producer.join();
+
+    BSONObj value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+
+    buffer.enterDrainMode();
+    ASSERT_FALSE(buffer.waitForData(Seconds(10)));
+    buffer.exitDrainMode();
+}
+
+TEST(OplogBufferRingBufferTest, ClearDiscardsEntriesAndUnblocksProducer) {
+    OplogBufferRingBuffer buffer(2 * kEntrySize, 8);
+    buffer.push(nullptr, makeEntry(0));
+    buffer.push(nullptr, makeEntry(1));
+
+    stdx::thread producer([&] { buffer.push(nullptr, makeEntry(2)); });
+    buffer.clear(nullptr);
+    producer.join();
+
+    // The entry pushed after clearing may or may not have been discarded.
+    ASSERT_LESS_THAN_OR_EQUALS(buffer.getCount(), 1U);
+    ASSERT_EQUALS(buffer.getCount() * kEntrySize, buffer.getSize());
+    BSONObj value;
+    if (buffer.tryPop(nullptr, &value)) {
+        ASSERT_BSONOBJ_EQ(makeEntry(2), value);
+    }
+
+    buffer.shutdown(nullptr);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+}
+
+TEST(OplogBufferRingBufferTest, ConcurrentProducerAndConsumerSeeEveryEntryInOrder) {
+    const int kNumEntries = 100 * 1000;
+    OplogBufferRingBuffer buffer(64 * kEntrySize, 16);
+
+    stdx::thread producer([&] {
+        OplogBuffer::Batch batch;
+        for (int i = 0; i < kNumEntries; ++i) {
+            batch.push_back(makeEntry(i));
+            if (batch.size() == 10) {
+                buffer.waitForSpace(nullptr, 10 * kEntrySize);
+                buffer.pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+                batch.clear();
+            }
+        }
+    });
+
+    int next = 0;
+    BSONObj value;
+    while (next < kNumEntries) {
+        if (!buffer.waitForData(Seconds(10))) {
+            break;
+        }
+        ASSERT_TRUE(buffer.peek(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(makeEntry(next), value);
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+        ASSERT_BSONOBJ_EQ(makeEntry(next), value);
+        ++next;
+    }
+    producer.join();
+
+    ASSERT_EQUALS(kNumEntries, next);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+}
+
+}  // namespace
@@ -38,6 +38,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/util/assert_util.h"
@@ -66,6 +67,11 @@ ServerStatusMetricField<Counter64> displayOpsRead("repl.network.ops", &opsReadSt
 Counter64 networkByteStats;
 ServerStatusMetricField<Counter64> displayBytesRead("repl.network.bytes", &networkByteStats);
 
+// Whether to request the next batch of oplog entries from the sync source while the current batch
+// is being validated and buffered, rather than after. Only one batch is read ahead, so a full oplog
+// buffer still stops the fetcher from requesting more.
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherReadAhead, bool, false);
+
 const Milliseconds maximumAwaitDataTimeoutMS(30 * 1000);
 
 /**
@@ -529,5 +535,23 @@ StatusWith<BSONObj> OplogFetcher::_onSuccessfulBatch(const Fetcher::QueryRespons
                                     _getGetMoreMaxTime(),
                                     _batchSize);
 }
+
+BSONObj OplogFetcher::_makeReadAheadGetMoreCommandObject(
+    const Fetcher::QueryResponse& queryResponse) const {
+    if (!oplogFetcherReadAhead.load()) {
+        return BSONObj();
+    }
+
+    // The term and commit point sent here may be one batch behind those in the getMore that
+    // _onSuccessfulBatch() would return. They only serve to wake up the sync source early and let
+    // it report a newer term, and the getMore sent after the next batch carries the current ones.
+    auto lastCommittedWithCurrentTerm =
+        _dataReplicatorExternalState->getCurrentTermAndLastCommittedOpTime();
+    return makeGetMoreCommandObject(queryResponse.nss,
+                                    queryResponse.cursorId,
+                                    lastCommittedWithCurrentTerm,
+                                    _getGetMoreMaxTime(),
+                                    _batchSize);
+}
 }  // namespace repl
 }  // namespace mongo
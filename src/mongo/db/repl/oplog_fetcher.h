@@ -160,6 +160,13 @@ private:
      */
     StatusWith<BSONObj> _onSuccessfulBatch(const Fetcher::QueryResponse& queryResponse) override;
 
+    /**
+     * Sends the `getMore` for the next batch while this one is processed when
+     * 'oplogFetcherReadAhead' is enabled.
+     */
+    BSONObj _makeReadAheadGetMoreCommandObject(
+        const Fetcher::QueryResponse& queryResponse) const override;
+
     // The metadata object sent with the Fetcher queries.
     const BSONObj _metadataObject;
 
@@ -67,6 +67,7 @@
 #include "mongo/db/repl/noop_writer.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_ring_buffer.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_metrics.h"
@@ -149,6 +150,10 @@ MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherInitialSyncMaxFetcherRestarts, int, 10
         return Status::OK();
     });
 
+// Set this to buffer fetched oplog entries in a lock-free ring buffer instead of a blocking queue
+// during steady state replication.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(oplogBufferUseRingBuffer, bool, false);
+
 /**
  * Returns new thread pool for thread pool task executor.
  */
@@ -227,7 +232,11 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
     invariant(replCoord);
     invariant(!_bgSync);
     log() << "Starting replication fetcher thread";
-    _oplogBuffer = stdx::make_unique<OplogBufferBlockingQueue>();
+    if (oplogBufferUseRingBuffer) {
+        _oplogBuffer = stdx::make_unique<OplogBufferRingBuffer>();
+    } else {
+        _oplogBuffer = stdx::make_unique<OplogBufferBlockingQueue>();
+    }
     _oplogBuffer->startup(opCtx);
 
     _bgSync =
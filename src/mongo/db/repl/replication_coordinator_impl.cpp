@@ -187,13 +187,15 @@ std::string ReplicationCoordinatorImpl::Waiter::toString() const {
 
 
 ReplicationCoordinatorImpl::ThreadWaiter::ThreadWaiter(OpTime _opTime,
-                                                       const WriteConcernOptions* _writeConcern,
-                                                       stdx::condition_variable* _condVar)
-    : Waiter(_opTime, _writeConcern), condVar(_condVar) {}
+                                                       const WriteConcernOptions* _writeConcern)
+    : Waiter(_opTime, _writeConcern) {}
 
 void ReplicationCoordinatorImpl::ThreadWaiter::notify_inlock() {
-    invariant(condVar);
-    condVar->notify_all();
+    notify();
+}
+
+void ReplicationCoordinatorImpl::ThreadWaiter::notify() {
+    condVar.notify_all();
 }
 
 ReplicationCoordinatorImpl::CallbackWaiter::CallbackWaiter(OpTime _opTime,
@@ -219,7 +221,8 @@ public:
      * _list is guarded by ReplicationCoordinatorImpl::_mutex, thus it is illegal to construct one
      * of these without holding _mutex
      */
-    WaiterGuard(WaiterList* list, Waiter* waiter) : _list(list), _waiter(waiter) {
+    WaiterGuard(WaiterList* list, std::shared_ptr<Waiter> waiter)
+        : _list(list), _waiter(std::move(waiter)) {
         list->add_inlock(_waiter);
     }
 
@@ -229,45 +232,104 @@ public:
 
 private:
     WaiterList* _list;
-    Waiter* _waiter;
+    std::shared_ptr<Waiter> _waiter;
+};
+
+/**
+ * Collects the ThreadWaiters signalled between collect_inlock() and stopCollecting_inlock(), and
+ * notifies them when it is destroyed. Declared before the lock on _mutex, it is destroyed after
+ * the lock has been released, so that the waiters don't wake up only to block on _mutex while
+ * the signalling thread still holds it.
+ */
+class ReplicationCoordinatorImpl::DeferredWaiterNotifier {
+    MONGO_DISALLOW_COPYING(DeferredWaiterNotifier);
+
+public:
+    explicit DeferredWaiterNotifier(ReplicationCoordinatorImpl* repl) : _repl(repl) {}
+
+    ~DeferredWaiterNotifier() {
+        if (_collecting) {
+            // Only happens when an exception skips stopCollecting_inlock().
+            stdx::lock_guard<stdx::mutex> lk(_repl->_mutex);
+            stopCollecting_inlock();
+        }
+        for (auto&& waiter : _waiters) {
+            waiter->notify();
+        }
+    }
+
+    void collect_inlock() {
+        invariant(!_repl->_deferredWaiterNotifications);
+        _repl->_deferredWaiterNotifications = &_waiters;
+        _collecting = true;
+    }
+
+    /**
+     * Must be called before _mutex is released.
+     */
+    void stopCollecting_inlock() {
+        invariant(_repl->_deferredWaiterNotifications == &_waiters);
+        _repl->_deferredWaiterNotifications = nullptr;
+        _collecting = false;
+    }
+
+private:
+    ReplicationCoordinatorImpl* const _repl;
+    std::vector<std::shared_ptr<ThreadWaiter>> _waiters;
+    bool _collecting = false;
 };
 
+ReplicationCoordinatorImpl::WaiterList::WriteConcernKey
+ReplicationCoordinatorImpl::WaiterList::_keyOf(const Waiter& waiter) {
+    if (!waiter.writeConcern) {
+        return WriteConcernKey();
+    }
+    const auto& writeConcern = *waiter.writeConcern;
+    return WriteConcernKey(writeConcern.wNumNodes, writeConcern.wMode, writeConcern.syncMode);
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(WaiterType waiter) {
-    _list.push_back(waiter);
+    auto& queue = _queues[_keyOf(*waiter)];
+    queue.emplace(waiter->opTime, std::move(waiter));
 }
 
 void ReplicationCoordinatorImpl::WaiterList::signalIf_inlock(
-    stdx::function<bool(WaiterType)> func) {
-    for (auto it = _list.begin(); it != _list.end();) {
-        if (!func(*it)) {
-            // This element doesn't match, so we advance the iterator to the next one.
-            ++it;
-            continue;
-        }
+    stdx::function<bool(Waiter*)> func, std::vector<std::shared_ptr<ThreadWaiter>>* toNotify) {
+    for (auto&& queue : _queues) {
+        auto& waiters = queue.second;
+        for (auto it = waiters.begin(); it != waiters.end();) {
+            if (!func(it->second.get())) {
+                // No waiter later in the queue can satisfy the condition either.
+                break;
+            }
 
-        if (!(*it)->runs_once()) {
-            (*it)->notify_inlock();
-            // Keep the waiter on the list and let the guard remove it instead. Advance the
-            // iterator since we are skipping the removal.
-            ++it;
-            continue;
-        }
+            if (!it->second->runs_once()) {
+                auto threadWaiter = std::dynamic_pointer_cast<ThreadWaiter>(it->second);
+                if (toNotify && threadWaiter) {
+                    toNotify->push_back(std::move(threadWaiter));
+                } else {
+                    it->second->notify_inlock();
+                }
+                // Keep the waiter on the list and let the guard remove it instead.
+                ++it;
+                continue;
+            }
 
-        // Remove the waiter from the list if it was only meant to be notified once.
-        WaiterType waiter = std::move(*it);
+            // Remove the waiter from the list if it was only meant to be notified once. It's
+            // important to call notify() after the waiter has been removed from the list since
+            // notify() might remove the waiter itself.
+            WaiterType waiter = std::move(it->second);
+            it = waiters.erase(it);
+            waiter->notify_inlock();
+        }
+    }
 
-        if (it == std::prev(_list.end())) {
-            // Iterator will be invalid after erasing the last element, so set it to the
-            // next one (i.e. end()).
-            it = _list.erase(it);
+    for (auto it = _queues.begin(); it != _queues.end();) {
+        if (it->second.empty()) {
+            it = _queues.erase(it);
         } else {
-            // Iterator is still valid after pop_back().
-            std::swap(*it, _list.back());
-            _list.pop_back();
+            ++it;
         }
-        // It's important to call notify() after the waiter has been removed from the list
-        // since notify() might remove the waiter itself.
-        waiter->notify_inlock();
     }
 }
 
@@ -276,13 +338,18 @@ void ReplicationCoordinatorImpl::WaiterList::signalAll_inlock() {
     this->signalIf_inlock([](Waiter* waiter) { return true; });
 }
 
-bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(WaiterType waiter) {
-    auto it = std::find(_list.begin(), _list.end(), waiter);
-    if (it == _list.end()) {
+bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(const WaiterType& waiter) {
+    auto queue = _queues.find(_keyOf(*waiter));
+    if (queue == _queues.end()) {
+        return false;
+    }
+    auto range = queue->second.equal_range(waiter->opTime);
+    auto it = std::find_if(
+        range.first, range.second, [waiter](const auto& entry) { return entry.second == waiter; });
+    if (it == range.second) {
         return false;
     }
-    std::swap(*it, _list.back());
-    _list.pop_back();
+    queue->second.erase(it);
     return true;
 }
 
@@ -1093,10 +1160,13 @@ void ReplicationCoordinatorImpl::setMyLastAppliedOpTimeForward(const OpTime& opT
     // applied optime is never greater than the latest cluster time in the logical clock.
     _externalState->setGlobalTimestamp(getServiceContext(), opTime.getTimestamp());
 
+    DeferredWaiterNotifier notifier(this);
     stdx::unique_lock<stdx::mutex> lock(_mutex);
     auto myLastAppliedOpTime = _getMyLastAppliedOpTime_inlock();
     if (opTime > myLastAppliedOpTime) {
+        notifier.collect_inlock();
         _setMyLastAppliedOpTime_inlock(opTime, false, consistency);
+        notifier.stopCollecting_inlock();
         _reportUpstream_inlock(std::move(lock));
     } else {
         if (opTime != myLastAppliedOpTime) {
@@ -1118,9 +1188,12 @@ void ReplicationCoordinatorImpl::setMyLastAppliedOpTimeForward(const OpTime& opT
 }
 
 void ReplicationCoordinatorImpl::setMyLastDurableOpTimeForward(const OpTime& opTime) {
+    DeferredWaiterNotifier notifier(this);
     stdx::unique_lock<stdx::mutex> lock(_mutex);
     if (opTime > _getMyLastDurableOpTime_inlock()) {
+        notifier.collect_inlock();
         _setMyLastDurableOpTime_inlock(opTime, false);
+        notifier.stopCollecting_inlock();
         _reportUpstream_inlock(std::move(lock));
     }
 }
@@ -1188,8 +1261,8 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTime_inlock(const OpTime& op
     }
 
     // Signal anyone waiting on optime changes.
-    _opTimeWaiterList.signalIf_inlock(
-        [opTime](Waiter* waiter) { return waiter->opTime <= opTime; });
+    _opTimeWaiterList.signalIf_inlock([opTime](Waiter* waiter) { return waiter->opTime <= opTime; },
+                                      _deferredWaiterNotifications);
 
     if (opTime.isNull()) {
         return;
@@ -1376,20 +1449,19 @@ Status ReplicationCoordinatorImpl::_waitUntilOpTime(OperationContext* opCtx,
         }
 
         // We just need to wait for the opTime to catch up to what we need (not majority RC).
-        stdx::condition_variable condVar;
-        ThreadWaiter waiter(targetOpTime, nullptr, &condVar);
-        WaiterGuard guard(&_opTimeWaiterList, &waiter);
+        auto waiter = std::make_shared<ThreadWaiter>(targetOpTime, nullptr);
+        WaiterGuard guard(&_opTimeWaiterList, waiter);
 
         LOG(3) << "waitUntilOpTime: OpID " << opCtx->getOpID() << " is waiting for OpTime "
-               << waiter << " until " << opCtx->getDeadline();
+               << *waiter << " until " << opCtx->getDeadline();
 
         auto waitStatus = Status::OK();
         if (deadline) {
             auto waitUntilStatus =
-                opCtx->waitForConditionOrInterruptNoAssertUntil(condVar, lock, *deadline);
+                opCtx->waitForConditionOrInterruptNoAssertUntil(waiter->condVar, lock, *deadline);
             waitStatus = waitUntilStatus.getStatus();
         } else {
-            waitStatus = opCtx->waitForConditionOrInterruptNoAssert(condVar, lock);
+            waitStatus = opCtx->waitForConditionOrInterruptNoAssert(waiter->condVar, lock);
         }
 
         if (!waitStatus.isOK()) {
@@ -1662,16 +1734,16 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
     }();
 
     // Must hold _mutex before constructing waitInfo as it will modify _replicationWaiterList
-    stdx::condition_variable condVar;
-    ThreadWaiter waiter(opTime, &writeConcern, &condVar);
-    WaiterGuard guard(&_replicationWaiterList, &waiter);
+    auto waiter = std::make_shared<ThreadWaiter>(opTime, &writeConcern);
+    WaiterGuard guard(&_replicationWaiterList, waiter);
     while (!_doneWaitingForReplication_inlock(opTime, writeConcern)) {
 
         if (_inShutdown) {
             return {ErrorCodes::ShutdownInProgress, "Replication is being shut down"};
         }
 
-        auto status = opCtx->waitForConditionOrInterruptNoAssertUntil(condVar, *lock, wTimeoutDate);
+        auto status =
+            opCtx->waitForConditionOrInterruptNoAssertUntil(waiter->condVar, *lock, wTimeoutDate);
         if (!status.isOK()) {
             return status.getStatus();
         }
@@ -1682,7 +1754,7 @@ Status ReplicationCoordinatorImpl::_awaitReplication_inlock(
                 BSONObjBuilder progress;
                 _topCoord->fillMemberData(&progress);
                 log() << "Replication for failed WC: " << writeConcern.toBSON()
-                      << ", waitInfo: " << waiter << ", opID: " << opCtx->getOpID()
+                      << ", waitInfo: " << *waiter << ", opID: " << opCtx->getOpID()
                       << ", progress: " << progress.done();
             }
             return {ErrorCodes::WriteConcernFailed, "waiting for replication timed out"};
@@ -1816,11 +1888,10 @@ Status ReplicationCoordinatorImpl::stepDown(OperationContext* opCtx,
 
         // Set up a waiter which will be signalled when we process a heartbeat or updatePosition
         // and have a majority of nodes at our optime.
-        stdx::condition_variable condVar;
         const WriteConcernOptions waiterWriteConcern(
             WriteConcernOptions::kMajority, WriteConcernOptions::SyncMode::NONE, waitTimeout);
-        ThreadWaiter waiter(lastAppliedOpTime, &waiterWriteConcern, &condVar);
-        WaiterGuard guard(&_replicationWaiterList, &waiter);
+        auto waiter = std::make_shared<ThreadWaiter>(lastAppliedOpTime, &waiterWriteConcern);
+        WaiterGuard guard(&_replicationWaiterList, waiter);
 
         while (!_topCoord->attemptStepDown(
             termAtStart, _replExecutor->now(), waitUntil, stepDownUntil, force)) {
@@ -1856,7 +1927,7 @@ Status ReplicationCoordinatorImpl::stepDown(OperationContext* opCtx,
             // attemptStepDown again will cause attemptStepDown to return ExceededTimeLimit with
             // the proper error message.
             opCtx->waitForConditionOrInterruptUntil(
-                condVar, lk, std::min(stepDownUntil, waitUntil));
+                waiter->condVar, lk, std::min(stepDownUntil, waitUntil));
         }
     } catch (const DBException& e) {
         return e.toStatus();
@@ -2910,7 +2981,7 @@ void ReplicationCoordinatorImpl::CatchupState::abort_inlock(PrimaryCatchUpConclu
         _repl->_replExecutor->cancel(_timeoutCbh);
     }
     if (_waiter) {
-        _repl->_opTimeWaiterList.remove_inlock(_waiter.get());
+        _repl->_opTimeWaiterList.remove_inlock(_waiter);
     }
 
     // Enter primary drain mode.
@@ -2947,7 +3018,7 @@ void ReplicationCoordinatorImpl::CatchupState::signalHeartbeatUpdate_inlock() {
 
     log() << "Heartbeats updated catchup target optime to " << *targetOpTime;
     if (_waiter) {
-        _repl->_opTimeWaiterList.remove_inlock(_waiter.get());
+        _repl->_opTimeWaiterList.remove_inlock(_waiter);
     } else {
         // Only increment the 'numCatchUps' election metric the first time we add a waiter, so that
         // we only increment it once each time a primary has to catch up. If there is already an
@@ -2967,8 +3038,8 @@ void ReplicationCoordinatorImpl::CatchupState::signalHeartbeatUpdate_inlock() {
             abort_inlock(PrimaryCatchUpConclusionReason::kSucceeded);
         }
     };
-    _waiter = stdx::make_unique<CallbackWaiter>(*targetOpTime, targetOpTimeCB);
-    _repl->_opTimeWaiterList.add_inlock(_waiter.get());
+    _waiter = std::make_shared<CallbackWaiter>(*targetOpTime, targetOpTimeCB);
+    _repl->_opTimeWaiterList.add_inlock(_waiter);
 }
 
 void ReplicationCoordinatorImpl::CatchupState::incrementNumCatchUpOps_inlock(long numOps) {
@@ -3143,9 +3214,11 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig_inlock(OperationContext* opCtx,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters_inlock() {
-    _replicationWaiterList.signalIf_inlock([this](Waiter* waiter) {
-        return _doneWaitingForReplication_inlock(waiter->opTime, *waiter->writeConcern);
-    });
+    _replicationWaiterList.signalIf_inlock(
+        [this](Waiter* waiter) {
+            return _doneWaitingForReplication_inlock(waiter->opTime, *waiter->writeConcern);
+        },
+        _deferredWaiterNotifications);
 
     if (_wMajorityWriteAvailabilityWaiter) {
         WriteConcernOptions kMajorityWriteConcern(
@@ -3166,7 +3239,10 @@ void ReplicationCoordinatorImpl::_wakeReadyWaiters_inlock() {
 
 Status ReplicationCoordinatorImpl::processReplSetUpdatePosition(const UpdatePositionArgs& updates,
                                                                 long long* configVersion) {
+    // Every update from a secondary may satisfy many waiting writers.
+    DeferredWaiterNotifier notifier(this);
     stdx::unique_lock<stdx::mutex> lock(_mutex);
+    notifier.collect_inlock();
     Status status = Status::OK();
     bool somethingChanged = false;
     for (UpdatePositionArgs::UpdateIterator update = updates.updatesBegin();
@@ -3178,6 +3254,7 @@ Status ReplicationCoordinatorImpl::processReplSetUpdatePosition(const UpdatePosi
         }
         somethingChanged = true;
     }
+    notifier.stopCollecting_inlock();
 
     if (somethingChanged && !_getMemberState_inlock().primary()) {
         lock.unlock();
@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -481,17 +484,20 @@ private:
     // When ThreadWaiter gets notified, it will signal the conditional variable.
     //
     // This is used when a thread wants to block inline until the opTime is reached with the given
-    // writeConcern.
+    // writeConcern. The waiting thread shares ownership of the waiter with whoever is going to
+    // notify it, so that the condition variable outlives a notification made after _mutex has
+    // been released.
     struct ThreadWaiter : public Waiter {
-        ThreadWaiter(OpTime _opTime,
-                     const WriteConcernOptions* _writeConcern,
-                     stdx::condition_variable* _condVar);
+        ThreadWaiter(OpTime _opTime, const WriteConcernOptions* _writeConcern);
         void notify_inlock() override;
         bool runs_once() const override {
             return false;
         }
 
-        stdx::condition_variable* condVar = nullptr;
+        // Unlike notify_inlock(), may be called without holding _mutex.
+        void notify();
+
+        stdx::condition_variable condVar;
     };
 
     // When the waiter is notified, finishCallback will be called while holding replCoord _mutex
@@ -513,21 +519,39 @@ private:
 
     class WaiterGuard;
 
+    class DeferredWaiterNotifier;
+
+    // Waiters are queued by write concern and ordered by opTime within each queue, so that
+    // signalling them only visits the waiters it notifies plus one per queue.
     class WaiterList {
     public:
-        using WaiterType = Waiter*;
+        using WaiterType = std::shared_ptr<Waiter>;
 
         // Adds waiter into the list.
         void add_inlock(WaiterType waiter);
         // Returns whether waiter is found and removed.
-        bool remove_inlock(WaiterType waiter);
-        // Signals all waiters that satisfy the condition.
-        void signalIf_inlock(stdx::function<bool(WaiterType)> fun);
+        bool remove_inlock(const WaiterType& waiter);
+        // Signals all waiters that satisfy the condition. The condition must be monotonic in the
+        // opTime: if it holds for a waiter, it must hold for every waiter with the same write
+        // concern and an earlier opTime. If 'toNotify' is given, the ThreadWaiters which satisfy
+        // the condition are appended to it for the caller to notify once it has released _mutex,
+        // rather than notified right away.
+        void signalIf_inlock(stdx::function<bool(Waiter*)> fun,
+                             std::vector<std::shared_ptr<ThreadWaiter>>* toNotify = nullptr);
         // Signals all waiters from the list.
         void signalAll_inlock();
 
     private:
-        std::vector<WaiterType> _list;
+        // The parts of a write concern which decide whether an opTime satisfies it. Waiters
+        // without a write concern, which are only found on _opTimeWaiterList, share the key of a
+        // default constructed tuple: (0, "", SyncMode::UNSET).
+        using WriteConcernKey = std::tuple<int, std::string, WriteConcernOptions::SyncMode>;
+
+        static WriteConcernKey _keyOf(const Waiter& waiter);
+
+        // Queues which no longer hold waiters are only erased by signalIf_inlock(), as waiters
+        // notified by it may remove other waiters.
+        std::map<WriteConcernKey, std::multimap<OpTime, WaiterType>> _queues;
     };
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
@@ -569,7 +593,7 @@ private:
         executor::TaskExecutor::CallbackHandle _timeoutCbh;
         // Handle to a Waiter that contains the current target optime to reach after which
         // we can exit catchup mode.
-        std::unique_ptr<CallbackWaiter> _waiter;
+        std::shared_ptr<CallbackWaiter> _waiter;
         // Counter for the number of ops applied during catchup.
         long _numCatchUpOps = 0;
     };
@@ -1200,13 +1224,16 @@ private:
     // Pointer to the ReplicationCoordinatorExternalState owned by this ReplicationCoordinator.
     std::unique_ptr<ReplicationCoordinatorExternalState> _externalState;  // (PS)
 
-    // list of information about clients waiting on replication.  Does *not* own the WaiterInfos.
+    // list of information about clients waiting on replication.
     WaiterList _replicationWaiterList;  // (M)
 
     // list of information about clients waiting for a particular opTime.
-    // Does *not* own the WaiterInfos.
     WaiterList _opTimeWaiterList;  // (M)
 
+    // Where signalled ThreadWaiters are collected while a DeferredWaiterNotifier is collecting
+    // them. Null when they are to be notified right away.
+    std::vector<std::shared_ptr<ThreadWaiter>>* _deferredWaiterNotifications = nullptr;  // (M)
+
     // Waiter waiting on w:majority write availability.
     std::unique_ptr<CallbackWaiter> _wMajorityWriteAvailabilityWaiter;  // (M)
 
@@ -1158,6 +1158,73 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesWaitersWithDifferentWriteConcernsAndOpTimesOnceEachIsSatisfied) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id"
+                                               << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id"
+                                                  << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id"
+                                                  << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    getReplCoord()->setMyLastAppliedOpTime(OpTimeWithTermOne(100, 1));
+    getReplCoord()->setMyLastDurableOpTime(OpTimeWithTermOne(100, 1));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    OpTimeWithTermOne time3(100, 3);
+    getReplCoord()->setMyLastAppliedOpTime(time3);
+    getReplCoord()->setMyLastDurableOpTime(time3);
+
+    WriteConcernOptions twoNodes;
+    twoNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    twoNodes.wNumNodes = 2;
+    WriteConcernOptions threeNodes = twoNodes;
+    threeNodes.wNumNodes = 3;
+
+    ReplicationAwaiter twoNodesTime1(getReplCoord(), getServiceContext());
+    twoNodesTime1.setOpTime(time1);
+    twoNodesTime1.setWriteConcern(twoNodes);
+    ReplicationAwaiter twoNodesTime2(getReplCoord(), getServiceContext());
+    twoNodesTime2.setOpTime(time2);
+    twoNodesTime2.setWriteConcern(twoNodes);
+    ReplicationAwaiter twoNodesTime3(getReplCoord(), getServiceContext());
+    twoNodesTime3.setOpTime(time3);
+    twoNodesTime3.setWriteConcern(twoNodes);
+    ReplicationAwaiter threeNodesTime1(getReplCoord(), getServiceContext());
+    threeNodesTime1.setOpTime(time1);
+    threeNodesTime1.setWriteConcern(threeNodes);
+
+    threeNodesTime1.start();
+    twoNodesTime3.start();
+    twoNodesTime2.start();
+    twoNodesTime1.start();
+
+    // Waiters for the same write concern are woken in opTime order, several at a time.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(twoNodesTime1.getResult().status);
+    ASSERT_OK(twoNodesTime2.getResult().status);
+
+    // A waiter for another write concern at an earlier opTime is woken independently.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(threeNodesTime1.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time3));
+    ASSERT_OK(twoNodesTime3.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
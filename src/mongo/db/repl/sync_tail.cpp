@@ -85,6 +85,7 @@
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -1460,6 +1461,7 @@ Status multiSyncApply(OperationContext* opCtx,
         : OplogApplication::Mode::kSecondary;
 
     ApplierHelpers::InsertGroup insertGroup(ops, opCtx, oplogApplicationMode);
+    ApplierHelpers::UpdateDeleteGroup updateDeleteGroup(ops, opCtx, oplogApplicationMode);
 
     {  // Ensure that the MultikeyPathTracker stops tracking paths.
         ON_BLOCK_EXIT([opCtx] { MultikeyPathTracker::get(opCtx).stopTrackingMultikeyPathInfo(); });
@@ -1476,6 +1478,13 @@ Status multiSyncApply(OperationContext* opCtx,
                 continue;
             }
 
+            // Likewise for groups of updates or deletes.
+            groupResult = updateDeleteGroup.groupAndApplyUpdatesAndDeletes(it, isDataConsistent);
+            if (groupResult.isOK()) {
+                it = groupResult.getValue();
+                continue;
+            }
+
             // If we didn't create a group, try to apply the op individually.
             try {
                 const Status status =
@@ -1581,9 +1590,18 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
     }
 
     LOG(2) << "replication batch size is " << ops.size();
+
+    _lastBatchPhaseTimes = {};
+    Timer phaseTimer;
+    auto endPhase = [&phaseTimer](Microseconds* phaseTime) {
+        *phaseTime = Microseconds(phaseTimer.micros());
+        phaseTimer.reset();
+    };
+
     // Stop all readers until we're done. This also prevents doc-locking engines from deleting old
     // entries from the oplog until we finish writing.
     Lock::ParallelBatchWriterMode pbwm(opCtx->lockState());
+    endPhase(&_lastBatchPhaseTimes.lock);
 
     auto replCoord = ReplicationCoordinator::get(opCtx);
     if (replCoord->getApplierState() == ReplicationCoordinator::ApplierState::Stopped) {
@@ -1648,9 +1666,11 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
         std::vector<MultiApplier::OperationPtrs> writerVectors(
             _writerPool->getStats().options.maxThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        endPhase(&_lastBatchPhaseTimes.partition);
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
+        endPhase(&_lastBatchPhaseTimes.waitForOplogWrites);
 
         // Read `minValid` prior to it possibly being written to.
         const bool isDataConsistent =
@@ -1673,6 +1693,7 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
                      &multikeyVector,
                      isDataConsistent);
             _writerPool->waitForIdle();
+            endPhase(&_lastBatchPhaseTimes.apply);
 
             // If any of the statuses is not ok, return error.
             for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
@@ -1728,10 +1749,15 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
     // Increment the counter for the number of ops applied during catchup if the node is in catchup
     // mode.
     replCoord->incrementNumCatchUpOpsIfCatchingUp(ops.size());
+    endPhase(&_lastBatchPhaseTimes.finish);
 
     // We have now written all database writes and updated the oplog to match.
     return ops.back().getOpTime();
 }
 
+OplogApplier::BatchPhaseTimes SyncTail::getLastBatchPhaseTimes() const {
+    return _lastBatchPhaseTimes;
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -273,6 +273,11 @@ public:
      */
     StatusWith<OpTime> multiApply(OperationContext* opCtx, MultiApplier::Operations ops);
 
+    /**
+     * Returns how long the phases of the last batch applied by multiApply() took.
+     */
+    OplogApplier::BatchPhaseTimes getLastBatchPhaseTimes() const;
+
 private:
     /**
      * Pops the operation at the front of the OplogBuffer.
@@ -302,6 +307,9 @@ private:
     // Used to configure multiApply() behavior.
     const OplogApplier::Options _options;
 
+    // Only accessed by the thread calling multiApply().
+    OplogApplier::BatchPhaseTimes _lastBatchPhaseTimes;
+
     // Protects member data of SyncTail.
     mutable stdx::mutex _mutex;
 
@@ -898,6 +898,99 @@ TEST_F(SyncTailTest, MultiSyncApplyAppliesOpIndividuallyWhenOpIndividuallyExceed
     ASSERT_BSONOBJ_EQ(insertOpSmall.getObject(), docsInserted[1][0]);
 }
 
+TEST_F(SyncTailTest, MultiSyncApplyGroupsUpdateAndDeleteOperationsByNamespace) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, {});
+    MultiApplier::Operations insertOps;
+    for (int i = 0; i < 4; ++i) {
+        insertOps.push_back(makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << i)));
+    }
+    ASSERT_OK(runOpsSteadyState(insertOps));
+
+    // Each delete records how many deletes had been committed before it was made.
+    int numDeletesCommitted = 0;
+    std::vector<int> numDeletesCommittedBeforeDelete;
+    _opObserver->onDeleteFn = [&](OperationContext* opCtx,
+                                  const NamespaceString&,
+                                  OptionalCollectionUUID,
+                                  StmtId,
+                                  bool,
+                                  const boost::optional<BSONObj>&) {
+        numDeletesCommittedBeforeDelete.push_back(numDeletesCommitted);
+        opCtx->recoveryUnit()->onCommit(
+            [&numDeletesCommitted](boost::optional<Timestamp>) { ++numDeletesCommitted; });
+    };
+
+    MultiApplier::Operations ops = {
+        makeUpdateDocumentOplogEntry(
+            nextOpTime(), nss, BSON("_id" << 0), BSON("$set" << BSON("x" << 0))),
+        makeUpdateDocumentOplogEntry(
+            nextOpTime(), nss, BSON("_id" << 1), BSON("$set" << BSON("x" << 1))),
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 2)),
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 3))};
+    ASSERT_OK(runOpsSteadyState(ops));
+
+    // Both deletes were made in the same storage transaction.
+    ASSERT_EQUALS(2U, numDeletesCommittedBeforeDelete.size());
+    ASSERT_EQUALS(0, numDeletesCommittedBeforeDelete[0]);
+    ASSERT_EQUALS(0, numDeletesCommittedBeforeDelete[1]);
+    ASSERT_EQUALS(2, numDeletesCommitted);
+
+    auto storage = getStorageInterface();
+    for (int i = 0; i < 2; ++i) {
+        auto doc = BSON("_id" << i << "x" << i);
+        ASSERT_BSONOBJ_EQ(doc,
+                          unittest::assertGet(storage->findById(_opCtx.get(), nss, doc["_id"])));
+    }
+    for (int i = 2; i < 4; ++i) {
+        ASSERT_EQUALS(ErrorCodes::NoSuchKey,
+                      storage->findById(_opCtx.get(), nss, BSON("_id" << i)["_id"]).getStatus());
+    }
+}
+
+TEST_F(SyncTailTest, MultiSyncApplyFallsBackOnApplyingDeletesIndividuallyWhenGroupedDeleteFails) {
+    NamespaceString nss("test." + _agent.getSuiteName() + "_" + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, {});
+    MultiApplier::Operations insertOps;
+    MultiApplier::Operations deleteOps;
+    for (int i = 0; i < 3; ++i) {
+        insertOps.push_back(makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << i)));
+        deleteOps.push_back(makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << i)));
+    }
+    ASSERT_OK(runOpsSteadyState(insertOps));
+
+    // Reject a second delete in the same storage transaction.
+    int numDeletesInTransaction = 0;
+    std::size_t numFailedGroupedDeletes = 0;
+    _opObserver->onDeleteFn = [&](OperationContext* opCtx,
+                                  const NamespaceString&,
+                                  OptionalCollectionUUID,
+                                  StmtId,
+                                  bool,
+                                  const boost::optional<BSONObj>&) {
+        if (numDeletesInTransaction++ > 0) {
+            numFailedGroupedDeletes++;
+            uasserted(ErrorCodes::OperationFailed, "grouped deletes not supported");
+        }
+        opCtx->recoveryUnit()->onCommit([&numDeletesInTransaction](boost::optional<Timestamp>) {
+            numDeletesInTransaction = 0;
+        });
+        opCtx->recoveryUnit()->onRollback(
+            [&numDeletesInTransaction] { numDeletesInTransaction = 0; });
+    };
+
+    ASSERT_OK(runOpsSteadyState(deleteOps));
+
+    // The grouped delete failed once, after which each delete was applied on its own.
+    ASSERT_EQUALS(1U, numFailedGroupedDeletes);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQUALS(ErrorCodes::NoSuchKey,
+                      getStorageInterface()
+                          ->findById(_opCtx.get(), nss, BSON("_id" << i)["_id"])
+                          .getStatus());
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyAppliesInsertOpsIndividuallyWhenUnableToCreateGroupByNamespace) {
     int seconds = 1;
     auto makeOp = [&seconds](const NamespaceString& nss) {
@@ -108,13 +108,16 @@ std::shared_ptr<Notification<void>> CatalogCacheLoaderMock::getChunksSince(
                 uassertStatusOK(_swCollectionReturnValue);
                 uassertStatusOK(_swChunksReturnValue);
 
-                return CollectionAndChangedChunks(
+                CollectionAndChangedChunks collAndChunks(
                     _swCollectionReturnValue.getValue().getUUID(),
                     _swCollectionReturnValue.getValue().getEpoch(),
                     _swCollectionReturnValue.getValue().getKeyPattern().toBSON(),
                     _swCollectionReturnValue.getValue().getDefaultCollation(),
                     _swCollectionReturnValue.getValue().getUnique(),
                     _swChunksReturnValue.getValue());
+                collAndChunks.shardKeyHashVersion =
+                    _swCollectionReturnValue.getValue().getHashVersion();
+                return collAndChunks;
             } catch (const DBException& ex) {
                 return ex.toStatus();
             }
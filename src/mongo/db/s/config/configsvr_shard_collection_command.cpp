@@ -78,7 +78,8 @@ const long long kMaxSizeMBDefault = 0;
 BSONObj makeCreateIndexesCmd(const NamespaceString& nss,
                              const BSONObj& keys,
                              const BSONObj& collation,
-                             bool unique) {
+                             bool unique,
+                             int hashVersion) {
     BSONObjBuilder index;
 
     // Required fields for an index.
@@ -117,6 +118,10 @@ BSONObj makeCreateIndexesCmd(const NamespaceString& nss,
         index.appendBool("unique", unique);
     }
 
+    if (hashVersion != BSONElementHasher::DEFAULT_HASH_VERSION) {
+        index.append(IndexDescriptor::kHashVersionFieldName, hashVersion);
+    }
+
     // The outer createIndexes command.
 
     BSONObjBuilder createIndexes;
@@ -274,7 +279,8 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
     //         ii. is not a sparse index, partial index, or index with a non-simple collation
     //         iii. contains no null values
     //         iv. is not multikey (maybe lift this restriction later)
-    //         v. if a hashed index, has default seed (lift this restriction later)
+    //         v. if a hashed index, has default seed (lift this restriction later) and the
+    //            same hash version as the proposed shard key
     //
     // 3. If the proposed shard key is specified as unique, there must exist a useful,
     //    unique index exactly equal to the proposedKey (not just a prefix).
@@ -331,6 +337,17 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key "
+                                  << proposedKey
+                                  << " and hash version "
+                                  << shardKeyPattern.getHashVersion()
+                                  << " because the hashed index uses hash version "
+                                  << idx[IndexDescriptor::kHashVersionFieldName].numberInt(),
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx[IndexDescriptor::kHashVersionFieldName].numberInt() ==
+                            shardKeyPattern.getHashVersion());
             hasUsefulIndexForKey = true;
         }
     }
@@ -401,7 +418,11 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
         BSONObj collation =
             !request.getCollation()->isEmpty() ? CollationSpec::kSimpleSpec : BSONObj();
         auto createIndexesCmd =
-            makeCreateIndexesCmd(nss, proposedKey, collation, request.getUnique());
+            makeCreateIndexesCmd(nss,
+                                 proposedKey,
+                                 collation,
+                                 request.getUnique(),
+                                 shardKeyPattern.getHashVersion());
 
         const auto swResponse = primaryShard->runCommandWithFixedRetryAttempts(
             opCtx,
@@ -675,7 +696,7 @@ public:
         // Get variables required throughout this command.
 
         auto proposedKey(request.getKey().getOwned());
-        ShardKeyPattern shardKeyPattern(proposedKey);
+        ShardKeyPattern shardKeyPattern(proposedKey, request.getHashVersion());
 
         std::vector<ShardId> shardIds;
         shardRegistry->getAllShardIds(opCtx, &shardIds);
@@ -741,6 +762,7 @@ public:
         shardsvrShardCollectionRequest.setNumInitialChunks(request.getNumInitialChunks());
         shardsvrShardCollectionRequest.setInitialSplitPoints(request.getInitialSplitPoints());
         shardsvrShardCollectionRequest.setCollation(request.getCollation());
+        shardsvrShardCollectionRequest.setHashVersion(request.getHashVersion());
         shardsvrShardCollectionRequest.setGetUUIDfromPrimaryShard(
             request.getGetUUIDfromPrimaryShard());
 
@@ -773,6 +795,13 @@ public:
 
             return true;
         } else {
+            // Shards which do not support sharding on the primary shard also do not know about
+            // hash versions other than the default one.
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "Hash version " << request.getHashVersion()
+                                  << " requires the primary shard to be upgraded",
+                    request.getHashVersion() == BSONElementHasher::DEFAULT_HASH_VERSION);
+
             // Step 2.
             if (auto existingColl =
                     InitialSplitPolicy::checkIfCollectionAlreadyShardedWithSameOptions(
@@ -427,6 +427,7 @@ boost::optional<CollectionType> InitialSplitPolicy::checkIfCollectionAlreadyShar
     requestedOptions.setKeyPattern(KeyPattern(request.getKey()));
     requestedOptions.setDefaultCollation(*request.getCollation());
     requestedOptions.setUnique(request.getUnique());
+    requestedOptions.setHashVersion(request.getHashVersion());
 
     // If the collection is already sharded, fail if the deduced options in this request do not
     // match the options the collection was originally sharded with.
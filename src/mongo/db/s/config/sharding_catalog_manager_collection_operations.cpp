@@ -454,6 +454,9 @@ void ShardingCatalogManager::shardCollection(OperationContext* opCtx,
         coll.setKeyPattern(fieldsAndOrder.toBSON());
         coll.setDefaultCollation(defaultCollator ? defaultCollator->getSpec().toBSON() : BSONObj());
         coll.setUnique(unique);
+        if (fieldsAndOrder.getHashVersion() != BSONElementHasher::DEFAULT_HASH_VERSION) {
+            coll.setHashVersion(fieldsAndOrder.getHashVersion());
+        }
 
         uassertStatusOK(ShardingCatalogClientImpl::updateShardingCatalogEntryForCollection(
             opCtx, nss, coll, true /*upsert*/));
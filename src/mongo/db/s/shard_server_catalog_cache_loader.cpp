@@ -96,6 +96,9 @@ Status persistCollectionAndChangedChunks(OperationContext* opCtx,
                                                      collAndChunks.shardKeyPattern,
                                                      collAndChunks.defaultCollation,
                                                      collAndChunks.shardKeyIsUnique);
+    if (collAndChunks.shardKeyHashVersion != BSONElementHasher::DEFAULT_HASH_VERSION) {
+        update.setHashVersion(collAndChunks.shardKeyHashVersion);
+    }
 
     // Mark the chunk metadata as refreshing, so that secondaries are aware of refresh.
     update.setRefreshing(true);
@@ -216,12 +219,14 @@ CollectionAndChangedChunks getPersistedMetadataSinceVersion(OperationContext* op
     auto changedChunks = uassertStatusOK(
         readShardChunks(opCtx, nss, diff.query, diff.sort, boost::none, startingVersion.epoch()));
 
-    return CollectionAndChangedChunks{shardCollectionEntry.getUUID(),
-                                      shardCollectionEntry.getEpoch(),
-                                      shardCollectionEntry.getKeyPattern().toBSON(),
-                                      shardCollectionEntry.getDefaultCollation(),
-                                      shardCollectionEntry.getUnique(),
-                                      std::move(changedChunks)};
+    CollectionAndChangedChunks collAndChunks{shardCollectionEntry.getUUID(),
+                                             shardCollectionEntry.getEpoch(),
+                                             shardCollectionEntry.getKeyPattern().toBSON(),
+                                             shardCollectionEntry.getDefaultCollation(),
+                                             shardCollectionEntry.getUnique(),
+                                             std::move(changedChunks)};
+    collAndChunks.shardKeyHashVersion = shardCollectionEntry.getHashVersion();
+    return collAndChunks;
 }
 
 DatabaseType getPersistedDbMetadata(OperationContext* opCtx, StringData dbName) {
@@ -134,7 +134,8 @@ void checkForExistingChunks(OperationContext* opCtx, const NamespaceString& nss)
 BSONObj makeCreateIndexesCmd(const NamespaceString& nss,
                              const BSONObj& keys,
                              const BSONObj& collation,
-                             bool unique) {
+                             bool unique,
+                             int hashVersion) {
     BSONObjBuilder index;
 
     // Required fields for an index.
@@ -173,6 +174,10 @@ BSONObj makeCreateIndexesCmd(const NamespaceString& nss,
         index.appendBool("unique", unique);
     }
 
+    if (hashVersion != BSONElementHasher::DEFAULT_HASH_VERSION) {
+        index.append(IndexDescriptor::kHashVersionFieldName, hashVersion);
+    }
+
     // The outer createIndexes command.
 
     BSONObjBuilder createIndexes;
@@ -207,7 +212,8 @@ void createIndexesOrValidateExisting(OperationContext* opCtx,
     //         ii. is not a sparse index, partial index, or index with a non-simple collation
     //         iii. contains no null values
     //         iv. is not multikey (maybe lift this restriction later)
-    //         v. if a hashed index, has default seed (lift this restriction later)
+    //         v. if a hashed index, has default seed (lift this restriction later) and the
+    //            same hash version as the proposed shard key
     //
     // 3. If the proposed shard key is specified as unique, there must exist a useful,
     //    unique index exactly equal to the proposedKey (not just a prefix).
@@ -254,6 +260,17 @@ void createIndexesOrValidateExisting(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key "
+                                  << proposedKey
+                                  << " and hash version "
+                                  << shardKeyPattern.getHashVersion()
+                                  << " because the hashed index uses hash version "
+                                  << idx[IndexDescriptor::kHashVersionFieldName].numberInt(),
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx[IndexDescriptor::kHashVersionFieldName].numberInt() ==
+                            shardKeyPattern.getHashVersion());
             hasUsefulIndexForKey = true;
         }
     }
@@ -309,7 +326,11 @@ void createIndexesOrValidateExisting(OperationContext* opCtx,
         BSONObj collation =
             !request.getCollation()->isEmpty() ? CollationSpec::kSimpleSpec : BSONObj();
         auto createIndexesCmd =
-            makeCreateIndexesCmd(nss, proposedKey, collation, request.getUnique());
+            makeCreateIndexesCmd(nss,
+                                 proposedKey,
+                                 collation,
+                                 request.getUnique(),
+                                 shardKeyPattern.getHashVersion());
 
         BSONObj res;
         localClient.runCommand(nss.db().toString(), createIndexesCmd, res);
@@ -482,7 +503,7 @@ ShardCollectionTargetState calculateTargetState(OperationContext* opCtx,
                                                 const NamespaceString& nss,
                                                 const ShardsvrShardCollection& request,
                                                 const BSONObj& proposedKey) {
-    ShardKeyPattern shardKeyPattern(proposedKey);
+    ShardKeyPattern shardKeyPattern(proposedKey, request.getHashVersion());
 
     auto tags = getTagsAndValidate(opCtx, nss, shardKeyPattern.toBSON(), shardKeyPattern);
     auto uuid = getOrGenerateUUID(opCtx, nss, request);
@@ -644,6 +665,9 @@ void updateShardingCatalogEntryForCollection(
     coll.setKeyPattern(prerequisites.shardKeyPattern.toBSON());
     coll.setDefaultCollation(defaultCollator ? defaultCollator->getSpec().toBSON() : BSONObj());
     coll.setUnique(unique);
+    if (prerequisites.shardKeyPattern.getHashVersion() != BSONElementHasher::DEFAULT_HASH_VERSION) {
+        coll.setHashVersion(prerequisites.shardKeyPattern.getHashVersion());
+    }
 
     uassertStatusOK(ShardingCatalogClientImpl::updateShardingCatalogEntryForCollection(
         opCtx, nss, coll, true /*upsert*/));
@@ -713,7 +737,7 @@ UUID shardCollection(OperationContext* opCtx,
     checkForExistingChunks(opCtx, nss);
 
     const auto proposedKey(request.getKey().getOwned());
-    const ShardKeyPattern shardKeyPattern(proposedKey);
+    const ShardKeyPattern shardKeyPattern(proposedKey, request.getHashVersion());
     createIndexesOrValidateExisting(opCtx, nss, proposedKey, shardKeyPattern, request);
 
     {
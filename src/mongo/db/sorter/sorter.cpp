@@ -49,10 +49,15 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <exception>
 #include <snappy.h>
 #include <vector>
+#include <zlib.h>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
@@ -61,6 +66,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/destructor_guard.h"
@@ -105,6 +111,88 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+// A compressed block of spilled data starts with one of these bytes, naming its compressor. A zlib
+// block then holds its uncompressed size, which snappy records itself.
+const char kSnappyBlock = 's';
+const char kZlibBlock = 'z';
+const size_t kZlibBlockHeaderSize = 1 + sizeof(int32_t);
+
+// A parallel sort gives each thread at least this many elements.
+const size_t kMinParallelSortChunkSize = 16 * 1024;
+
+/**
+ * Calls 'task' with each index in [0, numTasks), each on a thread of its own except for the first,
+ * which runs on this thread. Rethrows the first exception thrown by a task once all have finished.
+ */
+template <typename Task>
+void runInParallel(size_t numTasks, const Task& task) {
+    std::vector<std::exception_ptr> errors(numTasks);
+    auto runTask = [&](size_t i) {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < numTasks; ++i) {
+        try {
+            threads.emplace_back(runTask, i);
+        } catch (const std::system_error&) {
+            runTask(i);
+        }
+    }
+    runTask(0);
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * Like std::stable_sort(), but splits [begin, end) into up to 'numThreads' contiguous chunks which
+ * are sorted concurrently, and then merges adjacent chunks pairwise, also concurrently.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, const Less& less, size_t numThreads) {
+    const size_t size = std::distance(begin, end);
+    numThreads = std::min(numThreads, size / kMinParallelSortChunkSize);
+    if (numThreads <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    // The chunks are [bounds[i], bounds[i + 1]).
+    std::vector<RandomIt> bounds;
+    for (size_t i = 0; i <= numThreads; ++i) {
+        bounds.push_back(begin + size * i / numThreads);
+    }
+
+    runInParallel(numThreads, [&](size_t i) { std::stable_sort(bounds[i], bounds[i + 1], less); });
+
+    while (bounds.size() > 2) {
+        const size_t numChunks = bounds.size() - 1;
+        runInParallel(numChunks / 2, [&](size_t i) {
+            std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], less);
+        });
+
+        std::vector<RandomIt> mergedBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            mergedBounds.push_back(bounds[i]);
+        }
+        if (numChunks % 2) {
+            mergedBounds.push_back(bounds.back());
+        }
+        bounds.swap(mergedBounds);
+    }
+}
+
 /**
  * Returns results from sorted in-memory storage.
  */
@@ -264,17 +352,51 @@ private:
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
+        uassert(56869, "compressed block is empty", blockSize > 0);
+        const char* compressedData = _buffer.get() + 1;
+        size_t compressedSize = blockSize - 1;
 
         size_t uncompressedSize;
-        uassert(17061,
-                "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
-
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
-        uassert(17062,
-                "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+        std::unique_ptr<char[]> decompressionBuffer;
+        switch (_buffer[0]) {
+            case kSnappyBlock: {
+                dassert(snappy::IsValidCompressedBuffer(compressedData, compressedSize));
+
+                uassert(17061,
+                        "couldn't get uncompressed length",
+                        snappy::GetUncompressedLength(
+                            compressedData, compressedSize, &uncompressedSize));
+
+                decompressionBuffer.reset(new char[uncompressedSize]);
+                uassert(17062,
+                        "decompression failed",
+                        snappy::RawUncompress(
+                            compressedData, compressedSize, decompressionBuffer.get()));
+                break;
+            }
+            case kZlibBlock: {
+                uassert(56867, "zlib block too short", blockSize >= int32_t(kZlibBlockHeaderSize));
+                uncompressedSize = ConstDataView(compressedData).read<LittleEndian<int32_t>>();
+                compressedData += sizeof(int32_t);
+                compressedSize -= sizeof(int32_t);
+
+                decompressionBuffer.reset(new char[uncompressedSize]);
+                uLongf zlibSize = uncompressedSize;
+                const int ret = ::uncompress(reinterpret_cast<Bytef*>(decompressionBuffer.get()),
+                                             &zlibSize,
+                                             reinterpret_cast<const Bytef*>(compressedData),
+                                             compressedSize);
+                uassert(56868,
+                        str::stream() << "decompression failed: " << zError(ret),
+                        ret == Z_OK && zlibSize == uncompressedSize);
+                break;
+            }
+            default:
+                uasserted(56866,
+                          str::stream() << "unknown compressor for block in file \"" << _fileName
+                                        << "\": "
+                                        << static_cast<int>(_buffer[0]));
+        }
 
         // hold on to decompressed data and throw out compressed data at block exit
         _buffer.swap(decompressionBuffer);
@@ -364,7 +486,9 @@ public:
         // file. Some systems will error closing the file if any file handles are still open.
         _current.reset();
         _heap.clear();
-        DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
+        if (!_itersSourceFileName.empty()) {
+            DESTRUCTOR_GUARD(boost::filesystem::remove(_itersSourceFileName));
+        }
     }
 
     void openSource() {}
@@ -468,6 +592,54 @@ private:
     std::string _itersSourceFileName;
 };
 
+/**
+ * Merges runs which were spilled to 'fileName' into longer runs appended to the same file, until
+ * no more than opts.maxMergeFanIn remain in 'spilled'. Each pass merges consecutive groups of runs
+ * from the front, only as many as needed, so no data is written more than once per pass. A merged
+ * run takes the place of the runs it replaces, so the final merge still returns equal elements in
+ * the order in which they were added.
+ */
+template <typename Key, typename Value, typename Comparator>
+void mergeSpilledRuns(const SortOptions& opts,
+                      const Comparator& comp,
+                      const std::string& fileName,
+                      const typename SortedFileWriter<Key, Value>::Settings& settings,
+                      std::streampos* nextSortedFileWriterOffset,
+                      std::vector<std::shared_ptr<SortIteratorInterface<Key, Value>>>* spilled) {
+    typedef SortIteratorInterface<Key, Value> Iterator;
+
+    if (opts.maxMergeFanIn == 0) {
+        return;
+    }
+    const size_t fanIn = std::max(opts.maxMergeFanIn, size_t(2));
+
+    size_t pos = 0;  // The first run not yet merged by this pass.
+    while (spilled->size() > fanIn) {
+        if (spilled->size() - pos < 2) {
+            pos = 0;
+        }
+        const size_t numToMerge =
+            std::min({fanIn, spilled->size() - fanIn + 1, spilled->size() - pos});
+        const auto first = spilled->begin() + pos;
+        const auto last = first + numToMerge;
+
+        SortedFileWriter<Key, Value> writer(opts, fileName, *nextSortedFileWriterOffset, settings);
+        {
+            // The merged runs remain in the file, which still belongs to the caller.
+            MergeIterator<Key, Value, Comparator> merged(
+                std::vector<std::shared_ptr<Iterator>>(first, last), "", opts, comp);
+            while (merged.more()) {
+                auto next = merged.next();
+                writer.addAlreadySorted(next.first, next.second);
+            }
+        }
+        *first = std::shared_ptr<Iterator>(writer.done());
+        *nextSortedFileWriterOffset = writer.getFileEndOffset();
+        spilled->erase(first + 1, last);
+        ++pos;
+    }
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -516,6 +688,8 @@ public:
         }
 
         spill();
+        mergeSpilledRuns<Key, Value>(
+            _opts, _comp, _fileName, _settings, &_nextSortedFileWriterOffset, &_iters);
         Iterator* mergeIt = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return mergeIt;
@@ -536,7 +710,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data.begin(), _data.end(), less, _opts.numSortThreads);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
@@ -720,6 +894,8 @@ public:
         }
 
         spill();
+        mergeSpilledRuns<Key, Value>(
+            _opts, _comp, _fileName, _settings, &_nextSortedFileWriterOffset, &_iters);
         Iterator* iterator = Iterator::merge(_iters, _fileName, _opts, _comp);
         _done = true;
         return iterator;
@@ -894,9 +1070,14 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
                                                const std::string& fileName,
                                                const std::streampos fileStartOffset,
                                                const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings), _spillCompressionLevel(opts.spillCompressionLevel) {
     namespace str = mongoutils::str;
 
+    uassert(56865,
+            str::stream() << "invalid spill compression level: " << _spillCompressionLevel,
+            _spillCompressionLevel >= SortOptions::kNoSpillCompression &&
+                _spillCompressionLevel <= Z_BEST_COMPRESSION);
+
     // This should be checked by consumers, but if we get here don't allow writes.
     uassert(
         16946, "Attempting to use external sort from mongos. This is not allowed.", !isMongos());
@@ -945,14 +1126,33 @@ void SortedFileWriter<Key, Value>::spill() {
     if (size == 0)
         return;
 
-    std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
+    std::unique_ptr<char[]> compressed;
+    size_t compressedSize = 0;
+    if (_spillCompressionLevel == SortOptions::kSnappySpillCompression) {
+        compressed.reset(new char[1 + snappy::MaxCompressedLength(size)]);
+        compressed[0] = sorter::kSnappyBlock;
+        snappy::RawCompress(outBuffer, size, compressed.get() + 1, &compressedSize);
+        compressedSize += 1;
+    } else if (_spillCompressionLevel != SortOptions::kNoSpillCompression) {
+        uLongf zlibSize = compressBound(size);
+        compressed.reset(new char[sorter::kZlibBlockHeaderSize + zlibSize]);
+        compressed[0] = sorter::kZlibBlock;
+        DataView(compressed.get() + 1).write<LittleEndian<int32_t>>(size);
+        const int ret =
+            compress2(reinterpret_cast<Bytef*>(compressed.get() + sorter::kZlibBlockHeaderSize),
+                      &zlibSize,
+                      reinterpret_cast<const Bytef*>(outBuffer),
+                      size,
+                      _spillCompressionLevel);
+        massert(56864, str::stream() << "compression failed: " << zError(ret), ret == Z_OK);
+        compressedSize = sorter::kZlibBlockHeaderSize + zlibSize;
+    }
+    verify(compressedSize <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = compressed && compressedSize < size_t(_buffer.len() / 10 * 9);
     if (shouldCompress) {
-        size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        size = compressedSize;
+        outBuffer = compressed.get();
     }
 
     std::unique_ptr<char[]> out;
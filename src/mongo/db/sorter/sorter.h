@@ -91,6 +91,10 @@ namespace mongo {
  * Runtime options that control the Sorter's behavior
  */
 struct SortOptions {
+    // Values of spillCompressionLevel other than the zlib levels 1 through 9.
+    static const int kNoSpillCompression = -1;
+    static const int kSnappySpillCompression = 0;
+
     // The number of KV pairs to be returned. 0 indicates no limit.
     unsigned long long limit;
 
@@ -105,7 +109,25 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // The number of threads which sort the data held in memory before it is spilled or returned.
+    size_t numSortThreads;
+
+    // The most spilled runs which are merged at once. When a sorter has spilled more runs than
+    // this, the oldest ones are merged into longer runs appended to its spill file first, which
+    // bounds the number of file handles and buffers used by the final merge. 0 means no limit.
+    size_t maxMergeFanIn;
+
+    // How blocks of spilled data are compressed: kSnappySpillCompression is cheap, while the zlib
+    // levels 1 through 9 trade CPU time for smaller spill files.
+    int spillCompressionLevel;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          numSortThreads(1),
+          maxMergeFanIn(256),
+          spillCompressionLevel(kSnappySpillCompression) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -128,6 +150,21 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& NumSortThreads(size_t newNumSortThreads) {
+        numSortThreads = newNumSortThreads;
+        return *this;
+    }
+
+    SortOptions& MaxMergeFanIn(size_t newMaxMergeFanIn) {
+        maxMergeFanIn = newMaxMergeFanIn;
+        return *this;
+    }
+
+    SortOptions& SpillCompressionLevel(int newSpillCompressionLevel) {
+        spillCompressionLevel = newSpillCompressionLevel;
+        return *this;
+    }
 };
 
 /**
@@ -250,6 +287,7 @@ private:
     void spill();
 
     const Settings _settings;
+    const int _spillCompressionLevel;
     std::string _fileName;
     std::ofstream _file;
     BufBuilder _buffer;
@@ -304,6 +304,18 @@ public:
 
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
+        for (int level : {SortOptions::kNoSpillCompression, 1, 9}) {  // other compression levels
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions(opts).SpillCompressionLevel(level), fileName, 0);
+            for (int i = 0; i < 100 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
+                                        make_shared<IntIterator>(0, 100 * 1000));
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -366,6 +378,34 @@ public:
     }
 };
 
+class ParallelStableSortTests {
+public:
+    void run() {
+        auto less = [](const IWPair& lhs, const IWPair& rhs) {
+            return IWComparator()(lhs, rhs) < 0;
+        };
+
+        // Few distinct keys, so that any reordering of equal keys shows in the values.
+        std::vector<IWPair> input;
+        for (int i = 0; i < 100 * 1000; i++)
+            input.push_back(IWPair(std::rand() % 100, i));
+
+        std::vector<IWPair> expected(input);
+        std::stable_sort(expected.begin(), expected.end(), less);
+
+        for (size_t numThreads : {1, 2, 3, 8}) {
+            std::deque<IWPair> data(input.begin(), input.end());
+            parallelStableSort(data.begin(), data.end(), less, numThreads);
+
+            ASSERT_EQUALS(data.size(), expected.size());
+            for (size_t i = 0; i < data.size(); i++) {
+                ASSERT_EQUALS(data[i].first, expected[i].first);
+                ASSERT_EQUALS(data[i].second, expected[i].second);
+            }
+        }
+    }
+};
+
 namespace SorterTests {
 class Basic : public ScopedGlobalServiceContextForTest {
 public:
@@ -568,6 +608,18 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <int SpillCompressionLevel, bool Random = true>
+class LotsOfDataSmallMergeFanIn : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // The runs are merged a few at a time over several passes before the final merge.
+        return Parent::adjustSortOptions(opts)
+            .MaxMergeFanIn(4)
+            .NumSortThreads(4)
+            .SpillCompressionLevel(SpillCompressionLevel);
+    }
+};
 }
 
 class SorterSuite : public mongo::unittest::Suite {
@@ -578,6 +630,7 @@ public:
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
         add<MergeIteratorTests>();
+        add<ParallelStableSortTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
         add<SorterTests::Dupes>();
@@ -589,6 +642,9 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::LotsOfDataSmallMergeFanIn<SortOptions::kSnappySpillCompression>>();
+        add<SorterTests::LotsOfDataSmallMergeFanIn<SortOptions::kNoSpillCompression>>();
+        add<SorterTests::LotsOfDataSmallMergeFanIn<1, /*random=*/false>>();
     }
 };
 
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include <algorithm>
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/debug_util.h"
+
+namespace mongo {
+namespace clustered_record_id {
+
+namespace {
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+const int64_t kSlotMask = (int64_t(1) << kSlotBits) - 1;
+
+/**
+ * Returns the first four bytes of 'key' as a big-endian number, padded with zeros if the key is
+ * shorter, shifted above the slot bits. Every KeyString starts with a type byte between 10 and 240,
+ * so the result is positive and leaves room for the slot bits below RecordId::max().
+ */
+int64_t groupFor(StringData key) {
+    int64_t group = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        group = (group << 8) | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0);
+    }
+    return group << kSlotBits;
+}
+}  // namespace
+
+std::string keyForId(const BSONElement& id) {
+    const KeyString ks(KeyString::Version::V1, id.wrap(""), kAllAscending);
+    return std::string(ks.getBuffer(), ks.getSize());
+}
+
+StatusWith<std::string> extractKey(const char* data, int len) {
+    DEV invariant(validateBSON(data, len, BSONVersion::kLatest).isOK());
+
+    const BSONElement id = BSONObj(data)["_id"];
+    if (id.eoo())
+        return {ErrorCodes::BadValue, "documents in a clustered collection must have an _id"};
+    return keyForId(id);
+}
+
+RecordId homeRecordId(StringData key) {
+    // The hash must never change, since it places documents on disk.
+    uint32_t hash;
+    MurmurHash3_x86_32(key.rawData(), key.size(), 0, &hash);
+
+    // Keep all of the probed slots within the group.
+    const int64_t slot = std::min<int64_t>(hash & kSlotMask, kSlotMask - (kProbeSlots - 1));
+    return RecordId(groupFor(key) | slot);
+}
+
+RecordId minRecordIdInGroup(StringData key) {
+    return RecordId(groupFor(key));
+}
+
+RecordId maxRecordIdInGroup(StringData key) {
+    return RecordId(groupFor(key) | kSlotMask);
+}
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+class BSONElement;
+
+/**
+ * A collection created with the 'clustered' option has no _id index. Instead, each document is
+ * stored under a RecordId derived from the KeyString of its _id, so that the record store doubles
+ * as the _id index and secondary indexes point straight at the documents. Keys compare like _id
+ * values under the simple collation, and _id values which compare equal (e.g. 5, NumberLong(5) and
+ * 5.0) share a key, matching the uniqueness rules of an _id index.
+ *
+ * A RecordId is 64 bits, which cannot hold every key. Its high bits hold the key's group, which is
+ * its first four bytes, so that RecordIds order documents by group. The low kSlotBits bits hold a
+ * slot picked by hashing the whole key. A document is stored in the first free slot among the
+ * kProbeSlots slots starting at its key's home slot, and is found by comparing the _ids of the
+ * documents in those slots. Documents in the same group are not in _id order.
+ */
+namespace clustered_record_id {
+
+// The number of low bits of a RecordId which hold its slot within a group.
+const int kSlotBits = 31;
+
+// The number of consecutive slots, starting at the home slot, in which a key may be stored.
+const int kProbeSlots = 8;
+
+/**
+ * Returns the key under which the document with the given _id is stored.
+ */
+std::string keyForId(const BSONElement& id);
+
+/**
+ * data and len must be the arguments from RecordStore::insert() on a clustered collection. Returns
+ * BadValue if the document has no _id.
+ */
+StatusWith<std::string> extractKey(const char* data, int len);
+
+/**
+ * Returns the first of the kProbeSlots RecordIds under which the document with key 'key' may be
+ * stored.
+ */
+RecordId homeRecordId(StringData key);
+
+/**
+ * Returns the smallest and largest RecordIds of the group of 'key'. Documents whose keys are at or
+ * after 'key' have RecordIds at or after the first, and documents whose keys are at or before
+ * 'key' have RecordIds at or before the second.
+ */
+RecordId minRecordIdInGroup(StringData key);
+RecordId maxRecordIdInGroup(StringData key);
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::string keyFor(const BSONObj& obj) {
+    return clustered_record_id::keyForId(obj.firstElement());
+}
+
+TEST(ClusteredRecordIdTest, NumericallyEqualIdsShareAKey) {
+    const std::string expected = keyFor(BSON("_id" << 5));
+    ASSERT_EQ(expected, keyFor(BSON("_id" << 5LL)));
+    ASSERT_EQ(expected, keyFor(BSON("_id" << 5.0)));
+    ASSERT_EQ(expected, keyFor(BSON("_id" << Decimal128("5.00"))));
+    ASSERT_NE(expected, keyFor(BSON("_id" << 5.5)));
+}
+
+TEST(ClusteredRecordIdTest, KeysPreserveIdOrder) {
+    const OID oid = OID::gen();
+    const std::vector<BSONObj> ascending{BSON("_id" << MINKEY),
+                                         BSON("_id" << BSONNULL),
+                                         BSON("_id" << std::numeric_limits<double>::quiet_NaN()),
+                                         BSON("_id" << std::numeric_limits<long long>::min()),
+                                         BSON("_id" << -1.5),
+                                         BSON("_id" << 0),
+                                         BSON("_id" << 1),
+                                         BSON("_id" << (1LL << 40)),
+                                         BSON("_id" << 1e19),
+                                         BSON("_id"
+                                              << "a"),
+                                         BSON("_id"
+                                              << "b"),
+                                         BSON("_id" << BSON("x" << 1)),
+                                         BSON("_id" << oid),
+                                         BSON("_id" << true),
+                                         BSON("_id" << Date_t::fromMillisSinceEpoch(1)),
+                                         BSON("_id" << MAXKEY)};
+    for (size_t i = 1; i < ascending.size(); ++i) {
+        ASSERT_LT(keyFor(ascending[i - 1]), keyFor(ascending[i]))
+            << ascending[i - 1] << " " << ascending[i];
+        ASSERT_LT(ascending[i - 1].firstElement().woCompare(ascending[i].firstElement(), false),
+                  0);
+    }
+}
+
+TEST(ClusteredRecordIdTest, RecordIdsPreserveGroupOrder) {
+    const OID oid = OID::gen();
+    const std::vector<BSONObj> ascending{BSON("_id" << MINKEY),
+                                         BSON("_id" << -1.5),
+                                         BSON("_id" << 0),
+                                         BSON("_id" << (1LL << 40)),
+                                         BSON("_id"
+                                              << "a"),
+                                         BSON("_id"
+                                              << "abcd"),
+                                         BSON("_id"
+                                              << "abcde"),
+                                         BSON("_id" << oid),
+                                         BSON("_id" << MAXKEY)};
+    for (size_t i = 0; i < ascending.size(); ++i) {
+        const std::string key = keyFor(ascending[i]);
+        const RecordId home = clustered_record_id::homeRecordId(key);
+        const RecordId min = clustered_record_id::minRecordIdInGroup(key);
+        const RecordId max = clustered_record_id::maxRecordIdInGroup(key);
+        ASSERT(min.isNormal()) << ascending[i];
+        ASSERT(max.isNormal()) << ascending[i];
+        ASSERT_LTE(min, home);
+        ASSERT_LTE(home.repr() + clustered_record_id::kProbeSlots - 1, max.repr());
+
+        if (i > 0) {
+            const std::string prevKey = keyFor(ascending[i - 1]);
+            ASSERT_LTE(clustered_record_id::maxRecordIdInGroup(prevKey), max);
+            ASSERT_LTE(clustered_record_id::minRecordIdInGroup(prevKey), min);
+        }
+    }
+
+    // Keys which share their first four bytes share a group.
+    ASSERT_EQ(clustered_record_id::minRecordIdInGroup(keyFor(BSON("_id"
+                                                                  << "abcd"))),
+              clustered_record_id::minRecordIdInGroup(keyFor(BSON("_id"
+                                                                  << "abcde"))));
+}
+
+TEST(ClusteredRecordIdTest, NumericallyEqualIdsShareAHomeRecordId) {
+    const RecordId expected = clustered_record_id::homeRecordId(keyFor(BSON("_id" << 5)));
+    ASSERT_EQ(expected, clustered_record_id::homeRecordId(keyFor(BSON("_id" << 5LL))));
+    ASSERT_EQ(expected, clustered_record_id::homeRecordId(keyFor(BSON("_id" << 5.0))));
+}
+
+TEST(ClusteredRecordIdTest, ExtractsKeyFromDocument) {
+    const OID oid = OID::gen();
+    const BSONObj doc = BSON("a" << 1 << "_id" << oid);
+    ASSERT_EQ(keyFor(BSON("_id" << oid)),
+              unittest::assertGet(clustered_record_id::extractKey(doc.objdata(), doc.objsize())));
+
+    const BSONObj noId = BSON("a" << 1);
+    ASSERT_EQ(ErrorCodes::BadValue,
+              clustered_record_id::extractKey(noId.objdata(), noId.objsize()).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
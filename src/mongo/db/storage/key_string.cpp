@@ -342,11 +342,22 @@ void KeyString::resetToKey(const BSONObj& obj, Ordering ord, Discriminator discr
 void KeyString::_appendAllElementsForIndexing(const BSONObj& obj,
                                               Ordering ord,
                                               Discriminator discriminator) {
+    if (ord.descending(~0U) == 0) {
+        _appendAllElementsForIndexingImpl<true>(obj, ord, discriminator);
+    } else {
+        _appendAllElementsForIndexingImpl<false>(obj, ord, discriminator);
+    }
+}
+
+template <bool allAscending>
+void KeyString::_appendAllElementsForIndexingImpl(const BSONObj& obj,
+                                                  Ordering ord,
+                                                  Discriminator discriminator) {
     int elemCount = 0;
     BSONObjIterator it(obj);
     while (auto elem = it.next()) {
         const int elemIdx = elemCount++;
-        const bool invert = (ord.get(elemIdx) == -1);
+        const bool invert = !allAscending && (ord.get(elemIdx) == -1);
 
         _appendBsonValue(elem, invert, NULL);
 
@@ -364,6 +375,10 @@ void KeyString::_appendAllElementsForIndexing(const BSONObj& obj,
         }
     }
 
+    appendDiscriminator(discriminator);
+}
+
+void KeyString::appendDiscriminator(Discriminator discriminator) {
     // The discriminator forces this KeyString to compare Less/Greater than any KeyString with
     // the same prefix of keys. As an example, this can be used to land on the first key in the
     // index with the value "a" regardless of the RecordId. In compound indexes it can use a
@@ -328,6 +328,21 @@ public:
     void appendRecordId(RecordId loc);
     void appendTypeBits(const TypeBits& bits);
 
+    /**
+     * Appends the value of 'elem' as the next component of an index key, inverted if that
+     * component of the key pattern is descending. Together with appendDiscriminator(), this
+     * builds the same KeyString as resetToKey() from the elements of a key, without first
+     * assembling them into a BSONObj.
+     */
+    void appendBSONElement(const BSONElement& elem, bool invert = false) {
+        _appendBsonValue(elem, invert, nullptr);
+    }
+
+    /**
+     * Terminates a key built with appendBSONElement(). A RecordId may be appended afterwards.
+     */
+    void appendDiscriminator(Discriminator discriminator);
+
     /**
      * Resets to an empty state.
      * Equivalent to but faster than *this = KeyString()
@@ -376,6 +391,13 @@ private:
                                        Ordering ord,
                                        Discriminator discriminator);
 
+    // Instantiated separately for key patterns which are ascending in every field, which is the
+    // overwhelmingly common case, so that no per-element Ordering lookup is done for them.
+    template <bool allAscending>
+    void _appendAllElementsForIndexingImpl(const BSONObj& obj,
+                                           Ordering ord,
+                                           Discriminator discriminator);
+
     void _appendBool(bool val, bool invert);
     void _appendDate(Date_t val, bool invert);
     void _appendTimestamp(Timestamp val, bool invert);
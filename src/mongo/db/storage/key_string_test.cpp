@@ -1173,6 +1173,36 @@ TEST_F(KeyStringTest, RecordIds) {
     }
 }
 
+TEST_F(KeyStringTest, AppendingElementsMatchesResetToKey) {
+    const BSONObj key = BSON("" << 5 << ""
+                                << "str"
+                                << "" << 2.5 << "" << BSON("a" << 1) << "" << BSONNULL);
+    const RecordId rid(42);
+
+    for (auto&& ord : {ALL_ASCENDING,
+                       Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1 << "d" << -1 << "e"
+                                               << -1))}) {
+        KeyString appended(version);
+        int i = 0;
+        for (auto&& elem : key) {
+            appended.appendBSONElement(elem, ord.get(i++) == -1);
+        }
+        appended.appendDiscriminator(KeyString::kInclusive);
+
+        const KeyString expected(version, key, ord);
+        ASSERT_EQ(appended, expected);
+        ASSERT_EQ(appended.getTypeBits().getSize(), expected.getTypeBits().getSize());
+        ASSERT_EQ(0,
+                  memcmp(appended.getTypeBits().getBuffer(),
+                         expected.getTypeBits().getBuffer(),
+                         expected.getTypeBits().getSize()));
+        ASSERT_BSONOBJ_EQ(key, toBsonAndCheckKeySize(appended, ord));
+
+        appended.appendRecordId(rid);
+        ASSERT_EQ(appended, KeyString(version, key, ord, rid));
+    }
+}
+
 TEST_F(KeyStringTest, KeyWithTooManyTypeBitsCausesUassert) {
     BSONObj obj;
     {
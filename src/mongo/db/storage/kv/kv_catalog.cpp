@@ -60,6 +60,7 @@ const char kIsFeatureDocumentFieldName[] = "isFeatureDoc";
 const char kNamespaceFieldName[] = "ns";
 const char kNonRepairableFeaturesFieldName[] = "nonRepairable";
 const char kRepairableFeaturesFieldName[] = "repairable";
+const char kInternalIdentPrefix[] = "internal-";
 
 void appendPositionsOfBitsSet(uint64_t value, StringBuilder* sb) {
     invariant(sb);
@@ -642,6 +643,16 @@ bool KVCatalog::isCollectionIdent(StringData ident) const {
         ident.find("collection/") != std::string::npos;
 }
 
+std::string KVCatalog::newInternalIdent() {
+    StringBuilder buf;
+    buf << kInternalIdentPrefix << _next.fetchAndAdd(1) << '-' << _rand;
+    return buf.str();
+}
+
+bool KVCatalog::isInternalIdent(StringData ident) const {
+    return ident.startsWith(kInternalIdentPrefix);
+}
+
 StatusWith<std::string> KVCatalog::newOrphanedIdent(OperationContext* opCtx, std::string ident) {
     // The collection will be named local.orphan.xxxxx.
     std::string identNs = ident;
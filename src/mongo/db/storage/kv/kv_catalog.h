@@ -96,6 +96,14 @@ public:
 
     bool isCollectionIdent(StringData ident) const;
 
+    /**
+     * Returns a new ident for a table that is not part of the catalog, such as the backing table of
+     * a TemporaryRecordStore. Such idents are dropped on startup.
+     */
+    std::string newInternalIdent();
+
+    bool isInternalIdent(StringData ident) const;
+
     FeatureTracker* getFeatureTracker() const {
         invariant(_featureTracker);
         return _featureTracker.get();
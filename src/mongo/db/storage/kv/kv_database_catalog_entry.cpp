@@ -41,10 +41,13 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/s2_access_method.h"
+#include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/storage/kv/kv_collection_catalog_entry.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/kv/kv_lazy_sorted_data_interface.h"
 #include "mongo/db/storage/kv/kv_storage_engine.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 
@@ -67,6 +70,12 @@ IndexAccessMethod* KVDatabaseCatalogEntry::getIndex(OperationContext* opCtx,
 
     SortedDataInterface* sdi =
         _engine->getEngine()->getGroupedSortedDataInterface(opCtx, ident, desc, index->getPrefix());
+    if (auto warmer = _engine->getLazyIndexWarmer()) {
+        auto lazySdi =
+            stdx::make_unique<LazySortedDataInterface>(std::unique_ptr<SortedDataInterface>(sdi));
+        warmer->enqueue(collection->ns(), lazySdi->getOpener());
+        sdi = lazySdi.release();
+    }
 
     if ("" == type)
         return new BtreeAccessMethod(index, sdi);
@@ -86,6 +95,9 @@ IndexAccessMethod* KVDatabaseCatalogEntry::getIndex(OperationContext* opCtx,
     if (IndexNames::GEO_2D == type)
         return new TwoDAccessMethod(index, sdi);
 
+    if (IndexNames::WILDCARD == type)
+        return new WildcardAccessMethod(index, sdi);
+
     log() << "Can't find index for keyPattern " << desc->keyPattern();
     MONGO_UNREACHABLE;
 }
@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "mongo/base/status.h"
+#include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/catalog/collection_options.h"
@@ -151,6 +152,17 @@ public:
         return createRecordStore(opCtx, ns, ident, options);
     }
 
+    /**
+     * Creates and opens a RecordStore for 'ident' that is not part of the catalog, to back a
+     * TemporaryRecordStore. Storage engines may override this to skip bookkeeping that only durable
+     * collections need.
+     */
+    virtual std::unique_ptr<RecordStore> makeTemporaryRecordStore(OperationContext* opCtx,
+                                                                  StringData ident) {
+        uassertStatusOK(createRecordStore(opCtx, "", ident, CollectionOptions()));
+        return getRecordStore(opCtx, "", ident, CollectionOptions());
+    }
+
     virtual Status createSortedDataInterface(OperationContext* opCtx,
                                              StringData ident,
                                              const IndexDescriptor* desc) = 0;
@@ -229,6 +241,21 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * See StorageEngine::beginNonBlockingBackup for details
+     */
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "The current storage engine doesn't support non-blocking backups");
+    }
+
+    /**
+     * See StorageEngine::endNonBlockingBackup for details
+     */
+    virtual void endNonBlockingBackup(OperationContext* opCtx) {
+        MONGO_UNREACHABLE;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -377,6 +404,13 @@ public:
         return false;
     }
 
+    /**
+     * See `StorageEngine::supportsClusteredCollections`
+     */
+    virtual bool supportsClusteredRecordStores() const {
+        return false;
+    }
+
     /**
      * See `StorageEngine::replicationBatchIsComplete()`
      */
@@ -0,0 +1,264 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/kv/kv_lazy_sorted_data_interface.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(storageLazyIndexOpen, bool, false);
+
+// The maximum number of index handles the LazyIndexWarmer opens per second. Zero disables
+// background warming, leaving every index handle to be opened by its first operation.
+MONGO_EXPORT_SERVER_PARAMETER(storageLazyIndexWarmingRate, int, 1000)
+    ->withValidator([](const int& potentialNewValue) {
+        if (potentialNewValue < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "storageLazyIndexWarmingRate must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+void LazySortedDataInterface::Opener::open(OperationContext* opCtx) {
+    if (_isOpen.load()) {
+        return;
+    }
+    // The cursor is closed right away, but the storage engine keeps its handle open.
+    _sdi->newCursor(opCtx);
+    _isOpen.store(true);
+}
+
+SortedDataBuilderInterface* LazySortedDataInterface::getBulkBuilder(OperationContext* opCtx,
+                                                                    bool dupsAllowed) {
+    return _get(opCtx)->getBulkBuilder(opCtx, dupsAllowed);
+}
+
+Status LazySortedDataInterface::insert(OperationContext* opCtx,
+                                       const BSONObj& key,
+                                       const RecordId& loc,
+                                       bool dupsAllowed) {
+    return _get(opCtx)->insert(opCtx, key, loc, dupsAllowed);
+}
+
+boost::optional<KeyString::Version> LazySortedDataInterface::getKeyStringInsertVersion(
+    OperationContext* opCtx) const {
+    return _get(opCtx)->getKeyStringInsertVersion(opCtx);
+}
+
+Status LazySortedDataInterface::insertKeyString(OperationContext* opCtx,
+                                                const KeyString& keyString,
+                                                int keySize,
+                                                const RecordId& loc,
+                                                bool dupsAllowed) {
+    return _get(opCtx)->insertKeyString(opCtx, keyString, keySize, loc, dupsAllowed);
+}
+
+void LazySortedDataInterface::unindex(OperationContext* opCtx,
+                                      const BSONObj& key,
+                                      const RecordId& loc,
+                                      bool dupsAllowed) {
+    _get(opCtx)->unindex(opCtx, key, loc, dupsAllowed);
+}
+
+Status LazySortedDataInterface::dupKeyCheck(OperationContext* opCtx,
+                                            const BSONObj& key,
+                                            const RecordId& loc) {
+    return _get(opCtx)->dupKeyCheck(opCtx, key, loc);
+}
+
+Status LazySortedDataInterface::compact(OperationContext* opCtx) {
+    return _get(opCtx)->compact(opCtx);
+}
+
+void LazySortedDataInterface::fullValidate(OperationContext* opCtx,
+                                           long long* numKeysOut,
+                                           ValidateResults* fullResults) const {
+    _get(opCtx)->fullValidate(opCtx, numKeysOut, fullResults);
+}
+
+bool LazySortedDataInterface::appendCustomStats(OperationContext* opCtx,
+                                                BSONObjBuilder* output,
+                                                double scale) const {
+    return _get(opCtx)->appendCustomStats(opCtx, output, scale);
+}
+
+long long LazySortedDataInterface::getSpaceUsedBytes(OperationContext* opCtx) const {
+    return _get(opCtx)->getSpaceUsedBytes(opCtx);
+}
+
+bool LazySortedDataInterface::isEmpty(OperationContext* opCtx) {
+    return _get(opCtx)->isEmpty(opCtx);
+}
+
+Status LazySortedDataInterface::touch(OperationContext* opCtx) const {
+    return _get(opCtx)->touch(opCtx);
+}
+
+long long LazySortedDataInterface::numEntries(OperationContext* opCtx) const {
+    return _get(opCtx)->numEntries(opCtx);
+}
+
+std::unique_ptr<SortedDataInterface::Cursor> LazySortedDataInterface::newCursor(
+    OperationContext* opCtx, bool isForward) const {
+    return _get(opCtx)->newCursor(opCtx, isForward);
+}
+
+std::unique_ptr<SortedDataInterface::Cursor> LazySortedDataInterface::newRandomCursor(
+    OperationContext* opCtx) const {
+    return _get(opCtx)->newRandomCursor(opCtx);
+}
+
+Status LazySortedDataInterface::initAsEmpty(OperationContext* opCtx) {
+    return _get(opCtx)->initAsEmpty(opCtx);
+}
+
+void LazyIndexWarmer::enqueue(const NamespaceString& nss,
+                              std::weak_ptr<LazySortedDataInterface::Opener> opener) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _queue.emplace_back(nss, std::move(opener));
+    _condvar.notify_one();
+}
+
+void LazyIndexWarmer::shutdown() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _shuttingDown = true;
+        _queue.clear();
+        _condvar.notify_one();
+    }
+    if (getState() != NotStarted) {
+        wait();
+    }
+}
+
+bool LazyIndexWarmer::_warm(OperationContext* opCtx, const QueueEntry& entry) {
+    const auto& nss = entry.first;
+    {
+        auto opener = entry.second.lock();
+        if (!opener || opener->isOpen()) {
+            return true;
+        }
+    }
+
+    // Dropping the index requires an exclusive lock on its collection, so holding an intent lock
+    // keeps the index alive while its handle is opened. Give up
+    // quickly on contended locks, so that shutdown, which holds the global lock exclusively while
+    // it waits for this thread, is not blocked.
+    const Date_t deadline = Date_t::now() + Milliseconds(100);
+    Lock::DBLock dbLock(opCtx, nss.db(), MODE_IS, deadline);
+    if (!dbLock.isLocked()) {
+        return false;
+    }
+    Lock::CollectionLock collLock(opCtx->lockState(), nss.ns(), MODE_IS, deadline);
+    if (!collLock.isLocked()) {
+        return false;
+    }
+
+    if (auto opener = entry.second.lock()) {
+        opener->open(opCtx);
+    }
+    return true;
+}
+
+void LazyIndexWarmer::run() {
+    Client::initThread(name().c_str());
+    ON_BLOCK_EXIT([] { Client::destroy(); });
+
+    LOG(1) << "starting " << name() << " thread";
+
+    size_t numProcessed = 0;
+    Date_t startTime = Date_t::now();
+    while (true) {
+        QueueEntry entry;
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+            // Poll while warming is disabled, so that re-enabling it takes effect.
+            while (!_shuttingDown && (_queue.empty() || storageLazyIndexWarmingRate.load() == 0)) {
+                _condvar.wait_for(lk, Seconds(1).toSystemDuration());
+            }
+            if (_shuttingDown) {
+                break;
+            }
+            entry = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        bool done = false;
+        try {
+            auto opCtx = cc().makeOperationContext();
+            done = _warm(opCtx.get(), entry);
+        } catch (const DBException& ex) {
+            // The handle is left to be opened by the first operation on the index.
+            warning() << "Failed to open index on " << entry.first << " in the background: "
+                      << redact(ex);
+            done = true;
+        }
+
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            if (!done && !_shuttingDown) {
+                _queue.push_back(std::move(entry));
+            }
+            if (done) {
+                ++numProcessed;
+            }
+            if (_queue.empty() && numProcessed > 0) {
+                log() << "Finished opening " << numProcessed << " indexes in the background in "
+                      << (Date_t::now() - startTime);
+                numProcessed = 0;
+                startTime = Date_t::now();
+            }
+
+            // Pace the warming so that it does not compete with user operations at startup.
+            const int rate = storageLazyIndexWarmingRate.load();
+            if (rate > 0) {
+                _condvar.wait_for(lk,
+                                  Microseconds(1000 * 1000 / rate).toSystemDuration(),
+                                  [&] { return _shuttingDown; });
+            }
+        }
+    }
+
+    LOG(1) << "stopping " << name() << " thread";
+}
+
+}  // namespace mongo
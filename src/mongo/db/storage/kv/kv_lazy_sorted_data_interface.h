@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/background.h"
+
+namespace mongo {
+
+/**
+ * Whether the storage engine handles of existing indexes are opened in the background after
+ * startup, rather than by the first operation on each index.
+ */
+extern bool storageLazyIndexOpen;
+
+/**
+ * A SortedDataInterface whose storage engine handle is opened by the LazyIndexWarmer, unless an
+ * operation on the index gets to it first.
+ *
+ * The underlying index is constructed when the catalog is loaded, so its metadata, format version
+ * and table logging settings are validated, and altered if need be, before any user operation
+ * runs. Only opening the storage engine's handle on the index, which happens with its first
+ * cursor, is left until after startup.
+ */
+class LazySortedDataInterface final : public SortedDataInterface {
+    MONGO_DISALLOW_COPYING(LazySortedDataInterface);
+
+public:
+    /**
+     * Owns the underlying index. Shared with the LazyIndexWarmer, which only holds a weak
+     * reference except while it has the collection locked.
+     */
+    class Opener {
+        MONGO_DISALLOW_COPYING(Opener);
+
+    public:
+        explicit Opener(std::unique_ptr<SortedDataInterface> sdi) : _sdi(std::move(sdi)) {}
+
+        SortedDataInterface* get() const {
+            return _sdi.get();
+        }
+
+        /**
+         * Opens the storage engine's handle on the index, by opening and then closing a cursor.
+         */
+        void open(OperationContext* opCtx);
+
+        bool isOpen() const {
+            return _isOpen.load();
+        }
+
+    private:
+        const std::unique_ptr<SortedDataInterface> _sdi;
+        AtomicBool _isOpen{false};
+    };
+
+    explicit LazySortedDataInterface(std::unique_ptr<SortedDataInterface> sdi)
+        : _opener(std::make_shared<Opener>(std::move(sdi))) {}
+
+    std::weak_ptr<Opener> getOpener() const {
+        return _opener;
+    }
+
+    bool isOpen() const {
+        return _opener->isOpen();
+    }
+
+    SortedDataBuilderInterface* getBulkBuilder(OperationContext* opCtx, bool dupsAllowed) override;
+
+    Status insert(OperationContext* opCtx,
+                  const BSONObj& key,
+                  const RecordId& loc,
+                  bool dupsAllowed) override;
+
+    boost::optional<KeyString::Version> getKeyStringInsertVersion(
+        OperationContext* opCtx) const override;
+
+    Status insertKeyString(OperationContext* opCtx,
+                           const KeyString& keyString,
+                           int keySize,
+                           const RecordId& loc,
+                           bool dupsAllowed) override;
+
+    void unindex(OperationContext* opCtx,
+                 const BSONObj& key,
+                 const RecordId& loc,
+                 bool dupsAllowed) override;
+
+    Status dupKeyCheck(OperationContext* opCtx, const BSONObj& key, const RecordId& loc) override;
+
+    Status compact(OperationContext* opCtx) override;
+
+    void fullValidate(OperationContext* opCtx,
+                      long long* numKeysOut,
+                      ValidateResults* fullResults) const override;
+
+    bool appendCustomStats(OperationContext* opCtx,
+                           BSONObjBuilder* output,
+                           double scale) const override;
+
+    long long getSpaceUsedBytes(OperationContext* opCtx) const override;
+
+    bool isEmpty(OperationContext* opCtx) override;
+
+    Status touch(OperationContext* opCtx) const override;
+
+    long long numEntries(OperationContext* opCtx) const override;
+
+    std::unique_ptr<SortedDataInterface::Cursor> newCursor(OperationContext* opCtx,
+                                                           bool isForward = true) const override;
+
+    std::unique_ptr<SortedDataInterface::Cursor> newRandomCursor(
+        OperationContext* opCtx) const override;
+
+    Status initAsEmpty(OperationContext* opCtx) override;
+
+private:
+    SortedDataInterface* _get(OperationContext* opCtx) const {
+        return _opener->get();
+    }
+
+    const std::shared_ptr<Opener> _opener;
+};
+
+/**
+ * Opens the storage engine handles of indexes in the background after startup, so that the first
+ * operation on each index does not have to. Handles are opened one at a time, under an intent
+ * shared lock on their collection, at a rate bounded by the 'storageLazyIndexWarmingRate' server
+ * parameter.
+ */
+class LazyIndexWarmer : public BackgroundJob {
+    MONGO_DISALLOW_COPYING(LazyIndexWarmer);
+
+public:
+    LazyIndexWarmer() : BackgroundJob(false /* deleteSelf */) {}
+
+    std::string name() const override {
+        return "LazyIndexWarmer";
+    }
+
+    /**
+     * Queues the index for warming. 'nss' is the namespace of the index's collection.
+     */
+    void enqueue(const NamespaceString& nss, std::weak_ptr<LazySortedDataInterface::Opener> opener);
+
+    void run() override;
+
+    void shutdown();
+
+private:
+    using QueueEntry = std::pair<NamespaceString, std::weak_ptr<LazySortedDataInterface::Opener>>;
+
+    /**
+     * Opens the handle on the index in 'entry' unless it has already been opened or the index has
+     * been dropped. Returns false if the collection lock could not be acquired in time, in which
+     * case 'entry' should be retried.
+     */
+    bool _warm(OperationContext* opCtx, const QueueEntry& entry);
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    std::deque<QueueEntry> _queue;
+    bool _shuttingDown = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/kv/kv_lazy_sorted_data_interface.h"
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_btree_impl.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class LazySortedDataInterfaceTest : public ServiceContextTest {
+public:
+    std::unique_ptr<LazySortedDataInterface> makeLazySortedDataInterface() {
+        return stdx::make_unique<LazySortedDataInterface>(std::unique_ptr<SortedDataInterface>(
+            getEphemeralForTestBtreeImpl(Ordering::make(BSON("a" << 1)), false, &_data)));
+    }
+
+private:
+    std::shared_ptr<void> _data;
+};
+
+TEST_F(LazySortedDataInterfaceTest, ForwardsOperationsBeforeHandleIsOpened) {
+    OperationContextNoop opCtx;
+    auto sdi = makeLazySortedDataInterface();
+    ASSERT_FALSE(sdi->isOpen());
+
+    ASSERT_TRUE(sdi->isEmpty(&opCtx));
+    ASSERT_OK(sdi->insert(&opCtx, BSON("" << 1), RecordId(1), true));
+    ASSERT_OK(sdi->insert(&opCtx, BSON("" << 2), RecordId(2), true));
+    ASSERT_EQ(2, sdi->numEntries(&opCtx));
+
+    auto cursor = sdi->newCursor(&opCtx);
+    auto entry = cursor->seek(BSON("" << 2), true);
+    ASSERT(entry);
+    ASSERT_EQ(RecordId(2), entry->loc);
+}
+
+TEST_F(LazySortedDataInterfaceTest, OpenerIsSharedUntilIndexIsDestroyed) {
+    OperationContextNoop opCtx;
+    auto sdi = makeLazySortedDataInterface();
+    auto weakOpener = sdi->getOpener();
+
+    auto opener = weakOpener.lock();
+    ASSERT(opener);
+    opener->open(&opCtx);
+    ASSERT_TRUE(sdi->isOpen());
+    ASSERT_TRUE(sdi->isEmpty(&opCtx));
+    opener.reset();
+
+    sdi.reset();
+    ASSERT_FALSE(weakOpener.lock());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -92,11 +93,16 @@ KVStorageEngine::KVStorageEngine(
             "Storage engine does not support --directoryperdb",
             !(options.directoryPerDB && !engine->supportsDirectoryPerDB()));
 
+    if (storageLazyIndexOpen) {
+        _lazyIndexWarmer = stdx::make_unique<LazyIndexWarmer>();
+    }
+
     OperationContextNoop opCtx(_engine->newRecoveryUnit());
     loadCatalog(&opCtx);
 }
 
 void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
+    Timer timer;
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -253,6 +259,9 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
     KVPrefix::setLargestPrefix(maxSeenPrefix);
     opCtx->recoveryUnit()->abandonSnapshot();
 
+    log() << "Loaded the catalog entries for " << collectionsKnownToCatalog.size()
+          << " collections in " << timer.millis() << "ms";
+
     // Unset the unclean shutdown flag to avoid executing special behavior if this method is called
     // after startup.
     startingAfterUncleanShutdown(getGlobalServiceContext()) = false;
@@ -353,6 +362,16 @@ KVStorageEngine::reconcileCatalogAndIdents(OperationContext* opCtx) {
             continue;
         }
 
+        // Tables backing temporary record stores are never in the catalog, and are left behind if
+        // the server shuts down before their owner drops them.
+        if (_catalog->isInternalIdent(it)) {
+            log() << "Dropping internal ident: " << it;
+            WriteUnitOfWork wuow(opCtx);
+            fassert(56862, _engine->dropIdent(opCtx, it));
+            wuow.commit();
+            continue;
+        }
+
         if (!_catalog->isUserDataIdent(it)) {
             continue;
         }
@@ -462,6 +481,10 @@ std::string KVStorageEngine::getFilesystemPathForDb(const std::string& dbName) c
 }
 
 void KVStorageEngine::cleanShutdown() {
+    if (_lazyIndexWarmer) {
+        _lazyIndexWarmer->shutdown();
+    }
+
     for (DBMap::const_iterator it = _dbs.begin(); it != _dbs.end(); ++it) {
         delete it->second;
     }
@@ -480,6 +503,10 @@ void KVStorageEngine::finishInit() {}
 
 void KVStorageEngine::notifyStartupComplete() {
     _engine->notifyStartupComplete();
+
+    if (_lazyIndexWarmer) {
+        _lazyIndexWarmer->go();
+    }
 }
 
 RecoveryUnit* KVStorageEngine::newRecoveryUnit() {
@@ -499,6 +526,45 @@ void KVStorageEngine::listDatabases(std::vector<std::string>* out) const {
     }
 }
 
+namespace {
+
+/**
+ * Drops the table backing a TemporaryRecordStore through the KVEngine that created it.
+ */
+class KVTemporaryRecordStore final : public TemporaryRecordStore {
+public:
+    KVTemporaryRecordStore(KVEngine* engine, std::unique_ptr<RecordStore> rs)
+        : TemporaryRecordStore(std::move(rs)), _engine(engine) {}
+
+    ~KVTemporaryRecordStore() {
+        if (_rs) {
+            warning() << "Temporary table " << _rs->getIdent()
+                      << " was not dropped by its owner; it will be dropped on the next startup";
+        }
+    }
+
+    void deleteTemporaryTable(OperationContext* opCtx) override {
+        invariant(_rs);
+        const std::string ident = _rs->getIdent();
+        _rs.reset();
+        LOG(1) << "Dropping temporary table: " << ident;
+        fassert(56863, _engine->dropIdent(opCtx, ident));
+    }
+
+private:
+    KVEngine* const _engine;
+};
+
+}  // namespace
+
+std::unique_ptr<TemporaryRecordStore> KVStorageEngine::makeTemporaryRecordStore(
+    OperationContext* opCtx) {
+    const std::string ident = _catalog->newInternalIdent();
+    LOG(1) << "Creating temporary table: " << ident;
+    return stdx::make_unique<KVTemporaryRecordStore>(
+        _engine.get(), _engine->makeTemporaryRecordStore(opCtx, ident));
+}
+
 KVDatabaseCatalogEntryBase* KVStorageEngine::getDatabaseCatalogEntry(OperationContext* opCtx,
                                                                      StringData dbName) {
     stdx::lock_guard<stdx::mutex> lk(_dbsLock);
@@ -598,6 +664,23 @@ void KVStorageEngine::endBackup(OperationContext* opCtx) {
     _inBackupMode = false;
 }
 
+StatusWith<std::vector<std::string>> KVStorageEngine::beginNonBlockingBackup(
+    OperationContext* opCtx) {
+    // A storage engine pins a single backup at a time, whichever kind it is.
+    if (_inBackupMode)
+        return Status(ErrorCodes::BadValue, "Already in Backup Mode");
+    auto files = _engine->beginNonBlockingBackup(opCtx);
+    if (files.isOK())
+        _inBackupMode = true;
+    return files;
+}
+
+void KVStorageEngine::endNonBlockingBackup(OperationContext* opCtx) {
+    invariant(_inBackupMode);
+    _engine->endNonBlockingBackup(opCtx);
+    _inBackupMode = false;
+}
+
 bool KVStorageEngine::isDurable() const {
     return _engine->isDurable();
 }
@@ -700,6 +783,10 @@ bool KVStorageEngine::supportsReadConcernMajority() const {
     return _engine->supportsReadConcernMajority();
 }
 
+bool KVStorageEngine::supportsClusteredCollections() const {
+    return _engine->supportsClusteredRecordStores();
+}
+
 void KVStorageEngine::replicationBatchIsComplete() const {
     return _engine->replicationBatchIsComplete();
 }
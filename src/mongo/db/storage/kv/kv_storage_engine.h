@@ -40,6 +40,7 @@
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/kv/kv_catalog.h"
 #include "mongo/db/storage/kv/kv_database_catalog_entry_base.h"
+#include "mongo/db/storage/kv/kv_lazy_sorted_data_interface.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/stdx/functional.h"
@@ -92,6 +93,9 @@ public:
     KVDatabaseCatalogEntryBase* getDatabaseCatalogEntry(OperationContext* opCtx,
                                                         StringData db) override;
 
+    std::unique_ptr<TemporaryRecordStore> makeTemporaryRecordStore(
+        OperationContext* opCtx) override;
+
     virtual bool supportsDocLocking() const {
         return _supportsDocLocking;
     }
@@ -114,6 +118,10 @@ public:
 
     virtual void endBackup(OperationContext* opCtx);
 
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx);
+
+    virtual void endNonBlockingBackup(OperationContext* opCtx);
+
     virtual bool isDurable() const;
 
     virtual bool isEphemeral() const;
@@ -148,6 +156,8 @@ public:
 
     bool supportsReadConcernMajority() const final;
 
+    bool supportsClusteredCollections() const final;
+
     virtual void replicationBatchIsComplete() const override;
 
     SnapshotManager* getSnapshotManager() const final;
@@ -170,6 +180,14 @@ public:
         return _catalog.get();
     }
 
+    /**
+     * Returns the background warmer for index handles, or nullptr if they are left to the first
+     * operation on each index.
+     */
+    LazyIndexWarmer* getLazyIndexWarmer() {
+        return _lazyIndexWarmer.get();
+    }
+
     /**
      * Drop abandoned idents. Returns a parallel list of index name, index spec pairs to rebuild.
      */
@@ -238,5 +256,8 @@ private:
 
     // Flag variable that states if the storage engine is in backup mode.
     bool _inBackupMode = false;
+
+    // Opens lazily opened indexes in the background once startup has completed.
+    std::unique_ptr<LazyIndexWarmer> _lazyIndexWarmer;
 };
 }  // namespace mongo
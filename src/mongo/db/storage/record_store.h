@@ -313,6 +313,34 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if each record is stored under a RecordId derived from its document's _id, as
+     * described in clustered_record_id.h, rather than under a generated RecordId.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
+    /**
+     * Clustered record stores only. Returns the RecordId of the first record, in RecordId order,
+     * which may have an _id at or after 'id' if 'forward' is true, or at or before 'id' otherwise.
+     * Records are only ordered by the group of their _id, so records up to the end of the group of
+     * 'id' may still be out of range. Returns a null RecordId if there is no such record.
+     */
+    virtual RecordId seekClusteredId(OperationContext* opCtx,
+                                     const BSONElement& id,
+                                     bool forward) const {
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Clustered record stores only. Returns the RecordId of the record whose _id is 'id', or a null
+     * RecordId if there is none.
+     */
+    virtual RecordId findClusteredId(OperationContext* opCtx, const BSONElement& id) const {
+        MONGO_UNREACHABLE;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
@@ -644,6 +672,25 @@ public:
      */
     virtual void waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const = 0;
 
+    /**
+     * Called when a reader is about to wait for new data to be inserted into this capped
+     * collection. Storage engines which delay making new oplog entries visible may use this to
+     * stop delaying.
+     */
+    virtual void notifyCappedWaiterArrived() const {}
+
+    /**
+     * Trains a new block compression dictionary from a sample of up to 'sampleSize' documents and
+     * appends information about it to 'result'. Only blocks written afterwards use the new
+     * dictionary.
+     */
+    virtual Status trainCompressionDictionary(OperationContext* opCtx,
+                                              long long sampleSize,
+                                              BSONObjBuilder* result) {
+        return {ErrorCodes::CommandNotSupported,
+                "This storage engine does not support trained compression dictionaries"};
+    }
+
     /**
      * Called after a repair operation is run with the recomputed numRecords and dataSize.
      */
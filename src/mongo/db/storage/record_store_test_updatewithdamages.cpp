@@ -238,6 +238,64 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
     }
 }
 
+// Insert a record and try to perform an in-place update on it with a DamageVector containing
+// DamageEvents which are contiguous in both the source and the target.
+TEST(RecordStoreTestHarness, UpdateWithAdjacentDamageEvents) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    if (!rs->updateWithDamagesSupported())
+        return;
+
+    string data = "00010111";
+    RecordId loc;
+    const RecordData rec(data.c_str(), data.size() + 1);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), rec.data(), rec.size(), Timestamp(), false);
+            ASSERT_OK(res.getStatus());
+            loc = res.getValue();
+            uow.commit();
+        }
+    }
+
+    string damageSource = "1101";
+    string modifiedData = "00110111";
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            mutablebson::DamageVector dv(3);
+            dv[0].sourceOffset = 0;
+            dv[0].targetOffset = 2;
+            dv[0].size = 1;
+            dv[1].sourceOffset = 1;
+            dv[1].targetOffset = 3;
+            dv[1].size = 1;
+            dv[2].sourceOffset = 2;
+            dv[2].targetOffset = 4;
+            dv[2].size = 2;
+
+            WriteUnitOfWork uow(opCtx.get());
+            auto newRecStatus =
+                rs->updateWithDamages(opCtx.get(), loc, rec, damageSource.c_str(), dv);
+            ASSERT_OK(newRecStatus.getStatus());
+            ASSERT_EQUALS(modifiedData, newRecStatus.getValue().data());
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            RecordData record = rs->dataFor(opCtx.get(), loc);
+            ASSERT_EQUALS(modifiedData, record.data());
+        }
+    }
+}
+
 // Insert a record and try to call updateWithDamages() with an empty DamageVector.
 TEST(RecordStoreTestHarness, UpdateWithNoDamages) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
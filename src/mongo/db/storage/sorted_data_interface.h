@@ -36,6 +36,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/key_string.h"
 
 #pragma once
 
@@ -103,6 +104,32 @@ public:
                           const RecordId& loc,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Returns the KeyString version in which insertKeyString() accepts keys for 'this' index, or
+     * boost::none if keys can only be inserted as BSON through insert().
+     */
+    virtual boost::optional<KeyString::Version> getKeyStringInsertVersion(
+        OperationContext* opCtx) const {
+        return boost::none;
+    }
+
+    /**
+     * Insert an entry into the index with the specified key and RecordId, where the key has
+     * already been encoded as 'keyString' with this index's Ordering and the version returned by
+     * getKeyStringInsertVersion(). 'keyString' must not have a RecordId appended. 'keySize' is the
+     * size of the key as a BSONObj, against which key length limits are checked.
+     *
+     * Behaves as insert() otherwise, and may only be called if getKeyStringInsertVersion()
+     * returns a version.
+     */
+    virtual Status insertKeyString(OperationContext* opCtx,
+                                   const KeyString& keyString,
+                                   int keySize,
+                                   const RecordId& loc,
+                                   bool dupsAllowed) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * Remove the entry from the index with the specified key and RecordId.
      *
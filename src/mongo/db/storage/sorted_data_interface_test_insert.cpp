@@ -367,5 +367,39 @@ TEST(SortedDataInterface, InsertMultipleCompoundKeys) {
     }
 }
 
+// Insert keys already encoded as KeyStrings into a non-unique index which supports doing so, and
+// verify that they are stored exactly as the same keys inserted as BSON would have been.
+TEST(SortedDataInterface, InsertKeyString) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(harnessHelper->newSortedDataInterface(false));
+
+    const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    const auto version = sorted->getKeyStringInsertVersion(opCtx.get());
+    if (!version) {
+        return;
+    }
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        const KeyString keyString(*version, key1, Ordering::make(BSONObj()));
+        ASSERT_OK(sorted->insertKeyString(opCtx.get(), keyString, key1.objsize(), loc1, true));
+        ASSERT_OK(sorted->insert(opCtx.get(), key2, loc2, true));
+        uow.commit();
+    }
+
+    {
+        // Inserting the same entry as BSON does not add another one.
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(sorted->insert(opCtx.get(), key1, loc1, true));
+        uow.commit();
+    }
+    ASSERT_EQUALS(2, sorted->numEntries(opCtx.get()));
+
+    const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+    ASSERT_EQ(cursor->seek(key1, true), IndexKeyEntry(key1, loc1));
+    ASSERT_EQ(cursor->next(), IndexKeyEntry(key2, loc2));
+    ASSERT_EQ(cursor->next(), boost::none);
+}
+
 }  // namespace
 }  // namespace mongo
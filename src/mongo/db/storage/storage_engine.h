@@ -32,12 +32,15 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "mongo/base/status.h"
+#include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/timestamp.h"
+#include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -190,6 +193,15 @@ public:
     virtual DatabaseCatalogEntry* getDatabaseCatalogEntry(OperationContext* opCtx,
                                                           StringData db) = 0;
 
+    /**
+     * Creates a table that is not part of the catalog for the caller's private use. Returns
+     * nullptr if this storage engine does not support temporary record stores.
+     */
+    virtual std::unique_ptr<TemporaryRecordStore> makeTemporaryRecordStore(
+        OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Returns whether the storage engine supports its own locking locking below the collection
      * level. If the engine returns true, MongoDB will acquire intent locks down to the
@@ -289,6 +301,29 @@ public:
         return;
     }
 
+    /**
+     * Pins the files of the last checkpoint so that they may be copied while writes continue, and
+     * returns their names relative to the dbpath, along with those of any other files the storage
+     * engine needs to open them.
+     *
+     * The storage engine must be able to recover from the copied files to the state of that
+     * checkpoint, plus whatever its journal files held when they were copied.
+     *
+     * Storage engines that do not support this feature should use the default implementation.
+     * Storage engines that implement this must also implement endNonBlockingBackup().
+     */
+    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "The current storage engine doesn't support non-blocking backups");
+    }
+
+    /**
+     * Releases the checkpoint pinned by beginNonBlockingBackup().
+     */
+    virtual void endNonBlockingBackup(OperationContext* opCtx) {
+        return;
+    }
+
     /**
      * Recover as much data as possible from a potentially corrupt RecordStore.
      * This only recovers the record data, not indexes or anything else.
@@ -353,6 +388,14 @@ public:
         return false;
     }
 
+    /**
+     * Returns true if the storage engine can create collections with the 'clustered' option,
+     * whose records are keyed by _id.
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * Recovers the storage engine state to the last stable timestamp. "Stable" in this case
      * refers to a timestamp that is guaranteed to never be rolled back. The stable timestamp
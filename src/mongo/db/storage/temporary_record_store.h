@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/storage/record_store.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Owns a RecordStore holding data that only matters to the process which created it, such as the
+ * writes recorded during a hybrid index build. Temporary record stores are not part of the
+ * catalog and are never replicated.
+ *
+ * deleteTemporaryTable() must be called to drop the underlying table before this object is
+ * destroyed. A table left behind by a shutdown or crash is dropped on the next startup.
+ */
+class TemporaryRecordStore {
+    MONGO_DISALLOW_COPYING(TemporaryRecordStore);
+
+public:
+    explicit TemporaryRecordStore(std::unique_ptr<RecordStore> rs) : _rs(std::move(rs)) {}
+
+    virtual ~TemporaryRecordStore() = default;
+
+    /**
+     * Drops the underlying table. The RecordStore may not be used afterwards.
+     */
+    virtual void deleteTemporaryTable(OperationContext* opCtx) = 0;
+
+    RecordStore* rs() {
+        return _rs.get();
+    }
+
+    const RecordStore* rs() const {
+        return _rs.get();
+    }
+
+protected:
+    std::unique_ptr<RecordStore> _rs;
+};
+
+}  // namespace mongo
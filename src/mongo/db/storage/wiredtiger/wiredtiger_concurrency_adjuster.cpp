@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_adjuster.h"
+
+#include <algorithm>
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrency, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrencyMinTickets, int, 16)
+    ->withValidator([](const int& potentialNewValue) {
+        // TicketHolder::resize() rejects pools smaller than 5.
+        if (potentialNewValue < 5) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerAdaptiveConcurrencyMinTickets must be at least 5");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrencyMaxTickets, int, 512)
+    ->withValidator([](const int& potentialNewValue) {
+        if (potentialNewValue < 5) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerAdaptiveConcurrencyMaxTickets must be at least 5");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+// A pool is grown by this many tickets per interval while it is saturated and the cache is healthy.
+const int kAdditiveIncrease = 8;
+
+// A pool is shrunk to this fraction of its size per interval while the cache is under pressure.
+const double kMultiplicativeDecrease = 0.75;
+
+// The cache is considered under pressure when application threads spend at least this fraction of
+// the sampling interval, summed over all threads, waiting for space in the cache.
+const double kAppThreadWaitThreshold = 0.01;
+
+// These sit just below the WiredTiger defaults for eviction_trigger (95%) and
+// eviction_dirty_trigger (20%), above which application threads are pulled into eviction.
+const double kInUseThreshold = 0.93;
+const double kDirtyThreshold = 0.18;
+
+const char* actionName(WiredTigerConcurrencyAdjuster::Action action) {
+    switch (action) {
+        case WiredTigerConcurrencyAdjuster::Action::kNone:
+            return "none";
+        case WiredTigerConcurrencyAdjuster::Action::kIncrease:
+            return "increase";
+        case WiredTigerConcurrencyAdjuster::Action::kDecrease:
+            return "decrease";
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace
+
+WiredTigerConcurrencyAdjuster::WiredTigerConcurrencyAdjuster(TicketHolder* readTickets,
+                                                             TicketHolder* writeTickets)
+    : _readTickets(readTickets), _writeTickets(writeTickets) {}
+
+WiredTigerConcurrencyAdjuster::Pressure WiredTigerConcurrencyAdjuster::_evaluatePressure(
+    const CacheSample& sample, std::uint64_t waitMicros, Milliseconds interval) const {
+    Pressure pressure;
+    if (sample.bytesMax > 0) {
+        const double max = static_cast<double>(sample.bytesMax);
+        pressure.cache = sample.bytesInUse >= kInUseThreshold * max;
+        pressure.dirty = sample.bytesDirty >= kDirtyThreshold * max;
+    }
+
+    const bool appThreadsEvicting =
+        sample.appThreadPagesEvicted != _lastSample.appThreadPagesEvicted;
+    const auto intervalMicros = durationCount<Microseconds>(interval);
+    if (appThreadsEvicting && waitMicros >= kAppThreadWaitThreshold * intervalMicros) {
+        pressure.cache = true;
+    }
+    return pressure;
+}
+
+bool WiredTigerConcurrencyAdjuster::_resize(TicketHolder* holder, int newSize) {
+    const int minTickets = wiredTigerAdaptiveConcurrencyMinTickets.load();
+    const int maxTickets = std::max(minTickets, wiredTigerAdaptiveConcurrencyMaxTickets.load());
+    newSize = std::max(minTickets, std::min(maxTickets, newSize));
+
+    const int oldSize = holder->outof();
+    if (newSize == oldSize) {
+        return false;
+    }
+
+    Status status = holder->resizeWithoutWaiting(newSize);
+    if (!status.isOK()) {
+        warning() << "Failed to resize WiredTiger ticket pool from " << oldSize << " to "
+                  << newSize << ": " << status;
+        return false;
+    }
+    LOG(2) << "Resized WiredTiger ticket pool from " << oldSize << " to " << newSize;
+    return true;
+}
+
+WiredTigerConcurrencyAdjuster::Action WiredTigerConcurrencyAdjuster::adjust(
+    const CacheSample& sample, Milliseconds interval) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_hasBaseline) {
+        _hasBaseline = true;
+        _lastSample = sample;
+        return Action::kNone;
+    }
+
+    if (_originalReadSize == 0 && _originalWriteSize == 0) {
+        _originalReadSize = _readTickets->outof();
+        _originalWriteSize = _writeTickets->outof();
+    }
+
+    // The counters are cumulative, but restart from zero if the statistics are reset.
+    const std::uint64_t waitMicros =
+        sample.appThreadCacheWaitMicros >= _lastSample.appThreadCacheWaitMicros
+        ? sample.appThreadCacheWaitMicros - _lastSample.appThreadCacheWaitMicros
+        : sample.appThreadCacheWaitMicros;
+    const Pressure pressure = _evaluatePressure(sample, waitMicros, interval);
+    _lastSample = sample;
+
+    bool decreased = false;
+    bool increased = false;
+    auto adjustPool = [&](TicketHolder* holder, bool underPressure) {
+        const int size = holder->outof();
+        if (underPressure) {
+            decreased |= _resize(holder, static_cast<int>(size * kMultiplicativeDecrease));
+        } else if (holder->available() == 0) {
+            increased |= _resize(holder, size + kAdditiveIncrease);
+        }
+    };
+
+    // Dirty content is produced by writers, so only the write pool backs off when that is the
+    // sole source of pressure. Eviction waits and a full cache slow readers down as well.
+    adjustPool(_readTickets, pressure.cache);
+    adjustPool(_writeTickets, pressure.cache || pressure.dirty);
+
+    const Action action =
+        decreased ? Action::kDecrease : (increased ? Action::kIncrease : Action::kNone);
+
+    stdx::lock_guard<stdx::mutex> statsLk(_statsMutex);
+    if (action == Action::kIncrease) {
+        ++_numIncreases;
+    } else if (action == Action::kDecrease) {
+        ++_numDecreases;
+    }
+    _lastAction = action;
+    if (sample.bytesMax > 0) {
+        _lastInUsePercent = 100.0 * sample.bytesInUse / sample.bytesMax;
+        _lastDirtyPercent = 100.0 * sample.bytesDirty / sample.bytesMax;
+    }
+    _lastAppThreadCacheWaitMicros = waitMicros;
+    return action;
+}
+
+void WiredTigerConcurrencyAdjuster::reset() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _hasBaseline = false;
+    if (_originalReadSize == 0 && _originalWriteSize == 0) {
+        return;
+    }
+
+    // Restore the original sizes directly, as they may lie outside the adaptive bounds.
+    if (_originalReadSize != 0) {
+        uassertStatusOK(_readTickets->resizeWithoutWaiting(_originalReadSize));
+    }
+    if (_originalWriteSize != 0) {
+        uassertStatusOK(_writeTickets->resizeWithoutWaiting(_originalWriteSize));
+    }
+    _originalReadSize = 0;
+    _originalWriteSize = 0;
+
+    stdx::lock_guard<stdx::mutex> statsLk(_statsMutex);
+    _lastAction = Action::kNone;
+}
+
+Status WiredTigerConcurrencyAdjuster::setExplicitSize(TicketHolder* holder, int newSize) {
+    invariant(holder == _readTickets || holder == _writeTickets);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Status status = holder->resizeWithoutWaiting(newSize);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (wiredTigerAdaptiveConcurrency.load()) {
+        log() << "Switching off adaptive concurrency, as a WiredTiger ticket pool was sized "
+                 "explicitly";
+        wiredTigerAdaptiveConcurrency.store(false);
+    }
+
+    // An adjustment already under way on another thread sees a new baseline rather than resizing
+    // the pools again, and the size given here is not overwritten by the next reset().
+    _hasBaseline = false;
+    if (holder == _readTickets) {
+        _originalReadSize = 0;
+    } else {
+        _originalWriteSize = 0;
+    }
+    return Status::OK();
+}
+
+void WiredTigerConcurrencyAdjuster::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_statsMutex);
+    builder->append("mode", wiredTigerAdaptiveConcurrency.load() ? "adaptive" : "fixed");
+    builder->append("increases", static_cast<long long>(_numIncreases));
+    builder->append("decreases", static_cast<long long>(_numDecreases));
+    builder->append("lastAction", actionName(_lastAction));
+    builder->append("cacheInUsePercent", _lastInUsePercent);
+    builder->append("cacheDirtyPercent", _lastDirtyPercent);
+    builder->append("appThreadCacheWaitMicros",
+                    static_cast<long long>(_lastAppThreadCacheWaitMicros));
+}
+
+}  // namespace mongo
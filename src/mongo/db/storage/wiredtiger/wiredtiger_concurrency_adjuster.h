@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Whether the WiredTiger read and write ticket pools are resized at runtime. When false, the pools
+ * keep the sizes given by wiredTigerConcurrentReadTransactions and
+ * wiredTigerConcurrentWriteTransactions.
+ */
+extern AtomicBool wiredTigerAdaptiveConcurrency;
+
+/**
+ * Adjusts the size of the read and write ticket pools using additive-increase/multiplicative-
+ * decrease (AIMD), driven by periodic samples of the WiredTiger cache statistics.
+ *
+ * When application threads are being made to wait on cache eviction, or the cache is close to its
+ * dirty or total eviction triggers, the pools are shrunk multiplicatively so that fewer concurrent
+ * transactions compete for the cache. Otherwise, a pool that was fully in use at sample time is
+ * grown by a fixed step so that idle capacity is not left unused. Pool sizes stay within
+ * [wiredTigerAdaptiveConcurrencyMinTickets, wiredTigerAdaptiveConcurrencyMaxTickets].
+ *
+ * Shrinking a pool never waits for tickets in use; those are retired as they are released.
+ *
+ * Thread safe.
+ */
+class WiredTigerConcurrencyAdjuster {
+    MONGO_DISALLOW_COPYING(WiredTigerConcurrencyAdjuster);
+
+public:
+    /**
+     * A snapshot of the WiredTiger connection statistics which drive adjustment. The eviction and
+     * wait counters are cumulative; the adjuster works from the difference between samples.
+     */
+    struct CacheSample {
+        std::uint64_t bytesMax = 0;
+        std::uint64_t bytesInUse = 0;
+        std::uint64_t bytesDirty = 0;
+        std::uint64_t appThreadPagesEvicted = 0;
+        std::uint64_t appThreadCacheWaitMicros = 0;
+    };
+
+    enum class Action { kNone, kIncrease, kDecrease };
+
+    WiredTigerConcurrencyAdjuster(TicketHolder* readTickets, TicketHolder* writeTickets);
+
+    /**
+     * Feeds one sample, taken 'interval' after the previous one, and resizes the ticket pools.
+     * The first sample after construction, reset() or setExplicitSize() only establishes the
+     * baseline.
+     */
+    Action adjust(const CacheSample& sample, Milliseconds interval);
+
+    /**
+     * Restores the pool sizes that were in effect before the first adjustment, and forgets the
+     * previous sample. Called when adaptive concurrency is switched off.
+     */
+    void reset();
+
+    /**
+     * Resizes 'holder', one of the two pools, to a size set by the user at runtime. The user's
+     * choice takes over from adaptive concurrency, which is switched off, and is kept by the
+     * following reset().
+     */
+    Status setExplicitSize(TicketHolder* holder, int newSize);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct Pressure {
+        bool cache = false;  // Application threads are waiting on eviction, or the cache is full.
+        bool dirty = false;  // The dirty content of the cache is near the dirty trigger.
+    };
+
+    /**
+     * Compares 'sample' against the previous sample. 'waitMicros' is the time application threads
+     * spent waiting on the cache since the previous sample.
+     */
+    Pressure _evaluatePressure(const CacheSample& sample,
+                               std::uint64_t waitMicros,
+                               Milliseconds interval) const;
+
+    /**
+     * Resizes 'holder' to 'newSize' clamped to the configured bounds. Returns whether the size
+     * changed.
+     */
+    bool _resize(TicketHolder* holder, int newSize);
+
+    TicketHolder* const _readTickets;
+    TicketHolder* const _writeTickets;
+
+    // Serializes adjust(), reset() and setExplicitSize(), and protects the fields below.
+    stdx::mutex _mutex;
+
+    bool _hasBaseline = false;
+    CacheSample _lastSample;
+
+    // The pool sizes to restore on reset(). Zero while no adjustment has been made, or once the
+    // pool has been sized explicitly.
+    int _originalReadSize = 0;
+    int _originalWriteSize = 0;
+
+    // Protects the fields below, which are reported by appendStats().
+    mutable stdx::mutex _statsMutex;
+    std::uint64_t _numIncreases = 0;
+    std::uint64_t _numDecreases = 0;
+    Action _lastAction = Action::kNone;
+    double _lastDirtyPercent = 0;
+    double _lastInUsePercent = 0;
+    std::uint64_t _lastAppThreadCacheWaitMicros = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_adjuster.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+using Action = WiredTigerConcurrencyAdjuster::Action;
+using CacheSample = WiredTigerConcurrencyAdjuster::CacheSample;
+
+const Milliseconds kInterval(1000);
+const std::uint64_t kCacheSize = 1000 * 1000;
+
+CacheSample healthySample() {
+    CacheSample sample;
+    sample.bytesMax = kCacheSize;
+    sample.bytesInUse = kCacheSize / 2;
+    sample.bytesDirty = kCacheSize / 20;
+    return sample;
+}
+
+/**
+ * Takes every available ticket from 'holder', and gives them back on destruction.
+ */
+class SaturatedPool {
+public:
+    explicit SaturatedPool(TicketHolder* holder) : _holder(holder) {
+        while (_holder->tryAcquire()) {
+            ++_numHeld;
+        }
+    }
+
+    ~SaturatedPool() {
+        while (_numHeld-- > 0) {
+            _holder->release();
+        }
+    }
+
+private:
+    TicketHolder* _holder;
+    int _numHeld = 0;
+};
+
+TEST(WiredTigerConcurrencyAdjusterTest, FirstSampleOnlyEstablishesBaseline) {
+    TicketHolder readTickets(64);
+    TicketHolder writeTickets(64);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+
+    CacheSample sample = healthySample();
+    sample.bytesDirty = kCacheSize / 2;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kNone);
+    ASSERT_EQ(64, readTickets.outof());
+    ASSERT_EQ(64, writeTickets.outof());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, SaturatedPoolsGrowAdditivelyWhenCacheIsHealthy) {
+    TicketHolder readTickets(64);
+    TicketHolder writeTickets(64);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    adjuster.adjust(healthySample(), kInterval);
+
+    // Pools with idle tickets are left alone.
+    ASSERT(adjuster.adjust(healthySample(), kInterval) == Action::kNone);
+    ASSERT_EQ(64, readTickets.outof());
+
+    {
+        SaturatedPool saturatedReads(&readTickets);
+        ASSERT(adjuster.adjust(healthySample(), kInterval) == Action::kIncrease);
+    }
+    ASSERT_EQ(72, readTickets.outof());
+    ASSERT_EQ(72, readTickets.available());
+    ASSERT_EQ(64, writeTickets.outof());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, DirtyCacheShrinksOnlyWritePool) {
+    TicketHolder readTickets(64);
+    TicketHolder writeTickets(64);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    adjuster.adjust(healthySample(), kInterval);
+
+    CacheSample sample = healthySample();
+    sample.bytesDirty = kCacheSize / 4;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+    ASSERT_EQ(64, readTickets.outof());
+    ASSERT_EQ(48, writeTickets.outof());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, AppThreadEvictionShrinksBothPoolsDownToMinimum) {
+    TicketHolder readTickets(24);
+    TicketHolder writeTickets(24);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    CacheSample sample = healthySample();
+    adjuster.adjust(sample, kInterval);
+
+    // Application threads waited for 50ms in total during the interval.
+    sample.appThreadPagesEvicted += 100;
+    sample.appThreadCacheWaitMicros += 50 * 1000;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+    ASSERT_EQ(18, readTickets.outof());
+    ASSERT_EQ(18, writeTickets.outof());
+
+    sample.appThreadPagesEvicted += 100;
+    sample.appThreadCacheWaitMicros += 50 * 1000;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+    ASSERT_EQ(16, readTickets.outof());
+    ASSERT_EQ(16, writeTickets.outof());
+
+    // Already at the minimum.
+    sample.appThreadPagesEvicted += 100;
+    sample.appThreadCacheWaitMicros += 50 * 1000;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kNone);
+    ASSERT_EQ(16, readTickets.outof());
+
+    // A negligible amount of waiting is not treated as pressure.
+    sample.appThreadPagesEvicted += 1;
+    sample.appThreadCacheWaitMicros += 10;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kNone);
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, ResetRestoresOriginalPoolSizes) {
+    TicketHolder readTickets(128);
+    TicketHolder writeTickets(128);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    CacheSample sample = healthySample();
+    adjuster.adjust(sample, kInterval);
+
+    sample.bytesInUse = kCacheSize;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+    ASSERT_EQ(96, readTickets.outof());
+    ASSERT_EQ(96, writeTickets.outof());
+
+    adjuster.reset();
+    ASSERT_EQ(128, readTickets.outof());
+    ASSERT_EQ(128, writeTickets.outof());
+
+    // After a reset, the next sample is a new baseline.
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kNone);
+    ASSERT_EQ(128, readTickets.outof());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, ShrinkingDoesNotWaitForTicketsInUse) {
+    TicketHolder readTickets(64);
+    TicketHolder writeTickets(64);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    CacheSample sample = healthySample();
+    adjuster.adjust(sample, kInterval);
+
+    SaturatedPool saturatedWrites(&writeTickets);
+    sample.bytesDirty = kCacheSize / 4;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+    ASSERT_EQ(48, writeTickets.outof());
+    ASSERT_EQ(0, writeTickets.available());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, ExplicitSizeSwitchesOffAdaptiveConcurrency) {
+    TicketHolder readTickets(128);
+    TicketHolder writeTickets(128);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    wiredTigerAdaptiveConcurrency.store(true);
+    ON_BLOCK_EXIT([] { wiredTigerAdaptiveConcurrency.store(false); });
+
+    CacheSample sample = healthySample();
+    adjuster.adjust(sample, kInterval);
+    sample.bytesInUse = kCacheSize;
+    ASSERT(adjuster.adjust(sample, kInterval) == Action::kDecrease);
+
+    ASSERT_OK(adjuster.setExplicitSize(&readTickets, 40));
+    ASSERT_FALSE(wiredTigerAdaptiveConcurrency.load());
+    ASSERT_EQ(40, readTickets.outof());
+
+    // The pool sized by the user keeps its size, while the other one is restored.
+    adjuster.reset();
+    ASSERT_EQ(40, readTickets.outof());
+    ASSERT_EQ(128, writeTickets.outof());
+}
+
+TEST(WiredTigerConcurrencyAdjusterTest, StatsReportDecisions) {
+    TicketHolder readTickets(64);
+    TicketHolder writeTickets(64);
+    WiredTigerConcurrencyAdjuster adjuster(&readTickets, &writeTickets);
+    CacheSample sample = healthySample();
+    adjuster.adjust(sample, kInterval);
+    sample.bytesDirty = kCacheSize / 4;
+    adjuster.adjust(sample, kInterval);
+
+    BSONObjBuilder builder;
+    adjuster.appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQ("fixed", stats["mode"].str());
+    ASSERT_EQ(1, stats["decreases"].numberLong());
+    ASSERT_EQ(0, stats["increases"].numberLong());
+    ASSERT_EQ("decrease", stats["lastAction"].str());
+    ASSERT_EQ(25.0, stats["cacheDirtyPercent"].numberDouble());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,594 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <zlib.h>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/storage_file_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/compiler.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+// Every compressed block starts with a format byte and the little endian version of the
+// dictionary it was compressed with.
+const uint8_t kBlockFormatVersion = 1;
+const size_t kBlockHeaderSize = 1 + sizeof(uint32_t);
+
+// Longer string values are unlikely to repeat across documents.
+const int kMaxTrainedValueSize = 64;
+
+stdx::mutex openingMutex;
+WiredTigerDictionaryCompressors* openingCompressors = nullptr;
+
+void countFragments(const BSONObj& obj, StringMap<std::size_t>* counts) {
+    for (auto&& elem : obj) {
+        // The type byte, field name and its terminating NUL are repeated by every document.
+        ++(*counts)[StringData(elem.rawdata(), 1 + elem.fieldNameSize())];
+
+        if (elem.type() == BSONType::String && elem.valuestrsize() <= kMaxTrainedValueSize) {
+            ++(*counts)[StringData(elem.rawdata(), elem.size())];
+        } else if (elem.isABSONObj()) {
+            countFragments(elem.embeddedObject(), counts);
+        }
+    }
+}
+
+}  // namespace
+
+const StringData WiredTigerDictionaryCompressors::kBlockCompressorName = "dictionary"_sd;
+const StringData WiredTigerDictionaryCompressors::kFileName = "WiredTigerDictionaries.bson"_sd;
+
+WiredTigerDictionaryCompressors::WiredTigerDictionaryCompressors(std::string dbPath)
+    : _dbPath(std::move(dbPath)) {}
+
+WiredTigerDictionaryCompressors::~WiredTigerDictionaryCompressors() {
+    stdx::lock_guard<stdx::mutex> lk(openingMutex);
+    if (openingCompressors == this) {
+        openingCompressors = nullptr;
+    }
+}
+
+Status WiredTigerDictionaryCompressors::load() {
+    const boost::filesystem::path path = boost::filesystem::path(_dbPath) / kFileName.toString();
+    if (!boost::filesystem::exists(path)) {
+        return Status::OK();
+    }
+
+    std::vector<char> buffer(boost::filesystem::file_size(path));
+    {
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        ifs.read(buffer.data(), buffer.size());
+        if (!ifs) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to read " << path.string() << ": "
+                                  << errnoWithDescription()};
+        }
+    }
+
+    Status status = validateBSON(buffer.data(), buffer.size(), BSONVersion::kLatest);
+    if (!status.isOK()) {
+        return status.withContext(str::stream() << "Invalid BSON in " << path.string());
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(_compressors.empty());
+
+    const BSONObj obj(buffer.data());
+    _nextId = static_cast<std::uint32_t>(obj["nextId"].safeNumberLong());
+    for (auto&& compressorElem : obj["compressors"].Obj()) {
+        const BSONObj compressorObj = compressorElem.Obj();
+        const std::string name = compressorObj["name"].str();
+        if (!isDictionaryCompressor(name)) {
+            return {ErrorCodes::FailedToParse,
+                    str::stream() << "Unexpected compressor name '" << name << "' in "
+                                  << path.string()};
+        }
+
+        auto dictionaries = std::make_shared<Dictionaries>();
+        for (auto&& dictionaryElem : compressorObj["dictionaries"].Obj()) {
+            int length;
+            const char* data = dictionaryElem.binData(length);
+            dictionaries->push_back(std::make_shared<const std::string>(data, length));
+        }
+        Compressor* compressor = _addCompressor(lk, name);
+        std::atomic_store(&compressor->dictionaries,
+                          std::shared_ptr<const Dictionaries>(std::move(dictionaries)));
+    }
+
+    log() << "Loaded " << _compressors.size() << " dictionary block compressors";
+    return Status::OK();
+}
+
+std::string WiredTigerDictionaryCompressors::prepareOpenExtensionConfig() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(openingMutex);
+        openingCompressors = this;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_compressors.empty()) {
+        return "";
+    }
+    return "local=(entry=mongo_addWiredTigerDictionaryCompressors)";
+}
+
+int WiredTigerDictionaryCompressors::registerForOpen(WT_CONNECTION* conn) {
+    stdx::lock_guard<stdx::mutex> lk(openingMutex);
+    if (!openingCompressors) {
+        return 0;
+    }
+
+    Status status = openingCompressors->registerCompressors(conn);
+    if (!status.isOK()) {
+        error() << "Failed to register the dictionary block compressors: " << status;
+        return EINVAL;
+    }
+    return 0;
+}
+
+Status WiredTigerDictionaryCompressors::registerCompressors(WT_CONNECTION* conn) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (conn != _conn) {
+        _conn = conn;
+        for (auto&& compressor : _compressors) {
+            compressor->registered = false;
+        }
+    }
+
+    for (auto&& compressor : _compressors) {
+        if (!compressor->registered) {
+            Status status = _registerCompressor(lk, compressor.get());
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+StatusWith<std::string> WiredTigerDictionaryCompressors::createCompressor() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Compressor* compressor =
+        _addCompressor(lk, str::stream() << kBlockCompressorName << "_" << _nextId++);
+
+    // The compressor must be durable before any table refers to it.
+    Status status = _persist(lk);
+    if (!status.isOK()) {
+        _compressors.pop_back();
+        return status;
+    }
+
+    if (_conn) {
+        status = _registerCompressor(lk, compressor);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    LOG(1) << "Created dictionary block compressor " << compressor->name;
+    return compressor->name;
+}
+
+StatusWith<int> WiredTigerDictionaryCompressors::addDictionary(StringData compressorName,
+                                                               std::string dictionary) {
+    if (dictionary.empty() || dictionary.size() > kMaxDictionarySize) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Compression dictionaries must be between 1 and "
+                              << kMaxDictionarySize
+                              << " bytes long"};
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Compressor* compressor = _findCompressor(lk, compressorName);
+    if (!compressor) {
+        return {ErrorCodes::NoSuchKey,
+                str::stream() << "No dictionary block compressor named " << compressorName};
+    }
+
+    const auto oldDictionaries = std::atomic_load(&compressor->dictionaries);
+    auto newDictionaries = std::make_shared<Dictionaries>(*oldDictionaries);
+    newDictionaries->push_back(std::make_shared<const std::string>(std::move(dictionary)));
+    const int version = newDictionaries->size();
+
+    // The new dictionary must be durable before any block is compressed with it.
+    Status status = _persist(lk, compressor, newDictionaries.get());
+    if (!status.isOK()) {
+        return status;
+    }
+    std::atomic_store(&compressor->dictionaries,
+                      std::shared_ptr<const Dictionaries>(std::move(newDictionaries)));
+
+    log() << "Added version " << version << " of the compression dictionary of "
+          << compressorName;
+    return version;
+}
+
+void WiredTigerDictionaryCompressors::markDropped(StringData compressorName) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Compressor* compressor = _findCompressor(lk, compressorName);
+    if (compressor) {
+        compressor->dropped = true;
+    }
+}
+
+std::vector<std::string> WiredTigerDictionaryCompressors::getDroppedCompressors() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    std::vector<std::string> names;
+    for (auto&& compressor : _compressors) {
+        if (compressor->dropped) {
+            names.push_back(compressor->name);
+        }
+    }
+    return names;
+}
+
+Status WiredTigerDictionaryCompressors::removeCompressors(
+    const std::vector<std::string>& compressorNames) {
+    if (compressorNames.empty()) {
+        return Status::OK();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const auto firstRemoved =
+        std::stable_partition(_compressors.begin(), _compressors.end(), [&](const auto& c) {
+            return std::find(compressorNames.begin(), compressorNames.end(), c->name) ==
+                compressorNames.end();
+        });
+    const auto numRemoved = std::distance(firstRemoved, _compressors.end());
+    if (numRemoved == 0) {
+        return Status::OK();
+    }
+
+    std::move(firstRemoved, _compressors.end(), std::back_inserter(_removedCompressors));
+    _compressors.erase(firstRemoved, _compressors.end());
+    Status status = _persist(lk);
+    if (!status.isOK()) {
+        const auto firstRestored = _removedCompressors.end() - numRemoved;
+        std::move(firstRestored, _removedCompressors.end(), std::back_inserter(_compressors));
+        _removedCompressors.erase(firstRestored, _removedCompressors.end());
+        return status;
+    }
+
+    log() << "Removed " << numRemoved << " dictionary block compressors of dropped collections";
+    return Status::OK();
+}
+
+Status WiredTigerDictionaryCompressors::removeUnusedCompressors(WT_SESSION* session) {
+    std::set<std::string> usedNames;
+    {
+        WT_CURSOR* cursor;
+        Status status =
+            wtRCToStatus(session->open_cursor(session, "metadata:", nullptr, nullptr, &cursor));
+        if (!status.isOK()) {
+            return status;
+        }
+        ON_BLOCK_EXIT([cursor] { invariantWTOK(cursor->close(cursor)); });
+
+        int ret;
+        while ((ret = cursor->next(cursor)) == 0) {
+            const char* config;
+            status = wtRCToStatus(cursor->get_value(cursor, &config));
+            if (!status.isOK()) {
+                return status;
+            }
+            usedNames.insert(getBlockCompressor(config));
+        }
+        if (ret != WT_NOTFOUND) {
+            return wtRCToStatus(ret);
+        }
+    }
+
+    std::vector<std::string> unusedNames;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (auto&& compressor : _compressors) {
+            if (!usedNames.count(compressor->name)) {
+                unusedNames.push_back(compressor->name);
+            }
+        }
+    }
+    return removeCompressors(unusedNames);
+}
+
+bool WiredTigerDictionaryCompressors::isDictionaryCompressor(StringData compressorName) {
+    return compressorName.size() > kBlockCompressorName.size() + 1 &&
+        compressorName.startsWith(kBlockCompressorName) &&
+        compressorName[kBlockCompressorName.size()] == '_';
+}
+
+std::string WiredTigerDictionaryCompressors::getBlockCompressor(StringData config) {
+    WiredTigerConfigParser parser(config);
+    WT_CONFIG_ITEM value;
+    if (parser.get("block_compressor", &value) != 0) {
+        return "";
+    }
+    return std::string(value.str, value.len);
+}
+
+std::string WiredTigerDictionaryCompressors::trainDictionary(const std::vector<BSONObj>& samples,
+                                                             std::size_t maxSize) {
+    StringMap<std::size_t> counts;
+    for (auto&& sample : samples) {
+        countFragments(sample, &counts);
+    }
+
+    // Only fragments which repeat are worth having in the dictionary. They are scored by how many
+    // bytes they could save.
+    std::vector<std::pair<std::size_t, StringData>> candidates;
+    for (auto&& entry : counts) {
+        if (entry.second > 1) {
+            candidates.emplace_back(entry.second * entry.first.size(), entry.first);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+
+    std::vector<StringData> chosen;
+    std::size_t size = 0;
+    for (auto&& candidate : candidates) {
+        if (size + candidate.second.size() <= maxSize) {
+            chosen.push_back(candidate.second);
+            size += candidate.second.size();
+        }
+    }
+
+    std::string dictionary;
+    dictionary.reserve(size);
+    for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) {
+        dictionary.append(it->rawData(), it->size());
+    }
+    return dictionary;
+}
+
+WT_COMPRESSOR* WiredTigerDictionaryCompressors::getCompressor_forTest(StringData compressorName) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    Compressor* compressor = _findCompressor(lk, compressorName);
+    return compressor ? &compressor->wtCompressor : nullptr;
+}
+
+int WiredTigerDictionaryCompressors::_compress(WT_COMPRESSOR* wtCompressor,
+                                               WT_SESSION* session,
+                                               uint8_t* src,
+                                               size_t srcLen,
+                                               uint8_t* dst,
+                                               size_t dstLen,
+                                               size_t* resultLen,
+                                               int* compressionFailed) {
+    auto compressor = reinterpret_cast<Compressor*>(wtCompressor);
+    if (dstLen <= kBlockHeaderSize) {
+        *compressionFailed = 1;
+        return 0;
+    }
+
+    const auto dictionaries = std::atomic_load(&compressor->dictionaries);
+    const std::uint32_t version = dictionaries->size();
+    const std::string* dictionary = version > 0 ? dictionaries->back().get() : nullptr;
+
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) !=
+        Z_OK) {
+        return WT_ERROR;
+    }
+    ON_BLOCK_EXIT([&] { deflateEnd(&zs); });
+
+    if (dictionary &&
+        deflateSetDictionary(&zs,
+                             reinterpret_cast<const Bytef*>(dictionary->data()),
+                             dictionary->size()) != Z_OK) {
+        return WT_ERROR;
+    }
+
+    zs.next_in = src;
+    zs.avail_in = static_cast<uInt>(srcLen);
+    zs.next_out = dst + kBlockHeaderSize;
+    zs.avail_out = static_cast<uInt>(dstLen - kBlockHeaderSize);
+    const int ret = deflate(&zs, Z_FINISH);
+    if (ret == Z_OK || ret == Z_BUF_ERROR) {
+        // The compressed block does not fit in the destination, so WiredTiger stores it as is.
+        *compressionFailed = 1;
+        return 0;
+    } else if (ret != Z_STREAM_END) {
+        return WT_ERROR;
+    }
+
+    dst[0] = kBlockFormatVersion;
+    DataView(reinterpret_cast<char*>(dst) + 1).write<LittleEndian<std::uint32_t>>(version);
+    *resultLen = kBlockHeaderSize + zs.total_out;
+    *compressionFailed = 0;
+    return 0;
+}
+
+int WiredTigerDictionaryCompressors::_decompress(WT_COMPRESSOR* wtCompressor,
+                                                 WT_SESSION* session,
+                                                 uint8_t* src,
+                                                 size_t srcLen,
+                                                 uint8_t* dst,
+                                                 size_t dstLen,
+                                                 size_t* resultLen) {
+    auto compressor = reinterpret_cast<Compressor*>(wtCompressor);
+    if (srcLen < kBlockHeaderSize || src[0] != kBlockFormatVersion) {
+        error() << "Block compressed by " << compressor->name << " has an unknown format";
+        return WT_ERROR;
+    }
+
+    const std::uint32_t version =
+        ConstDataView(reinterpret_cast<const char*>(src) + 1).read<LittleEndian<std::uint32_t>>();
+    const auto dictionaries = std::atomic_load(&compressor->dictionaries);
+    if (version > dictionaries->size()) {
+        error() << "Block compressed by " << compressor->name << " uses dictionary version "
+                << version << ", which is not known";
+        return WT_ERROR;
+    }
+    const std::string* dictionary = version > 0 ? (*dictionaries)[version - 1].get() : nullptr;
+
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.next_in = src + kBlockHeaderSize;
+    zs.avail_in = static_cast<uInt>(srcLen - kBlockHeaderSize);
+    if (inflateInit2(&zs, -MAX_WBITS) != Z_OK) {
+        return WT_ERROR;
+    }
+    ON_BLOCK_EXIT([&] { inflateEnd(&zs); });
+
+    if (dictionary &&
+        inflateSetDictionary(&zs,
+                             reinterpret_cast<const Bytef*>(dictionary->data()),
+                             dictionary->size()) != Z_OK) {
+        return WT_ERROR;
+    }
+
+    zs.next_out = dst;
+    zs.avail_out = static_cast<uInt>(dstLen);
+    // The source may be followed by padding, so the stream does not have to consume all of it.
+    if (inflate(&zs, Z_FINISH) != Z_STREAM_END) {
+        return WT_ERROR;
+    }
+
+    *resultLen = zs.total_out;
+    return 0;
+}
+
+WiredTigerDictionaryCompressors::Compressor* WiredTigerDictionaryCompressors::_addCompressor(
+    WithLock, std::string name) {
+    auto compressor = stdx::make_unique<Compressor>();
+    memset(&compressor->wtCompressor, 0, sizeof(compressor->wtCompressor));
+    compressor->wtCompressor.compress = &WiredTigerDictionaryCompressors::_compress;
+    compressor->wtCompressor.decompress = &WiredTigerDictionaryCompressors::_decompress;
+    compressor->name = std::move(name);
+    std::atomic_store(&compressor->dictionaries, std::make_shared<const Dictionaries>());
+
+    _compressors.push_back(std::move(compressor));
+    return _compressors.back().get();
+}
+
+WiredTigerDictionaryCompressors::Compressor* WiredTigerDictionaryCompressors::_findCompressor(
+    WithLock, StringData name) {
+    for (auto&& compressor : _compressors) {
+        if (compressor->name == name) {
+            return compressor.get();
+        }
+    }
+    return nullptr;
+}
+
+Status WiredTigerDictionaryCompressors::_registerCompressor(WithLock, Compressor* compressor) {
+    invariant(_conn);
+    Status status = wtRCToStatus(_conn->add_compressor(
+        _conn, compressor->name.c_str(), &compressor->wtCompressor, nullptr));
+    if (status.isOK()) {
+        compressor->registered = true;
+    }
+    return status;
+}
+
+Status WiredTigerDictionaryCompressors::_persist(WithLock,
+                                                 const Compressor* changedCompressor,
+                                                 const Dictionaries* changedDictionaries) {
+    BSONObjBuilder builder;
+    builder.append("nextId", static_cast<long long>(_nextId));
+    {
+        BSONArrayBuilder compressorsBuilder(builder.subarrayStart("compressors"));
+        for (auto&& compressor : _compressors) {
+            BSONObjBuilder compressorBuilder(compressorsBuilder.subobjStart());
+            compressorBuilder.append("name", compressor->name);
+            const auto dictionaries = compressor.get() == changedCompressor
+                ? *changedDictionaries
+                : *std::atomic_load(&compressor->dictionaries);
+            BSONArrayBuilder dictionariesBuilder(compressorBuilder.subarrayStart("dictionaries"));
+            for (auto&& dictionary : dictionaries) {
+                dictionariesBuilder.appendBinData(
+                    dictionary->size(), BinDataGeneral, dictionary->data());
+            }
+        }
+    }
+    const BSONObj obj = builder.obj();
+
+    const boost::filesystem::path path = boost::filesystem::path(_dbPath) / kFileName.toString();
+    const boost::filesystem::path tempPath =
+        boost::filesystem::path(_dbPath) / (kFileName.toString() + ".tmp");
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        ofs.write(obj.objdata(), obj.objsize());
+        if (!ofs) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to write " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+    }
+
+    Status status = fsyncFile(tempPath);
+    if (!status.isOK()) {
+        return status;
+    }
+    try {
+        boost::filesystem::rename(tempPath, path);
+    } catch (const std::exception& ex) {
+        return {ErrorCodes::FileRenameFailed,
+                str::stream() << "Failed to rename " << tempPath.string() << " to "
+                              << path.string()
+                              << ": "
+                              << ex.what()};
+    }
+    return fsyncParentDirectory(path);
+}
+
+}  // namespace mongo
+
+// Entry point of the WiredTiger extension loaded by wiredtiger_open, which looks it up in the
+// running executable.
+extern "C" MONGO_COMPILER_API_EXPORT int mongo_addWiredTigerDictionaryCompressors(
+    WT_CONNECTION* conn, WT_CONFIG_ARG* config) {
+    return mongo::WiredTigerDictionaryCompressors::registerForOpen(conn);
+}
@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <wiredtiger.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+/**
+ * WiredTiger block compressors which compress with zlib and a preset dictionary trained from a
+ * sample of a collection's documents. Collections of small documents with repetitive field names
+ * compress much better this way than with per-page compression alone.
+ *
+ * WiredTiger does not tell a compressor which table a block belongs to, so every collection
+ * created with 'block_compressor=dictionary' gets a compressor of its own, named
+ * "dictionary_<id>". Every compressed block records the version of the dictionary it was
+ * compressed with, so training a new dictionary only affects blocks written afterwards.
+ *
+ * Dictionaries are needed while WiredTiger runs recovery, before the catalog can be read. They are
+ * therefore kept in their own file in the dbpath, and the compressors are registered through a
+ * WiredTiger extension which wiredtiger_open loads before recovery.
+ */
+class WiredTigerDictionaryCompressors {
+    MONGO_DISALLOW_COPYING(WiredTigerDictionaryCompressors);
+
+public:
+    // The block_compressor value which gives a collection a dictionary compressor of its own.
+    static const StringData kBlockCompressorName;
+
+    // The name of the file in the dbpath which holds the dictionaries.
+    static const StringData kFileName;
+
+    // zlib only looks back this far, so larger dictionaries are of no use.
+    static const std::size_t kMaxDictionarySize = 32 * 1024;
+
+    explicit WiredTigerDictionaryCompressors(std::string dbPath);
+    ~WiredTigerDictionaryCompressors();
+
+    /**
+     * Reads the dictionaries file in the dbpath, if there is one.
+     */
+    Status load();
+
+    /**
+     * Returns the config to add to the 'extensions' list of wiredtiger_open so that it registers
+     * the compressors before running recovery, or an empty string if there are no compressors yet.
+     * Makes this the instance which the extension registers.
+     */
+    std::string prepareOpenExtensionConfig();
+
+    /**
+     * Registers any compressors which wiredtiger_open has not registered with 'conn', and
+     * remembers 'conn' so that compressors created later are registered with it as well.
+     */
+    Status registerCompressors(WT_CONNECTION* conn);
+
+    /**
+     * Creates a compressor for a new collection and returns the block_compressor value to create
+     * the collection's table with. Blocks are compressed without a dictionary until one has been
+     * added with addDictionary(). The compressor is registered with the connection passed to
+     * registerCompressors(), if there has been one.
+     */
+    StatusWith<std::string> createCompressor();
+
+    /**
+     * Adds 'dictionary' to the compressor called 'compressorName'. Blocks compressed from now on
+     * use it. Returns the version of the new dictionary.
+     */
+    StatusWith<int> addDictionary(StringData compressorName, std::string dictionary);
+
+    /**
+     * Notes that the table which used the compressor called 'compressorName' has been dropped.
+     * The compressor stays in the dictionaries file until it is passed to removeCompressors(),
+     * which must wait until the drop is durable: recovery could not read the table otherwise.
+     */
+    void markDropped(StringData compressorName);
+
+    /**
+     * Returns the names of the compressors passed to markDropped() which have not been removed.
+     */
+    std::vector<std::string> getDroppedCompressors();
+
+    /**
+     * Removes the compressors called 'compressorNames' from the dictionaries file. They are not
+     * registered with connections opened later.
+     */
+    Status removeCompressors(const std::vector<std::string>& compressorNames);
+
+    /**
+     * Removes the compressors which no table in the metadata of the connection of 'session' uses.
+     * These are left behind by drops which were not durable yet when the server stopped.
+     */
+    Status removeUnusedCompressors(WT_SESSION* session);
+
+    /**
+     * Returns whether 'compressorName' names one of these compressors.
+     */
+    static bool isDictionaryCompressor(StringData compressorName);
+
+    /**
+     * Returns the block_compressor which WiredTiger uses for a table created with 'config', or an
+     * empty string if the config does not set one.
+     */
+    static std::string getBlockCompressor(StringData config);
+
+    /**
+     * Builds a zlib preset dictionary of at most 'maxSize' bytes out of the field names and short
+     * string values which repeat across 'samples'. The most valuable strings are placed at the end,
+     * where zlib can refer to them most cheaply.
+     */
+    static std::string trainDictionary(const std::vector<BSONObj>& samples, std::size_t maxSize);
+
+    /**
+     * Entry point of the WiredTiger extension which registers the compressors.
+     */
+    static int registerForOpen(WT_CONNECTION* conn);
+
+    WT_COMPRESSOR* getCompressor_forTest(StringData compressorName);
+
+private:
+    using Dictionaries = std::vector<std::shared_ptr<const std::string>>;
+
+    struct Compressor {
+        // Must be the first member: WiredTiger passes a pointer to it to the callbacks.
+        WT_COMPRESSOR wtCompressor;
+        std::string name;
+        // Dictionary version 'v' is '(*dictionaries)[v - 1]'. Version 0 means no dictionary.
+        // Published dictionaries are never modified, so that the callbacks can use them without
+        // taking the mutex: adding a dictionary publishes a new vector. Only accessed through
+        // std::atomic_load() and std::atomic_store().
+        std::shared_ptr<const Dictionaries> dictionaries;
+        bool registered = false;
+        bool dropped = false;
+    };
+
+    static int _compress(WT_COMPRESSOR* compressor,
+                         WT_SESSION* session,
+                         uint8_t* src,
+                         size_t srcLen,
+                         uint8_t* dst,
+                         size_t dstLen,
+                         size_t* resultLen,
+                         int* compressionFailed);
+
+    static int _decompress(WT_COMPRESSOR* compressor,
+                           WT_SESSION* session,
+                           uint8_t* src,
+                           size_t srcLen,
+                           uint8_t* dst,
+                           size_t dstLen,
+                           size_t* resultLen);
+
+    Compressor* _addCompressor(WithLock, std::string name);
+
+    Compressor* _findCompressor(WithLock, StringData name);
+
+    Status _registerCompressor(WithLock, Compressor* compressor);
+
+    /**
+     * Atomically replaces the dictionaries file with the current set of dictionaries, except that
+     * 'changedDictionaries' is written for 'changedCompressor' if one is given.
+     */
+    Status _persist(WithLock,
+                    const Compressor* changedCompressor = nullptr,
+                    const Dictionaries* changedDictionaries = nullptr);
+
+    const std::string _dbPath;
+
+    // Guards all members below, and publishing the dictionaries of every compressor.
+    stdx::mutex _mutex;
+
+    // Compressors are never destroyed while this object lives, as WiredTiger holds pointers to
+    // them until the connection is closed. Removed compressors are kept in '_removedCompressors'.
+    std::vector<std::unique_ptr<Compressor>> _compressors;
+    std::vector<std::unique_ptr<Compressor>> _removedCompressors;
+    std::uint32_t _nextId = 1;
+    WT_CONNECTION* _conn = nullptr;
+};
+
+}  // namespace mongo
@@ -0,0 +1,292 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
+
+#include <boost/filesystem.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONObj> makeEvents(int count) {
+    std::vector<BSONObj> events;
+    for (int i = 0; i < count; ++i) {
+        events.push_back(BSON("eventType" << (i % 2 ? "click" : "view") << "userAgent"
+                                          << "Mozilla/5.0"
+                                          << "sequence"
+                                          << i
+                                          << "payload"
+                                          << BSON("page"
+                                                  << "/home"
+                                                  << "visible"
+                                                  << true)));
+    }
+    return events;
+}
+
+std::string concatenate(const std::vector<BSONObj>& objs) {
+    std::string data;
+    for (auto&& obj : objs) {
+        data.append(obj.objdata(), obj.objsize());
+    }
+    return data;
+}
+
+size_t compress(WT_COMPRESSOR* compressor, const std::string& src, std::vector<uint8_t>* dst) {
+    dst->resize(src.size());
+    size_t resultLen;
+    int compressionFailed;
+    auto in = reinterpret_cast<uint8_t*>(const_cast<char*>(src.data()));
+    ASSERT_EQ(0,
+              compressor->compress(compressor,
+                                   nullptr,
+                                   in,
+                                   src.size(),
+                                   dst->data(),
+                                   dst->size(),
+                                   &resultLen,
+                                   &compressionFailed));
+    ASSERT_EQ(0, compressionFailed);
+    dst->resize(resultLen);
+    return resultLen;
+}
+
+std::string decompress(WT_COMPRESSOR* compressor, std::vector<uint8_t>* src, size_t size) {
+    std::string dst(size, '\0');
+    size_t resultLen;
+    ASSERT_EQ(0,
+              compressor->decompress(compressor,
+                                     nullptr,
+                                     src->data(),
+                                     src->size(),
+                                     reinterpret_cast<uint8_t*>(&dst[0]),
+                                     dst.size(),
+                                     &resultLen));
+    ASSERT_EQ(size, resultLen);
+    return dst;
+}
+
+TEST(WiredTigerDictionaryCompressorTest, TrainedDictionaryHoldsRepeatedFieldNamesAndValues) {
+    const auto dictionary =
+        WiredTigerDictionaryCompressors::trainDictionary(makeEvents(100), 1024);
+    ASSERT_LTE(dictionary.size(), 1024U);
+    ASSERT_NE(std::string::npos, dictionary.find("eventType"));
+    ASSERT_NE(std::string::npos, dictionary.find("Mozilla/5.0"));
+    ASSERT_NE(std::string::npos, dictionary.find("page"));
+
+    // A single document has nothing which repeats across documents.
+    ASSERT_EQ(std::string::npos,
+              WiredTigerDictionaryCompressors::trainDictionary(makeEvents(1), 1024)
+                  .find("sequence"));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, TrainedDictionaryRespectsMaximumSize) {
+    ASSERT_LTE(WiredTigerDictionaryCompressors::trainDictionary(makeEvents(100), 16).size(), 16U);
+    ASSERT_EQ("", WiredTigerDictionaryCompressors::trainDictionary({}, 1024));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, ParsesBlockCompressorFromConfig) {
+    ASSERT_EQ("", WiredTigerDictionaryCompressors::getBlockCompressor("type=file"));
+    ASSERT_EQ("dictionary",
+              WiredTigerDictionaryCompressors::getBlockCompressor(
+                  "block_compressor=snappy,block_compressor=dictionary"));
+    ASSERT_TRUE(WiredTigerDictionaryCompressors::isDictionaryCompressor("dictionary_12"));
+    ASSERT_FALSE(WiredTigerDictionaryCompressors::isDictionaryCompressor("dictionary"));
+    ASSERT_FALSE(WiredTigerDictionaryCompressors::isDictionaryCompressor("snappy"));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, BlocksStayReadableAfterRetraining) {
+    unittest::TempDir dbPath("wt_dictionary_compressor_test");
+    WiredTigerDictionaryCompressors compressors(dbPath.path());
+    const auto name = unittest::assertGet(compressors.createCompressor());
+    auto compressor = compressors.getCompressor_forTest(name);
+    ASSERT(compressor);
+
+    const auto page = concatenate(makeEvents(50));
+    std::vector<uint8_t> withoutDictionary;
+    const auto sizeWithoutDictionary = compress(compressor, page, &withoutDictionary);
+
+    ASSERT_EQ(1,
+              unittest::assertGet(compressors.addDictionary(
+                  name,
+                  WiredTigerDictionaryCompressors::trainDictionary(
+                      makeEvents(100), WiredTigerDictionaryCompressors::kMaxDictionarySize))));
+    std::vector<uint8_t> withDictionary;
+    ASSERT_LT(compress(compressor, page, &withDictionary), sizeWithoutDictionary);
+
+    ASSERT_EQ(2,
+              unittest::assertGet(compressors.addDictionary(
+                  name, WiredTigerDictionaryCompressors::trainDictionary(makeEvents(10), 64))));
+
+    ASSERT_EQ(page, decompress(compressor, &withoutDictionary, page.size()));
+    ASSERT_EQ(page, decompress(compressor, &withDictionary, page.size()));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, DictionariesAreLoadedFromTheDbPath) {
+    unittest::TempDir dbPath("wt_dictionary_compressor_test");
+    const auto page = concatenate(makeEvents(50));
+    std::vector<uint8_t> block;
+    std::string name;
+    {
+        WiredTigerDictionaryCompressors compressors(dbPath.path());
+        ASSERT_OK(compressors.load());
+        ASSERT_EQ("", compressors.prepareOpenExtensionConfig());
+
+        name = unittest::assertGet(compressors.createCompressor());
+        ASSERT_OK(compressors
+                      .addDictionary(name,
+                                     WiredTigerDictionaryCompressors::trainDictionary(
+                                         makeEvents(100),
+                                         WiredTigerDictionaryCompressors::kMaxDictionarySize))
+                      .getStatus());
+        compress(compressors.getCompressor_forTest(name), page, &block);
+    }
+    ASSERT(boost::filesystem::exists(boost::filesystem::path(dbPath.path()) /
+                                     WiredTigerDictionaryCompressors::kFileName.toString()));
+
+    WiredTigerDictionaryCompressors compressors(dbPath.path());
+    ASSERT_OK(compressors.load());
+    ASSERT_NE("", compressors.prepareOpenExtensionConfig());
+    ASSERT_EQ(page, decompress(compressors.getCompressor_forTest(name), &block, page.size()));
+
+    // Identifiers are not reused.
+    ASSERT_NE(name, unittest::assertGet(compressors.createCompressor()));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, TablesCanUseRegisteredCompressors) {
+    unittest::TempDir dbPath("wt_dictionary_compressor_test");
+    WiredTigerDictionaryCompressors compressors(dbPath.path());
+
+    WT_CONNECTION* conn;
+    ASSERT_OK(wtRCToStatus(wiredtiger_open(dbPath.path().c_str(), nullptr, "create", &conn)));
+    ON_BLOCK_EXIT([&] { conn->close(conn, nullptr); });
+    ASSERT_OK(compressors.registerCompressors(conn));
+
+    const auto name = unittest::assertGet(compressors.createCompressor());
+    ASSERT_OK(compressors
+                  .addDictionary(name,
+                                 WiredTigerDictionaryCompressors::trainDictionary(
+                                     makeEvents(100),
+                                     WiredTigerDictionaryCompressors::kMaxDictionarySize))
+                  .getStatus());
+
+    WT_SESSION* session;
+    ASSERT_OK(wtRCToStatus(conn->open_session(conn, nullptr, nullptr, &session)));
+    const std::string config =
+        "key_format=q,value_format=u,block_compressor=" + name;
+    ASSERT_OK(wtRCToStatus(session->create(session, "table:events", config.c_str())));
+
+    const auto events = makeEvents(1000);
+    WT_CURSOR* cursor;
+    ASSERT_OK(wtRCToStatus(session->open_cursor(session, "table:events", nullptr, nullptr, &cursor)));
+    for (size_t i = 0; i < events.size(); ++i) {
+        cursor->set_key(cursor, static_cast<int64_t>(i));
+        WiredTigerItem value(events[i].objdata(), events[i].objsize());
+        cursor->set_value(cursor, value.Get());
+        ASSERT_OK(wtRCToStatus(cursor->insert(cursor)));
+    }
+    ASSERT_OK(wtRCToStatus(cursor->close(cursor)));
+
+    // Checkpointing writes the compressed pages, and reopening reads them back from disk.
+    ASSERT_OK(wtRCToStatus(session->checkpoint(session, nullptr)));
+    ASSERT_OK(wtRCToStatus(session->close(session, nullptr)));
+    ASSERT_OK(wtRCToStatus(conn->close(conn, nullptr)));
+    ASSERT_OK(wtRCToStatus(wiredtiger_open(dbPath.path().c_str(), nullptr, "", &conn)));
+    ASSERT_OK(compressors.registerCompressors(conn));
+
+    ASSERT_OK(wtRCToStatus(conn->open_session(conn, nullptr, nullptr, &session)));
+    ASSERT_OK(wtRCToStatus(session->open_cursor(session, "table:events", nullptr, nullptr, &cursor)));
+    size_t count = 0;
+    while (cursor->next(cursor) == 0) {
+        WT_ITEM value;
+        ASSERT_OK(wtRCToStatus(cursor->get_value(cursor, &value)));
+        ASSERT_BSONOBJ_EQ(events[count], BSONObj(static_cast<const char*>(value.data)));
+        ++count;
+    }
+    ASSERT_EQ(events.size(), count);
+}
+
+TEST(WiredTigerDictionaryCompressorTest, DroppedCompressorsAreRemovedFromTheDbPath) {
+    unittest::TempDir dbPath("wt_dictionary_compressor_test");
+    std::string keptName;
+    std::string droppedName;
+    {
+        WiredTigerDictionaryCompressors compressors(dbPath.path());
+        keptName = unittest::assertGet(compressors.createCompressor());
+        droppedName = unittest::assertGet(compressors.createCompressor());
+        ASSERT(compressors.getDroppedCompressors().empty());
+
+        compressors.markDropped(droppedName);
+        const auto dropped = compressors.getDroppedCompressors();
+        ASSERT_EQ(1U, dropped.size());
+        ASSERT_EQ(droppedName, dropped[0]);
+
+        ASSERT_OK(compressors.removeCompressors(dropped));
+        ASSERT(compressors.getDroppedCompressors().empty());
+        ASSERT_FALSE(compressors.getCompressor_forTest(droppedName));
+    }
+
+    WiredTigerDictionaryCompressors compressors(dbPath.path());
+    ASSERT_OK(compressors.load());
+    ASSERT(compressors.getCompressor_forTest(keptName));
+    ASSERT_FALSE(compressors.getCompressor_forTest(droppedName));
+}
+
+TEST(WiredTigerDictionaryCompressorTest, CompressorsWhichNoTableUsesAreRemoved) {
+    unittest::TempDir dbPath("wt_dictionary_compressor_test");
+    WiredTigerDictionaryCompressors compressors(dbPath.path());
+
+    WT_CONNECTION* conn;
+    ASSERT_OK(wtRCToStatus(wiredtiger_open(dbPath.path().c_str(), nullptr, "create", &conn)));
+    ON_BLOCK_EXIT([&] { conn->close(conn, nullptr); });
+    ASSERT_OK(compressors.registerCompressors(conn));
+
+    const auto usedName = unittest::assertGet(compressors.createCompressor());
+    const auto unusedName = unittest::assertGet(compressors.createCompressor());
+
+    WT_SESSION* session;
+    ASSERT_OK(wtRCToStatus(conn->open_session(conn, nullptr, nullptr, &session)));
+    const std::string config = "key_format=q,value_format=u,block_compressor=" + usedName;
+    ASSERT_OK(wtRCToStatus(session->create(session, "table:events", config.c_str())));
+
+    ASSERT_OK(compressors.removeUnusedCompressors(session));
+    ASSERT(compressors.getCompressor_forTest(usedName));
+    ASSERT_FALSE(compressors.getCompressor_forTest(unusedName));
+}
+
+}  // namespace
+}  // namespace mongo
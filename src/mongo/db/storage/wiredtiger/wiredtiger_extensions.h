@@ -48,7 +48,7 @@ public:
     std::string getOpenExtensionsConfig() const;
 
     /**
-     * Add an item to the `wiredtiger_open` extensions list.
+     * Add an item to the `wiredtiger_open` extensions list, unless it is already on it.
      */
     void addExtension(StringData extensionConfigStr);
 
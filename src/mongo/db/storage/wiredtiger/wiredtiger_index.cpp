@@ -107,12 +107,16 @@ BSONObj stripFieldNames(const BSONObj& query) {
     return bb.obj();
 }
 
+Status keyTooLongError(const BSONObj& key) {
+    string msg = mongoutils::str::stream()
+        << "WiredTigerIndex::insert: key too large to index, failing " << ' ' << key.objsize()
+        << ' ' << key;
+    return Status(ErrorCodes::KeyTooLong, msg);
+}
+
 Status checkKeySize(const BSONObj& key) {
     if (key.objsize() >= TempKeyMaxSize) {
-        string msg = mongoutils::str::stream()
-            << "WiredTigerIndex::insert: key too large to index, failing " << ' ' << key.objsize()
-            << ' ' << key;
-        return Status(ErrorCodes::KeyTooLong, msg);
+        return keyTooLongError(key);
     }
     return Status::OK();
 }
@@ -1646,6 +1650,34 @@ SortedDataBuilderInterface* WiredTigerIndexStandard::getBulkBuilder(OperationCon
     return new StandardBulkBuilder(this, opCtx, _prefix);
 }
 
+Status WiredTigerIndexStandard::insertKeyString(OperationContext* opCtx,
+                                                const KeyString& keyString,
+                                                int keySize,
+                                                const RecordId& id,
+                                                bool dupsAllowed) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    invariant(id.isNormal());
+    invariant(dupsAllowed);
+    dassert(keyString.version == keyStringVersion());
+
+    if (keySize >= TempKeyMaxSize) {
+        return keyTooLongError(KeyString::toBson(
+            keyString.getBuffer(), keyString.getSize(), _ordering, keyString.getTypeBits()));
+    }
+
+    TRACE_INDEX << " KeyString: " << keyString << " id: " << id;
+
+    // Table keys of a standard index are the index key followed by the RecordId. Copying the
+    // encoded key into a stack-allocated KeyString is much cheaper than encoding it again.
+    KeyString tableKey(keyStringVersion());
+    tableKey.resetFromBuffer(keyString.getBuffer(), keyString.getSize());
+    tableKey.appendRecordId(id);
+
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    curwrap.assertInActiveTxn();
+    return _insertTableKey(curwrap.get(), tableKey, keyString.getTypeBits());
+}
+
 Status WiredTigerIndexStandard::_insert(OperationContext* opCtx,
                                         WT_CURSOR* c,
                                         const BSONObj& keyBson,
@@ -1656,11 +1688,17 @@ Status WiredTigerIndexStandard::_insert(OperationContext* opCtx,
     TRACE_INDEX << " key: " << keyBson << " id: " << id;
 
     KeyString key(keyStringVersion(), keyBson, _ordering, id);
-    WiredTigerItem keyItem(key.getBuffer(), key.getSize());
+    return _insertTableKey(c, key, key.getTypeBits());
+}
+
+Status WiredTigerIndexStandard::_insertTableKey(WT_CURSOR* c,
+                                                const KeyString& tableKey,
+                                                const KeyString::TypeBits& typeBits) {
+    WiredTigerItem keyItem(tableKey.getBuffer(), tableKey.getSize());
 
-    WiredTigerItem valueItem = key.getTypeBits().isAllZeros()
+    WiredTigerItem valueItem = typeBits.isAllZeros()
         ? emptyItem
-        : WiredTigerItem(key.getTypeBits().getBuffer(), key.getTypeBits().getSize());
+        : WiredTigerItem(typeBits.getBuffer(), typeBits.getSize());
 
     setKey(c, keyItem.Get());
     c->set_value(c, valueItem.Get());
@@ -276,6 +276,17 @@ public:
         return false;
     }
 
+    boost::optional<KeyString::Version> getKeyStringInsertVersion(
+        OperationContext* opCtx) const override {
+        return keyStringVersion();
+    }
+
+    Status insertKeyString(OperationContext* opCtx,
+                           const KeyString& keyString,
+                           int keySize,
+                           const RecordId& id,
+                           bool dupsAllowed) override;
+
     Status _insert(OperationContext* opCtx,
                    WT_CURSOR* c,
                    const BSONObj& key,
@@ -287,6 +298,15 @@ public:
                   const BSONObj& key,
                   const RecordId& id,
                   bool dupsAllowed) override;
+
+private:
+    /**
+     * Inserts the table key 'tableKey', which is an index key with the RecordId appended, with
+     * 'typeBits' as its value.
+     */
+    Status _insertTableKey(WT_CURSOR* c,
+                           const KeyString& tableKey,
+                           const KeyString::TypeBits& typeBits);
 };
 
 }  // namespace
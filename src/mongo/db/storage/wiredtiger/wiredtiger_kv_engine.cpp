@@ -73,6 +73,7 @@
 #include "mongo/db/storage/storage_file_util.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/storage_repair_observer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_adjuster.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -276,6 +277,88 @@ private:
     AtomicBool _shuttingDown{false};
 };
 
+class WiredTigerKVEngine::WiredTigerConcurrencyAdjusterThread : public BackgroundJob {
+public:
+    WiredTigerConcurrencyAdjusterThread(WiredTigerSessionCache* sessionCache,
+                                        WiredTigerConcurrencyAdjuster* adjuster)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache), _adjuster(adjuster) {}
+
+    virtual string name() const {
+        return "WTConcurrencyAdjuster";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        const Milliseconds interval(1000);
+        bool wasAdaptive = false;
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, interval.toSystemDuration());
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            const bool isAdaptive = wiredTigerAdaptiveConcurrency.load();
+            if (!isAdaptive) {
+                if (wasAdaptive) {
+                    log() << "Restoring fixed WiredTiger concurrent transaction limits";
+                    _adjuster->reset();
+                }
+                wasAdaptive = false;
+                continue;
+            }
+            wasAdaptive = true;
+
+            _adjuster->adjust(_takeSample(), interval);
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<stdx::mutex> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    WiredTigerConcurrencyAdjuster::CacheSample _takeSample() {
+        UniqueWiredTigerSession session = _sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+        auto getStat = [s](int key) -> std::uint64_t {
+            auto swValue =
+                WiredTigerUtil::getStatisticsValue(s, "statistics:", "statistics=(fast)", key);
+            return swValue.isOK() ? swValue.getValue() : 0;
+        };
+
+        WiredTigerConcurrencyAdjuster::CacheSample sample;
+        sample.bytesMax = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        sample.bytesInUse = getStat(WT_STAT_CONN_CACHE_BYTES_INUSE);
+        sample.bytesDirty = getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        sample.appThreadPagesEvicted = getStat(WT_STAT_CONN_CACHE_EVICTION_APP);
+        sample.appThreadCacheWaitMicros = getStat(WT_STAT_CONN_APPLICATION_CACHE_TIME);
+        return sample;
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    WiredTigerConcurrencyAdjuster* _adjuster;
+    AtomicBool _shuttingDown{false};
+
+    stdx::mutex _mutex;  // protects _condvar
+    // The adjuster thread idles on this condition variable between samples. It can be triggered
+    // early to expedite shutdown.
+    stdx::condition_variable _condvar;
+};
+
 class WiredTigerKVEngine::WiredTigerCheckpointThread : public BackgroundJob {
 public:
     explicit WiredTigerCheckpointThread(WiredTigerSessionCache* sessionCache)
@@ -305,6 +388,12 @@ public:
 
             const Timestamp stableTimestamp(_stableTimestamp.load());
             const Timestamp initialDataTimestamp(_initialDataTimestamp.load());
+
+            // The drops of the collections which used these compressors are durable once the
+            // checkpoint completes, so the compressors can then be removed.
+            auto dictionaryCompressors = _sessionCache->getKVEngine()->getDictionaryCompressors();
+            const auto droppedCompressors = dictionaryCompressors->getDroppedCompressors();
+            bool checkpointed = false;
             try {
                 // Three cases:
                 //
@@ -325,10 +414,12 @@ public:
                     UniqueWiredTigerSession session = _sessionCache->getSession();
                     WT_SESSION* s = session->getSession();
                     invariantWTOK(s->checkpoint(s, "use_timestamp=false"));
+                    checkpointed = true;
                 } else if (!serverGlobalParams.enableMajorityReadConcern) {
                     UniqueWiredTigerSession session = _sessionCache->getSession();
                     WT_SESSION* s = session->getSession();
                     invariantWTOK(s->checkpoint(s, "use_timestamp=false"));
+                    checkpointed = true;
 
                     // Ensure '_lastStableCheckpointTimestamp' is set such that oplog truncation may
                     // take place entirely based on the oplog size.
@@ -350,6 +441,7 @@ public:
                     UniqueWiredTigerSession session = _sessionCache->getSession();
                     WT_SESSION* s = session->getSession();
                     invariantWTOK(s->checkpoint(s, "use_timestamp=true"));
+                    checkpointed = true;
 
                     // Publish the checkpoint time after the checkpoint becomes durable.
                     _lastStableCheckpointTimestamp.store(stableTimestamp);
@@ -360,6 +452,15 @@ public:
             } catch (const AssertionException& exc) {
                 invariant(ErrorCodes::isShutdownError(exc.code()), exc.what());
             }
+
+            if (checkpointed) {
+                Status status = dictionaryCompressors->removeCompressors(droppedCompressors);
+                if (!status.isOK()) {
+                    warning() << "Failed to remove the dictionary block compressors of dropped "
+                                 "collections: "
+                              << status;
+                }
+            }
         }
         LOG(1) << "stopping " << name() << " thread";
     }
@@ -431,12 +532,20 @@ private:
 
 namespace {
 
+TicketHolder openWriteTransaction(128);
+TicketHolder openReadTransaction(128);
+WiredTigerConcurrencyAdjuster concurrencyAdjuster(&openReadTransaction, &openWriteTransaction);
+
 class TicketServerParameter : public ServerParameter {
     MONGO_DISALLOW_COPYING(TicketServerParameter);
 
 public:
-    TicketServerParameter(TicketHolder* holder, const std::string& name)
-        : ServerParameter(ServerParameterSet::getGlobal(), name, true, true), _holder(holder) {}
+    TicketServerParameter(TicketHolder* holder,
+                          WiredTigerConcurrencyAdjuster* adjuster,
+                          const std::string& name)
+        : ServerParameter(ServerParameterSet::getGlobal(), name, true, true),
+          _holder(holder),
+          _adjuster(adjuster) {}
 
     virtual void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) {
         b.append(name, _holder->outof());
@@ -445,7 +554,12 @@ public:
     virtual Status set(const BSONElement& newValueElement) {
         if (!newValueElement.isNumber())
             return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be a number");
-        return _set(newValueElement.numberInt());
+        Status status = _validate(newValueElement.numberInt());
+        if (!status.isOK())
+            return status;
+
+        // A size set at runtime takes over from adaptive concurrency.
+        return _adjuster->setExplicitSize(_holder, newValueElement.numberInt());
     }
 
     virtual Status setFromString(const std::string& str) {
@@ -453,32 +567,54 @@ public:
         Status status = parseNumberFromString(str, &num);
         if (!status.isOK())
             return status;
+        // Sizes given at startup are the fixed sizes that adaptive concurrency starts from.
         return _set(num);
     }
 
     Status _set(int newNum) {
-        if (newNum <= 0) {
-            return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be > 0");
-        }
+        Status status = _validate(newNum);
+        if (!status.isOK())
+            return status;
 
         return _holder->resize(newNum);
     }
 
 private:
+    Status _validate(int newNum) const {
+        if (newNum <= 0) {
+            return Status(ErrorCodes::BadValue, str::stream() << name() << " has to be > 0");
+        }
+        return Status::OK();
+    }
+
     TicketHolder* _holder;
+    WiredTigerConcurrencyAdjuster* _adjuster;
 };
 
-TicketHolder openWriteTransaction(128);
 TicketServerParameter openWriteTransactionParam(&openWriteTransaction,
+                                                &concurrencyAdjuster,
                                                 "wiredTigerConcurrentWriteTransactions");
 
-TicketHolder openReadTransaction(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
+                                               &concurrencyAdjuster,
                                                "wiredTigerConcurrentReadTransactions");
 
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
+
+/**
+ * Returns the name of the dictionary compressor of the table at 'uri', or an empty string if it
+ * does not have one.
+ */
+std::string getDictionaryCompressorName(WT_SESSION* session, const std::string& uri) {
+    auto metadata = WiredTigerUtil::getMetadataCreate(session, uri);
+    if (!metadata.isOK()) {
+        return "";
+    }
+    auto name = WiredTigerDictionaryCompressors::getBlockCompressor(metadata.getValue());
+    return WiredTigerDictionaryCompressors::isDictionaryCompressor(name) ? name : "";
+}
 }  // namespace
 
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
@@ -547,6 +683,16 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     }
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())
               ->getTableCreateConfig("system");
+    _dictionaryCompressors = stdx::make_unique<WiredTigerDictionaryCompressors>(path);
+    fassert(56855, _dictionaryCompressors->load());
+    const auto dictionaryCompressorsExtension =
+        _dictionaryCompressors->prepareOpenExtensionConfig();
+    if (!dictionaryCompressorsExtension.empty()) {
+        // Recovery may need to read blocks written by the dictionary compressors, so they have to
+        // be registered while wiredtiger_open runs.
+        WiredTigerExtensions::get(getGlobalServiceContext())
+            ->addExtension(dictionaryCompressorsExtension);
+    }
     ss << WiredTigerExtensions::get(getGlobalServiceContext())->getOpenExtensionsConfig();
     ss << extraOpenOptions;
     if (_readOnly) {
@@ -585,6 +731,15 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     string config = ss.str();
     log() << "wiredtiger_open config: " << config;
     _openWiredTiger(path, config);
+    fassert(56856, _dictionaryCompressors->registerCompressors(_conn));
+    if (!_readOnly) {
+        // Collections dropped shortly before the last shutdown may have left their compressors.
+        WiredTigerSession session(_conn);
+        Status status = _dictionaryCompressors->removeUnusedCompressors(session.getSession());
+        if (!status.isOK()) {
+            warning() << "Failed to remove unused dictionary block compressors: " << status;
+        }
+    }
     _eventHandler.setStartupSuccessful();
     _wtOpenConfig = config;
 
@@ -630,6 +785,12 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+
+    if (!_readOnly) {
+        _concurrencyAdjuster = stdx::make_unique<WiredTigerConcurrencyAdjusterThread>(
+            _sessionCache.get(), &concurrencyAdjuster);
+        _concurrencyAdjuster->go();
+    }
 }
 
 
@@ -661,6 +822,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("totalTickets", openReadTransaction.outof());
         bbb.done();
     }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("adjustment"));
+        concurrencyAdjuster.appendStats(&bbb);
+        bbb.done();
+    }
     bb.done();
 }
 
@@ -737,6 +903,9 @@ void WiredTigerKVEngine::cleanShutdown() {
     }
 
     // these must be the last things we do before _conn->close();
+    if (_concurrencyAdjuster) {
+        _concurrencyAdjuster->shutdown();
+    }
     if (_sessionSweeper) {
         log() << "Shutting down session sweeper thread";
         _sessionSweeper->shutdown();
@@ -976,6 +1145,54 @@ void WiredTigerKVEngine::endBackup(OperationContext* opCtx) {
     _backupSession.reset();
 }
 
+StatusWith<std::vector<std::string>> WiredTigerKVEngine::beginNonBlockingBackup(
+    OperationContext* opCtx) {
+    invariant(!_backupSession);
+
+    if (_ephemeral) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "The in-memory storage engine has no files to back up");
+    }
+
+    // The cursor is freed along with the session, which keeps the checkpoint it lists pinned
+    // until endNonBlockingBackup().
+    auto session = stdx::make_unique<WiredTigerSession>(_conn);
+    WT_CURSOR* c = NULL;
+    WT_SESSION* s = session->getSession();
+    int ret = WT_OP_CHECK(s->open_cursor(s, "backup:", NULL, NULL, &c));
+    if (ret != 0) {
+        return wtRCToStatus(ret);
+    }
+
+    std::vector<std::string> filesToCopy;
+    while ((ret = c->next(c)) == 0) {
+        const char* filename;
+        invariantWTOK(c->get_key(c, &filename));
+        std::string name(filename);
+        // WiredTiger names its log files without the journal directory it keeps them in.
+        if (StringData(name).startsWith("WiredTigerLog.")) {
+            name = "journal/" + name;
+        }
+        filesToCopy.push_back(std::move(name));
+    }
+    if (ret != WT_NOTFOUND) {
+        return wtRCToStatus(ret);
+    }
+
+    // Tables compressed with a trained dictionary can't be read without it.
+    const auto dictionariesFile = WiredTigerDictionaryCompressors::kFileName.toString();
+    if (boost::filesystem::exists(boost::filesystem::path(_path) / dictionariesFile)) {
+        filesToCopy.push_back(dictionariesFile);
+    }
+
+    _backupSession = std::move(session);
+    return filesToCopy;
+}
+
+void WiredTigerKVEngine::endNonBlockingBackup(OperationContext* opCtx) {
+    _backupSession.reset();
+}
+
 void WiredTigerKVEngine::syncSizeInfo(bool sync) const {
     if (!_sizeStorer)
         return;
@@ -1008,6 +1225,10 @@ Status WiredTigerKVEngine::createGroupedRecordStore(OperationContext* opCtx,
     WiredTigerSession session(_conn);
 
     const bool prefixed = prefix.isPrefixed();
+    if (prefixed && options.clustered) {
+        return {ErrorCodes::InvalidOptions,
+                "Clustered collections are not supported with --groupCollections"};
+    }
     StatusWith<std::string> result = WiredTigerRecordStore::generateCreateString(
         _canonicalName, ns, options, _rsOptions, prefixed);
     if (!result.isOK()) {
@@ -1015,6 +1236,17 @@ Status WiredTigerKVEngine::createGroupedRecordStore(OperationContext* opCtx,
     }
     std::string config = result.getValue();
 
+    // Each collection which asks for dictionary compression gets a compressor of its own, since
+    // WiredTiger does not tell compressors which table they are compressing for.
+    if (WiredTigerDictionaryCompressors::getBlockCompressor(config) ==
+        WiredTigerDictionaryCompressors::kBlockCompressorName) {
+        auto compressorName = _dictionaryCompressors->createCompressor();
+        if (!compressorName.isOK()) {
+            return compressorName.getStatus();
+        }
+        config += ",block_compressor=" + compressorName.getValue();
+    }
+
     string uri = _uri(ident);
     WT_SESSION* s = session.getSession();
     LOG(2) << "WiredTigerKVEngine::createRecordStore ns: " << ns << " uri: " << uri
@@ -1105,6 +1337,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.uri = _uri(ident);
     params.engineName = _canonicalName;
     params.isCapped = options.capped;
+    params.isClustered = options.clustered;
     params.isEphemeral = _ephemeral;
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
@@ -1143,6 +1376,29 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     return std::move(ret);
 }
 
+std::unique_ptr<RecordStore> WiredTigerKVEngine::makeTemporaryRecordStore(OperationContext* opCtx,
+                                                                          StringData ident) {
+    uassertStatusOK(
+        createGroupedRecordStore(opCtx, "", ident, CollectionOptions(), KVPrefix::kNotPrefixed));
+
+    // Temporary tables are dropped before the next restart, so their sizes aren't persisted.
+    WiredTigerRecordStore::Params params;
+    params.ns = "";
+    params.uri = _uri(ident);
+    params.engineName = _canonicalName;
+    params.isCapped = false;
+    params.isEphemeral = _ephemeral;
+    params.cappedCallback = nullptr;
+    params.sizeStorer = nullptr;
+    params.isReadOnly = false;
+    params.cappedMaxSize = -1;
+    params.cappedMaxDocs = -1;
+
+    auto rs = stdx::make_unique<StandardWiredTigerRecordStore>(this, opCtx, params);
+    rs->postConstructorInit(opCtx);
+    return std::move(rs);
+}
+
 string WiredTigerKVEngine::_uri(StringData ident) const {
     return string("table:") + ident.toString();
 }
@@ -1217,12 +1473,16 @@ Status WiredTigerKVEngine::dropIdent(OperationContext* opCtx, StringData ident)
 
     WiredTigerSession session(_conn);
 
+    const auto compressorName = getDictionaryCompressorName(session.getSession(), uri);
     int ret = session.getSession()->drop(
         session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
     LOG(1) << "WT drop of  " << uri << " res " << ret;
 
     if (ret == 0) {
         // yay, it worked
+        if (!compressorName.empty()) {
+            _dictionaryCompressors->markDropped(compressorName);
+        }
         return Status::OK();
     }
 
@@ -1311,6 +1571,7 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
             uri = _identToDrop.front();
             _identToDrop.pop_front();
         }
+        const auto compressorName = getDictionaryCompressorName(session.getSession(), uri);
         int ret = session.getSession()->drop(
             session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
         LOG(1) << "WT queued drop of  " << uri << " res " << ret;
@@ -1320,6 +1581,9 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
             _identToDrop.push_back(uri);
         } else {
             invariantWTOK(ret);
+            if (!compressorName.empty()) {
+                _dictionaryCompressors->markDropped(compressorName);
+            }
         }
     }
 }
@@ -1703,6 +1967,10 @@ bool WiredTigerKVEngine::supportsReadConcernMajority() const {
     return _keepDataHistory;
 }
 
+bool WiredTigerKVEngine::supportsClusteredRecordStores() const {
+    return true;
+}
+
 void WiredTigerKVEngine::startOplogManager(OperationContext* opCtx,
                                            const std::string& uri,
                                            WiredTigerRecordStore* oplogRecordStore) {
@@ -42,6 +42,7 @@
 #include "mongo/bson/ordering.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -138,6 +139,9 @@ public:
                                                                const CollectionOptions& options,
                                                                KVPrefix prefix) override;
 
+    std::unique_ptr<RecordStore> makeTemporaryRecordStore(OperationContext* opCtx,
+                                                          StringData ident) override;
+
     virtual Status createGroupedSortedDataInterface(OperationContext* opCtx,
                                                     StringData ident,
                                                     const IndexDescriptor* desc,
@@ -166,6 +170,10 @@ public:
 
     virtual void endBackup(OperationContext* opCtx);
 
+    StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx) override;
+
+    void endNonBlockingBackup(OperationContext* opCtx) override;
+
     virtual int64_t getIdentSize(OperationContext* opCtx, StringData ident) override;
 
     virtual Status repairIdent(OperationContext* opCtx, StringData ident) override;
@@ -223,6 +231,8 @@ public:
 
     bool supportsReadConcernMajority() const final;
 
+    bool supportsClusteredRecordStores() const final;
+
     // wiredtiger specific
     // Calls WT_CONNECTION::reconfigure on the underlying WT_CONNECTION
     // held by this class
@@ -266,6 +276,10 @@ public:
         return _oplogManager.get();
     }
 
+    WiredTigerDictionaryCompressors* getDictionaryCompressors() const {
+        return _dictionaryCompressors.get();
+    }
+
     /*
      * This function is called when replication has completed a batch.  In this function, we
      * refresh our oplog visiblity read-at-timestamp value.
@@ -305,6 +319,7 @@ public:
 private:
     class WiredTigerSessionSweeper;
     class WiredTigerJournalFlusher;
+    class WiredTigerConcurrencyAdjusterThread;
     class WiredTigerCheckpointThread;
 
     /**
@@ -343,6 +358,9 @@ private:
     std::size_t _oplogManagerCount = 0;
     std::unique_ptr<WiredTigerOplogManager> _oplogManager;
 
+    // Must outlive '_conn', which refers to the compressors.
+    std::unique_ptr<WiredTigerDictionaryCompressors> _dictionaryCompressors;
+
     std::string _canonicalName;
     std::string _path;
     std::string _wtOpenConfig;
@@ -364,6 +382,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerConcurrencyAdjusterThread> _concurrencyAdjuster;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
 
@@ -32,15 +32,19 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/bits.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -131,6 +135,9 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     _opsWaitingForVisibility++;
     invariant(_opsWaitingForVisibility > 0);
     auto exitGuard = MakeGuard([&] { _opsWaitingForVisibility--; });
+    if (_opsWaitingForJournal) {
+        _opsWaitingForJournalCV.notify_one();
+    }
 
     opCtx->waitForConditionOrInterrupt(_opsBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
@@ -156,14 +163,33 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     });
 }
 
-void WiredTigerOplogManager::triggerJournalFlush() {
+void WiredTigerOplogManager::triggerJournalFlush(Timestamp commitTimestamp) {
+    const auto now = curTimeMicros64();
+
     stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    if (_pendingVisibilityBatch.commits++ == 0) {
+        _pendingVisibilityBatch.firstCommitMicros = now;
+    } else if (now > _pendingVisibilityBatch.firstCommitMicros) {
+        _pendingVisibilityBatch.commitOffsetMicros +=
+            now - _pendingVisibilityBatch.firstCommitMicros;
+    }
+    _pendingVisibilityBatch.newestTimestamp = std::max<std::uint64_t>(
+        _pendingVisibilityBatch.newestTimestamp, commitTimestamp.asULL());
+
     if (!_opsWaitingForJournal) {
         _opsWaitingForJournal = true;
         _opsWaitingForJournalCV.notify_one();
     }
 }
 
+void WiredTigerOplogManager::notifyOplogWaiterArrived() {
+    stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    if (_opsWaitingForJournal && !_oplogWaiterArrived) {
+        _oplogWaiterArrived = true;
+        _opsWaitingForJournalCV.notify_one();
+    }
+}
+
 void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                                      WiredTigerRecordStore* oplogRecordStore,
                                                      const bool updateOldestTimestamp) noexcept {
@@ -185,26 +211,21 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
             if (journalDelay == Milliseconds(0)) {
                 journalDelay = Milliseconds(WiredTigerKVEngine::kDefaultJournalDelayMillis);
             }
-            auto now = Date_t::now();
-            auto deadline = now + journalDelay;
+            auto deadline = Date_t::now() + journalDelay;
             auto shouldSyncOpsWaitingForJournal = [&] {
-                return _shuttingDown || _opsWaitingForVisibility ||
+                return _shuttingDown || _opsWaitingForVisibility || _oplogWaiterArrived ||
                     oplogRecordStore->haveCappedWaiters();
             };
 
-            // Eventually it would be more optimal to merge this with the normal journal flushing
-            // and block for either oplog tailers or operations waiting for oplog visibility. For
-            // now this loop will poll once a millisecond up to the journalDelay to see if we have
-            // any waiters yet. This reduces sync-related I/O on the primary when secondaries are
-            // lagged, but will avoid significant delays in confirming majority writes on replica
-            // sets with infrequent writes.
-            // Callers of waitForAllEarlierOplogWritesToBeVisible() like causally consistent reads
-            // will preempt this delay.
-            while (now < deadline &&
-                   !_opsWaitingForJournalCV.wait_until(
-                       lk, now.toSystemTimePoint(), shouldSyncOpsWaitingForJournal)) {
-                now += Milliseconds(1);
-            }
+            // Delaying reduces sync-related I/O on the primary when secondaries are lagged. Oplog
+            // tailers and callers of waitForAllEarlierOplogWritesToBeVisible(), like causally
+            // consistent reads, signal _opsWaitingForJournalCV when they start waiting, which
+            // preempts this delay. Readers which were already waiting when the flush was
+            // triggered are seen by the first check of the predicate, so the new oplog entries
+            // are made visible to them right away. Commits which trigger a flush while this
+            // thread is busy are coalesced into the next pass.
+            _opsWaitingForJournalCV.wait_until(
+                lk, deadline.toSystemTimePoint(), shouldSyncOpsWaitingForJournal);
         }
 
         while (!_shuttingDown && MONGO_FAIL_POINT(WTPausePrimaryOplogDurabilityLoop)) {
@@ -219,6 +240,11 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         }
         invariant(_opsWaitingForJournal);
         _opsWaitingForJournal = false;
+        _oplogWaiterArrived = false;
+
+        // Commits which trigger a flush from here on are covered by the next pass.
+        const PendingVisibilityBatch batch = _pendingVisibilityBatch;
+        _pendingVisibilityBatch = PendingVisibilityBatch();
         lk.unlock();
 
         const uint64_t newTimestamp = fetchAllCommittedValue(sessionCache->conn());
@@ -235,6 +261,11 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
                 const bool force = false;
                 sessionCache->getKVEngine()->setOldestTimestamp(Timestamp(newTimestamp), force);
             }
+
+            // The batch's writes are either already visible or are behind a hole. In the latter
+            // case, the commit which fills the hole triggers another pass, which records them.
+            lk.lock();
+            _recordVisibilityLatencyIfVisible(lk, batch);
             continue;
         }
 
@@ -248,6 +279,7 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         if (newTimestamp > oldTimestamp) {
             _setOplogReadTimestamp(lk, newTimestamp);
         }
+        _recordVisibilityLatencyIfVisible(lk, batch);
         lk.unlock();
 
         if (updateOldestTimestamp) {
@@ -275,6 +307,64 @@ void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimest
     LOG(2) << "setting new oplogReadTimestamp: " << newTimestamp;
 }
 
+void WiredTigerOplogManager::_recordVisibilityLatencyIfVisible(
+    WithLock lk, const PendingVisibilityBatch& batch) {
+    if (batch.newestTimestamp <= getOplogReadTimestamp()) {
+        _recordVisibilityLatency(lk, batch);
+        return;
+    }
+
+    // Every commit in the pending batch triggered after the commits in 'batch', so 'batch' becomes
+    // its front and the offsets of the pending commits are rebased onto its oldest commit.
+    auto& pending = _pendingVisibilityBatch;
+    if (pending.commits > 0 && pending.firstCommitMicros > batch.firstCommitMicros) {
+        pending.commitOffsetMicros +=
+            (pending.firstCommitMicros - batch.firstCommitMicros) * pending.commits;
+    }
+    pending.commitOffsetMicros += batch.commitOffsetMicros;
+    pending.commits += batch.commits;
+    pending.firstCommitMicros = batch.firstCommitMicros;
+    pending.newestTimestamp = std::max(pending.newestTimestamp, batch.newestTimestamp);
+}
+
+void WiredTigerOplogManager::_recordVisibilityLatency(WithLock,
+                                                      const PendingVisibilityBatch& batch) {
+    if (batch.commits == 0) {
+        return;
+    }
+
+    const auto now = curTimeMicros64();
+    const std::uint64_t oldestCommitLatency =
+        now > batch.firstCommitMicros ? now - batch.firstCommitMicros : 0;
+    const std::uint64_t totalLatency = oldestCommitLatency * batch.commits;
+
+    // The histogram counts each batch once, at the latency of its oldest commit.
+    const int bucket = std::min(64 - countLeadingZeros64(oldestCommitLatency),
+                                VisibilityLatencyStats::kNumBuckets - 1);
+    _visibilityLatencyStats.buckets[bucket]++;
+    _visibilityLatencyStats.batches++;
+    _visibilityLatencyStats.commits += batch.commits;
+    _visibilityLatencyStats.totalMicros +=
+        totalLatency > batch.commitOffsetMicros ? totalLatency - batch.commitOffsetMicros : 0;
+}
+
+void WiredTigerOplogManager::appendVisibilityLatencyStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    builder->append("batches", static_cast<long long>(_visibilityLatencyStats.batches));
+    builder->append("commits", static_cast<long long>(_visibilityLatencyStats.commits));
+    builder->append("totalMicros", static_cast<long long>(_visibilityLatencyStats.totalMicros));
+
+    BSONArrayBuilder histogram(builder->subarrayStart("histogram"));
+    for (int i = 0; i < VisibilityLatencyStats::kNumBuckets; i++) {
+        if (_visibilityLatencyStats.buckets[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder entry(histogram.subobjStart());
+        entry.append("micros", i == 0 ? 0LL : 1LL << (i - 1));
+        entry.append("count", static_cast<long long>(_visibilityLatencyStats.buckets[i]));
+    }
+}
+
 uint64_t WiredTigerOplogManager::fetchAllCommittedValue(WT_CONNECTION* conn) {
     // Fetch the latest all_committed value from the storage engine.  This value will be a
     // timestamp that has no holes (uncommitted transactions with lower timestamps) behind it.
@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
@@ -39,12 +42,13 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 
 
-// Manages oplog visibility, by periodically querying WiredTiger's all_committed timestamp value and
-// then using that timestamp for all transactions that read the oplog collection.
+// Manages oplog visibility, by querying WiredTiger's all_committed timestamp value whenever oplog
+// writes commit and then using that timestamp for all transactions that read the oplog collection.
 class WiredTigerOplogManager {
     MONGO_DISALLOW_COPYING(WiredTigerOplogManager);
 
@@ -74,7 +78,14 @@ public:
     void setOplogReadTimestamp(Timestamp ts);
 
     // Triggers the oplogJournal thread to update its oplog read timestamp, by flushing the journal.
-    void triggerJournalFlush();
+    // Commits which trigger a flush while an earlier one is still pending are coalesced into the
+    // same visibility update. 'commitTimestamp' is the newest timestamp written by the triggering
+    // commit, if known; it is only used to tell when the commit becomes visible.
+    void triggerJournalFlush(Timestamp commitTimestamp = Timestamp());
+
+    // Tells the oplogJournal thread that a reader is about to wait for new oplog entries, so that
+    // a pending visibility update should not be delayed.
+    void notifyOplogWaiterArrived();
 
     // Waits until all committed writes at this point to become visible (that is, no holes exist in
     // the oplog.)
@@ -85,13 +96,47 @@ public:
     // all committed timestamp are committed.
     uint64_t fetchAllCommittedValue(WT_CONNECTION* conn);
 
+    // Appends statistics about how long committed oplog writes wait to become visible.
+    void appendVisibilityLatencyStats(BSONObjBuilder* builder) const;
+
 private:
+    // The oplog writes which have triggered a journal flush but are not yet covered by a
+    // visibility update.
+    struct PendingVisibilityBatch {
+        std::uint64_t commits = 0;
+        // When the oldest commit in the batch triggered the flush.
+        std::uint64_t firstCommitMicros = 0;
+        // The sum of how long after the oldest commit each of the other commits triggered.
+        std::uint64_t commitOffsetMicros = 0;
+        // The newest timestamp written by any commit in the batch. The batch is visible once the
+        // oplog read timestamp reaches it.
+        std::uint64_t newestTimestamp = 0;
+    };
+
+    // Power-of-two buckets of commit to visible latencies, in microseconds. Bucket 0 holds
+    // latencies under a microsecond and bucket i > 0 holds latencies in [2^(i-1), 2^i), except for
+    // the last bucket which holds everything above its lower bound.
+    struct VisibilityLatencyStats {
+        static const int kNumBuckets = 32;
+
+        std::array<std::uint64_t, kNumBuckets> buckets{};
+        std::uint64_t batches = 0;
+        std::uint64_t commits = 0;
+        std::uint64_t totalMicros = 0;
+    };
+
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                  WiredTigerRecordStore* oplogRecordStore,
                                  const bool updateOldestTimestamp) noexcept;
 
     void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
 
+    // Records the batch's latency if its writes are visible, and otherwise puts it back in front of
+    // the pending batch so that it is recorded by a later pass.
+    void _recordVisibilityLatencyIfVisible(WithLock, const PendingVisibilityBatch& batch);
+
+    void _recordVisibilityLatency(WithLock, const PendingVisibilityBatch& batch);
+
     stdx::thread _oplogJournalThread;
     mutable stdx::mutex _oplogVisibilityStateMutex;
     mutable stdx::condition_variable
@@ -107,6 +152,12 @@ private:
     RecordId _oplogMaxAtStartup = RecordId(0);  // Guarded by oplogVisibilityStateMutex.
     bool _opsWaitingForJournal = false;         // Guarded by oplogVisibilityStateMutex.
 
+    // Set when a reader starts waiting for new oplog entries while a journal flush is pending.
+    bool _oplogWaiterArrived = false;  // Guarded by oplogVisibilityStateMutex.
+
+    PendingVisibilityBatch _pendingVisibilityBatch;  // Guarded by oplogVisibilityStateMutex.
+    VisibilityLatencyStats _visibilityLatencyStats;  // Guarded by oplogVisibilityStateMutex.
+
     // When greater than 0, indicates that there are operations waiting for oplog visibility, and
     // journal flushing should not be delayed.
     std::int64_t _opsWaitingForVisibility = 0;  // Guarded by oplogVisibilityStateMutex.
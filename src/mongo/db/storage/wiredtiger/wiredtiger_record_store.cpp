@@ -50,8 +50,10 @@
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compressor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
@@ -88,6 +90,15 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+Status clusteredDuplicateKeyError(StringData ns, const char* data) {
+    BSONObjBuilder key;
+    key.appendAs(BSONObj(data)["_id"], "");
+    return Status(ErrorCodes::DuplicateKey,
+                  str::stream() << "E11000 duplicate key error collection: " << ns
+                                << " index: _id_ dup key: "
+                                << key.obj());
+}
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTCompactRecordStoreEBUSY);
@@ -644,6 +655,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
           getGlobalReplSettings().usingReplSets() ||
               repl::ReplSettings::shouldRecoverFromOplogAsStandalone())),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isClustered(params.isClustered),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -667,6 +679,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
     }
 
     if (_isCapped) {
+        invariant(!_isClustered);
         invariant(_cappedMaxSize > 0);
         invariant(_cappedMaxDocs == -1 || _cappedMaxDocs > 0);
     } else {
@@ -779,6 +792,115 @@ bool WiredTigerRecordStore::isCapped() const {
     return _isCapped;
 }
 
+bool WiredTigerRecordStore::isClustered() const {
+    return _isClustered;
+}
+
+RecordId WiredTigerRecordStore::seekClusteredId(OperationContext* opCtx,
+                                                const BSONElement& id,
+                                                bool forward) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    invariant(_isClustered);
+
+    const std::string key = clustered_record_id::keyForId(id);
+    WiredTigerCursor cursor(_uri, _tableId, true, opCtx);
+    WT_CURSOR* c = cursor.get();
+    setKey(c,
+           forward ? clustered_record_id::minRecordIdInGroup(key)
+                   : clustered_record_id::maxRecordIdInGroup(key));
+
+    int cmp;
+    int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search_near(c, &cmp); });
+    if (ret == 0 && (forward ? cmp < 0 : cmp > 0)) {
+        // Landed on the wrong side of the group of 'id'.
+        ret = wiredTigerPrepareConflictRetry(opCtx,
+                                             [&] { return forward ? c->next(c) : c->prev(c); });
+    }
+    if (ret == WT_NOTFOUND)
+        return RecordId();
+    invariantWTOK(ret);
+    return getKey(c);
+}
+
+RecordId WiredTigerRecordStore::findClusteredId(OperationContext* opCtx,
+                                                const BSONElement& id) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    invariant(_isClustered);
+
+    WiredTigerCursor cursor(_uri, _tableId, true, opCtx);
+    return _probeClusteredKey(opCtx, cursor.get(), clustered_record_id::keyForId(id)).found;
+}
+
+WiredTigerRecordStore::ClusteredProbe WiredTigerRecordStore::_probeClusteredKey(
+    OperationContext* opCtx, WT_CURSOR* c, const std::string& key) const {
+    const RecordId home = clustered_record_id::homeRecordId(key);
+    const int64_t end = home.repr() + clustered_record_id::kProbeSlots;
+
+    ClusteredProbe probe;
+    int64_t nextSlot = home.repr();
+    setKey(c, home);
+    int cmp;
+    int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search_near(c, &cmp); });
+    if (ret == 0 && cmp < 0) {
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
+    }
+    while (ret == 0) {
+        const RecordId id = getKey(c);
+        if (id.repr() >= end)
+            break;
+        if (probe.firstFree.isNull() && id.repr() > nextSlot) {
+            probe.firstFree = RecordId(nextSlot);
+        }
+        nextSlot = id.repr() + 1;
+
+        WT_ITEM value;
+        invariantWTOK(c->get_value(c, &value));
+        if (uassertStatusOK(clustered_record_id::extractKey(static_cast<const char*>(value.data),
+                                                            value.size)) == key) {
+            probe.found = id;
+            return probe;
+        }
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
+    }
+    if (ret != WT_NOTFOUND) {
+        invariantWTOK(ret);
+    }
+
+    if (probe.firstFree.isNull() && nextSlot < end) {
+        probe.firstFree = RecordId(nextSlot);
+    }
+    return probe;
+}
+
+StatusWith<RecordId> WiredTigerRecordStore::_clusteredRecordIdForInsert(OperationContext* opCtx,
+                                                                        WT_CURSOR* c,
+                                                                        const RecordData& data) {
+    StatusWith<std::string> key = clustered_record_id::extractKey(data.data(), data.size());
+    if (!key.isOK())
+        return key.getStatus();
+
+    const ClusteredProbe probe = _probeClusteredKey(opCtx, c, key.getValue());
+    if (!probe.found.isNull())
+        return clusteredDuplicateKeyError(ns(), data.data());
+    if (probe.firstFree.isNull()) {
+        return {ErrorCodes::OperationFailed,
+                str::stream() << "All " << clustered_record_id::kProbeSlots
+                              << " RecordIds for the _id of the document are in use in "
+                              << ns()};
+    }
+
+    // Two transactions inserting the same _id may see different slots free, if they run on
+    // different snapshots. Both write to the home slot, by inserting there or by reserving the
+    // record there, so that WiredTiger makes one of them conflict.
+    const RecordId home = clustered_record_id::homeRecordId(key.getValue());
+    if (probe.firstFree != home) {
+        setKey(c, home);
+        invariantWTOK(wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search(c); }));
+        invariantWTOK(WT_OP_CHECK(c->reserve(c)));
+    }
+    return probe.firstFree;
+}
+
 int64_t WiredTigerRecordStore::cappedMaxDocs() const {
     invariant(_isCapped);
     return _cappedMaxDocs;
@@ -1242,6 +1364,9 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
+        } else if (_isClustered) {
+            // Assigned below, where the records inserted before it are visible to the probe.
+            continue;
         } else {
             record.id = _nextId(opCtx);
         }
@@ -1268,6 +1393,12 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             LOG(4) << "inserting record with timestamp " << ts;
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
         }
+        if (_isClustered) {
+            StatusWith<RecordId> status = _clusteredRecordIdForInsert(opCtx, c, record.data);
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+        }
         setKey(c, record.id);
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
@@ -1386,6 +1517,18 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
+    if (_isClustered) {
+        // The RecordId is derived from the _id, so the _id cannot change.
+        StatusWith<std::string> newKey = clustered_record_id::extractKey(data, len);
+        if (!newKey.isOK())
+            return newKey.getStatus();
+        const BSONObj oldObj(static_cast<const char*>(old_value.data));
+        if (newKey.getValue() != clustered_record_id::keyForId(oldObj["_id"])) {
+            return {ErrorCodes::ImmutableField,
+                    "Cannot change the _id of a document in a clustered collection"};
+        }
+    }
+
     WiredTigerItem value(data, len);
 
     // Check if we should modify rather than doing a full update.  Look for deltas for documents
@@ -1441,17 +1584,34 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
+    dassert(opCtx->lockState()->isWriteLocked());
+
+    // Translate the damage events into WiredTiger modifications, coalescing events which are
+    // contiguous in both the source and the target buffers. The update path generates many small
+    // adjacent events (e.g. a type byte followed by the value) and WiredTiger applies, stores and
+    // caches each modification individually.
+    std::vector<WT_MODIFY> entries;
+    entries.reserve(damages.size());
+    for (const auto& damage : damages) {
+        const char* source = damageSource + damage.sourceOffset;
+        if (!entries.empty()) {
+            WT_MODIFY& last = entries.back();
+            if (last.offset + last.size == damage.targetOffset &&
+                static_cast<const char*>(last.data.data) + last.data.size == source) {
+                last.data.size += damage.size;
+                last.size += damage.size;
+                continue;
+            }
+        }
 
-    const int nentries = damages.size();
-    mutablebson::DamageVector::const_iterator where = damages.begin();
-    const mutablebson::DamageVector::const_iterator end = damages.cend();
-    std::vector<WT_MODIFY> entries(nentries);
-    for (u_int i = 0; where != end; ++i, ++where) {
-        entries[i].data.data = damageSource + where->sourceOffset;
-        entries[i].data.size = where->size;
-        entries[i].offset = where->targetOffset;
-        entries[i].size = where->size;
+        WT_MODIFY entry;
+        entry.data.data = source;
+        entry.data.size = damage.size;
+        entry.offset = damage.targetOffset;
+        entry.size = damage.size;
+        entries.push_back(entry);
     }
+    const int nentries = entries.size();
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
     curwrap.assertInActiveTxn();
@@ -1461,9 +1621,11 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
 
     // The test harness calls us with empty damage vectors which WiredTiger doesn't allow.
     if (nentries == 0)
-        invariantWTOK(WT_OP_CHECK(c->search(c)));
+        invariantWTOK(
+            wiredTigerPrepareConflictRetry(opCtx, [&] { return WT_OP_CHECK(c->search(c)); }));
     else
-        invariantWTOK(WT_OP_CHECK(c->modify(c, entries.data(), nentries)));
+        invariantWTOK(wiredTigerPrepareConflictRetry(
+            opCtx, [&] { return WT_OP_CHECK(c->modify(c, entries.data(), nentries)); }));
 
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
@@ -1603,6 +1765,9 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
                                               BSONObjBuilder* result,
                                               double scale) const {
     result->appendBool("capped", _isCapped);
+    if (_isClustered) {
+        result->appendBool("clustered", true);
+    }
     if (_isCapped) {
         result->appendIntOrLL("max", _cappedMaxDocs);
         result->appendIntOrLL("maxSize", static_cast<long long>(_cappedMaxSize / scale));
@@ -1665,6 +1830,67 @@ void WiredTigerRecordStore::waitForAllEarlierOplogWritesToBeVisible(OperationCon
     }
 }
 
+void WiredTigerRecordStore::notifyCappedWaiterArrived() const {
+    if (_isOplog) {
+        _kvEngine->getOplogManager()->notifyOplogWaiterArrived();
+    }
+}
+
+Status WiredTigerRecordStore::trainCompressionDictionary(OperationContext* opCtx,
+                                                        long long sampleSize,
+                                                        BSONObjBuilder* result) {
+    auto metadata = WiredTigerUtil::getMetadataCreate(opCtx, _uri);
+    if (!metadata.isOK()) {
+        return metadata.getStatus();
+    }
+    const auto compressorName =
+        WiredTigerDictionaryCompressors::getBlockCompressor(metadata.getValue());
+    if (!WiredTigerDictionaryCompressors::isDictionaryCompressor(compressorName)) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "Collection " << ns() << " was not created with the '"
+                              << WiredTigerDictionaryCompressors::kBlockCompressorName
+                              << "' block compressor"};
+    }
+
+    std::vector<BSONObj> samples;
+    auto cursor = getRandomCursor(opCtx);
+    if (!cursor) {
+        cursor = getCursor(opCtx, true);
+    }
+    while (static_cast<long long>(samples.size()) < sampleSize) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        samples.push_back(record->data.releaseToBson().getOwned());
+    }
+    if (samples.empty()) {
+        return {ErrorCodes::IllegalOperation,
+                str::stream() << "Cannot train a compression dictionary for " << ns()
+                              << " because it is empty"};
+    }
+
+    auto dictionary = WiredTigerDictionaryCompressors::trainDictionary(
+        samples, WiredTigerDictionaryCompressors::kMaxDictionarySize);
+    if (dictionary.empty()) {
+        return {ErrorCodes::IllegalOperation,
+                str::stream() << "The documents sampled from " << ns()
+                              << " have nothing in common to train a compression dictionary with"};
+    }
+
+    const auto dictionarySize = dictionary.size();
+    auto version = _kvEngine->getDictionaryCompressors()->addDictionary(compressorName,
+                                                                        std::move(dictionary));
+    if (!version.isOK()) {
+        return version.getStatus();
+    }
+
+    result->append("version", version.getValue());
+    result->append("size", static_cast<long long>(dictionarySize));
+    result->append("sampledDocuments", static_cast<long long>(samples.size()));
+    return Status::OK();
+}
+
 boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
     OperationContext* opCtx, const RecordId& startingPosition) const {
     dassert(opCtx->lockState()->isReadLocked());
@@ -1672,9 +1898,7 @@ boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
     if (!_isOplog)
         return boost::none;
 
-    if (_isOplog) {
-        WiredTigerRecoveryUnit::get(opCtx)->setIsOplogReader();
-    }
+    WiredTigerRecoveryUnit::get(opCtx)->setIsOplogReader();
 
     WiredTigerCursor cursor(_uri, _tableId, true, opCtx);
     WT_CURSOR* c = cursor.get();
@@ -107,6 +107,7 @@ public:
         std::string uri;
         std::string engineName;
         bool isCapped;
+        bool isClustered = false;
         bool isEphemeral;
         int64_t cappedMaxSize;
         int64_t cappedMaxDocs;
@@ -132,6 +133,14 @@ public:
 
     virtual bool isCapped() const;
 
+    bool isClustered() const final;
+
+    RecordId seekClusteredId(OperationContext* opCtx,
+                             const BSONElement& id,
+                             bool forward) const final;
+
+    RecordId findClusteredId(OperationContext* opCtx, const BSONElement& id) const final;
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = NULL,
                                 int infoLevel = 0) const;
@@ -233,6 +242,12 @@ public:
 
     void waitForAllEarlierOplogWritesToBeVisible(OperationContext* opCtx) const override;
 
+    void notifyCappedWaiterArrived() const override;
+
+    Status trainCompressionDictionary(OperationContext* opCtx,
+                                      long long sampleSize,
+                                      BSONObjBuilder* result) override;
+
     Status updateCappedSize(OperationContext* opCtx, long long cappedSize) final;
 
     void setCappedCallback(CappedCallback* cb) {
@@ -318,6 +333,31 @@ private:
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
+    /**
+     * The slots examined for a key of a clustered record store, see clustered_record_id.h. Either
+     * RecordId is null if there is no such record or slot.
+     */
+    struct ClusteredProbe {
+        RecordId found;      // The record of the key.
+        RecordId firstFree;  // The first free slot, unless the key was found.
+    };
+
+    /**
+     * Clustered record stores only. Examines the slots in which the document with the given key
+     * may be stored, using the table cursor 'c'.
+     */
+    ClusteredProbe _probeClusteredKey(OperationContext* opCtx,
+                                      WT_CURSOR* c,
+                                      const std::string& key) const;
+
+    /**
+     * Clustered record stores only. Returns the RecordId under which to insert the document in
+     * 'data', or DuplicateKey if there already is a document with its _id.
+     */
+    StatusWith<RecordId> _clusteredRecordIdForInsert(OperationContext* opCtx,
+                                                     WT_CURSOR* c,
+                                                     const RecordData& data);
+
 
     /**
      * Initialize the largest known RecordId if it is not already. This is designed to be called
@@ -360,6 +400,8 @@ private:
     const bool _isLogged;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if records are keyed by RecordIds derived from their document's _id.
+    const bool _isClustered;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
@@ -381,7 +381,10 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
             // We only need to update oplog visibility where commits can be out-of-order with
             // respect to their assigned optime and such commits might otherwise be visible.
             // This should happen only on primary nodes.
-            _oplogManager->triggerJournalFlush();
+            // A rolled back transaction has nothing which needs to become visible.
+            const Timestamp newestTimestamp =
+                commit ? _lastTimestampSet.value_or(_commitTimestamp) : Timestamp();
+            _oplogManager->triggerJournalFlush(newestTimestamp);
         }
         _isTimestamped = false;
     }
@@ -87,6 +87,9 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
                           Timestamp(_engine->getOplogManager()->getOplogReadTimestamp()));
+
+        BSONObjBuilder latency(subsection.subobjStart("commit to visible latency"));
+        _engine->getOplogManager()->appendVisibilityLatencyStats(&latency);
     }
 
     return bob.obj();
@@ -36,6 +36,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -204,14 +206,39 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+// Upper bound on the number of session cache partitions. Beyond this point the partitions are
+// contended by so few threads that adding more only makes the cross-partition scans in
+// getSession() and closeAll() slower.
+const size_t kMaxSessionCachePartitions = 64;
+
+size_t numSessionCachePartitions() {
+    const size_t numCores = stdx::thread::hardware_concurrency();
+    return std::max(size_t(1), std::min(numCores, kMaxSessionCachePartitions));
+}
+
+// Threads are assigned partitions round-robin on their first use of any session cache, so that
+// concurrently active threads are spread evenly across the partitions.
+AtomicUInt32 nextPartitionAssignment;
+thread_local uint32_t threadPartitionAssignment = 0;
+thread_local bool threadPartitionAssigned = false;
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
-      _shuttingDown(0) {}
+      _shuttingDown(0),
+      _partitions(numSessionCachePartitions()) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
-    : _engine(NULL), _conn(conn), _clockSource(cs), _shuttingDown(0) {}
+    : _engine(NULL),
+      _conn(conn),
+      _clockSource(cs),
+      _shuttingDown(0),
+      _partitions(numSessionCachePartitions()) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -335,25 +362,69 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
-    }
+    _forEachIdleSession([&](WiredTigerSession* session) { session->closeAllCursors(uri); });
 }
 
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    _forEachIdleSession(
+        [&](WiredTigerSession* session) { session->closeCursorsForQueuedDrops(_engine); });
+}
+
+void WiredTigerSessionCache::_forEachIdleSession(
+    const stdx::function<void(WiredTigerSession*)>& func) {
+    // Like releaseSession(), hold off shutdown while the sessions are out of the cache.
+    const int shuttingDown = _shuttingDown.fetchAndAdd(1);
+    ON_BLOCK_EXIT([this] { _shuttingDown.fetchAndSubtract(1); });
+    if (shuttingDown & kShuttingDownMask) {
+        return;
+    }
+
+    // Another caller must not miss the sessions this one has taken out of the cache.
+    stdx::lock_guard<stdx::mutex> idleSessionsLk(_forEachIdleSessionMutex);
+    for (auto& partition : _partitions) {
+        // Closing cursors can take a while, so the sessions are taken out of the partition rather
+        // than have other threads spin on its lock meanwhile. Those threads take their sessions
+        // from other partitions or open new ones.
+        SessionCache sessions;
+        {
+            stdx::lock_guard<SpinLock> lock(partition.lock);
+            sessions.swap(partition.sessions);
+        }
+
+        for (auto session : sessions) {
+            func(session);
+        }
+
+        SessionCache sessionsToClose;
+        {
+            stdx::lock_guard<SpinLock> lock(partition.lock);
+            // Put the sessions back ahead of those released meanwhile, as they have been idle
+            // longer, unless closeAll() has run since they were taken out.
+            const auto currentEpoch = _epoch.load();
+            auto keep = std::stable_partition(
+                sessions.begin(), sessions.end(), [&](WiredTigerSession* session) {
+                    return session->_getEpoch() == currentEpoch;
+                });
+            sessionsToClose.assign(keep, sessions.end());
+            partition.sessions.insert(partition.sessions.begin(), sessions.begin(), keep);
+        }
+
+        for (auto session : sessionsToClose) {
+            delete session;
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<SpinLock> lock(partition.lock);
+        count += partition.sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -365,14 +436,14 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<SpinLock> lock(partition.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
@@ -380,8 +451,8 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
         }
     }
 
-    // Closing expired idle sessions is expensive, so do it outside of the cache mutex. This helps
-    // to avoid periodic operation latency spikes as seen in SERVER-52879.
+    // Closing expired idle sessions is expensive, so do it outside of the partition locks. This
+    // helps to avoid periodic operation latency spikes as seen in SERVER-52879.
     for (auto session : sessionsToClose) {
         delete session;
     }
@@ -389,12 +460,16 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 
 void WiredTigerSessionCache::closeAll() {
     // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // The epoch must be bumped before any partition is emptied, so that a concurrent
+    // releaseSession() either sees the new epoch when it rechecks under its partition lock, or
+    // pushes its session before we take that lock and it is swapped out below.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<SpinLock> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -411,20 +486,24 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Start with this thread's own partition, and only steal from the others when it is empty.
+    const size_t numPartitions = _partitions.size();
+    const size_t home = _getPartitionIndex();
+    for (size_t i = 0; i < numPartitions; ++i) {
+        auto& partition = _partitions[(home + i) % numPartitions];
+        stdx::lock_guard<SpinLock> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
-    // Outside of the cache partition lock, but on release will be put back on the cache
+    // Outside of the cache partition locks, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -479,10 +558,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        auto& partition = _partitions[_getPartitionIndex()];
+        stdx::lock_guard<SpinLock> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -495,6 +575,14 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+size_t WiredTigerSessionCache::_getPartitionIndex() const {
+    if (!threadPartitionAssigned) {
+        threadPartitionAssignment = nextPartitionAssignment.fetchAndAdd(1);
+        threadPartitionAssigned = true;
+    }
+    return threadPartitionAssignment % _partitions.size();
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<stdx::mutex> lk(_journalListenerMutex);
     _journalListener = jl;
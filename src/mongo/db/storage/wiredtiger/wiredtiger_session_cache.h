@@ -32,16 +32,20 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -291,9 +295,35 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    /**
+     * A free list of idle sessions. The cache is split into several of these so that threads
+     * running on different cores do not all serialize on a single lock to get and release their
+     * sessions. Each thread prefers the partition it was assigned on first use, and only looks
+     * at the other partitions when its own is empty.
+     */
+    struct SessionCachePartition {
+        SpinLock lock;
+        SessionCache sessions;
+    };
+    using CacheAlignedPartition = CacheAligned<SessionCachePartition>;
+
+    /**
+     * Returns the index of the partition preferred by the calling thread.
+     */
+    size_t _getPartitionIndex() const;
+
+    /**
+     * Calls 'func' on each cached session, outside of the partition locks.
+     */
+    void _forEachIdleSession(const stdx::function<void(WiredTigerSession*)>& func);
+
+    std::vector<CacheAlignedPartition, boost::alignment::aligned_allocator<CacheAlignedPartition>>
+        _partitions;
+
+    // Serializes calls to _forEachIdleSession().
+    stdx::mutex _forEachIdleSessionMutex;
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
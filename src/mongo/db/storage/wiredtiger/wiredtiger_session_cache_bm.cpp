@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/system_clock_source.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads to use for session cache perf
+
+class WiredTigerSessionCacheTest : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        if (state.thread_index == 0) {
+            _dbpath = stdx::make_unique<unittest::TempDir>("wt_session_cache_bm");
+            _clockSource = stdx::make_unique<SystemClockSource>();
+            invariantWTOK(wiredtiger_open(
+                _dbpath->path().c_str(), nullptr, "create,cache_size=50M,", &_conn));
+            sessionCache = stdx::make_unique<WiredTigerSessionCache>(_conn, _clockSource.get());
+        }
+    }
+
+    void TearDown(benchmark::State& state) override {
+        if (state.thread_index == 0) {
+            sessionCache.reset();
+            invariantWTOK(_conn->close(_conn, nullptr));
+            _conn = nullptr;
+            _clockSource.reset();
+            _dbpath.reset();
+        }
+    }
+
+protected:
+    std::unique_ptr<WiredTigerSessionCache> sessionCache;
+
+private:
+    std::unique_ptr<unittest::TempDir> _dbpath;
+    std::unique_ptr<ClockSource> _clockSource;
+    WT_CONNECTION* _conn = nullptr;
+};
+
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSession)
+(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        benchmark::DoNotOptimize(session.get());
+    }
+}
+
+// Models an operation which holds a session while a nested unit of work, such as the size storer
+// flush, briefly acquires a second one.
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetAndReleaseNestedSessions)
+(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        UniqueWiredTigerSession outer = sessionCache->getSession();
+        UniqueWiredTigerSession inner = sessionCache->getSession();
+        benchmark::DoNotOptimize(inner.get());
+    }
+}
+
+// Measures the cost of the session cache when another thread periodically invalidates all cached
+// sessions, as happens on every closeAll() during rollback or repair.
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSessionWithCloseAll)
+(benchmark::State& state) {
+    int iterations = 0;
+    for (auto keepRunning : state) {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        benchmark::DoNotOptimize(session.get());
+        if (state.thread_index == 0 && ++iterations % 1000 == 0) {
+            session.reset();
+            sessionCache->closeAll();
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSession)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetAndReleaseNestedSessions)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetAndReleaseSessionWithCloseAll)
+    ->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -116,4 +117,42 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, CloseAllDiscardsSessionsReleasedByAllThreads) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Sessions released by different threads may be cached in different partitions, but are all
+    // visible to the idle session count and reusable by any thread.
+    const size_t kNumThreads = 8;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] { sessionCache->getSession(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const size_t numIdle = sessionCache->getIdleSessionsCount();
+    ASSERT_GTE(numIdle, 1U);
+    ASSERT_LTE(numIdle, kNumThreads);
+
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numIdle; ++i) {
+            sessions.push_back(sessionCache->getSession());
+        }
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numIdle);
+
+    // Sessions acquired before closeAll() are not returned to the cache on release.
+    UniqueWiredTigerSession outstanding = sessionCache->getSession();
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    outstanding.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    sessionCache->getSession();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+}
+
 }  // namespace mongo
@@ -578,7 +578,40 @@ bool WiredTigerUtil::useTableLogging(NamespaceString ns, bool replEnabled) {
     return true;
 }
 
+namespace {
+std::string tableLoggingSetting(bool on) {
+    return on ? "log=(enabled=true)" : "log=(enabled=false)";
+}
+
+/**
+ * Does some "weak" parsing of a table's creation metadata to see if the table is already in the
+ * expected logging state.
+ */
+bool hasTableLoggingSetting(const std::string& uri, const std::string& existingMetadata, bool on) {
+    if (existingMetadata.find("log=(enabled=true)") != std::string::npos &&
+        existingMetadata.find("log=(enabled=false)") != std::string::npos) {
+        // Sanity check against a table having multiple logging specifications.
+        invariant(false,
+                  str::stream() << "Table has contradictory logging settings. Uri: " << uri
+                                << " Conf: "
+                                << existingMetadata);
+    }
+
+    return existingMetadata.find(tableLoggingSetting(on)) != std::string::npos;
+}
+}  // namespace
+
 Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::string& uri, bool on) {
+    // Almost every table already has the expected setting. Check it through the caller's cached
+    // metadata cursor first, so that the cursor sweep and the dedicated session below are only
+    // paid for tables which actually have to be altered. This is called for every collection and
+    // index when the catalog is loaded at startup.
+    _noteTableLoggingCheck();
+    auto existingMetadata = getMetadataCreate(opCtx, uri);
+    if (existingMetadata.isOK() && hasTableLoggingSetting(uri, existingMetadata.getValue(), on)) {
+        return Status::OK();
+    }
+
     // Try to close as much as possible to avoid EBUSY errors.
     WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
     WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
@@ -590,43 +623,21 @@ Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::strin
 }
 
 Status WiredTigerUtil::setTableLogging(WT_SESSION* session, const std::string& uri, bool on) {
-    {
-        stdx::lock_guard<stdx::mutex> lk(_tableLoggingInfoMutex);
-        if (_tableLoggingInfo.isFirstTable && _tableLoggingInfo.isInitializing) {
-            log() << "Starting to check the table logging settings for existing WiredTiger tables";
-            _tableLoggingInfo.isFirstTable = false;
-        }
-    }
-
-    std::string setting;
-    if (on) {
-        setting = "log=(enabled=true)";
-    } else {
-        setting = "log=(enabled=false)";
-    }
+    _noteTableLoggingCheck();
 
-    // This method does some "weak" parsing to see if the table is in the expected logging
-    // state. Only attempt to alter the table when a change is needed. This avoids grabbing heavy
-    // locks in WT when creating new tables for collections and indexes. Those tables are created
-    // with the proper settings and consequently should not be getting changed here.
+    // Only attempt to alter the table when a change is needed. This avoids grabbing heavy locks in
+    // WT when creating new tables for collections and indexes. Those tables are created with the
+    // proper settings and consequently should not be getting changed here.
     //
     // If the settings need to be changed (only expected at startup), the alter table call must
     // succeed.
     std::string existingMetadata = getMetadataCreate(session, uri).getValue();
-    if (existingMetadata.find("log=(enabled=true)") != std::string::npos &&
-        existingMetadata.find("log=(enabled=false)") != std::string::npos) {
-        // Sanity check against a table having multiple logging specifications.
-        invariant(false,
-                  str::stream() << "Table has contradictory logging settings. Uri: " << uri
-                                << " Conf: "
-                                << existingMetadata);
-    }
-
-    if (existingMetadata.find(setting) != std::string::npos) {
+    if (hasTableLoggingSetting(uri, existingMetadata, on)) {
         // The table is running with the expected logging settings.
         return Status::OK();
     }
 
+    const std::string setting = tableLoggingSetting(on);
     LOG(1) << "Changing table logging settings. Uri: " << uri << " Enable? " << on;
     int ret = session->alter(session, uri.c_str(), setting.c_str());
     if (ret) {
@@ -639,6 +650,14 @@ Status WiredTigerUtil::setTableLogging(WT_SESSION* session, const std::string& u
     return Status::OK();
 }
 
+void WiredTigerUtil::_noteTableLoggingCheck() {
+    stdx::lock_guard<stdx::mutex> lk(_tableLoggingInfoMutex);
+    if (_tableLoggingInfo.isFirstTable && _tableLoggingInfo.isInitializing) {
+        log() << "Starting to check the table logging settings for existing WiredTiger tables";
+        _tableLoggingInfo.isFirstTable = false;
+    }
+}
+
 Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
                                          const std::string& uri,
                                          const std::string& config,
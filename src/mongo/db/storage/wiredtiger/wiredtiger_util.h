@@ -278,6 +278,12 @@ private:
     template <typename T>
     static T _castStatisticsValue(uint64_t statisticsValue, T maximumResultType);
 
+    /**
+     * Logs once, during startup, that the table logging settings of existing tables are being
+     * checked.
+     */
+    static void _noteTableLoggingCheck();
+
     static stdx::mutex _tableLoggingInfoMutex;
     static struct TableLoggingInfo {
         bool isInitializing = true;
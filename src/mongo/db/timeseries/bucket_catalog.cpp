@@ -0,0 +1,261 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+#include <cstring>
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/bucket_format.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const auto getBucketCatalog = ServiceContext::declareDecoration<BucketCatalog>();
+
+// A bucket is closed once it holds this many measurements, or once the measurements written to it
+// add up to this many bytes. Together they keep bucket documents, and the updates which append to
+// them, well below the maximum document size.
+MONGO_EXPORT_SERVER_PARAMETER(timeseriesBucketMaxCount, int, 1000);
+MONGO_EXPORT_SERVER_PARAMETER(timeseriesBucketMaxSizeBytes, int, 125 * 1024);
+
+// The start of a bucket's time range is kept in the timestamp of its _id, which holds an unsigned
+// number of seconds since the epoch.
+const long long kMaxBucketStartSeconds = std::numeric_limits<uint32_t>::max();
+
+}  // namespace
+
+MONGO_EXPORT_SERVER_PARAMETER(timeseriesMaxOpenBuckets, int, 100 * 1000)
+    ->withValidator([](const int& potentialNewValue) {
+        if (potentialNewValue < 1) {
+            return Status(ErrorCodes::BadValue, "timeseriesMaxOpenBuckets must be at least 1");
+        }
+        return Status::OK();
+    });
+
+bool BucketCatalog::BucketKey::operator<(const BucketKey& other) const {
+    if (ns != other.ns) {
+        return ns < other.ns;
+    }
+
+    // Meta values are compared byte-wise so that, for example, the values 1 and 1.0 end up in
+    // different buckets and each measurement reads back with the meta value it was written with.
+    if (meta.objsize() != other.meta.objsize()) {
+        return meta.objsize() < other.meta.objsize();
+    }
+    return std::memcmp(meta.objdata(), other.meta.objdata(), meta.objsize()) < 0;
+}
+
+BucketCatalog& BucketCatalog::get(ServiceContext* svcCtx) {
+    return getBucketCatalog(svcCtx);
+}
+
+BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+BSONObj BucketCatalog::makeBucketUpdate(
+    const TimeseriesOptions& options,
+    const std::vector<std::pair<BSONObj, Placement>>& measurements) {
+    invariant(!measurements.empty());
+
+    const std::string dataPrefix = timeseries::kBucketDataFieldName + ".";
+    Date_t minTime = Date_t::max();
+    Date_t maxTime = Date_t::min();
+    BSONElement metaElem;
+
+    BSONObjBuilder builder;
+    {
+        BSONObjBuilder set(builder.subobjStart("$set"));
+        for (auto&& measurement : measurements) {
+            const auto& placement = measurement.second;
+            const std::string indexSuffix = "." + std::to_string(placement.index);
+
+            for (auto&& elem : measurement.first) {
+                auto fieldName = elem.fieldNameStringData();
+                const std::string path = dataPrefix + fieldName + indexSuffix;
+                if (fieldName == options.timeField) {
+                    minTime = std::min(minTime, elem.date());
+                    maxTime = std::max(maxTime, elem.date());
+                    // Most buckets span at most a few hours, so the offsets fit in 32 bits.
+                    if (placement.timeOffsetMillis <= std::numeric_limits<int>::max()) {
+                        set.append(path, static_cast<int>(placement.timeOffsetMillis));
+                    } else {
+                        set.append(path, placement.timeOffsetMillis);
+                    }
+                } else if (options.metaField && fieldName == *options.metaField) {
+                    metaElem = elem;
+                } else {
+                    set.appendAs(elem, path);
+                }
+            }
+        }
+    }
+    {
+        BSONObjBuilder setOnInsert(builder.subobjStart("$setOnInsert"));
+        setOnInsert.append(
+            timeseries::kBucketControlFieldName + "." + timeseries::kControlVersionFieldName,
+            timeseries::kBucketVersion);
+        if (!metaElem.eoo()) {
+            setOnInsert.appendAs(metaElem, timeseries::kBucketMetaFieldName);
+        }
+    }
+
+    const std::string controlPrefix = timeseries::kBucketControlFieldName + ".";
+    builder.append("$min",
+                   BSON(controlPrefix + timeseries::kControlMinFieldName + "." + options.timeField
+                        << minTime));
+    builder.append("$max",
+                   BSON(controlPrefix + timeseries::kControlMaxFieldName + "." + options.timeField
+                        << maxTime));
+    builder.append("$inc",
+                   BSON(controlPrefix + timeseries::kControlCountFieldName
+                        << static_cast<int>(measurements.size())));
+    return builder.obj();
+}
+
+StatusWith<BucketCatalog::Placement> BucketCatalog::insert(const NamespaceString& bucketsNs,
+                                                           const TimeseriesOptions& options,
+                                                           const BSONObj& measurement) {
+    BSONElement timeElem;
+    BSONElement metaElem;
+    for (auto&& elem : measurement) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName.startsWith("$") || fieldName.find('.') != std::string::npos) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Field name '" << fieldName
+                                  << "' is not allowed in a time-series measurement"};
+        }
+        if (fieldName == options.timeField) {
+            timeElem = elem;
+        } else if (options.metaField && fieldName == *options.metaField) {
+            metaElem = elem;
+        }
+    }
+
+    if (timeElem.type() != BSONType::Date) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << options.timeField
+                              << "' must be present and contain a valid BSON UTC datetime value"};
+    }
+    const auto time = timeElem.date();
+    const long long timeSeconds = durationCount<Seconds>(time.toDurationSinceEpoch());
+    if (time < Date_t() || timeSeconds > kMaxBucketStartSeconds) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << options.timeField << "' must be between "
+                              << dateToISOStringUTC(Date_t())
+                              << " and "
+                              << dateToISOStringUTC(Date_t::fromMillisSinceEpoch(
+                                     kMaxBucketStartSeconds * 1000))
+                              << ", found: "
+                              << dateToISOStringUTC(time)};
+    }
+
+    BucketKey key{bucketsNs, metaElem.eoo() ? BSONObj() : metaElem.wrap("")};
+    const int size = measurement.objsize() - key.meta.objsize();
+    const Milliseconds maxSpan = Seconds(options.bucketMaxSpanSeconds);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _openBuckets.find(key);
+    if (it != _openBuckets.end()) {
+        const auto& bucket = it->second;
+        if (time < bucket.start || time - bucket.start >= maxSpan ||
+            bucket.numMeasurements >= timeseriesBucketMaxCount.load() ||
+            bucket.size + size > timeseriesBucketMaxSizeBytes.load()) {
+            _close_inlock(it);
+            it = _openBuckets.end();
+        }
+    }
+
+    if (it == _openBuckets.end()) {
+        const size_t maxOpenBuckets = timeseriesMaxOpenBuckets.load();
+        while (!_lru.empty() && _openBuckets.size() >= maxOpenBuckets) {
+            _close_inlock(_openBuckets.find(_lru.back()));
+        }
+
+        Bucket bucket;
+        bucket.id = OID::gen();
+        bucket.id.setTimestamp(static_cast<OID::Timestamp>(static_cast<uint32_t>(timeSeconds)));
+        bucket.start = Date_t::fromMillisSinceEpoch(timeSeconds * 1000);
+        bucket.lruPosition = _lru.insert(_lru.begin(), key);
+        it = _openBuckets.emplace(std::move(key), bucket).first;
+    } else {
+        _lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+    }
+
+    auto& bucket = it->second;
+    Placement placement{
+        bucket.id, bucket.numMeasurements, durationCount<Milliseconds>(time - bucket.start)};
+    ++bucket.numMeasurements;
+    bucket.size += size;
+    return placement;
+}
+
+void BucketCatalog::clear(const NamespaceString& bucketsNs) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _openBuckets.lower_bound({bucketsNs, BSONObj()});
+    while (it != _openBuckets.end() && it->first.ns == bucketsNs) {
+        it = _close_inlock(it);
+    }
+}
+
+size_t BucketCatalog::numOpenBuckets() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _openBuckets.size();
+}
+
+void BucketCatalog::registerBucketsCollection(const NamespaceString& bucketsNs) {
+    stdx::lock_guard<stdx::mutex> lk(_bucketsCollectionsMutex);
+    _timeseriesNamespaces.insert(bucketsNs.getTimeseriesViewNamespace());
+    _hasBucketsCollections.store(true);
+}
+
+bool BucketCatalog::mayBeTimeseriesCollection(const NamespaceString& ns) const {
+    if (!_hasBucketsCollections.load()) {
+        return false;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_bucketsCollectionsMutex);
+    return _timeseriesNamespaces.count(ns) > 0;
+}
+
+std::map<BucketCatalog::BucketKey, BucketCatalog::Bucket>::iterator BucketCatalog::_close_inlock(
+    std::map<BucketKey, Bucket>::iterator it) {
+    _lru.erase(it->second.lruPosition);
+    return _openBuckets.erase(it);
+}
+
+}  // namespace mongo
@@ -0,0 +1,173 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * The maximum number of buckets the BucketCatalog keeps open across all time-series collections.
+ * Beyond it, the least recently used bucket is closed.
+ */
+extern AtomicInt32 timeseriesMaxOpenBuckets;
+
+/**
+ * Tracks the buckets of time-series collections which are still accepting measurements.
+ *
+ * Each measurement inserted into a time-series collection is assigned a slot in the open bucket for
+ * its buckets collection and meta value. A bucket is closed, and a new one opened in its place,
+ * once it is full or a measurement falls outside of its time range. Only the in-memory bookkeeping
+ * lives here: the caller writes each measurement into its assigned slot with an upsert, so slots
+ * assigned to writes which later fail, or buckets forgotten by a restart, a clear() or eviction,
+ * merely leave unused slots behind.
+ *
+ * The catalog is a decoration on the ServiceContext and is safe to use concurrently.
+ */
+class BucketCatalog {
+    MONGO_DISALLOW_COPYING(BucketCatalog);
+
+public:
+    /**
+     * The slot assigned to a measurement.
+     */
+    struct Placement {
+        // The _id of the bucket. Its timestamp is the start of the bucket's time range, to the
+        // second, from which the time of each of its measurements is delta-encoded.
+        OID bucketId;
+
+        // The index of the measurement within the bucket.
+        int index;
+
+        // The time of the measurement, as milliseconds since the start of the bucket.
+        long long timeOffsetMillis;
+    };
+
+    static BucketCatalog& get(ServiceContext* svcCtx);
+    static BucketCatalog& get(OperationContext* opCtx);
+
+    /**
+     * Returns the update which writes each measurement into the slot it was assigned, where all of
+     * the slots belong to the same bucket. The update is applied as an upsert on the bucket's _id,
+     * so that whichever write reaches a bucket first creates it. See bucket_format.h.
+     */
+    static BSONObj makeBucketUpdate(const TimeseriesOptions& options,
+                                    const std::vector<std::pair<BSONObj, Placement>>& measurements);
+
+    BucketCatalog() = default;
+
+    /**
+     * Validates 'measurement' against 'options' and assigns it a slot in an open bucket of the
+     * buckets collection 'bucketsNs', opening a new bucket if needed. Returns BadValue if the
+     * measurement cannot be stored in a bucket.
+     */
+    StatusWith<Placement> insert(const NamespaceString& bucketsNs,
+                                 const TimeseriesOptions& options,
+                                 const BSONObj& measurement);
+
+    /**
+     * Forgets the open buckets of 'bucketsNs', e.g. because the collection was dropped.
+     */
+    void clear(const NamespaceString& bucketsNs);
+
+    /**
+     * Returns the number of buckets currently accepting measurements.
+     */
+    size_t numOpenBuckets() const;
+
+    /**
+     * Records that the buckets collection 'bucketsNs' exists, because it was created or loaded.
+     * Namespaces are not forgotten when their collection is dropped.
+     */
+    void registerBucketsCollection(const NamespaceString& bucketsNs);
+
+    /**
+     * Returns false if 'ns' cannot be a time-series collection, because no buckets collection for
+     * it has existed in this process. Cheap enough to check on every insert, so that inserts into
+     * regular collections need not look for a time-series view.
+     */
+    bool mayBeTimeseriesCollection(const NamespaceString& ns) const;
+
+private:
+    struct BucketKey {
+        bool operator<(const BucketKey& other) const;
+
+        NamespaceString ns;
+
+        // The meta value of the measurements in the bucket, wrapped in an object with an empty
+        // field name, or an empty object if the measurements have no meta value.
+        BSONObj meta;
+    };
+
+    struct Bucket {
+        OID id;
+        Date_t start;
+        int numMeasurements = 0;
+        int size = 0;
+
+        // The bucket's position in '_lru'.
+        std::list<BucketKey>::iterator lruPosition;
+    };
+
+    /**
+     * Forgets the open bucket at 'it'.
+     */
+    std::map<BucketKey, Bucket>::iterator _close_inlock(std::map<BucketKey, Bucket>::iterator it);
+
+    mutable stdx::mutex _mutex;
+    std::map<BucketKey, Bucket> _openBuckets;
+
+    // The keys of the open buckets, most recently used first.
+    std::list<BucketKey> _lru;
+
+    AtomicBool _hasBucketsCollections{false};
+    // The namespaces of the time-series collections whose buckets collections have existed.
+    mutable stdx::mutex _bucketsCollectionsMutex;
+    std::set<NamespaceString> _timeseriesNamespaces;
+};
+
+}  // namespace mongo
@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+class BucketCatalogTest : public unittest::Test {
+protected:
+    BSONObj measurement(long long millis, int meta, int value) {
+        return BSON("t" << Date_t::fromMillisSinceEpoch(millis) << "m" << meta << "v" << value);
+    }
+
+    BucketCatalog::Placement insert(const BSONObj& doc) {
+        return uassertStatusOK(_catalog.insert(_ns, _options, doc));
+    }
+
+    const NamespaceString _ns{"test.system.buckets.weather"};
+    const TimeseriesOptions _options = uassertStatusOK(
+        TimeseriesOptions::parse(BSON("timeField"
+                                      << "t"
+                                      << "metaField"
+                                      << "m"
+                                      << "bucketMaxSpanSeconds"
+                                      << 60)));
+    BucketCatalog _catalog;
+};
+
+TEST_F(BucketCatalogTest, MeasurementsWithTheSameMetaShareABucket) {
+    auto first = insert(measurement(1000500, 1, 10));
+    auto second = insert(measurement(1001500, 1, 11));
+
+    ASSERT_EQ(first.bucketId, second.bucketId);
+    ASSERT_EQ(0, first.index);
+    ASSERT_EQ(1, second.index);
+
+    // The bucket starts at the second of its first measurement.
+    ASSERT_EQ(1000, first.bucketId.getTimestamp());
+    ASSERT_EQ(500, first.timeOffsetMillis);
+    ASSERT_EQ(1500, second.timeOffsetMillis);
+    ASSERT_EQ(1U, _catalog.numOpenBuckets());
+}
+
+TEST_F(BucketCatalogTest, MeasurementsWithDifferentMetaUseDifferentBuckets) {
+    auto first = insert(measurement(1000000, 1, 10));
+    auto second = insert(measurement(1000000, 2, 10));
+    auto third = insert(BSON("t" << Date_t::fromMillisSinceEpoch(1000000) << "m" << 1.0));
+    auto fourth = insert(BSON("t" << Date_t::fromMillisSinceEpoch(1000000)));
+
+    ASSERT_NE(first.bucketId, second.bucketId);
+    ASSERT_NE(first.bucketId, third.bucketId);
+    ASSERT_NE(first.bucketId, fourth.bucketId);
+    ASSERT_EQ(4U, _catalog.numOpenBuckets());
+}
+
+TEST_F(BucketCatalogTest, MeasurementOutsideOfTheTimeRangeOpensANewBucket) {
+    auto first = insert(measurement(1000000, 1, 10));
+    auto later = insert(measurement(1000000 + 60 * 1000, 1, 11));
+    ASSERT_NE(first.bucketId, later.bucketId);
+    ASSERT_EQ(0, later.index);
+
+    auto earlier = insert(measurement(999999, 1, 12));
+    ASSERT_NE(later.bucketId, earlier.bucketId);
+    ASSERT_EQ(999, earlier.bucketId.getTimestamp());
+    ASSERT_EQ(999, earlier.timeOffsetMillis);
+    ASSERT_EQ(1U, _catalog.numOpenBuckets());
+}
+
+TEST_F(BucketCatalogTest, RejectsInvalidMeasurements) {
+    ASSERT_EQ(ErrorCodes::BadValue,
+              _catalog.insert(_ns, _options, BSON("m" << 1)).getStatus().code());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              _catalog.insert(_ns, _options, BSON("t" << 1000 << "m" << 1)).getStatus().code());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              _catalog
+                  .insert(_ns,
+                          _options,
+                          BSON("t" << Date_t::fromMillisSinceEpoch(-1000) << "m" << 1))
+                  .getStatus()
+                  .code());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              _catalog
+                  .insert(_ns,
+                          _options,
+                          BSON("t" << Date_t::fromMillisSinceEpoch(1000) << "a.b" << 1))
+                  .getStatus()
+                  .code());
+    ASSERT_EQ(0U, _catalog.numOpenBuckets());
+}
+
+TEST_F(BucketCatalogTest, ClearForgetsTheBucketsOfOneNamespace) {
+    auto first = insert(measurement(1000000, 1, 10));
+    ASSERT_OK(_catalog
+                  .insert(NamespaceString("test.system.buckets.other"),
+                          _options,
+                          measurement(1000000, 1, 10))
+                  .getStatus());
+    ASSERT_EQ(2U, _catalog.numOpenBuckets());
+
+    _catalog.clear(_ns);
+    ASSERT_EQ(1U, _catalog.numOpenBuckets());
+
+    auto second = insert(measurement(1000000, 1, 10));
+    ASSERT_NE(first.bucketId, second.bucketId);
+    ASSERT_EQ(0, second.index);
+}
+
+TEST_F(BucketCatalogTest, LeastRecentlyUsedBucketIsClosedOverTheLimit) {
+    const int originalMaxOpenBuckets = timeseriesMaxOpenBuckets.load();
+    timeseriesMaxOpenBuckets.store(2);
+    ON_BLOCK_EXIT([&] { timeseriesMaxOpenBuckets.store(originalMaxOpenBuckets); });
+
+    auto first = insert(measurement(1000000, 1, 10));
+    auto second = insert(measurement(1000000, 2, 10));
+    ASSERT_EQ(first.bucketId, insert(measurement(1000000, 1, 11)).bucketId);
+
+    // The bucket for meta 2 was used least recently, so it makes way for the one for meta 3.
+    insert(measurement(1000000, 3, 10));
+    ASSERT_EQ(2U, _catalog.numOpenBuckets());
+    ASSERT_EQ(first.bucketId, insert(measurement(1000000, 1, 12)).bucketId);
+    ASSERT_NE(second.bucketId, insert(measurement(1000000, 2, 11)).bucketId);
+    ASSERT_EQ(2U, _catalog.numOpenBuckets());
+}
+
+TEST_F(BucketCatalogTest, OnlyRegisteredNamespacesMayBeTimeseriesCollections) {
+    ASSERT_FALSE(_catalog.mayBeTimeseriesCollection(NamespaceString("test.weather")));
+
+    _catalog.registerBucketsCollection(_ns);
+    ASSERT_TRUE(_catalog.mayBeTimeseriesCollection(NamespaceString("test.weather")));
+    ASSERT_FALSE(_catalog.mayBeTimeseriesCollection(NamespaceString("test.other")));
+}
+
+TEST_F(BucketCatalogTest, MakeBucketUpdate) {
+    auto first = measurement(1000500, 1, 10);
+    auto second = BSON("t" << Date_t::fromMillisSinceEpoch(1000250) << "m" << 1 << "w"
+                           << "x");
+    auto update = BucketCatalog::makeBucketUpdate(
+        _options, {{first, insert(first)}, {second, insert(second)}});
+
+    ASSERT_BSONOBJ_EQ(BSON("$set" << BSON("data.t.0" << 500 << "data.v.0" << 10 << "data.t.1"
+                                                      << 250
+                                                      << "data.w.1"
+                                                      << "x")
+                                  << "$setOnInsert"
+                                  << BSON("control.version" << 1 << "meta" << 1)
+                                  << "$min"
+                                  << BSON("control.min.t" << Date_t::fromMillisSinceEpoch(1000250))
+                                  << "$max"
+                                  << BSON("control.max.t" << Date_t::fromMillisSinceEpoch(1000500))
+                                  << "$inc"
+                                  << BSON("control.count" << 2)),
+                      update);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * The layout of the documents in the buckets collection of a time-series collection. A bucket
+ * holds the measurements for one meta value, column by column:
+ *
+ *     {
+ *         _id: <ObjectId whose timestamp is the start of the bucket's time range>,
+ *         control: {
+ *             version: 1,
+ *             min: {<timeField>: <earliest time>},
+ *             max: {<timeField>: <latest time>},
+ *             count: <number of measurements>
+ *         },
+ *         meta: <meta value, absent if the measurements have none>,
+ *         data: {
+ *             <timeField>: {"0": <milliseconds since the start>, "1": ..., ...},
+ *             <field>: {"0": <value>, ...},
+ *             ...
+ *         }
+ *     }
+ *
+ * Each column maps the index of a measurement in the bucket to its value, so a column only holds
+ * the measurements which have that field. The time column is delta-encoded against the start of
+ * the bucket. Indexes need not be contiguous, nor appear in order.
+ */
+namespace timeseries {
+
+constexpr int kBucketVersion = 1;
+
+constexpr StringData kBucketIdFieldName = "_id"_sd;
+constexpr StringData kBucketControlFieldName = "control"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+constexpr StringData kBucketDataFieldName = "data"_sd;
+
+constexpr StringData kControlVersionFieldName = "version"_sd;
+constexpr StringData kControlMinFieldName = "min"_sd;
+constexpr StringData kControlMaxFieldName = "max"_sd;
+constexpr StringData kControlCountFieldName = "count"_sd;
+
+}  // namespace timeseries
+}  // namespace mongo
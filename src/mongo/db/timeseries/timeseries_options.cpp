@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/timeseries_options.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+constexpr StringData TimeseriesOptions::kTimeFieldName;
+constexpr StringData TimeseriesOptions::kMetaFieldName;
+constexpr StringData TimeseriesOptions::kBucketMaxSpanSecondsFieldName;
+constexpr int TimeseriesOptions::kDefaultBucketMaxSpanSeconds;
+constexpr int TimeseriesOptions::kMaxBucketMaxSpanSeconds;
+
+namespace {
+
+/**
+ * Measurement fields become the names of the columns of a bucket and are addressed by dotted
+ * paths when a bucket is updated, so they must be plain top-level field names.
+ */
+Status validateFieldName(StringData option, const BSONElement& elem) {
+    if (elem.type() != BSONType::String) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "'timeseries." << option << "' must be a string, found: "
+                              << typeName(elem.type())};
+    }
+
+    auto name = elem.valueStringData();
+    if (name.empty() || name.find('.') != std::string::npos || name.startsWith("$") ||
+        name == "_id") {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'timeseries." << option
+                              << "' must be a non-empty top-level field name other than '_id', "
+                                 "found: '"
+                              << name
+                              << "'"};
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+StatusWith<TimeseriesOptions> TimeseriesOptions::parse(const BSONObj& obj) {
+    TimeseriesOptions options;
+    bool hasTimeField = false;
+
+    for (auto&& elem : obj) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kTimeFieldName) {
+            auto status = validateFieldName(fieldName, elem);
+            if (!status.isOK()) {
+                return status;
+            }
+            options.timeField = elem.str();
+            hasTimeField = true;
+        } else if (fieldName == kMetaFieldName) {
+            auto status = validateFieldName(fieldName, elem);
+            if (!status.isOK()) {
+                return status;
+            }
+            options.metaField = elem.str();
+        } else if (fieldName == kBucketMaxSpanSecondsFieldName) {
+            if (!elem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "'timeseries." << fieldName
+                                      << "' must be a number, found: "
+                                      << typeName(elem.type())};
+            }
+            const long long span = elem.safeNumberLong();
+            if (span != elem.numberDouble() || span < 1 || span > kMaxBucketMaxSpanSeconds) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "'timeseries." << fieldName
+                                      << "' must be an integer between 1 and "
+                                      << kMaxBucketMaxSpanSeconds
+                                      << ", found: "
+                                      << elem};
+            }
+            options.bucketMaxSpanSeconds = static_cast<int>(span);
+        } else {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "'" << fieldName
+                                  << "' is not a valid time-series option. Options: "
+                                  << obj};
+        }
+    }
+
+    if (!hasTimeField) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "time-series options must specify '" << kTimeFieldName << "'"};
+    }
+    if (options.metaField == options.timeField) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << "'" << kMetaFieldName << "' and '" << kTimeFieldName
+                              << "' must be different fields"};
+    }
+
+    return options;
+}
+
+BSONObj TimeseriesOptions::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append(kTimeFieldName, timeField);
+    if (metaField) {
+        builder.append(kMetaFieldName, *metaField);
+    }
+    builder.append(kBucketMaxSpanSecondsFieldName, bucketMaxSpanSeconds);
+    return builder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * The options of a time-series collection, given as the 'timeseries' collection option:
+ *
+ *     {timeField: <string>, metaField: <string>, bucketMaxSpanSeconds: <int>}
+ *
+ * Measurements are grouped into buckets by the value of their 'metaField'. A bucket only holds
+ * measurements whose 'timeField' lies within 'bucketMaxSpanSeconds' of the first measurement
+ * written to it.
+ */
+struct TimeseriesOptions {
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+    static constexpr StringData kBucketMaxSpanSecondsFieldName = "bucketMaxSpanSeconds"_sd;
+
+    static constexpr int kDefaultBucketMaxSpanSeconds = 60 * 60;
+    static constexpr int kMaxBucketMaxSpanSeconds = 365 * 24 * 60 * 60;
+
+    /**
+     * Parses and validates the 'timeseries' collection option.
+     */
+    static StatusWith<TimeseriesOptions> parse(const BSONObj& obj);
+
+    /**
+     * Returns the options with all defaults filled in, as stored in the catalog.
+     */
+    BSONObj toBSON() const;
+
+    std::string timeField;
+    boost::optional<std::string> metaField;
+    int bucketMaxSpanSeconds = kDefaultBucketMaxSpanSeconds;
+};
+
+}  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
@@ -306,6 +307,73 @@ public:
     }
 };
 
+/**
+ * Test that a multi-delete with batching enabled stages documents from its child and deletes them
+ * a full batch at a time.
+ */
+class QueryStageDeleteBatched : public QueryStageDeleteBase {
+public:
+    QueryStageDeleteBatched() : _oldBatchMaxDocs(internalQueryExecWriteBatchMaxDocs.load()) {
+        internalQueryExecWriteBatchMaxDocs.store(kBatchMaxDocs);
+    }
+
+    ~QueryStageDeleteBatched() {
+        internalQueryExecWriteBatchMaxDocs.store(_oldBatchMaxDocs);
+    }
+
+    void run() {
+        // Batching is only used by storage engines which support document-level locking.
+        if (!supportsDocLocking()) {
+            return;
+        }
+
+        OldClientWriteContext ctx(&_opCtx, nss.ns());
+        Collection* coll = ctx.getCollection();
+
+        // Configure the scan.
+        CollectionScanParams collScanParams;
+        collScanParams.collection = coll;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        // Configure the delete stage.
+        DeleteStageParams deleteStageParams;
+        deleteStageParams.isMulti = true;
+
+        WorkingSet ws;
+        DeleteStage deleteStage(&_opCtx,
+                                deleteStageParams,
+                                &ws,
+                                coll,
+                                new CollectionScan(&_opCtx, collScanParams, &ws, NULL));
+
+        const DeleteStats* stats = static_cast<const DeleteStats*>(deleteStage.getSpecificStats());
+
+        // Nothing is deleted until a full batch has been staged.
+        while (stats->docsDeleted == 0) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = deleteStage.work(&id);
+            ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+        }
+        ASSERT_EQUALS(static_cast<size_t>(kBatchMaxDocs), stats->docsDeleted);
+        ASSERT_EQUALS(numObj() - kBatchMaxDocs, static_cast<size_t>(coll->numRecords(&_opCtx)));
+
+        // Delete the rest, including the final partial batch.
+        while (!deleteStage.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = deleteStage.work(&id);
+            ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        ASSERT_EQUALS(numObj(), stats->docsDeleted);
+        ASSERT_EQUALS(0, coll->numRecords(&_opCtx));
+    }
+
+private:
+    static const int kBatchMaxDocs = 7;
+
+    const int _oldBatchMaxDocs;
+};
 
 class All : public Suite {
 public:
@@ -316,6 +384,7 @@ public:
         add<QueryStageDeleteInvalidateUpcomingObject>();
         add<QueryStageDeleteReturnOldDoc>();
         add<QueryStageDeleteSkipOwnedObjects>();
+        add<QueryStageDeleteBatched>();
     }
 };
 
@@ -51,6 +51,7 @@
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/update/update_driver.h"
 #include "mongo/dbtests/dbtests.h"
@@ -598,6 +599,87 @@ public:
     }
 };
 
+/**
+ * Test that a multi-update with batching enabled updates every matching document, including those
+ * in a final partial batch.
+ */
+class QueryStageUpdateBatched : public QueryStageUpdateBase {
+public:
+    QueryStageUpdateBatched() : _oldBatchMaxDocs(internalQueryExecWriteBatchMaxDocs.load()) {
+        internalQueryExecWriteBatchMaxDocs.store(3);
+    }
+
+    ~QueryStageUpdateBatched() {
+        internalQueryExecWriteBatchMaxDocs.store(_oldBatchMaxDocs);
+    }
+
+    void run() {
+        // Run the update.
+        {
+            OldClientWriteContext ctx(&_opCtx, nss.ns());
+
+            // Populate the collection.
+            for (int i = 0; i < 10; ++i) {
+                insert(BSON("_id" << i << "foo" << i));
+            }
+            ASSERT_EQUALS(10U, count(BSONObj()));
+
+            CurOp& curOp = *CurOp::get(_opCtx);
+            OpDebug* opDebug = &curOp.debug();
+            const CollatorInterface* collator = nullptr;
+            UpdateDriver driver(new ExpressionContext(&_opCtx, collator));
+            Collection* coll = ctx.getCollection();
+
+            UpdateRequest request(nss);
+            UpdateLifecycleImpl updateLifecycle(nss);
+            request.setLifecycle(&updateLifecycle);
+
+            // Update is a multi-update that increments 'foo' in every document where foo is less
+            // than 8.
+            BSONObj query = fromjson("{foo: {$lt: 8}}");
+            BSONObj updates = fromjson("{$inc: {foo: 100}}");
+
+            request.setMulti();
+            request.setQuery(query);
+            request.setUpdates(updates);
+
+            ASSERT_OK(driver.parse(request.getUpdates(), {}, request.isMulti()));
+
+            // Configure the scan.
+            CollectionScanParams collScanParams;
+            collScanParams.collection = coll;
+            collScanParams.direction = CollectionScanParams::FORWARD;
+            collScanParams.tailable = false;
+
+            // Configure the update.
+            UpdateStageParams updateParams(&request, &driver, opDebug);
+            unique_ptr<CanonicalQuery> cq(canonicalize(query));
+            updateParams.canonicalQuery = cq.get();
+
+            auto ws = make_unique<WorkingSet>();
+            auto cs = make_unique<CollectionScan>(&_opCtx, collScanParams, ws.get(), cq->root());
+
+            auto updateStage =
+                make_unique<UpdateStage>(&_opCtx, updateParams, ws.get(), coll, cs.release());
+
+            runUpdate(updateStage.get());
+
+            const UpdateStats* stats =
+                static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+            ASSERT_EQUALS(8U, stats->nModified);
+            ASSERT_EQUALS(8U, stats->nMatched);
+        }
+
+        // Every matching document was updated exactly once.
+        ASSERT_EQUALS(8U, count(fromjson("{foo: {$gte: 100}}")));
+        ASSERT_EQUALS(0U, count(fromjson("{foo: {$gte: 200}}")));
+        ASSERT_EQUALS(2U, count(fromjson("{foo: {$lt: 100}}")));
+    }
+
+private:
+    const int _oldBatchMaxDocs;
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_update") {}
@@ -609,6 +691,7 @@ public:
         add<QueryStageUpdateReturnOldDoc>();
         add<QueryStageUpdateReturnNewDoc>();
         add<QueryStageUpdateSkipOwnedObjects>();
+        add<QueryStageUpdateBatched>();
     }
 };
 
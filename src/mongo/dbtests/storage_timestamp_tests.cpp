@@ -795,6 +795,84 @@ public:
     }
 };
 
+class PrimaryBatchedDeleteTimes : public StorageTimestampTest {
+public:
+    void run() {
+        // Only run on 'wiredTiger'. No other storage engines to-date timestamp writes.
+        if (!(mongo::storageGlobalParams.engine == "wiredTiger" &&
+              mongo::serverGlobalParams.enableMajorityReadConcern)) {
+            return;
+        }
+
+        NamespaceString nss("unittests.timestampedBatchedDeletes");
+        reset(nss);
+
+        AutoGetCollection autoColl(_opCtx, nss, LockMode::MODE_X, LockMode::MODE_IX);
+
+        // Insert some documents.
+        const std::int32_t docsToInsert = 10;
+        {
+            repl::UnreplicatedWritesBlock uwb(_opCtx);
+            const LogicalTime firstInsertTime = _clock->reserveTicks(docsToInsert);
+            WriteUnitOfWork wunit(_opCtx);
+            for (std::int32_t num = 0; num < docsToInsert; ++num) {
+                insertDocument(autoColl.getCollection(),
+                               InsertStatement(BSON("_id" << num << "a" << num),
+                                               firstInsertTime.addTicks(num).asTimestamp(),
+                                               0LL));
+            }
+            wunit.commit();
+        }
+
+        std::vector<RecordId> recordIds;
+        auto cursor = autoColl.getCollection()->getRecordStore()->getCursor(_opCtx);
+        while (auto record = cursor->next()) {
+            recordIds.push_back(record->id);
+        }
+        cursor.reset();
+        ASSERT_EQ(docsToInsert, static_cast<std::int32_t>(recordIds.size()));
+
+        // Delete all documents in one WriteUnitOfWork, the way a batched multi-delete does.
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            repl::OplogBatch oplogBatch(_opCtx, nss, recordIds.size());
+            for (const auto& recordId : recordIds) {
+                oplogBatch.prepareForNextWrite();
+                autoColl.getCollection()->deleteDocument(_opCtx,
+                                                         kUninitializedStmtId,
+                                                         recordId,
+                                                         nullptr,
+                                                         false,
+                                                         false,
+                                                         Collection::StoreDeletedDoc::Off);
+            }
+            oplogBatch.flush();
+            wunit.commit();
+        }
+
+        // Each delete is visible at the timestamp of its own oplog entry and not before.
+        Timestamp lastDeleteTs;
+        for (std::int32_t num = 0; num < docsToInsert; ++num) {
+            auto deleteTs = queryOplog(BSON("op"
+                                            << "d"
+                                            << "ns"
+                                            << nss.ns()
+                                            << "o._id"
+                                            << num))["ts"]
+                                .timestamp();
+            ASSERT_GT(deleteTs, lastDeleteTs);
+            lastDeleteTs = deleteTs;
+
+            {
+                OneOffRead oor(_opCtx, Timestamp(deleteTs.asULL() - 1));
+                ASSERT_EQ(docsToInsert - num, itCount(autoColl.getCollection()));
+            }
+            OneOffRead oor(_opCtx, deleteTs);
+            ASSERT_EQ(docsToInsert - num - 1, itCount(autoColl.getCollection()));
+        }
+    }
+};
+
 class SecondaryUpdateTimes : public StorageTimestampTest {
 public:
     void run() {
@@ -2609,6 +2687,7 @@ public:
         add<SecondaryInsertTimes>();
         add<SecondaryArrayInsertTimes>();
         add<SecondaryDeleteTimes>();
+        add<PrimaryBatchedDeleteTimes>();
         add<SecondaryUpdateTimes>();
         add<SecondaryInsertToUpsert>();
         add<SecondaryAtomicApplyOps>();
@@ -37,7 +37,9 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/hasher.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 namespace {
@@ -56,6 +58,7 @@ const BSONField<Date_t> CollectionType::updatedAt("lastmod");
 const BSONField<BSONObj> CollectionType::keyPattern("key");
 const BSONField<BSONObj> CollectionType::defaultCollation("defaultCollation");
 const BSONField<bool> CollectionType::unique("unique");
+const BSONField<int> CollectionType::hashVersion("hashVersion");
 const BSONField<UUID> CollectionType::uuid("uuid");
 
 StatusWith<CollectionType> CollectionType::fromBSON(const BSONObj& source) {
@@ -152,6 +155,23 @@ StatusWith<CollectionType> CollectionType::fromBSON(const BSONObj& source) {
         }
     }
 
+    {
+        long long collHashVersion;
+        Status status = bsonExtractIntegerField(source, hashVersion.name(), &collHashVersion);
+        if (status.isOK()) {
+            if (!BSONElementHasher::isValidHashVersion(collHashVersion)) {
+                return {ErrorCodes::UnsupportedFormat,
+                        str::stream() << "Unsupported shard key hash version "
+                                      << collHashVersion};
+            }
+            coll._hashVersion = static_cast<int>(collHashVersion);
+        } else if (status == ErrorCodes::NoSuchKey) {
+            // Hash version can be missing in which case the default hash function is used
+        } else {
+            return status;
+        }
+    }
+
     {
         BSONElement uuidElem;
         Status status = bsonExtractField(source, uuid.name(), &uuidElem);
@@ -258,6 +278,10 @@ BSONObj CollectionType::toBSON() const {
         builder.append(unique.name(), _unique.get());
     }
 
+    if (_hashVersion.is_initialized()) {
+        builder.append(hashVersion.name(), _hashVersion.get());
+    }
+
     if (_uuid.is_initialized()) {
         _uuid->appendToBuilder(&builder, uuid.name());
     }
@@ -304,7 +328,7 @@ bool CollectionType::hasSameOptions(CollectionType& other) {
                                                     other.getKeyPattern().toBSON()) &&
         SimpleBSONObjComparator::kInstance.evaluate(_defaultCollation ==
                                                     other.getDefaultCollation()) &&
-        *_unique == other.getUnique();
+        *_unique == other.getUnique() && getHashVersion() == other.getHashVersion();
 }
 
 }  // namespace mongo
@@ -33,6 +33,7 @@
 #include <boost/optional.hpp>
 #include <string>
 
+#include "mongo/db/hasher.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/namespace_string.h"
@@ -63,6 +64,7 @@ class StatusWith;
  *          "locale" : "fr_CA"
  *      },
  *      "unique" : false,
+ *      "hashVersion" : 1,
  *      "uuid" : UUID,
  *      "noBalance" : false,
  *      "allowSplit" : false
@@ -80,6 +82,7 @@ public:
     static const BSONField<BSONObj> keyPattern;
     static const BSONField<BSONObj> defaultCollation;
     static const BSONField<bool> unique;
+    static const BSONField<int> hashVersion;
     static const BSONField<UUID> uuid;
 
     /**
@@ -148,6 +151,13 @@ public:
         _unique = unique;
     }
 
+    int getHashVersion() const {
+        return _hashVersion.get_value_or(BSONElementHasher::DEFAULT_HASH_VERSION);
+    }
+    void setHashVersion(int hashVersion) {
+        _hashVersion = hashVersion;
+    }
+
     boost::optional<UUID> getUUID() const {
         return _uuid;
     }
@@ -192,6 +202,10 @@ private:
     // Optional uniqueness of the sharding key. If missing, implies false.
     boost::optional<bool> _unique;
 
+    // Optional hash version of a hashed sharding key. If missing, implies the default hash
+    // version.
+    boost::optional<int> _hashVersion;
+
     // Optional in 3.6 binaries, because UUID does not exist in featureCompatibilityVersion=3.4.
     boost::optional<UUID> _uuid;
 
@@ -171,6 +171,52 @@ TEST(CollectionType, MissingDefaultCollationIsNotSerialized) {
     ASSERT_FALSE(serialized["defaultCollation"]);
 }
 
+TEST(CollectionType, HashVersionRoundTrips) {
+    const OID oid = OID::gen();
+    StatusWith<CollectionType> status =
+        CollectionType::fromBSON(BSON(CollectionType::fullNs("db.coll")
+                                      << CollectionType::epoch(oid)
+                                      << CollectionType::updatedAt(Date_t::fromMillisSinceEpoch(1))
+                                      << CollectionType::keyPattern(BSON("a"
+                                                                         << "hashed"))
+                                      << CollectionType::unique(false)
+                                      << CollectionType::hashVersion(1)));
+    ASSERT_OK(status.getStatus());
+
+    CollectionType coll = status.getValue();
+    ASSERT_EQUALS(coll.getHashVersion(), 1);
+    ASSERT_EQUALS(coll.toBSON()["hashVersion"].numberInt(), 1);
+}
+
+TEST(CollectionType, MissingHashVersionIsDefaultAndNotSerialized) {
+    const OID oid = OID::gen();
+    StatusWith<CollectionType> status =
+        CollectionType::fromBSON(BSON(CollectionType::fullNs("db.coll")
+                                      << CollectionType::epoch(oid)
+                                      << CollectionType::updatedAt(Date_t::fromMillisSinceEpoch(1))
+                                      << CollectionType::keyPattern(BSON("a"
+                                                                         << "hashed"))
+                                      << CollectionType::unique(false)));
+    ASSERT_OK(status.getStatus());
+
+    CollectionType coll = status.getValue();
+    ASSERT_EQUALS(coll.getHashVersion(), 0);
+    ASSERT_FALSE(coll.toBSON()["hashVersion"]);
+}
+
+TEST(CollectionType, UnknownHashVersionFailsToParse) {
+    const OID oid = OID::gen();
+    StatusWith<CollectionType> status =
+        CollectionType::fromBSON(BSON(CollectionType::fullNs("db.coll")
+                                      << CollectionType::epoch(oid)
+                                      << CollectionType::updatedAt(Date_t::fromMillisSinceEpoch(1))
+                                      << CollectionType::keyPattern(BSON("a"
+                                                                         << "hashed"))
+                                      << CollectionType::unique(false)
+                                      << CollectionType::hashVersion(7)));
+    ASSERT_EQUALS(status.getStatus(), ErrorCodes::UnsupportedFormat);
+}
+
 TEST(CollectionType, EpochCorrectness) {
     CollectionType coll;
     coll.setNs(NamespaceString{"db.coll"});
@@ -36,8 +36,10 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/hasher.h"
 #include "mongo/s/catalog/type_collection.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
@@ -47,6 +49,7 @@ const BSONField<OID> ShardCollectionType::epoch("epoch");
 const BSONField<BSONObj> ShardCollectionType::keyPattern("key");
 const BSONField<BSONObj> ShardCollectionType::defaultCollation("defaultCollation");
 const BSONField<bool> ShardCollectionType::unique("unique");
+const BSONField<int> ShardCollectionType::hashVersion("hashVersion");
 const BSONField<bool> ShardCollectionType::refreshing("refreshing");
 const BSONField<Date_t> ShardCollectionType::lastRefreshedCollectionVersion(
     "lastRefreshedCollectionVersion");
@@ -149,6 +152,24 @@ StatusWith<ShardCollectionType> ShardCollectionType::fromBSON(const BSONObj& sou
 
     // Below are optional fields.
 
+    {
+        long long collHashVersion;
+        Status status = bsonExtractIntegerField(
+            source, ShardCollectionType::hashVersion.name(), &collHashVersion);
+        if (status.isOK()) {
+            if (!BSONElementHasher::isValidHashVersion(collHashVersion)) {
+                return {ErrorCodes::UnsupportedFormat,
+                        str::stream() << "Unsupported shard key hash version "
+                                      << collHashVersion};
+            }
+            shardCollectionType.setHashVersion(static_cast<int>(collHashVersion));
+        } else if (status == ErrorCodes::NoSuchKey) {
+            // The default hash version is in use.
+        } else {
+            return status;
+        }
+    }
+
     {
         bool refreshing;
         Status status =
@@ -194,6 +215,10 @@ BSONObj ShardCollectionType::toBSON() const {
 
     builder.append(unique.name(), _unique);
 
+    if (_hashVersion) {
+        builder.append(hashVersion.name(), _hashVersion.get());
+    }
+
     if (_refreshing) {
         builder.append(refreshing.name(), _refreshing.get());
     }
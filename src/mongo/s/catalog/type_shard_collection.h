@@ -33,6 +33,7 @@
 #include <boost/optional.hpp>
 #include <string>
 
+#include "mongo/db/hasher.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/namespace_string.h"
@@ -63,6 +64,7 @@ class StatusWith;
  *          "locale" : "fr_CA"
  *      },
  *      "unique" : false,
+ *      "hashVersion" : 1,                                   // optional
  *      "refreshing" : true,                                 // optional
  *      "lastRefreshedCollectionVersion" : Timestamp(1, 0),  // optional
  *      "enterCriticalSectionCounter" : 4                    // optional
@@ -78,6 +80,7 @@ public:
     static const BSONField<BSONObj> keyPattern;
     static const BSONField<BSONObj> defaultCollation;
     static const BSONField<bool> unique;
+    static const BSONField<int> hashVersion;
     static const BSONField<bool> refreshing;
     static const BSONField<Date_t> lastRefreshedCollectionVersion;
     static const BSONField<int> enterCriticalSectionCounter;
@@ -138,6 +141,13 @@ public:
         _unique = unique;
     }
 
+    int getHashVersion() const {
+        return _hashVersion.get_value_or(BSONElementHasher::DEFAULT_HASH_VERSION);
+    }
+    void setHashVersion(int hashVersion) {
+        _hashVersion = hashVersion;
+    }
+
     bool hasRefreshing() const {
         return _refreshing.is_initialized();
     }
@@ -173,6 +183,9 @@ private:
     // Uniqueness of the sharding key.
     bool _unique;
 
+    // Hash version of a hashed sharding key. If missing, implies the default hash version.
+    boost::optional<int> _hashVersion;
+
     // Refresh fields set by primaries and used by shard secondaries to safely refresh chunk
     // metadata. '_refreshing' indicates whether the chunks collection is currently being updated,
     // which means read results won't provide a complete view of the chunk metadata.
@@ -102,7 +102,8 @@ std::shared_ptr<RoutingTableHistory> refreshCollectionRoutingInfo(
                                             std::move(defaultCollator),
                                             collectionAndChunks.shardKeyIsUnique,
                                             collectionAndChunks.epoch,
-                                            collectionAndChunks.changedChunks);
+                                            collectionAndChunks.changedChunks,
+                                            collectionAndChunks.shardKeyHashVersion);
     }();
 
     std::set<ShardId> shardIds;
@@ -82,12 +82,13 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          KeyPattern shardKeyPattern,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
+                                         int shardKeyHashVersion,
                                          ChunkInfoMap chunkMap,
                                          ChunkVersion collectionVersion)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
-      _shardKeyPattern(shardKeyPattern),
+      _shardKeyPattern(shardKeyPattern, shardKeyHashVersion),
       _shardKeyOrdering(Ordering::make(_shardKeyPattern.toBSON())),
       _defaultCollator(std::move(defaultCollator)),
       _unique(unique),
@@ -179,7 +180,9 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     //   Query { a : { $gte : 1, $lt : 2 },
     //            b : { $gte : 3, $lt : 4 } }
     //   => Bounds { a : [1, 2), b : [3, 4) }
-    IndexBounds bounds = getIndexBoundsForQuery(_rt->getShardKeyPattern().toBSON(), *cq);
+    IndexBounds bounds = getIndexBoundsForQuery(_rt->getShardKeyPattern().toBSON(),
+                                                *cq,
+                                                _rt->getShardKeyPattern().getHashVersion());
 
     // Transforms bounds for each shard key field into full shard key ranges
     // for example :
@@ -282,7 +285,8 @@ RoutingTableHistory::overlappingRanges(const BSONObj& min,
 }
 
 IndexBounds ChunkManager::getIndexBoundsForQuery(const BSONObj& key,
-                                                 const CanonicalQuery& canonicalQuery) {
+                                                 const CanonicalQuery& canonicalQuery,
+                                                 int hashVersion) {
     // $text is not allowed in planning since we don't have text index on mongos.
     // TODO: Treat $text query as a no-op in planning on mongos. So with shard key {a: 1},
     //       the query { a: 2, $text: { ... } } will only target to {a: 2}.
@@ -307,6 +311,10 @@ IndexBounds ChunkManager::getIndexBoundsForQuery(const BSONObj& key,
     QueryPlannerParams plannerParams;
     // Must use "shard key" index
     plannerParams.options = QueryPlannerParams::NO_TABLE_SCAN;
+    // The index spec only needs to carry the hash version, which determines the hashed bounds.
+    const BSONObj infoObj = hashVersion != BSONElementHasher::DEFAULT_HASH_VERSION
+        ? BSON("key" << key << "hashVersion" << hashVersion)
+        : BSONObj();
     IndexEntry indexEntry(key,
                           accessMethod,
                           false /* multiKey */,
@@ -315,7 +323,7 @@ IndexBounds ChunkManager::getIndexBoundsForQuery(const BSONObj& key,
                           false /* unique */,
                           "shardkey",
                           NULL /* filterExpr */,
-                          BSONObj(),
+                          infoObj,
                           NULL /* collator */);
     plannerParams.indices.push_back(indexEntry);
 
@@ -525,12 +533,14 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
     std::unique_ptr<CollatorInterface> defaultCollator,
     bool unique,
     OID epoch,
-    const std::vector<ChunkType>& chunks) {
+    const std::vector<ChunkType>& chunks,
+    int shardKeyHashVersion) {
     return RoutingTableHistory(std::move(nss),
                                std::move(uuid),
                                std::move(shardKeyPattern),
                                std::move(defaultCollator),
                                std::move(unique),
+                               shardKeyHashVersion,
                                {},
                                {0, 0, epoch})
         .makeUpdated(chunks);
@@ -591,6 +601,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 KeyPattern(getShardKeyPattern().getKeyPattern()),
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
+                                getShardKeyPattern().getHashVersion(),
                                 std::move(chunkMap),
                                 collectionVersion));
 }
@@ -75,6 +75,8 @@ public:
      *
      * The "chunks" vector must contain the chunk routing information sorted in ascending order by
      * chunk version, and adhere to the requirements of the routing table update algorithm.
+     *
+     * "shardKeyHashVersion" is the hash version used to route on a hashed shard key.
      */
     static std::shared_ptr<RoutingTableHistory> makeNew(
         NamespaceString nss,
@@ -83,7 +85,8 @@ public:
         std::unique_ptr<CollatorInterface> defaultCollator,
         bool unique,
         OID epoch,
-        const std::vector<ChunkType>& chunks);
+        const std::vector<ChunkType>& chunks,
+        int shardKeyHashVersion = BSONElementHasher::DEFAULT_HASH_VERSION);
 
     /**
      * Constructs a new instance with a routing table updated according to the changes described
@@ -162,6 +165,7 @@ private:
                         KeyPattern shardKeyPattern,
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
+                        int shardKeyHashVersion,
                         ChunkInfoMap chunkMap,
                         ChunkVersion collectionVersion);
 
@@ -398,8 +402,11 @@ public:
     //   Query { a : { $gte : 1, $lt : 2 },
     //            b : { $gte : 3, $lt : 4 } }
     //   => Bounds { a : [1, 2), b : [3, 4) }
-    static IndexBounds getIndexBoundsForQuery(const BSONObj& key,
-                                              const CanonicalQuery& canonicalQuery);
+    // Equalities on a hashed shard key are hashed with 'hashVersion'.
+    static IndexBounds getIndexBoundsForQuery(
+        const BSONObj& key,
+        const CanonicalQuery& canonicalQuery,
+        int hashVersion = BSONElementHasher::DEFAULT_HASH_VERSION);
 
     // Collapse query solution tree.
     //
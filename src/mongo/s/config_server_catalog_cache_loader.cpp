@@ -127,12 +127,14 @@ CollectionAndChangedChunks getChangedChunks(OperationContext* opCtx,
             "No chunks were found for the collection",
             !changedChunks.empty());
 
-    return CollectionAndChangedChunks(coll.getUUID(),
-                                      coll.getEpoch(),
-                                      coll.getKeyPattern().toBSON(),
-                                      coll.getDefaultCollation(),
-                                      coll.getUnique(),
-                                      std::move(changedChunks));
+    CollectionAndChangedChunks collAndChunks(coll.getUUID(),
+                                             coll.getEpoch(),
+                                             coll.getKeyPattern().toBSON(),
+                                             coll.getDefaultCollation(),
+                                             coll.getUnique(),
+                                             std::move(changedChunks));
+    collAndChunks.shardKeyHashVersion = coll.getHashVersion();
+    return collAndChunks;
 }
 
 }  // namespace
@@ -178,13 +178,23 @@ Status ShardKeyPattern::checkShardKeyIsValidForMetadataStorage(const BSONObj& sh
     return Status::OK();
 }
 
-ShardKeyPattern::ShardKeyPattern(const BSONObj& keyPattern)
+ShardKeyPattern::ShardKeyPattern(const BSONObj& keyPattern, int hashVersion)
     : _keyPattern(keyPattern),
       _keyPatternPaths(parseShardKeyPattern(keyPattern)),
-      _hasId(keyPattern.hasField("_id"_sd)) {}
+      _hasId(keyPattern.hasField("_id"_sd)),
+      _hashVersion(hashVersion) {
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Invalid hash version " << hashVersion,
+            BSONElementHasher::isValidHashVersion(hashVersion));
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Hash version " << hashVersion
+                          << " can only be specified for a hashed shard key, but got "
+                          << keyPattern,
+            hashVersion == BSONElementHasher::DEFAULT_HASH_VERSION || isHashedPattern());
+}
 
-ShardKeyPattern::ShardKeyPattern(const KeyPattern& keyPattern)
-    : ShardKeyPattern(keyPattern.toBSON()) {}
+ShardKeyPattern::ShardKeyPattern(const KeyPattern& keyPattern, int hashVersion)
+    : ShardKeyPattern(keyPattern.toBSON(), hashVersion) {}
 
 bool ShardKeyPattern::isHashedPatternEl(const BSONElement& el) {
     return el.type() == String && el.String() == IndexNames::HASHED;
@@ -260,7 +270,8 @@ BSONObj ShardKeyPattern::extractShardKeyFromMatchable(const MatchableDocument& m
         if (isHashedPatternEl(patternEl)) {
             keyBuilder.append(
                 patternEl.fieldName(),
-                BSONElementHasher::hash64(matchEl, BSONElementHasher::DEFAULT_HASH_SEED));
+                BSONElementHasher::hash64(
+                    matchEl, BSONElementHasher::DEFAULT_HASH_SEED, _hashVersion));
         } else {
             // NOTE: The matched element may *not* have the same field name as the path -
             // index keys don't contain field names, for example
@@ -326,7 +337,8 @@ BSONObj ShardKeyPattern::extractShardKeyFromQuery(const CanonicalQuery& query) c
         if (isHashedPattern()) {
             keyBuilder.append(
                 patternPath.dottedField(),
-                BSONElementHasher::hash64(equalEl, BSONElementHasher::DEFAULT_HASH_SEED));
+                BSONElementHasher::hash64(
+                    equalEl, BSONElementHasher::DEFAULT_HASH_SEED, _hashVersion));
         } else {
             // NOTE: The equal element may *not* have the same field name as the path - nested $and,
             // $eq, for example
@@ -35,6 +35,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/matchable.h"
@@ -84,13 +85,19 @@ public:
     /**
      * Constructs a shard key pattern from a BSON pattern document.  If the document is not a
      * valid shard key pattern, !isValid() will be true and key extraction will fail.
+     *
+     * 'hashVersion' selects the hash function used to compute the shard key values of a hashed
+     * shard key pattern (see BSONElementHasher) and must match the hash version of the hashed
+     * index backing the shard key. Non-hashed patterns only accept the default.
      */
-    explicit ShardKeyPattern(const BSONObj& keyPattern);
+    explicit ShardKeyPattern(const BSONObj& keyPattern,
+                             int hashVersion = BSONElementHasher::DEFAULT_HASH_VERSION);
 
     /**
      * Constructs a shard key pattern from a key pattern, see above.
      */
-    explicit ShardKeyPattern(const KeyPattern& keyPattern);
+    explicit ShardKeyPattern(const KeyPattern& keyPattern,
+                             int hashVersion = BSONElementHasher::DEFAULT_HASH_VERSION);
 
     /**
      * Returns whether the provided element is hashed.
@@ -99,6 +106,14 @@ public:
 
     bool isHashedPattern() const;
 
+    /**
+     * Returns the hash version used to hash shard key values. Only meaningful for hashed
+     * patterns.
+     */
+    int getHashVersion() const {
+        return _hashVersion;
+    }
+
     const KeyPattern& getKeyPattern() const;
 
     const std::vector<std::unique_ptr<FieldRef>>& getKeyPatternFields() const;
@@ -247,6 +262,8 @@ private:
     std::vector<std::unique_ptr<FieldRef>> _keyPatternPaths;
 
     bool _hasId;
+
+    int _hashVersion;
 };
 
 }  // namespace mongo
@@ -420,6 +420,40 @@ TEST(ShardKeyPattern, ExtractQueryShardKeyHashed) {
     ASSERT_BSONOBJ_EQ(queryKey(pattern, BSON("a" << BSON_ARRAY(BSON("b" << value)))), BSONObj());
 }
 
+TEST(ShardKeyPattern, ExtractShardKeyHashedWithHashVersion) {
+    const string value = "12345";
+    const BSONObj bsonValue = BSON("" << value);
+    const long long hashValue =
+        BSONElementHasher::hash64(bsonValue.firstElement(),
+                                  BSONElementHasher::DEFAULT_HASH_SEED,
+                                  BSONElementHasher::MURMUR3_HASH_VERSION);
+    ASSERT_NOT_EQUALS(hashValue,
+                      BSONElementHasher::hash64(bsonValue.firstElement(),
+                                                BSONElementHasher::DEFAULT_HASH_SEED));
+
+    ShardKeyPattern pattern(BSON("a.b"
+                                 << "hashed"),
+                            BSONElementHasher::MURMUR3_HASH_VERSION);
+    ASSERT_EQUALS(pattern.getHashVersion(), BSONElementHasher::MURMUR3_HASH_VERSION);
+    ASSERT_BSONOBJ_EQ(docKey(pattern, BSON("a" << BSON("b" << value))), BSON("a.b" << hashValue));
+    ASSERT_BSONOBJ_EQ(queryKey(pattern, BSON("a.b" << value)), BSON("a.b" << hashValue));
+}
+
+TEST(ShardKeyPattern, HashVersionValidityCheck) {
+    ASSERT_EQUALS(ShardKeyPattern(BSON("a" << 1)).getHashVersion(),
+                  BSONElementHasher::DEFAULT_HASH_VERSION);
+
+    // Only hashed shard keys may use a non-default hash version.
+    ASSERT_THROWS_CODE(ShardKeyPattern(BSON("a" << 1), BSONElementHasher::MURMUR3_HASH_VERSION),
+                       DBException,
+                       ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(ShardKeyPattern(BSON("a"
+                                            << "hashed"),
+                                       2),
+                       DBException,
+                       ErrorCodes::BadValue);
+}
+
 static bool indexComp(const ShardKeyPattern& pattern, const BSONObj& indexPattern) {
     return pattern.isUniqueIndexCompatible(indexPattern);
 }
@@ -0,0 +1,432 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "mongo/base/data_view.h"
+#include "mongo/base/initializer.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/logical_clock.h"
+#include "mongo/db/op_observer_impl.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/replication_consistency_markers_impl.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/repl/sync_tail.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/tools/oplog_replay_benchmark_options.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/quick_exit.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/signal_handlers_synchronous.h"
+#include "mongo/util/text.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// How often progress is logged while replaying.
+const int kProgressIntervalSecs = 10;
+
+/**
+ * Reads the oplog entries in a BSON dump, such as one of local.oplog.rs written by mongodump.
+ */
+std::vector<BSONObj> loadOplogEntries(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    uassert(ErrorCodes::FileOpenFailed,
+            str::stream() << "Failed to open " << path << ": " << errnoWithDescription(),
+            in.is_open());
+
+    std::vector<BSONObj> entries;
+    while (true) {
+        char sizeBytes[sizeof(int32_t)];
+        in.read(sizeBytes, sizeof(sizeBytes));
+        if (in.gcount() == 0 && in.eof()) {
+            break;
+        }
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << path << " is truncated after " << entries.size() << " entries",
+                in.gcount() == sizeof(sizeBytes));
+
+        const int32_t size = ConstDataView(sizeBytes).read<LittleEndian<int32_t>>();
+        uassert(ErrorCodes::InvalidBSON,
+                str::stream() << "Entry " << entries.size() << " in " << path
+                              << " has an invalid size: "
+                              << size,
+                size >= BSONObj::kMinBSONLength && size <= BSONObjMaxInternalSize);
+
+        auto buffer = SharedBuffer::allocate(size);
+        std::copy(sizeBytes, sizeBytes + sizeof(sizeBytes), buffer.get());
+        in.read(buffer.get() + sizeof(sizeBytes), size - sizeof(sizeBytes));
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << path << " is truncated after " << entries.size() << " entries",
+                in.gcount() == size - static_cast<std::streamsize>(sizeof(sizeBytes)));
+        uassertStatusOKWithContext(validateBSON(buffer.get(), size, BSONVersion::kLatest),
+                                   str::stream() << "Entry " << entries.size() << " in " << path);
+        entries.emplace_back(std::move(buffer));
+    }
+    return entries;
+}
+
+/**
+ * Creates the collections the entries write to without having created them, with the UUIDs the
+ * entries refer to them by, so that a segment of an oplog can be replayed into an empty data
+ * directory. Indexes other than the _id index are not recreated, and neither are the collections
+ * only written to by operations nested in applyOps entries.
+ */
+void createMissingCollections(OperationContext* opCtx,
+                              StorageInterface* storageInterface,
+                              const std::vector<BSONObj>& entries) {
+    std::set<NamespaceString> createdBySegment;
+    std::set<NamespaceString> created;
+    for (auto&& raw : entries) {
+        OplogEntry entry(raw);
+        if (entry.isCommand() && entry.getCommandType() == OplogEntry::CommandType::kCreate) {
+            createdBySegment.emplace(entry.getNamespace().db(),
+                                     entry.getObject().firstElement().valueStringData());
+            continue;
+        }
+        const auto& nss = entry.getNamespace();
+        if (!entry.isCrudOpType() || !entry.getUuid() || createdBySegment.count(nss) ||
+            created.count(nss)) {
+            continue;
+        }
+
+        CollectionOptions options;
+        options.uuid = entry.getUuid();
+        auto status = storageInterface->createCollection(opCtx, nss, options);
+        if (status.isOK()) {
+            log() << "Created " << nss << " with UUID " << *entry.getUuid();
+        } else if (status != ErrorCodes::NamespaceExists) {
+            uassertStatusOKWithContext(status, str::stream() << "Failed to create " << nss.ns());
+        }
+        created.insert(nss);
+    }
+}
+
+/**
+ * Returns the value below which the given fraction of the sorted latencies fall.
+ */
+long long percentile(const std::vector<Microseconds>& sortedLatencies, double fraction) {
+    invariant(!sortedLatencies.empty());
+    const auto index = std::min(sortedLatencies.size() - 1,
+                                static_cast<std::size_t>(fraction * sortedLatencies.size()));
+    return durationCount<Microseconds>(sortedLatencies[index]);
+}
+
+class ReplayStats : public OplogApplier::Observer {
+public:
+    void onBatchBegin(const OplogApplier::Operations& batch) final {}
+    void onBatchEnd(const StatusWith<OpTime>&, const OplogApplier::Operations&) final {}
+    void onMissingDocumentsFetchedAndInserted(const std::vector<FetchInfo>&) final {}
+    void onOperationConsumed(const BSONObj& op) final {}
+
+    void recordBatch(std::size_t numOps,
+                     Microseconds batching,
+                     Microseconds latency,
+                     const OplogApplier::BatchPhaseTimes& phases) {
+        _numOps += numOps;
+        _batching += batching;
+        _latencies.push_back(latency);
+        _lock += phases.lock;
+        _partition += phases.partition;
+        _waitForOplogWrites += phases.waitForOplogWrites;
+        _apply += phases.apply;
+        _finish += phases.finish;
+    }
+
+    std::size_t numOps() const {
+        return _numOps;
+    }
+
+    std::size_t numBatches() const {
+        return _latencies.size();
+    }
+
+    BSONObj toBSON(Milliseconds elapsed) const {
+        const auto& params = oplogReplayBenchmarkGlobalParams;
+        BSONObjBuilder bob;
+        bob.append("operations", static_cast<long long>(_numOps));
+        bob.append("batches", static_cast<long long>(_latencies.size()));
+        bob.append("elapsedMillis", durationCount<Milliseconds>(elapsed));
+        bob.append("opsPerSecond",
+                   elapsed > Milliseconds(0)
+                       ? _numOps * 1000.0 / durationCount<Milliseconds>(elapsed)
+                       : 0.0);
+        bob.append("threads", params.threads);
+        bob.append("batchLimitOps", static_cast<long long>(params.batchLimitOps));
+        bob.append("batchLimitBytes", static_cast<long long>(params.batchLimitBytes));
+        bob.append("writeOplog", params.writeOplog);
+
+        if (!_latencies.empty()) {
+            auto sorted = _latencies;
+            std::sort(sorted.begin(), sorted.end());
+            Microseconds total{0};
+            for (auto&& latency : sorted) {
+                total += latency;
+            }
+            BSONObjBuilder latencyBuilder(bob.subobjStart("batchLatencyMicros"));
+            latencyBuilder.append("min", durationCount<Microseconds>(sorted.front()));
+            latencyBuilder.append("mean",
+                                  durationCount<Microseconds>(total) /
+                                      static_cast<long long>(sorted.size()));
+            latencyBuilder.append("p50", percentile(sorted, 0.5));
+            latencyBuilder.append("p90", percentile(sorted, 0.9));
+            latencyBuilder.append("p99", percentile(sorted, 0.99));
+            latencyBuilder.append("max", durationCount<Microseconds>(sorted.back()));
+        }
+
+        BSONObjBuilder phaseBuilder(bob.subobjStart("phaseMicros"));
+        phaseBuilder.append("batching", durationCount<Microseconds>(_batching));
+        phaseBuilder.append("lock", durationCount<Microseconds>(_lock));
+        phaseBuilder.append("partition", durationCount<Microseconds>(_partition));
+        phaseBuilder.append("waitForOplogWrites",
+                            durationCount<Microseconds>(_waitForOplogWrites));
+        phaseBuilder.append("apply", durationCount<Microseconds>(_apply));
+        phaseBuilder.append("finish", durationCount<Microseconds>(_finish));
+        phaseBuilder.doneFast();
+        return bob.obj();
+    }
+
+private:
+    std::size_t _numOps = 0;
+    std::vector<Microseconds> _latencies;
+    Microseconds _batching{0};
+    Microseconds _lock{0};
+    Microseconds _partition{0};
+    Microseconds _waitForOplogWrites{0};
+    Microseconds _apply{0};
+    Microseconds _finish{0};
+};
+
+/**
+ * Applies the entries the way a secondary does, and returns the statistics of doing so.
+ */
+BSONObj replay(OperationContext* opCtx,
+               StorageInterface* storageInterface,
+               const std::vector<BSONObj>& entries) {
+    const auto& params = oplogReplayBenchmarkGlobalParams;
+
+    ReplicationConsistencyMarkersImpl consistencyMarkers(storageInterface);
+    consistencyMarkers.initializeMinValidDocument(opCtx);
+
+    if (params.writeOplog) {
+        auto oplogSize =
+            storageInterface->getOplogMaxSize(opCtx, NamespaceString::kRsOplogNamespace);
+        if (oplogSize == ErrorCodes::NamespaceNotFound) {
+            uassertStatusOK(
+                storageInterface->createOplog(opCtx, NamespaceString::kRsOplogNamespace));
+        } else {
+            uassertStatusOK(oplogSize);
+        }
+    }
+
+    createMissingCollections(opCtx, storageInterface, entries);
+
+    OplogBufferBlockingQueue oplogBuffer;
+    oplogBuffer.startup(opCtx);
+    ON_BLOCK_EXIT([&] { oplogBuffer.shutdown(opCtx); });
+
+    // Without writes to the oplog, operations are applied as in startup recovery, which tolerates
+    // writes to collections and documents which no longer exist.
+    OplogApplier::Options options;
+    options.allowNamespaceNotFoundErrorsOnCrudOps = !params.writeOplog;
+    options.skipWritesToOplog = !params.writeOplog;
+
+    ReplayStats stats;
+    auto writerPool = SyncTail::makeWriterPool(params.threads);
+    OplogApplier oplogApplier(nullptr,
+                              &oplogBuffer,
+                              &stats,
+                              ReplicationCoordinator::get(opCtx),
+                              &consistencyMarkers,
+                              storageInterface,
+                              options,
+                              writerPool.get());
+
+    OplogApplier::BatchLimits batchLimits;
+    batchLimits.ops = params.batchLimitOps;
+    batchLimits.bytes = params.batchLimitBytes;
+
+    auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    auto next = entries.cbegin();
+    Timer elapsed;
+    Timer progressTimer;
+    while (true) {
+        // Keeps the buffer full, so that batches are only limited by the batch limits.
+        while (next != entries.cend() &&
+               oplogBuffer.getSize() + next->objsize() <= oplogBuffer.getMaxSize()) {
+            oplogBuffer.push(opCtx, *next++);
+        }
+
+        Timer batchingTimer;
+        auto batch = uassertStatusOK(oplogApplier.getNextApplierBatch(opCtx, batchLimits));
+        if (batch.empty()) {
+            break;
+        }
+        const Microseconds batching(batchingTimer.micros());
+        const auto numOps = batch.size();
+
+        Timer applyTimer;
+        const auto lastApplied = uassertStatusOK(oplogApplier.multiApply(opCtx, std::move(batch)));
+        stats.recordBatch(numOps,
+                          batching,
+                          Microseconds(applyTimer.micros()),
+                          oplogApplier.getLastBatchPhaseTimes());
+
+        // Lets the storage engine discard the history the replay no longer needs, as a secondary
+        // does when the majority commit point advances.
+        storageEngine->setStableTimestamp(lastApplied.getTimestamp());
+
+        if (progressTimer.seconds() >= kProgressIntervalSecs) {
+            log() << "Applied " << stats.numOps() << " of " << entries.size() << " operations in "
+                  << stats.numBatches() << " batches, through " << lastApplied;
+            progressTimer.reset();
+        }
+    }
+
+    return stats.toBSON(Milliseconds(elapsed.millis()));
+}
+
+}  // namespace
+
+int oplogReplayBenchmarkMain(int argc, char** argv, char** envp) {
+    setupSynchronousSignalHandlers();
+    runGlobalInitializersOrDie(argc, argv, envp);
+    serverGlobalParams.featureCompatibility.setVersion(
+        ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo40);
+
+    const auto& params = oplogReplayBenchmarkGlobalParams;
+    log() << "Loading oplog entries from " << params.oplogFile;
+    std::vector<BSONObj> entries;
+    try {
+        entries = loadOplogEntries(params.oplogFile);
+    } catch (const DBException& ex) {
+        error() << "Failed to load oplog entries: " << redact(ex.toStatus());
+        return EXIT_BADOPTIONS;
+    }
+    log() << "Loaded " << entries.size() << " oplog entries";
+
+    setGlobalServiceContext(ServiceContext::make());
+    auto service = getGlobalServiceContext();
+    LogicalClock::set(service, stdx::make_unique<LogicalClock>(service));
+
+    ReplSettings replSettings;
+    replSettings.setReplSetString("oplogReplayBenchmark");
+    replSettings.setOplogSizeBytes(params.oplogSizeMB * 1024 * 1024);
+    ReplicationCoordinator::set(
+        service, stdx::make_unique<ReplicationCoordinatorMock>(service, replSettings));
+    fassert(56875,
+            ReplicationCoordinator::get(service)->setFollowerMode(MemberState::RS_SECONDARY));
+
+    StorageInterface::set(service, stdx::make_unique<StorageInterfaceImpl>());
+    auto storageInterface = StorageInterface::get(service);
+    DropPendingCollectionReaper::set(
+        service, stdx::make_unique<DropPendingCollectionReaper>(storageInterface));
+
+    registerShutdownTask([service] {
+        if (service->getStorageEngine()) {
+            shutdownGlobalStorageEngineCleanly(service);
+        }
+    });
+
+    // Set up the periodic runner for background job execution, which is required by the storage
+    // engine to be running beforehand.
+    service->setPeriodicRunner(makePeriodicRunner(service));
+    initializeStorageEngine(service, StorageEngineInitFlags::kNone);
+
+    auto registry = stdx::make_unique<OpObserverRegistry>();
+    registry->addObserver(stdx::make_unique<OpObserverImpl>());
+    registry->addObserver(stdx::make_unique<UUIDCatalogObserver>());
+    service->setOpObserver(std::move(registry));
+    setOplogCollectionName(service);
+
+    Client::initThread("oplogReplayBenchmark");
+    BSONObj report;
+    try {
+        auto opCtx = cc().makeOperationContext();
+        report = replay(opCtx.get(), storageInterface, entries);
+    } catch (const DBException& ex) {
+        error() << "Failed to replay oplog entries: " << redact(ex.toStatus());
+        exitCleanly(EXIT_UNCAUGHT);
+    }
+    log() << "Replay complete: " << report;
+    std::cout << report.jsonString(Strict, 1) << std::endl;
+
+    exitCleanly(EXIT_CLEAN);
+    return EXIT_CLEAN;
+}
+
+}  // namespace repl
+}  // namespace mongo
+
+#if defined(_WIN32)
+// In Windows, wmain() is an alternate entry point for main(), and receives the same parameters
+// as main() but encoded in Windows Unicode (UTF-16); "wide" 16-bit wchar_t characters.  The
+// WindowsCommandLine object converts these wide character strings to a UTF-8 coded equivalent
+// and makes them available through the argv() and envp() members.  This enables
+// oplogReplayBenchmarkMain() to process UTF-8 encoded arguments and environment variables without
+// regard to platform.
+int wmain(int argc, wchar_t* argvW[], wchar_t* envpW[]) {
+    mongo::WindowsCommandLine wcl(argc, argvW, envpW);
+    int exitCode = mongo::repl::oplogReplayBenchmarkMain(argc, wcl.argv(), wcl.envp());
+    mongo::quickExit(exitCode);
+}
+#else
+int main(int argc, char* argv[], char** envp) {
+    int exitCode = mongo::repl::oplogReplayBenchmarkMain(argc, argv, envp);
+    mongo::quickExit(exitCode);
+}
+#endif
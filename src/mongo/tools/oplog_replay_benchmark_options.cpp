@@ -0,0 +1,169 @@
+
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/tools/oplog_replay_benchmark_options.h"
+
+#include <algorithm>
+#include <boost/filesystem/operations.hpp>
+#include <iostream>
+
+#include "mongo/base/status.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/options_parser/startup_options.h"
+
+namespace mongo {
+
+OplogReplayBenchmarkGlobalParams oplogReplayBenchmarkGlobalParams;
+
+Status addOplogReplayBenchmarkOptions(moe::OptionSection* options) {
+    options->addOptionChaining("help", "help", moe::Switch, "show this usage information");
+
+    options->addOptionChaining(
+        "dbpath", "dbpath", moe::String, "scratch directory the oplog entries are applied to");
+
+    options
+        ->addOptionChaining(
+            "storage.engine", "storageEngine", moe::String, "what storage engine to use")
+        .setDefault(moe::Value(std::string("wiredTiger")));
+
+    options->addOptionChaining(
+        "oplogFile", "oplogFile", moe::String, "BSON dump of the oplog entries to replay");
+
+    options
+        ->addOptionChaining(
+            "threads", "threads", moe::Int, "number of writer threads applying each batch")
+        .setDefault(moe::Value(16));
+
+    options
+        ->addOptionChaining(
+            "batchLimitOps", "batchLimitOps", moe::Int, "maximum number of operations per batch")
+        .setDefault(moe::Value(5 * 1000));
+
+    options
+        ->addOptionChaining(
+            "batchLimitBytes", "batchLimitBytes", moe::Int, "maximum number of bytes per batch")
+        .setDefault(moe::Value(100 * 1024 * 1024));
+
+    options->addOptionChaining("writeOplog",
+                               "writeOplog",
+                               moe::Switch,
+                               "also write the oplog entries to local.oplog.rs, as a secondary "
+                               "does, instead of only applying them");
+
+    options
+        ->addOptionChaining("oplogSizeMB",
+                            "oplogSizeMB",
+                            moe::Int,
+                            "size of the oplog to create with --writeOplog if there is none")
+        .setDefault(moe::Value(1024));
+
+    options->addOptionChaining("verbose", "verbose", moe::String, "log more verbose output")
+        .setImplicit(moe::Value(std::string("v")));
+
+    return Status::OK();
+}
+
+void printOplogReplayBenchmarkHelp(std::ostream* out) {
+    *out << "Usage: oplog_replay_benchmark --dbpath <path> --oplogFile <file> [ --threads <n> ]"
+            " [ --batchLimitOps <n> ] [ --batchLimitBytes <n> ] [ --writeOplog ] [ --help ]"
+         << std::endl;
+    *out << "Replays a BSON dump of oplog entries through the secondary oplog applier and reports "
+            "its throughput as JSON."
+         << std::endl;
+    *out << moe::startupOptions.helpString();
+    *out << std::flush;
+}
+
+bool handlePreValidationOplogReplayBenchmarkOptions(const moe::Environment& params) {
+    if (params.count("help")) {
+        printOplogReplayBenchmarkHelp(&std::cout);
+        return false;
+    }
+    return true;
+}
+
+Status storeOplogReplayBenchmarkOptions(const moe::Environment& params,
+                                        const std::vector<std::string>& args) {
+    if (!params.count("dbpath")) {
+        return {ErrorCodes::BadValue, "Missing required option: --dbpath"};
+    }
+
+    if (!params.count("oplogFile")) {
+        return {ErrorCodes::BadValue, "Missing required option: --oplogFile"};
+    }
+
+    storageGlobalParams.dbpath = params["dbpath"].as<std::string>();
+    if (!boost::filesystem::is_directory(storageGlobalParams.dbpath)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "--dbpath " << storageGlobalParams.dbpath
+                              << " is not a directory"};
+    }
+    storageGlobalParams.engine = params["storage.engine"].as<std::string>();
+
+    auto& benchmarkParams = oplogReplayBenchmarkGlobalParams;
+    benchmarkParams.oplogFile = params["oplogFile"].as<std::string>();
+
+    benchmarkParams.threads = params["threads"].as<int>();
+    if (benchmarkParams.threads < 1 || benchmarkParams.threads > 256) {
+        return {ErrorCodes::BadValue, "--threads must be between 1 and 256"};
+    }
+
+    const int batchLimitOps = params["batchLimitOps"].as<int>();
+    const int batchLimitBytes = params["batchLimitBytes"].as<int>();
+    if (batchLimitOps < 1 || batchLimitBytes < 1) {
+        return {ErrorCodes::BadValue, "--batchLimitOps and --batchLimitBytes must be positive"};
+    }
+    benchmarkParams.batchLimitOps = batchLimitOps;
+    benchmarkParams.batchLimitBytes = batchLimitBytes;
+
+    benchmarkParams.writeOplog = params.count("writeOplog") > 0;
+    benchmarkParams.oplogSizeMB = params["oplogSizeMB"].as<int>();
+    if (benchmarkParams.oplogSizeMB < 1) {
+        return {ErrorCodes::BadValue, "--oplogSizeMB must be positive"};
+    }
+
+    if (params.count("verbose")) {
+        std::string verbosity = params["verbose"].as<std::string>();
+        if (std::any_of(verbosity.cbegin(), verbosity.cend(), [](char ch) { return ch != 'v'; })) {
+            return {ErrorCodes::BadValue,
+                    "The string for the --verbose option cannot contain characters other than 'v'"};
+        }
+        logger::globalLogDomain()->setMinimumLoggedSeverity(
+            logger::LogSeverity::Debug(verbosity.length()));
+    }
+
+    return Status::OK();
+}
+
+}  // namespace mongo
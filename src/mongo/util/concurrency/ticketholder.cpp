@@ -34,6 +34,7 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "mongo/util/log.h"
@@ -69,6 +70,19 @@ void tsFromDate(const Date_t& deadline, struct timespec& ts) {
     ts.tv_sec = deadline.toTimeT();
     ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
 }
+
+Status validateSize(int newSize) {
+    if (newSize < 5)
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Minimum value for semaphore is 5; given " << newSize);
+
+    if (newSize > SEM_VALUE_MAX)
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
+                                    << "; given "
+                                    << newSize);
+    return Status::OK();
+}
 }  // namespace
 
 TicketHolder::TicketHolder(int num) : _outof(num) {
@@ -125,21 +139,23 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
 }
 
 void TicketHolder::release() {
+    // A ticket owed to an earlier shrink is retired instead of being handed back.
+    int toRetire = _ticketsToRetire.load();
+    while (toRetire > 0) {
+        const int observed = _ticketsToRetire.compareAndSwap(toRetire, toRetire - 1);
+        if (observed == toRetire)
+            return;
+        toRetire = observed;
+    }
     check(sem_post(&_sem));
 }
 
 Status TicketHolder::resize(int newSize) {
     stdx::lock_guard<stdx::mutex> lk(_resizeMutex);
 
-    if (newSize < 5)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Minimum value for semaphore is 5; given " << newSize);
-
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given "
-                                    << newSize);
+    Status status = validateSize(newSize);
+    if (!status.isOK())
+        return status;
 
     while (_outof.load() < newSize) {
         release();
@@ -155,6 +171,27 @@ Status TicketHolder::resize(int newSize) {
     return Status::OK();
 }
 
+Status TicketHolder::resizeWithoutWaiting(int newSize) {
+    stdx::lock_guard<stdx::mutex> lk(_resizeMutex);
+
+    Status status = validateSize(newSize);
+    if (!status.isOK())
+        return status;
+
+    // Growing pays off any tickets still owed for retirement before adding new ones.
+    while (_outof.load() < newSize) {
+        release();
+        _outof.fetchAndAdd(1);
+    }
+
+    while (_outof.load() > newSize) {
+        if (!tryAcquire())
+            _ticketsToRetire.fetchAndAdd(1);
+        _outof.subtractAndFetch(1);
+    }
+    return Status::OK();
+}
+
 int TicketHolder::available() const {
     int val = 0;
     check(sem_getvalue(&_sem, &val));
@@ -205,6 +242,11 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
 void TicketHolder::release() {
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // A ticket owed to an earlier shrink is retired instead of being handed back.
+        if (_ticketsToRetire > 0) {
+            _ticketsToRetire--;
+            return;
+        }
         _num++;
     }
     _newTicket.notify_one();
@@ -232,6 +274,25 @@ Status TicketHolder::resize(int newSize) {
     return Status::OK();
 }
 
+Status TicketHolder::resizeWithoutWaiting(int newSize) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    const int delta = newSize - _outof.load();
+    if (delta >= 0) {
+        const int repaid = std::min(delta, _ticketsToRetire);
+        _ticketsToRetire -= repaid;
+        _num += delta - repaid;
+    } else {
+        const int taken = std::min(-delta, _num);
+        _num -= taken;
+        _ticketsToRetire += -delta - taken;
+    }
+    _outof.store(newSize);
+
+    _newTicket.notify_all();
+    return Status::OK();
+}
+
 int TicketHolder::available() const {
     return _num;
 }
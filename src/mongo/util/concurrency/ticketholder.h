@@ -76,6 +76,13 @@ public:
 
     Status resize(int newSize);
 
+    /**
+     * Like resize(), but does not wait for tickets in use to be released when shrinking. Available
+     * tickets are taken out of the pool immediately, and the remainder are retired as they are
+     * released, so used() may transiently exceed outof().
+     */
+    Status resizeWithoutWaiting(int newSize);
+
     int available() const;
 
     int used() const;
@@ -89,11 +96,15 @@ private:
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicInt32 _outof;
     stdx::mutex _resizeMutex;
+
+    // Number of tickets to retire on release rather than hand back to the semaphore.
+    AtomicInt32 _ticketsToRetire;
 #else
     bool _tryAcquire();
 
     AtomicInt32 _outof;
     int _num;
+    int _ticketsToRetire = 0;
     stdx::mutex _mutex;
     stdx::condition_variable _newTicket;
 #endif
@@ -73,4 +73,35 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, ResizeWithoutWaitingRetiresHeldTickets) {
+    TicketHolder holder(10);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    // Two tickets are available immediately; the other two are retired as they come back.
+    ASSERT_OK(holder.resizeWithoutWaiting(6));
+    ASSERT_EQ(holder.outof(), 6);
+    ASSERT_EQ(holder.available(), 0);
+
+    for (int i = 0; i < 2; ++i) {
+        holder.release();
+        ASSERT_EQ(holder.available(), 0);
+    }
+    holder.release();
+    ASSERT_EQ(holder.available(), 1);
+
+    // Growing hands back tickets that no longer need to be retired.
+    ASSERT(holder.tryAcquire());
+    ASSERT_OK(holder.resizeWithoutWaiting(5));
+    ASSERT_OK(holder.resizeWithoutWaiting(7));
+    ASSERT_EQ(holder.outof(), 7);
+    ASSERT_EQ(holder.available(), 1);
+    for (int i = 0; i < 6; ++i) {
+        holder.release();
+    }
+    ASSERT_EQ(holder.available(), 7);
+    ASSERT_EQ(holder.used(), 0);
+}
 }  // namespace